@@ -34,6 +34,19 @@
 #define ONLP_SNMP_PLATFORM_GENERAL_OID ONLP_SNMP_PLATFORM_INFORMATION_OID,1
 #define ONLP_SNMP_PLATFORM_SYSTEM_OID ONLP_SNMP_PLATFORM_GENERAL_OID,1
 
+#define ONLP_SNMP_PLATFORM_RESOURCES_OID            1,3,6,1,4,1,42623,1,3
+#define ONLP_SNMP_PLATFORM_API_STATS_TABLE_OID ONLP_SNMP_PLATFORM_RESOURCES_OID,2,1
+
+/** ONLP API statistics table columns */
+#define ONLP_SNMP_API_STATS_INDEX          1
+#define ONLP_SNMP_API_STATS_NAME           2
+#define ONLP_SNMP_API_STATS_CALLS          3
+#define ONLP_SNMP_API_STATS_ERRORS         4
+#define ONLP_SNMP_API_STATS_LOCK_TOTAL     5
+#define ONLP_SNMP_API_STATS_LOCK_MAX       6
+#define ONLP_SNMP_API_STATS_CALL_TOTAL     7
+#define ONLP_SNMP_API_STATS_CALL_MAX       8
+
 #endif /* __ONLP_SNMP_PLATFORM_OIDS_H__ */
 
 
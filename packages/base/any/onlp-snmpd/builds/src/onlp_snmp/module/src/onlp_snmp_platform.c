@@ -32,6 +32,8 @@
 #include <net-snmp/net-snmp-includes.h>
 #include <net-snmp/agent/net-snmp-agent-includes.h>
 #include <onlp/sys.h>
+#include <onlp/stats.h>
+#include <onlp_snmp/onlp_snmp_platform_oids.h>
 
 static void
 platform_string_register(int index, const char* desc, char* value)
@@ -175,6 +177,153 @@ idle_handler(netsnmp_mib_handler *handler,
     return SNMP_ERR_NOERROR;
 }
 
+/*
+ * ONLP API statistics table.
+ * Each row refers to a slot in the shared API statistics table.
+ */
+static netsnmp_tdata* api_stats_table__ = NULL;
+static uint32_t api_stats_rows__[ONLP_CONFIG_API_STATS_MAX];
+
+static void
+api_stats_rows_update__(void)
+{
+    int i;
+    onlp_api_stats_t s;
+
+    for(i = 0; i < ONLP_CONFIG_API_STATS_MAX; i++) {
+        netsnmp_tdata_row* row;
+
+        if(api_stats_rows__[i] || onlp_api_stats_get(i, &s) < 0) {
+            continue;
+        }
+        if( (row = netsnmp_tdata_create_row()) == NULL) {
+            AIM_LOG_ERROR("failed to allocate table row");
+            return;
+        }
+        /* Row indexes are 1-based */
+        api_stats_rows__[i] = i + 1;
+        row->data = api_stats_rows__ + i;
+        netsnmp_tdata_row_add_index(row, ASN_INTEGER, &api_stats_rows__[i],
+                                    sizeof(api_stats_rows__[i]));
+        netsnmp_tdata_add_row(api_stats_table__, row);
+    }
+}
+
+static void
+api_stats_counter64__(netsnmp_request_info* req, uint64_t v)
+{
+    struct counter64 c;
+    c.high = v >> 32;
+    c.low = v & 0xFFFFFFFF;
+    snmp_set_var_typed_value(req->requestvb, ASN_COUNTER64,
+                             (u_char*) &c, sizeof(c));
+}
+
+static void
+api_stats_gauge__(netsnmp_request_info* req, uint64_t v)
+{
+    uint32_t g = (v > 0xFFFFFFFF) ? 0xFFFFFFFF : v;
+    snmp_set_var_typed_value(req->requestvb, ASN_GAUGE,
+                             (u_char*) &g, sizeof(g));
+}
+
+static int
+api_stats_handler__(netsnmp_mib_handler *handler,
+                    netsnmp_handler_registration *reginfo,
+                    netsnmp_agent_request_info *reqinfo,
+                    netsnmp_request_info *requests)
+{
+    netsnmp_request_info *req;
+
+    if (reqinfo->mode != MODE_GET && reqinfo->mode != MODE_GETNEXT) {
+        return SNMP_ERR_NOERROR;
+    }
+
+    for (req = requests; req; req = req->next) {
+        onlp_api_stats_t s;
+        uint32_t* index = (uint32_t*) netsnmp_tdata_extract_entry(req);
+        netsnmp_table_request_info *table_info =
+            netsnmp_extract_table_info(req);
+
+        if (index == NULL || onlp_api_stats_get(*index - 1, &s) < 0) {
+            netsnmp_set_request_error(reqinfo, req, SNMP_NOSUCHINSTANCE);
+            continue;
+        }
+
+        switch(table_info->colnum)
+            {
+            case ONLP_SNMP_API_STATS_INDEX:
+                snmp_set_var_typed_integer(req->requestvb, ASN_INTEGER, *index);
+                break;
+            case ONLP_SNMP_API_STATS_NAME:
+                snmp_set_var_typed_value(req->requestvb, ASN_OCTET_STR,
+                                         (u_char*) s.name, strlen(s.name));
+                break;
+            case ONLP_SNMP_API_STATS_CALLS:
+                api_stats_counter64__(req, s.calls);
+                break;
+            case ONLP_SNMP_API_STATS_ERRORS:
+                api_stats_counter64__(req, s.errors);
+                break;
+            case ONLP_SNMP_API_STATS_LOCK_TOTAL:
+                api_stats_counter64__(req, s.lock.total);
+                break;
+            case ONLP_SNMP_API_STATS_LOCK_MAX:
+                api_stats_gauge__(req, s.lock.max);
+                break;
+            case ONLP_SNMP_API_STATS_CALL_TOTAL:
+                api_stats_counter64__(req, s.call.total);
+                break;
+            case ONLP_SNMP_API_STATS_CALL_MAX:
+                api_stats_gauge__(req, s.call.max);
+                break;
+            default:
+                netsnmp_set_request_error(reqinfo, req, SNMP_NOSUCHINSTANCE);
+                break;
+            }
+    }
+
+    /* APIs called for the first time since the last request appear on the next walk. */
+    api_stats_rows_update__();
+
+    if (handler->next && handler->next->access_method) {
+        return netsnmp_call_next_handler(handler, reginfo, reqinfo, requests);
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
+static void
+api_stats_register__(void)
+{
+    oid tree[] = { ONLP_SNMP_PLATFORM_API_STATS_TABLE_OID };
+    netsnmp_table_registration_info *table_info;
+    netsnmp_handler_registration *reg;
+
+    api_stats_table__ = netsnmp_tdata_create_table("onlpApiStatsTable", 0);
+    table_info = SNMP_MALLOC_TYPEDEF(netsnmp_table_registration_info);
+    if (api_stats_table__ == NULL || table_info == NULL) {
+        AIM_LOG_ERROR("failed to create the API statistics table");
+        return;
+    }
+
+    netsnmp_table_helper_add_indexes(table_info, ASN_INTEGER, 0);
+    table_info->min_column = ONLP_SNMP_API_STATS_INDEX;
+    table_info->max_column = ONLP_SNMP_API_STATS_CALL_MAX;
+
+    reg = netsnmp_create_handler_registration("onlpApiStatsTable",
+                                              api_stats_handler__,
+                                              tree, OID_LENGTH(tree),
+                                              HANDLER_CAN_RONLY);
+    if (reg == NULL ||
+        netsnmp_tdata_register(reg, api_stats_table__, table_info) != MIB_REGISTERED_OK) {
+        AIM_LOG_ERROR("failed to register the API statistics table");
+        return;
+    }
+
+    api_stats_rows_update__();
+}
+
 void
 onlp_snmp_platform_init(void)
 {
@@ -218,5 +367,6 @@ onlp_snmp_platform_init(void)
 
     resource_int_register(1, "CpuAllPercentUtilization", utilization_handler);
     resource_int_register(2, "CpuAllPercentIdle", idle_handler);
+    api_stats_register__();
 }
 
@@ -0,0 +1,159 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * ONLP Asynchronous API
+ *
+ * Info gets and SFP reads may be submitted without blocking.
+ * Requests are queued on an executor worker for the I/O domain
+ * of the device (see onlp_sys_pm_domain_t). Each worker takes
+ * its whole queue at once, sorts it by device and issues a
+ * single hardware access for identical requests.
+ *
+ * Completed requests are collected on a completion queue. Its
+ * eventfd (onlp_async_fd()) becomes readable when completions
+ * are pending, and onlp_async_poll() runs their callbacks in
+ * the calling thread. A single-threaded event loop can keep
+ * any number of requests in flight.
+ *
+ ***********************************************************/
+#ifndef __ONLP_ASYNC_H__
+#define __ONLP_ASYNC_H__
+
+#include <onlp/onlp_config.h>
+#include <onlp/onlp.h>
+#include <onlp/thermal.h>
+#include <onlp/fan.h>
+#include <onlp/psu.h>
+#include <onlp/led.h>
+#include <onlp/sfp.h>
+
+/**
+ * Asynchronous operations.
+ */
+typedef enum onlp_async_op_e {
+    /** onlp_thermal_info_get(oid) */
+    ONLP_ASYNC_OP_THERMAL_INFO_GET,
+    /** onlp_fan_info_get(oid) */
+    ONLP_ASYNC_OP_FAN_INFO_GET,
+    /** onlp_psu_info_get(oid) */
+    ONLP_ASYNC_OP_PSU_INFO_GET,
+    /** onlp_led_info_get(oid) */
+    ONLP_ASYNC_OP_LED_INFO_GET,
+    /** onlp_sfp_eeprom_read(port) into data */
+    ONLP_ASYNC_OP_SFP_EEPROM_READ,
+    /** onlp_sfp_dom_read(port) into data */
+    ONLP_ASYNC_OP_SFP_DOM_READ,
+    /** onlp_sfp_read(port, devaddr, page, offset, len) into data */
+    ONLP_ASYNC_OP_SFP_READ,
+    ONLP_ASYNC_OP_COUNT,
+} onlp_async_op_t;
+
+/** The data size of the SFP EEPROM and DOM read operations. */
+#define ONLP_ASYNC_SFP_DATA_SIZE 256
+
+typedef struct onlp_async_req_s onlp_async_req_t;
+
+/**
+ * Completion callback.
+ * @param req The completed request. req->rv holds the result.
+ * @param cookie The cookie given to onlp_async_submit().
+ */
+typedef void (*onlp_async_cb_f)(onlp_async_req_t* req, void* cookie);
+
+/**
+ * Asynchronous request.
+ *
+ * The request is owned by the caller and must remain valid
+ * until its callback has run. No memory is allocated per request.
+ */
+struct onlp_async_req_s {
+    /** The operation */
+    onlp_async_op_t op;
+
+    /** The target of info gets */
+    onlp_oid_t oid;
+
+    /** The following are only used by SFP reads. */
+    int port;
+    uint8_t devaddr;
+    int page;
+    int offset;
+    int len;
+
+    /**
+     * Receives the SFP data. Must hold ONLP_ASYNC_SFP_DATA_SIZE
+     * bytes for EEPROM and DOM reads, or len bytes for reads.
+     */
+    uint8_t* data;
+
+    /** Receives the info for info gets */
+    union {
+        onlp_thermal_info_t thermal;
+        onlp_fan_info_t fan;
+        onlp_psu_info_t psu;
+        onlp_led_info_t led;
+    } info;
+
+    /** The return value of the operation */
+    int rv;
+
+    /** Internal */
+    onlp_async_cb_f cb;
+    void* cookie;
+    onlp_async_req_t* next;
+};
+
+/**
+ * @brief Submit an asynchronous request.
+ * @param req The request.
+ * @param cb The completion callback. May be NULL.
+ * @param cookie Passed to the callback.
+ * @note The executor is started on first use.
+ */
+int onlp_async_submit(onlp_async_req_t* req, onlp_async_cb_f cb, void* cookie);
+
+/**
+ * @brief Get the completion eventfd.
+ * @returns A file descriptor which is readable while completions
+ * are pending, or an error.
+ * @note The descriptor is owned by ONLP. Do not read or close it.
+ */
+int onlp_async_fd(void);
+
+/**
+ * @brief Run the callbacks of completed requests.
+ * @param max The maximum number of completions to process.
+ * Zero or less processes all of them.
+ * @returns The number of completions processed.
+ * @note This never blocks.
+ */
+int onlp_async_poll(int max);
+
+/**
+ * @brief Stop the executor.
+ * @note Requests already being executed are completed. Queued
+ * requests are completed with ONLP_STATUS_E_BUSY. All pending
+ * callbacks run before this returns. This must not be called
+ * concurrently with onlp_async_submit() or onlp_async_poll().
+ */
+void onlp_async_denit(void);
+
+#endif /* __ONLP_ASYNC_H__ */
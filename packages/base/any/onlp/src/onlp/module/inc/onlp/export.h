@@ -0,0 +1,98 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Structured Platform Export.
+ *
+ * Platform state is written as a stream of self-contained
+ * records, one per OID or SFP port, directly to a file
+ * descriptor. Two encodings are supported:
+ *
+ *   JSON -- One JSON object per line (JSON Lines).
+ *   CBOR -- A CBOR sequence (RFC 8742) of maps.
+ *
+ ***********************************************************/
+#ifndef __ONLP_EXPORT_H__
+#define __ONLP_EXPORT_H__
+
+#include <onlp/onlp_config.h>
+#include <onlp/onlp.h>
+#include <onlp/oids.h>
+
+/** Encode records as CBOR instead of JSON. */
+#define ONLP_EXPORT_F_CBOR     0x1
+/** Export all children of the given OID. */
+#define ONLP_EXPORT_F_RECURSE  0x2
+/** Include DOM data in SFP records. */
+#define ONLP_EXPORT_F_SFP_DOM  0x4
+
+typedef struct onlp_export_s onlp_export_t;
+
+/**
+ * @brief Create an export stream.
+ * @param fd The output file descriptor.
+ * @param flags The export flags.
+ * @note The descriptor is not closed when the stream is destroyed.
+ */
+onlp_export_t* onlp_export_create(int fd, uint32_t flags);
+
+/**
+ * @brief Flush any buffered output.
+ * @param e The export stream.
+ * @returns < 0 if any write to the descriptor has failed.
+ */
+int onlp_export_flush(onlp_export_t* e);
+
+/**
+ * @brief Flush and destroy an export stream.
+ * @param e The export stream.
+ * @returns < 0 if any write to the descriptor has failed.
+ */
+int onlp_export_destroy(onlp_export_t* e);
+
+/**
+ * @brief Export an OID record.
+ * @param e The export stream.
+ * @param oid The OID.
+ * @note With ONLP_EXPORT_F_RECURSE all children are also exported.
+ */
+int onlp_export_oid(onlp_export_t* e, onlp_oid_t oid);
+
+/**
+ * @brief Export the inventory record for a single SFP port.
+ * @param e The export stream.
+ * @param port The port number.
+ */
+int onlp_export_sfp(onlp_export_t* e, int port);
+
+/**
+ * @brief Export inventory records for all SFP ports.
+ * @param e The export stream.
+ */
+int onlp_export_sfps(onlp_export_t* e);
+
+/**
+ * @brief Export the complete OID tree and SFP inventory.
+ * @param fd The output file descriptor.
+ * @param flags The export flags. ONLP_EXPORT_F_RECURSE is implied.
+ */
+int onlp_export_platform(int fd, uint32_t flags);
+
+#endif /* __ONLP_EXPORT_H__ */
@@ -100,6 +100,21 @@ typedef struct onlp_led_info_s {
 
 } onlp_led_info_t;
 
+/**
+ * A single LED mode update for onlp_led_set_many().
+ */
+typedef struct onlp_led_update_s {
+    /** The LED OID */
+    onlp_oid_t id;
+
+    /** The new mode */
+    onlp_led_mode_t mode;
+
+    /** [out] The result of this update */
+    int rv;
+
+} onlp_led_update_t;
+
 /**
  * @brief Initialize the LED subsystem.
  */
@@ -142,6 +157,11 @@ int onlp_led_set(onlp_oid_t id, int on_or_off);
  * @param id The LED OID
  * @param color The color.
  * @note Only relevant if the LED supports the color capability.
+ * @note When ONLP_CONFIG_INCLUDE_LED_SOFT_BLINK is set, a blinking
+ * color mode which the LED does not support is emulated if the LED
+ * supports the solid color. Emulation is available to every process
+ * while the platform manager is running, and the emulated modes are
+ * advertised in the LED caps for that time only.
  */
 int onlp_led_mode_set(onlp_oid_t id, onlp_led_mode_t color);
 
@@ -154,6 +174,18 @@ int onlp_led_mode_set(onlp_oid_t id, onlp_led_mode_t color);
  */
 int onlp_led_char_set(onlp_oid_t id, char c);
 
+/**
+ * @brief Set the mode of multiple LEDs.
+ * @param updates The updates. The result of each update is
+ * stored in its rv field.
+ * @param count The number of updates.
+ * @returns ONLP_STATUS_OK if all updates succeeded, otherwise
+ * the first failure.
+ * @note The platform may coalesce updates which share a register.
+ * See onlp_led_mode_set() for blinking mode emulation.
+ */
+int onlp_led_set_many(onlp_led_update_t* updates, int count);
+
 /**
  * @brief LED OID debug dump
  * @param id The LED OID
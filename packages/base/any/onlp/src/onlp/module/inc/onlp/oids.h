@@ -92,8 +92,12 @@ typedef enum onlp_oid_type_e {
 
 typedef char onlp_oid_desc_t[ONLP_OID_DESC_SIZE];
 
-/* fixme */
-#define ONLP_OID_TABLE_SIZE 32
+/**
+ * The fixed-size child table embedded in each OID header.
+ * Objects with more children than this are enumerated using
+ * the onlp_oid_list_t APIs below.
+ */
+#define ONLP_OID_TABLE_SIZE ONLP_CONFIG_OID_TABLE_SIZE
 typedef onlp_oid_t onlp_oid_table_t[ONLP_OID_TABLE_SIZE];
 #define ONLP_OID_TABLE_SIZE_BYTES (sizeof(onlp_oid_t)*ONLP_OID_TABLE_SIZE)
 #define ONLP_OID_TABLE_COPY(_dst, _src) memcpy(_dst, _src, ONLP_OID_TABLE_SIZE_BYTES)
@@ -164,6 +168,126 @@ void onlp_oid_table_show(onlp_oid_table_t table, aim_pvs_t* pvs,
     ONLP_OID_TABLE_ITER_EXPR(_table, _oidp, ONLP_OID_IS_TYPE(ONLP_OID_TYPE_##_type, *_oidp))
 
 
+/**
+ * Variable-length OID list.
+ *
+ * The entries are stored in a single contiguous allocation
+ * which grows as required. Lists must be initialized with
+ * onlp_oid_list_init() (or ONLP_OID_LIST_INIT) and released
+ * with onlp_oid_list_free().
+ */
+typedef struct onlp_oid_list_s {
+    /** The number of valid entries */
+    int count;
+    /** The number of allocated entries */
+    int size;
+    /** The entries */
+    onlp_oid_t* oids;
+} onlp_oid_list_t;
+
+#define ONLP_OID_LIST_INIT { 0, 0, NULL }
+
+/**
+ * @brief Initialize an empty OID list.
+ * @param list The list.
+ */
+void onlp_oid_list_init(onlp_oid_list_t* list);
+
+/**
+ * @brief Release the storage associated with an OID list.
+ * @param list The list.
+ * @note The list is left empty and may be reused.
+ */
+void onlp_oid_list_free(onlp_oid_list_t* list);
+
+/**
+ * @brief Remove all entries from an OID list without releasing its storage.
+ * @param list The list.
+ */
+void onlp_oid_list_clear(onlp_oid_list_t* list);
+
+/**
+ * @brief Make sure the list can hold at least the given number of entries.
+ * @param list The list.
+ * @param size The required number of entries.
+ */
+int onlp_oid_list_reserve(onlp_oid_list_t* list, int size);
+
+/**
+ * @brief Append an OID to the list.
+ * @param list The list.
+ * @param oid The OID.
+ */
+int onlp_oid_list_append(onlp_oid_list_t* list, onlp_oid_t oid);
+
+/**
+ * @brief Append all OIDs in a fixed OID table to the list.
+ * @param list The list.
+ * @param table The source table.
+ */
+int onlp_oid_list_append_table(onlp_oid_list_t* list, onlp_oid_table_t table);
+
+/**
+ * @brief Copy the first ONLP_OID_TABLE_SIZE entries of a list into a fixed table.
+ * @param list The list.
+ * @param table The destination table.
+ * @returns The number of entries copied.
+ * @note Provided for compatibility with the onlp_oid_hdr_t child table.
+ */
+int onlp_oid_list_to_table(onlp_oid_list_t* list, onlp_oid_table_t table);
+
+/**
+ * @brief Iterate over all OIDs in the given list that match the given expression.
+ * @param _list  The OID list pointer.
+ * @param _oidp  OID pointer iterator.
+ * @param _expr  OID Expression which must be true.
+ */
+#define ONLP_OID_LIST_ITER_EXPR(_list, _oidp, _expr)                    \
+    for(_oidp = (_list)->oids;                                          \
+        _oidp && _oidp < ((_list)->oids + (_list)->count); _oidp++)     \
+        if( (*_oidp) && (_expr) )
+
+/**
+ * @brief Iterate over all OIDs in the given list.
+ * @param _list The OID list pointer.
+ * @param _oidp OID pointer iterator.
+ */
+#define ONLP_OID_LIST_ITER(_list, _oidp) ONLP_OID_LIST_ITER_EXPR(_list, _oidp, 1)
+
+/**
+ * @brief Iterate over all OIDs in the given list of the given type.
+ * @param _list The OID list pointer.
+ * @param _oidp OID pointer iterator.
+ * @param _type The OID Type
+ */
+#define ONLP_OID_LIST_ITER_TYPE(_list, _oidp, _type)                    \
+    ONLP_OID_LIST_ITER_EXPR(_list, _oidp, ONLP_OID_IS_TYPE(ONLP_OID_TYPE_##_type, *_oidp))
+
+/**
+ * @brief Dump all OIDs in the list.
+ * @param list The list.
+ * @param pvs The output pvs.
+ * @param flags The ONLP_OID_DUMP_F_* flags.
+ */
+void onlp_oid_list_dump(onlp_oid_list_t* list, aim_pvs_t* pvs, uint32_t flags);
+
+/**
+ * @brief Show all OIDs in the list.
+ * @param list The list.
+ * @param pvs The output pvs.
+ * @param flags The ONLP_OID_SHOW_F_* flags.
+ */
+void onlp_oid_list_show(onlp_oid_list_t* list, aim_pvs_t* pvs, uint32_t flags);
+
+/**
+ * @brief Get the complete list of children for the given OID.
+ * @param oid The OID.
+ * @param list [out] Receives the child OIDs. Existing entries are replaced.
+ * @note Unlike onlp_oid_hdr_get(), the result is not limited
+ * to ONLP_OID_TABLE_SIZE entries.
+ */
+int onlp_oid_coids_get(onlp_oid_t oid, onlp_oid_list_t* list);
+
 /**
  * Iterator
  */
@@ -38,6 +38,7 @@ typedef enum onlp_status_e {
     ONLP_STATUS_E_INTERNAL = -13,
     ONLP_STATUS_E_PARAM = -14,
     ONLP_STATUS_E_I2C = -15,
+    ONLP_STATUS_E_BUSY = -16,
 } onlp_status_t;
 /* <auto.end.enum(tag:onlp).define> */
 
@@ -59,6 +60,33 @@ typedef enum onlp_status_e {
  */
 int onlp_init(void);
 
+/**
+ * @brief Reload the ONLP configuration file.
+ * @note The file is reread the next time it is used.
+ * This is async-signal-safe, e.g. for use in a SIGHUP handler.
+ */
+void onlp_config_reload(void);
+
+/**
+ * Wait for the API lock as configured: forever for the shared lock
+ * unless ONLP_CONFIG_API_LOCK_SHARED_TIMEOUT_FATAL is set, otherwise
+ * up to ONLP_CONFIG_API_LOCK_TIMEOUT, after which failure is fatal.
+ */
+#define ONLP_API_LOCK_TIMEOUT_DEFAULT -1
+/** Only try to take the API lock once. */
+#define ONLP_API_LOCK_TIMEOUT_TRY      0
+
+/**
+ * @brief Select how the calling thread waits for the API lock.
+ * @param timeout ONLP_API_LOCK_TIMEOUT_DEFAULT, ONLP_API_LOCK_TIMEOUT_TRY,
+ * or the maximum wait in microseconds.
+ * @returns The previous setting.
+ * @note With a try or bounded wait an API returns ONLP_STATUS_E_BUSY
+ * without doing anything if the lock is not acquired in time. This allows
+ * latency-sensitive callers to skip a cycle instead of stalling.
+ */
+int64_t onlp_api_lock_timeout_set(int64_t timeout);
+
 
 /**
  * @brief Dump the current platform data.
@@ -224,6 +224,16 @@
 #define ONLP_CONFIG_API_LOCK_TIMEOUT 60000000
 #endif
 
+/**
+ * ONLP_CONFIG_API_LOCK_SHARED_TIMEOUT_FATAL
+ *
+ * Apply ONLP_CONFIG_API_LOCK_TIMEOUT to the shared API lock. By default the shared API lock waits forever. */
+
+
+#ifndef ONLP_CONFIG_API_LOCK_SHARED_TIMEOUT_FATAL
+#define ONLP_CONFIG_API_LOCK_SHARED_TIMEOUT_FATAL 0
+#endif
+
 /**
  * ONLP_CONFIG_INFO_STR_MAX
  *
@@ -254,6 +264,216 @@
 #define ONLP_CONFIG_INCLUDE_API_PROFILING 0
 #endif
 
+/**
+ * ONLP_CONFIG_OID_TABLE_SIZE
+ *
+ * The number of child OIDs stored inline in each OID header. Larger child sets are available through the OID list APIs. */
+
+
+#ifndef ONLP_CONFIG_OID_TABLE_SIZE
+#define ONLP_CONFIG_OID_TABLE_SIZE 32
+#endif
+
+/**
+ * ONLP_CONFIG_SERVER_SOCKET_PATH
+ *
+ * The Unix domain socket served by the platform manager daemon. */
+
+
+#ifndef ONLP_CONFIG_SERVER_SOCKET_PATH
+#define ONLP_CONFIG_SERVER_SOCKET_PATH "/var/run/onlpd.sock"
+#endif
+
+/**
+ * ONLP_CONFIG_SERVER_REFRESH_INTERVAL
+ *
+ * The interval (in usecs) at which the daemon refreshes its cached OID records. */
+
+
+#ifndef ONLP_CONFIG_SERVER_REFRESH_INTERVAL
+#define ONLP_CONFIG_SERVER_REFRESH_INTERVAL 5000000
+#endif
+
+/**
+ * ONLP_CONFIG_SERVER_SFP_DOM_REFRESH_INTERVAL
+ *
+ * The interval (in usecs) at which the daemon refreshes SFP records and their DOM monitors. SFP records are otherwise only refreshed when presence changes. */
+
+
+#ifndef ONLP_CONFIG_SERVER_SFP_DOM_REFRESH_INTERVAL
+#define ONLP_CONFIG_SERVER_SFP_DOM_REFRESH_INTERVAL 30000000
+#endif
+
+/**
+ * ONLP_CONFIG_SERVER_CLIENTS_MAX
+ *
+ * The maximum number of concurrent server clients. */
+
+
+#ifndef ONLP_CONFIG_SERVER_CLIENTS_MAX
+#define ONLP_CONFIG_SERVER_CLIENTS_MAX 32
+#endif
+
+/**
+ * ONLP_CONFIG_SERVER_REQUEST_MAX
+ *
+ * The maximum length of a single server request line. */
+
+
+#ifndef ONLP_CONFIG_SERVER_REQUEST_MAX
+#define ONLP_CONFIG_SERVER_REQUEST_MAX 1024
+#endif
+
+/**
+ * ONLP_CONFIG_INCLUDE_API_STATS
+ *
+ * Include per-API call, error and latency statistics in all locked API wrappers. */
+
+
+#ifndef ONLP_CONFIG_INCLUDE_API_STATS
+#define ONLP_CONFIG_INCLUDE_API_STATS 1
+#endif
+
+/**
+ * ONLP_CONFIG_API_STATS_MAX
+ *
+ * The maximum number of distinct APIs tracked in the statistics table. */
+
+
+#ifndef ONLP_CONFIG_API_STATS_MAX
+#define ONLP_CONFIG_API_STATS_MAX 256
+#endif
+
+/**
+ * ONLP_CONFIG_API_STATS_SHM_KEY
+ *
+ * The shared memory key for the API statistics table. */
+
+
+#ifndef ONLP_CONFIG_API_STATS_SHM_KEY
+#define ONLP_CONFIG_API_STATS_SHM_KEY 0xF00DF00E
+#endif
+
+/**
+ * ONLP_CONFIG_INCLUDE_LED_SOFT_BLINK
+ *
+ * Emulate blinking LED modes in the platform manager when the LED only supports the solid color. */
+
+
+#ifndef ONLP_CONFIG_INCLUDE_LED_SOFT_BLINK
+#define ONLP_CONFIG_INCLUDE_LED_SOFT_BLINK 1
+#endif
+
+/**
+ * ONLP_CONFIG_LED_BLINK_PERIOD_MS
+ *
+ * The period of emulated LED blinking, in milliseconds. */
+
+
+#ifndef ONLP_CONFIG_LED_BLINK_PERIOD_MS
+#define ONLP_CONFIG_LED_BLINK_PERIOD_MS 1000
+#endif
+
+/**
+ * ONLP_CONFIG_LED_BLINK_MAX
+ *
+ * The maximum number of LEDs with an emulated blinking mode. */
+
+
+#ifndef ONLP_CONFIG_LED_BLINK_MAX
+#define ONLP_CONFIG_LED_BLINK_MAX 64
+#endif
+
+/**
+ * ONLP_CONFIG_LED_BLINK_SHM_KEY
+ *
+ * The shared memory key for the emulated LED blink table. */
+
+
+#ifndef ONLP_CONFIG_LED_BLINK_SHM_KEY
+#define ONLP_CONFIG_LED_BLINK_SHM_KEY 0xF00DF011
+#endif
+
+/**
+ * ONLP_CONFIG_PSU_POWER_WINDOW
+ *
+ * The number of PSU power samples kept by the platform manager for min/avg/max statistics. */
+
+
+#ifndef ONLP_CONFIG_PSU_POWER_WINDOW
+#define ONLP_CONFIG_PSU_POWER_WINDOW 60
+#endif
+
+/**
+ * ONLP_CONFIG_PSU_POWER_MAX
+ *
+ * The maximum number of PSUs sampled for power statistics. */
+
+
+#ifndef ONLP_CONFIG_PSU_POWER_MAX
+#define ONLP_CONFIG_PSU_POWER_MAX 8
+#endif
+
+/**
+ * ONLP_CONFIG_PSU_POWER_SHM_KEY
+ *
+ * The shared memory key for the PSU power statistics table. */
+
+
+#ifndef ONLP_CONFIG_PSU_POWER_SHM_KEY
+#define ONLP_CONFIG_PSU_POWER_SHM_KEY 0xF00DF012
+#endif
+
+/**
+ * ONLP_CONFIG_INCLUDE_PLATFORM_PLUGINS
+ *
+ * Load the platform driver at runtime instead of linking it. Requires -ldl. */
+
+
+#ifndef ONLP_CONFIG_INCLUDE_PLATFORM_PLUGINS
+#define ONLP_CONFIG_INCLUDE_PLATFORM_PLUGINS 0
+#endif
+
+/**
+ * ONLP_CONFIG_PLATFORM_PLUGIN_PATH
+ *
+ * The platform driver path. Each %s is replaced by the platform name. */
+
+
+#ifndef ONLP_CONFIG_PLATFORM_PLUGIN_PATH
+#define ONLP_CONFIG_PLATFORM_PLUGIN_PATH "/lib/platform-config/%s/onl/lib/libonlp-%s.so"
+#endif
+
+/**
+ * ONLP_CONFIG_PLATFORM_PLUGIN_ENV
+ *
+ * The name of the environment variable which overrides the platform driver path. */
+
+
+#ifndef ONLP_CONFIG_PLATFORM_PLUGIN_ENV
+#define ONLP_CONFIG_PLATFORM_PLUGIN_ENV "ONLP_PLATFORM_PLUGIN"
+#endif
+
+/**
+ * ONLP_CONFIG_PLATFORM_SHIMS_ENV
+ *
+ * The name of the environment variable which lists colon separated platform interface shims. */
+
+
+#ifndef ONLP_CONFIG_PLATFORM_SHIMS_ENV
+#define ONLP_CONFIG_PLATFORM_SHIMS_ENV "ONLP_PLATFORM_SHIMS"
+#endif
+
+/**
+ * ONLP_CONFIG_INCLUDE_ASYNC
+ *
+ * Include the asynchronous API. */
+
+
+#ifndef ONLP_CONFIG_INCLUDE_ASYNC
+#define ONLP_CONFIG_INCLUDE_ASYNC 1
+#endif
+
 
 
 /**
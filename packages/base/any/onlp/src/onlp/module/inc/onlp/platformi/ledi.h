@@ -85,4 +85,17 @@ int onlp_ledi_mode_set(onlp_oid_t id, onlp_led_mode_t mode);
  */
 int onlp_ledi_char_set(onlp_oid_t id, char c);
 
+/**
+ * @brief Set the mode of multiple LEDs.
+ * @param updates The updates.
+ * @param count The number of updates.
+ * @notes Optional. The platform should perform all updates which
+ * share a register with a single write and store the result of each
+ * update in its rv field. Updates to modes which are not advertised
+ * in the LED capabilities must fail with ONLP_STATUS_E_UNSUPPORTED.
+ * If this returns ONLP_STATUS_E_UNSUPPORTED onlp_ledi_mode_set() is
+ * called for each update instead.
+ */
+int onlp_ledi_set_many(onlp_led_update_t* updates, int count);
+
 #endif /* __ONLP_LED_H__ */
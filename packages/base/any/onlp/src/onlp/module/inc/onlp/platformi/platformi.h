@@ -0,0 +1,102 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Runtime-loadable platform drivers.
+ *
+ * A platform driver plugin is a shared library which exports
+ * onlp_platformi_get(). It returns a versioned table of the
+ * driver's platform interface functions. When ONLP is built with
+ * ONLP_CONFIG_INCLUDE_PLATFORM_PLUGINS every onlp_*i_* call is
+ * dispatched through the table of the driver loaded for the
+ * current platform.
+ *
+ ***********************************************************/
+#ifndef __ONLP_PLATFORMI_H__
+#define __ONLP_PLATFORMI_H__
+
+#include <onlp/platformi/sysi.h>
+#include <onlp/platformi/thermali.h>
+#include <onlp/platformi/fani.h>
+#include <onlp/platformi/psui.h>
+#include <onlp/platformi/ledi.h>
+#include <onlp/platformi/sfpi.h>
+
+/**
+ * The table version. Tables with a different version are rejected.
+ * Appending functions does not change the version.
+ */
+#define ONLP_PLATFORMI_VERSION 1
+
+/**
+ * Platform interface table.
+ *
+ * A NULL entry is treated as unsupported.
+ */
+typedef struct onlp_platformi_s {
+    /** ONLP_PLATFORMI_VERSION */
+    uint32_t version;
+
+    /** sizeof(onlp_platformi_t) when the driver was built */
+    uint32_t size;
+
+    const char* (*onlp_sysi_platform_get)(void);
+
+#define ONLP_PLATFORMI_FUNCTION(_name, _params, _args) int (*_name) _params;
+#define ONLP_PLATFORMI_VFUNCTION(_name, _params, _args) void (*_name) _params;
+#include <onlp/platformi/platformi.x>
+
+} onlp_platformi_t;
+
+/** The plugin entry point symbol. */
+#define ONLP_PLATFORMI_ENTRY "onlp_platformi_get"
+
+/**
+ * @brief Get the driver's platform interface table.
+ * @note Exported by each driver plugin.
+ */
+const onlp_platformi_t* onlp_platformi_get(void);
+
+/** The shim entry point symbol. */
+#define ONLP_PLATFORMI_SHIM_ENTRY "onlp_platformi_shim"
+
+/**
+ * @brief Wrap a platform interface table.
+ * @param inner The table being wrapped.
+ * @returns The wrapping table, or NULL to leave the table unchanged.
+ * @note Exported by shims listed in ONLP_CONFIG_PLATFORM_SHIMS_ENV.
+ * Shims are applied in order, so the last shim listed is called first.
+ */
+const onlp_platformi_t* onlp_platformi_shim(const onlp_platformi_t* inner);
+
+/**
+ * @brief Get the active platform interface table.
+ * @returns NULL unless platform plugins are enabled.
+ */
+const onlp_platformi_t* onlp_platformi_table_get(void);
+
+/**
+ * @brief Replace the active platform interface table.
+ * @param table The new table. NULL restores the driver table.
+ * @note The table must remain valid while ONLP is in use.
+ */
+int onlp_platformi_table_set(const onlp_platformi_t* table);
+
+#endif /* __ONLP_PLATFORMI_H__ */
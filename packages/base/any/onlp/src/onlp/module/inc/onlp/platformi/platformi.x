@@ -0,0 +1,102 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Platform interface function list.
+ *
+ * ONLP_PLATFORMI_FUNCTION(_name, _params, _args) returns int.
+ * ONLP_PLATFORMI_VFUNCTION(_name, _params, _args) returns void.
+ * Both must be defined.
+ *
+ * New entries must be appended. Removing or reordering entries
+ * requires a new ONLP_PLATFORMI_VERSION.
+ *
+ ***********************************************************/
+
+#ifdef ONLP_PLATFORMI_FUNCTION
+ONLP_PLATFORMI_FUNCTION(onlp_sysi_platform_set, (const char* platform), (platform))
+ONLP_PLATFORMI_FUNCTION(onlp_sysi_init, (void), ())
+ONLP_PLATFORMI_FUNCTION(onlp_sysi_onie_data_phys_addr_get, (void** physaddr), (physaddr))
+ONLP_PLATFORMI_FUNCTION(onlp_sysi_onie_data_get, (uint8_t** data, int* size), (data, size))
+ONLP_PLATFORMI_VFUNCTION(onlp_sysi_onie_data_free, (uint8_t* data), (data))
+ONLP_PLATFORMI_FUNCTION(onlp_sysi_onie_info_get, (onlp_onie_info_t* onie), (onie))
+ONLP_PLATFORMI_FUNCTION(onlp_sysi_oids_get, (onlp_oid_t* table, int max), (table, max))
+ONLP_PLATFORMI_FUNCTION(onlp_sysi_ioctl, (int code, va_list vargs), (code, vargs))
+ONLP_PLATFORMI_FUNCTION(onlp_sysi_platform_manage_init, (void), ())
+ONLP_PLATFORMI_FUNCTION(onlp_sysi_platform_manage_fans, (void), ())
+ONLP_PLATFORMI_FUNCTION(onlp_sysi_platform_manage_leds, (void), ())
+ONLP_PLATFORMI_FUNCTION(onlp_sysi_platform_manage_domain_get, (onlp_sys_pm_task_t task), (task))
+ONLP_PLATFORMI_FUNCTION(onlp_sysi_platform_info_get, (onlp_platform_info_t* info), (info))
+ONLP_PLATFORMI_VFUNCTION(onlp_sysi_platform_info_free, (onlp_platform_info_t* info), (info))
+ONLP_PLATFORMI_FUNCTION(onlp_sysi_debug, (aim_pvs_t* pvs, int argc, char** argv), (pvs, argc, argv))
+ONLP_PLATFORMI_FUNCTION(onlp_thermali_init, (void), ())
+ONLP_PLATFORMI_FUNCTION(onlp_thermali_info_get, (onlp_oid_t id, onlp_thermal_info_t* rv), (id, rv))
+ONLP_PLATFORMI_FUNCTION(onlp_thermali_status_get, (onlp_oid_t id, uint32_t* rv), (id, rv))
+ONLP_PLATFORMI_FUNCTION(onlp_thermali_hdr_get, (onlp_oid_t id, onlp_oid_hdr_t* rv), (id, rv))
+ONLP_PLATFORMI_FUNCTION(onlp_thermali_ioctl, (int id, va_list vargs), (id, vargs))
+ONLP_PLATFORMI_FUNCTION(onlp_fani_init, (void), ())
+ONLP_PLATFORMI_FUNCTION(onlp_fani_info_get, (onlp_oid_t id, onlp_fan_info_t* rv), (id, rv))
+ONLP_PLATFORMI_FUNCTION(onlp_fani_status_get, (onlp_oid_t id, uint32_t* rv), (id, rv))
+ONLP_PLATFORMI_FUNCTION(onlp_fani_hdr_get, (onlp_oid_t id, onlp_oid_hdr_t* hdr), (id, hdr))
+ONLP_PLATFORMI_FUNCTION(onlp_fani_rpm_set, (onlp_oid_t id, int rpm), (id, rpm))
+ONLP_PLATFORMI_FUNCTION(onlp_fani_percentage_set, (onlp_oid_t id, int p), (id, p))
+ONLP_PLATFORMI_FUNCTION(onlp_fani_mode_set, (onlp_oid_t id, onlp_fan_mode_t mode), (id, mode))
+ONLP_PLATFORMI_FUNCTION(onlp_fani_dir_set, (onlp_oid_t id, onlp_fan_dir_t dir), (id, dir))
+ONLP_PLATFORMI_FUNCTION(onlp_fani_ioctl, (onlp_oid_t fid, va_list vargs), (fid, vargs))
+ONLP_PLATFORMI_FUNCTION(onlp_psui_init, (void), ())
+ONLP_PLATFORMI_FUNCTION(onlp_psui_info_get, (onlp_oid_t id, onlp_psu_info_t* rv), (id, rv))
+ONLP_PLATFORMI_FUNCTION(onlp_psui_status_get, (onlp_oid_t id, uint32_t* rv), (id, rv))
+ONLP_PLATFORMI_FUNCTION(onlp_psui_hdr_get, (onlp_oid_t id, onlp_oid_hdr_t* rv), (id, rv))
+ONLP_PLATFORMI_FUNCTION(onlp_psui_ioctl, (onlp_oid_t pid, va_list vargs), (pid, vargs))
+ONLP_PLATFORMI_FUNCTION(onlp_ledi_init, (void), ())
+ONLP_PLATFORMI_FUNCTION(onlp_ledi_info_get, (onlp_oid_t id, onlp_led_info_t* rv), (id, rv))
+ONLP_PLATFORMI_FUNCTION(onlp_ledi_status_get, (onlp_oid_t id, uint32_t* rv), (id, rv))
+ONLP_PLATFORMI_FUNCTION(onlp_ledi_hdr_get, (onlp_oid_t id, onlp_oid_hdr_t* rv), (id, rv))
+ONLP_PLATFORMI_FUNCTION(onlp_ledi_set, (onlp_oid_t id, int on_or_off), (id, on_or_off))
+ONLP_PLATFORMI_FUNCTION(onlp_ledi_ioctl, (onlp_oid_t id, va_list vargs), (id, vargs))
+ONLP_PLATFORMI_FUNCTION(onlp_ledi_mode_set, (onlp_oid_t id, onlp_led_mode_t mode), (id, mode))
+ONLP_PLATFORMI_FUNCTION(onlp_ledi_char_set, (onlp_oid_t id, char c), (id, c))
+ONLP_PLATFORMI_FUNCTION(onlp_ledi_set_many, (onlp_led_update_t* updates, int count), (updates, count))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_init, (void), ())
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_bitmap_get, (onlp_sfp_bitmap_t* bmap), (bmap))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_is_present, (int port), (port))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_presence_bitmap_get, (onlp_sfp_bitmap_t* dst), (dst))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_rx_los_bitmap_get, (onlp_sfp_bitmap_t* dst), (dst))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_eeprom_read, (int port, uint8_t data[256]), (port, data))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_dev_readb, (int port, uint8_t devaddr, uint8_t addr), (port, devaddr, addr))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_dev_writeb, (int port, uint8_t devaddr, uint8_t addr, uint8_t value), (port, devaddr, addr, value))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_dev_readw, (int port, uint8_t devaddr, uint8_t addr), (port, devaddr, addr))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_dev_writew, (int port, uint8_t devaddr, uint8_t addr, uint16_t value), (port, devaddr, addr, value))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_dom_read, (int port, uint8_t data[256]), (port, data))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_read, (int port, uint8_t devaddr, int page, int offset, int len, uint8_t* buf), (port, devaddr, page, offset, len, buf))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_post_insert, (int port, sff_info_t* info), (port, info))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_control_supported, (int port, onlp_sfp_control_t control, int* rv), (port, control, rv))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_control_set, (int port, onlp_sfp_control_t control, int value), (port, control, value))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_control_get, (int port, onlp_sfp_control_t control, int* value), (port, control, value))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_port_map, (int port, int* rport), (port, rport))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_denit, (void), ())
+ONLP_PLATFORMI_VFUNCTION(onlp_sfpi_debug, (int port, aim_pvs_t* pvs), (port, pvs))
+ONLP_PLATFORMI_FUNCTION(onlp_sfpi_ioctl, (int port, va_list vargs), (port, vargs))
+#undef ONLP_PLATFORMI_FUNCTION
+#endif
+
+#ifdef ONLP_PLATFORMI_VFUNCTION
+#undef ONLP_PLATFORMI_VFUNCTION
+#endif
@@ -106,6 +106,22 @@ int onlp_sfpi_dev_writew(int port, uint8_t devaddr, uint8_t addr, uint16_t value
  */
 int onlp_sfpi_dom_read(int port, uint8_t data[256]);
 
+/**
+ * @brief Read a range of a module's memory map.
+ * @param port The port number.
+ * @param devaddr The device address.
+ * @param page The upper page to select, or ONLP_SFP_PAGE_NONE.
+ * @param offset The starting offset.
+ * @param len The number of bytes to read.
+ * @param buf Receives the data.
+ * @returns The number of bytes read, or an error.
+ * @notes Optional. The range has been validated by the caller.
+ * If this returns ONLP_STATUS_E_UNSUPPORTED the read is emulated
+ * with onlp_sfpi_dev_writeb() and onlp_sfpi_dev_readb().
+ */
+int onlp_sfpi_read(int port, uint8_t devaddr, int page, int offset, int len,
+                   uint8_t* buf);
+
 /**
  * @brief Perform any actions required after an SFP is inserted.
  * @param port The port number.
@@ -114,6 +114,10 @@ int onlp_sysi_onie_info_get(onlp_onie_info_t* onie);
  * @brief This function returns the root oid list for the platform.
  * @param table [out] Receives the table.
  * @param max The maximum number of entries you can fill.
+ * @note If all max entries are filled this function will be
+ * called again with a larger table, so platforms with more than
+ * ONLP_OID_TABLE_SIZE root objects can report all of them.
+ * Never write more than max entries.
  */
 int onlp_sysi_oids_get(onlp_oid_t* table, int max);
 
@@ -149,6 +153,18 @@ int onlp_sysi_platform_manage_fans(void);
  */
 int onlp_sysi_platform_manage_leds(void);
 
+/**
+ * @brief Return the I/O domain of a platform management task.
+ * @param task The task.
+ * @returns The onlp_sys_pm_domain_t the task should run in,
+ * or < 0 to use the default domain.
+ * @notes Optional. Tasks in different domains run concurrently.
+ * Tasks which share hardware or platform state must be placed
+ * in the same domain. By default the fan and LED management
+ * tasks share a domain.
+ */
+int onlp_sysi_platform_manage_domain_get(onlp_sys_pm_task_t task);
+
 /**
  * @brief Return custom platform information.
  */
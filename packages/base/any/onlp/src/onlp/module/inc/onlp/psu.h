@@ -84,6 +84,31 @@ typedef struct onlp_psu_info_t {
 
 } onlp_psu_info_t;
 
+/**
+ * PSU power statistics.
+ *
+ * Collected once per second by the platform manager.
+ */
+typedef struct onlp_psu_power_stats_s {
+    /** The number of samples in the window */
+    uint32_t samples;
+
+    /** Input power over the window, in milliwatts */
+    int mpin_min;
+    int mpin_avg;
+    int mpin_max;
+
+    /** Output power over the window, in milliwatts */
+    int mpout_min;
+    int mpout_avg;
+    int mpout_max;
+
+    /** Energy since the platform manager started, in millijoules */
+    uint64_t mjin;
+    uint64_t mjout;
+
+} onlp_psu_power_stats_t;
+
 /**
  * @brief Initialize the PSU subsystem.
  */
@@ -124,6 +149,16 @@ int onlp_psu_ioctl(onlp_oid_t id, ...);
  */
 int onlp_psu_vioctl(onlp_oid_t id, va_list vargs);
 
+/**
+ * @brief Get the PSU power statistics.
+ * @param id The PSU OID
+ * @param rv [out] Receives the statistics.
+ * @returns ONLP_STATUS_E_UNSUPPORTED if no platform manager is
+ * sampling this PSU.
+ * @note The statistics are shared, so they may be read from any process.
+ */
+int onlp_psu_power_stats_get(onlp_oid_t id, onlp_psu_power_stats_t* rv);
+
 /**
  * @brief PSU OID debug dump
  * @param id The PSU OID
@@ -0,0 +1,92 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Platform State Server
+ *
+ * When started with -R, the platform manager daemon (onlpd)
+ * keeps a periodically refreshed snapshot of all OID records
+ * and the SFP inventory and serves it over a Unix domain stream
+ * socket. Queries are answered from the snapshot and never
+ * touch the hardware or take the ONLP API lock.
+ *
+ * OID records are refreshed every ONLP_CONFIG_SERVER_REFRESH_INTERVAL.
+ * SFP records are refreshed when module presence changes and
+ * every ONLP_CONFIG_SERVER_SFP_DOM_REFRESH_INTERVAL.
+ *
+ * Protocol
+ *
+ * Requests are newline-terminated lines. Multiple commands may
+ * be batched on one line separated by ';', and any number of
+ * lines may be pipelined. Each command is answered with zero
+ * or more records (see onlp/export.h) followed by a reply
+ * record:
+ *
+ *    { "reply": <command>, "status": "OK" | <error>,
+ *      "count": <records>, "age": <usecs> }
+ *
+ * "age" is the time since the snapshot the records were taken
+ * from was refreshed. It is omitted when no snapshot was used.
+ *
+ * Commands:
+ *
+ *    format json|cbor     Select the response encoding (default json).
+ *    get <oid> [<oid>...] OID records.
+ *    tree [<oid>]         OID records for the given subtree (default: the system).
+ *    sfp <port> [...]     SFP records.
+ *    sfps                 All SFP records.
+ *    all                  All OID and SFP records.
+ *    subscribe            Receive changed records after each refresh,
+ *                         followed by an "update" reply record.
+ *    unsubscribe          Stop receiving updates.
+ *    ping                 Reply only.
+ *
+ * Closing the write side of the connection ends the request
+ * stream. Subscriptions continue until the peer disconnects.
+ *
+ ***********************************************************/
+#ifndef __ONLP_SERVER_H__
+#define __ONLP_SERVER_H__
+
+#include <onlp/onlp_config.h>
+#include <onlp/onlp.h>
+
+/**
+ * @brief Start the platform state server.
+ * @param path The socket path. NULL selects ONLP_CONFIG_SERVER_SOCKET_PATH.
+ * @note The refresh and server threads run until onlp_server_stop().
+ */
+int onlp_server_start(const char* path);
+
+/**
+ * @brief Stop the platform state server and remove its socket.
+ */
+int onlp_server_stop(void);
+
+/**
+ * @brief Send a request to the platform state server.
+ * @param path The socket path. NULL selects ONLP_CONFIG_SERVER_SOCKET_PATH.
+ * @param request The request line(s).
+ * @param fd All responses are copied to this descriptor.
+ * @note This does not require onlp_init().
+ */
+int onlp_server_request(const char* path, const char* request, int fd);
+
+#endif /* __ONLP_SERVER_H__ */
@@ -77,6 +77,42 @@ typedef aim_bitmap256_t onlp_sfp_bitmap_t;
  */
 void onlp_sfp_bitmap_t_init(onlp_sfp_bitmap_t* bmap);
 
+/**
+ * @brief Word-level bitmap operations.
+ * @param dst Receives the result. Must be initialized.
+ * @param a First operand.
+ * @param b Second operand.
+ * @note dst may be the same as a or b.
+ */
+void onlp_sfp_bitmap_xor(onlp_sfp_bitmap_t* dst, const onlp_sfp_bitmap_t* a,
+                         const onlp_sfp_bitmap_t* b);
+void onlp_sfp_bitmap_or(onlp_sfp_bitmap_t* dst, const onlp_sfp_bitmap_t* a,
+                        const onlp_sfp_bitmap_t* b);
+void onlp_sfp_bitmap_and(onlp_sfp_bitmap_t* dst, const onlp_sfp_bitmap_t* a,
+                         const onlp_sfp_bitmap_t* b);
+
+/**
+ * @brief Return the number of set bits.
+ * @param bmap The bitmap.
+ */
+int onlp_sfp_bitmap_popcount(const onlp_sfp_bitmap_t* bmap);
+
+/**
+ * @brief Find the next set bit.
+ * @param bmap The bitmap.
+ * @param port The first port to consider.
+ * @returns The first set port >= port, or -1 if there is none.
+ */
+int onlp_sfp_bitmap_next(const onlp_sfp_bitmap_t* bmap, int port);
+
+/**
+ * Iterate over the set bits of an SFP bitmap a word at a time.
+ */
+#define ONLP_SFP_BITMAP_ITER(_bmap, _port)                      \
+    for((_port) = onlp_sfp_bitmap_next((_bmap), 0);            \
+        (_port) >= 0;                                           \
+        (_port) = onlp_sfp_bitmap_next((_bmap), (_port) + 1))
+
 /**
  * @brief Get the set of valid {Q}SFP ports.
  * @param bmap Returns the valid set of SFP-capable port numbers.
@@ -107,6 +143,21 @@ int onlp_sfp_is_present(int port);
  */
 int onlp_sfp_presence_bitmap_get(onlp_sfp_bitmap_t* dst);
 
+/**
+ * @brief Return the ports whose presence changed since a generation.
+ * @param generation [in,out] The generation last seen by the caller,
+ * or 0 for none. Receives the current generation.
+ * @param changed Receives the ports that changed since that generation.
+ * @param current Receives the current presence bitmap. May be NULL.
+ * @returns The number of changed ports, or an error.
+ * @note The presence bitmap is sampled on every call. Each sample that
+ * differs from the previous one starts a new generation. If the given
+ * generation is 0, unknown or too old, all ports are reported as changed.
+ */
+int onlp_sfp_presence_changes_get(uint32_t* generation,
+                                  onlp_sfp_bitmap_t* changed,
+                                  onlp_sfp_bitmap_t* current);
+
 /**
  * @brief Read IEEE standard EEPROM data from the given port.
  * @param port The SFP Port
@@ -130,6 +181,71 @@ int onlp_sfp_eeprom_read(int port, uint8_t** rv);
  */
 int onlp_sfp_dom_read(int port, uint8_t** rv);
 
+/**
+ * Compact module inventory record for a single port.
+ */
+typedef struct onlp_sfp_inventory_s {
+    /** The SFP port */
+    int port;
+
+    /** Whether a module is present */
+    int present;
+
+    /** The EEPROM read status. Only valid if present. */
+    int status;
+
+    /** Whether the module EEPROM was identified */
+    int identified;
+
+    /** The following are only valid if identified. */
+    sff_sfp_type_t sfp_type;
+    sff_module_type_t module_type;
+    sff_media_type_t media_type;
+    sff_module_caps_t caps;
+
+    /** Cable length in meters, or -1 */
+    int length;
+
+    char vendor[17];
+    char model[17];
+    char serial[17];
+} onlp_sfp_inventory_t;
+
+/**
+ * @brief Collect the module inventory for all ports.
+ * @param records [out] Receives one record per SFP port, in port order.
+ * @param max The number of entries in records.
+ * @returns The number of records filled in, or an error.
+ * @note No memory is allocated. Presence is collected with a
+ * single bitmap request and each EEPROM is parsed in place.
+ */
+int onlp_sfp_inventory_get(onlp_sfp_inventory_t* records, int max);
+
+/** Page select byte of the paged SFF-8472/SFF-8636/CMIS memory maps */
+#define ONLP_SFP_PAGE_SELECT 127
+
+/** Start of the paged upper half of the memory map */
+#define ONLP_SFP_PAGE_UPPER 128
+
+/** Do not select a page before reading */
+#define ONLP_SFP_PAGE_NONE -1
+
+/**
+ * @brief Read a range of a module's memory map.
+ * @param port The SFP Port
+ * @param devaddr The device address (0x50 or 0x51).
+ * @param page The upper page to select, or ONLP_SFP_PAGE_NONE.
+ * @param offset The starting offset (0-255).
+ * @param len The number of bytes to read. offset + len must not exceed 256.
+ * @param buf Receives the data.
+ * @returns The number of bytes read, or an error.
+ * @note The page is only selected if the range covers the upper half.
+ * Page 0 is selected again afterwards.
+ * @note Platforms without block access are emulated with byte reads.
+ */
+int onlp_sfp_read(int port, uint8_t devaddr, int page, int offset, int len,
+                  uint8_t* buf);
+
 /**
  * @brief Deinitialize the SFP subsystem.
  */
@@ -144,6 +260,14 @@ int onlp_sfp_denit(void);
  */
 int onlp_sfp_rx_los_bitmap_get(onlp_sfp_bitmap_t* dst);
 
+/**
+ * @brief Return the ports whose RX_LOS changed since a generation.
+ * @note See onlp_sfp_presence_changes_get().
+ */
+int onlp_sfp_rx_los_changes_get(uint32_t* generation,
+                                onlp_sfp_bitmap_t* changed,
+                                onlp_sfp_bitmap_t* current);
+
 
 /**
  * @brief Read a byte from an address on the given SFP port's bus.
@@ -0,0 +1,107 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * ONLP API Statistics
+ *
+ * Every locked API entry point records its call count, error
+ * count, API lock wait time and platform call time. The
+ * statistics are kept in shared memory and aggregate all
+ * ONLP processes on the system.
+ *
+ ***********************************************************/
+#ifndef __ONLP_STATS_H__
+#define __ONLP_STATS_H__
+
+#include <onlp/onlp_config.h>
+#include <onlp/onlp.h>
+
+/**
+ * Latency histograms use power-of-two buckets.
+ * Bucket 0 counts durations under 1 usec.
+ * Bucket N counts durations in [2^(N-1), 2^N) usecs.
+ * The last bucket also counts all longer durations.
+ */
+#define ONLP_API_STATS_BUCKETS 26
+
+#define ONLP_API_STATS_NAME_MAX 48
+
+typedef struct onlp_api_timer_stats_s {
+    /** Total time (usecs) */
+    uint64_t total;
+    /** Maximum time (usecs) */
+    uint64_t max;
+    /** Histogram */
+    uint64_t buckets[ONLP_API_STATS_BUCKETS];
+} onlp_api_timer_stats_t;
+
+typedef struct onlp_api_stats_s {
+    /** API name */
+    char name[ONLP_API_STATS_NAME_MAX];
+    /** Number of calls */
+    uint64_t calls;
+    /** Number of calls which returned an error */
+    uint64_t errors;
+    /** Time spent waiting for the API lock */
+    onlp_api_timer_stats_t lock;
+    /** Time spent in the API implementation */
+    onlp_api_timer_stats_t call;
+} onlp_api_stats_t;
+
+/**
+ * @brief Get the statistics in the given table slot.
+ * @param index The slot index (0 to ONLP_CONFIG_API_STATS_MAX-1).
+ * @param stats Receives the statistics.
+ * @returns ONLP_STATUS_E_MISSING if the slot is unused.
+ */
+int onlp_api_stats_get(int index, onlp_api_stats_t* stats);
+
+/**
+ * @brief Clear all API statistics.
+ */
+int onlp_api_stats_clear(void);
+
+/** Include latency histograms in the output. */
+#define ONLP_API_STATS_SHOW_F_HISTOGRAMS 0x1
+
+/**
+ * @brief Show the API statistics.
+ * @param pvs The output pvs.
+ * @param flags ONLP_API_STATS_SHOW_F_*
+ */
+void onlp_api_stats_show(aim_pvs_t* pvs, uint32_t flags);
+
+/**
+ * @brief Get the lower bound (usecs) of the given histogram bucket.
+ */
+uint64_t onlp_api_stats_bucket_floor(int bucket);
+
+/**
+ * @brief Show the API lock owner and contention statistics.
+ * @param pvs The output pvs.
+ */
+void onlp_api_lock_show(aim_pvs_t* pvs);
+
+/**
+ * @brief Clear the API lock contention statistics.
+ */
+int onlp_api_lock_stats_clear(void);
+
+#endif /* __ONLP_STATS_H__ */
@@ -64,9 +64,16 @@ void onlp_sys_info_free(onlp_sys_info_t* info);
 
 /**
  * @brief Get the system header.
+ * @note The header child table is limited to ONLP_OID_TABLE_SIZE entries.
  */
 int onlp_sys_hdr_get(onlp_oid_hdr_t* hdr);
 
+/**
+ * @brief Get the complete list of system child OIDs.
+ * @param list [out] Receives the OIDs. Existing entries are replaced.
+ */
+int onlp_sys_coids_get(onlp_oid_list_t* list);
+
 /**
  * @brief SYS OID debug dump.
  * @param id The SYS OID.
@@ -98,6 +105,48 @@ int onlp_sys_ioctl(int code, ...);
  */
 int onlp_sys_vioctl(int code, va_list vargs);
 
+/**
+ * Platform management I/O domains.
+ *
+ * Each domain has its own worker thread. Tasks in different
+ * domains run concurrently. Tasks in the same domain run
+ * one at a time, in the order their deadlines expired.
+ * The management thread holds the API lock while any task
+ * runs, so tasks never overlap with other API callers.
+ */
+typedef enum onlp_sys_pm_domain_e {
+    ONLP_SYS_PM_DOMAIN_SYSFS,
+    ONLP_SYS_PM_DOMAIN_I2C,
+    ONLP_SYS_PM_DOMAIN_CPLD,
+    ONLP_SYS_PM_DOMAIN_COUNT,
+} onlp_sys_pm_domain_t;
+
+/**
+ * Platform management tasks.
+ */
+typedef enum onlp_sys_pm_task_e {
+    ONLP_SYS_PM_TASK_FANS,
+    ONLP_SYS_PM_TASK_LEDS,
+    ONLP_SYS_PM_TASK_PSU_NOTIFY,
+    ONLP_SYS_PM_TASK_FAN_NOTIFY,
+    ONLP_SYS_PM_TASK_LED_BLINK,
+    ONLP_SYS_PM_TASK_COUNT,
+} onlp_sys_pm_task_t;
+
+/**
+ * Platform management domain statistics.
+ */
+typedef struct onlp_sys_pm_domain_stats_s {
+    /** Tasks currently queued or running */
+    uint32_t depth;
+    /** The largest depth seen */
+    uint32_t depth_max;
+    /** Tasks completed */
+    uint64_t runs;
+    /** Deadlines dropped because the task was still pending */
+    uint64_t skipped;
+} onlp_sys_pm_domain_stats_t;
+
 /**
  * @brief Start the platform management thread.
  */
@@ -122,6 +171,14 @@ int onlp_sys_platform_manage_join(void);
 
 void onlp_sys_platform_manage_now(void);
 
+/**
+ * @brief Get the statistics for a platform management domain.
+ * @param domain The domain.
+ * @param[out] stats Receives the statistics.
+ */
+int onlp_sys_platform_manage_domain_stats_get(onlp_sys_pm_domain_t domain,
+                                              onlp_sys_pm_domain_stats_t* stats);
+
 int onlp_sys_debug(aim_pvs_t* pvs, int argc, char** argv);
 
 #endif /* __ONLP_SYS_H_ */
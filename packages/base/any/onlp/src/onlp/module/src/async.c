@@ -0,0 +1,483 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Asynchronous API executor.
+ *
+ * There is one worker per I/O domain. All queues and the
+ * completion list are protected by a single mutex, which is
+ * never held across a hardware access.
+ *
+ * The workers call the synchronous ONLP APIs, so hardware
+ * accesses are still serialized by the API lock. Submitting
+ * does not wait for it.
+ *
+ ***********************************************************/
+#include <onlp/onlp_config.h>
+
+#if ONLP_CONFIG_INCLUDE_ASYNC == 1
+
+#include <onlp/async.h>
+#include <onlp/sys.h>
+#include <onlp/platformi/sysi.h>
+#include <OS/os_thread.h>
+#include <AIM/aim.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <pthread.h>
+#include "onlp_log.h"
+#include "onlp_int.h"
+
+typedef struct async_queue_s {
+    pthread_t thread;
+    pthread_cond_t cond;
+
+    /** FIFO of submitted requests */
+    onlp_async_req_t* head;
+    onlp_async_req_t* tail;
+} async_queue_t;
+
+typedef struct async_ctrl_s {
+    /** Protects everything below */
+    pthread_mutex_t lock;
+
+    /** Non-zero while the workers should run */
+    int running;
+
+    /** Number of workers started */
+    int workers;
+
+    /** Completion eventfd */
+    int eventfd;
+
+    /** The domain each operation is executed in */
+    onlp_sys_pm_domain_t domains[ONLP_ASYNC_OP_COUNT];
+
+    async_queue_t queues[ONLP_SYS_PM_DOMAIN_COUNT];
+
+    /** Completed requests, in completion order */
+    onlp_async_req_t* done_head;
+    onlp_async_req_t* done_tail;
+} async_ctrl_t;
+
+static async_ctrl_t ctrl__ = { PTHREAD_MUTEX_INITIALIZER, 0, 0, -1 };
+
+static const char* domain_names__[ONLP_SYS_PM_DOMAIN_COUNT] = {
+    "sysfs", "i2c", "cpld",
+};
+
+/*
+ * Fans, PSUs and LEDs are placed in the same domain as
+ * their platform management tasks.
+ */
+static onlp_sys_pm_domain_t
+async_domain__(onlp_sys_pm_task_t task, onlp_sys_pm_domain_t dflt)
+{
+    int domain = onlp_sysi_platform_manage_domain_get(task);
+    return (domain >= 0 && domain < ONLP_SYS_PM_DOMAIN_COUNT) ? domain : dflt;
+}
+
+static void
+async_domains_init__(void)
+{
+    ctrl__.domains[ONLP_ASYNC_OP_THERMAL_INFO_GET] = ONLP_SYS_PM_DOMAIN_SYSFS;
+    ctrl__.domains[ONLP_ASYNC_OP_FAN_INFO_GET] =
+        async_domain__(ONLP_SYS_PM_TASK_FAN_NOTIFY, ONLP_SYS_PM_DOMAIN_CPLD);
+    ctrl__.domains[ONLP_ASYNC_OP_PSU_INFO_GET] =
+        async_domain__(ONLP_SYS_PM_TASK_PSU_NOTIFY, ONLP_SYS_PM_DOMAIN_I2C);
+    ctrl__.domains[ONLP_ASYNC_OP_LED_INFO_GET] =
+        async_domain__(ONLP_SYS_PM_TASK_LEDS, ONLP_SYS_PM_DOMAIN_SYSFS);
+    ctrl__.domains[ONLP_ASYNC_OP_SFP_EEPROM_READ] = ONLP_SYS_PM_DOMAIN_I2C;
+    ctrl__.domains[ONLP_ASYNC_OP_SFP_DOM_READ] = ONLP_SYS_PM_DOMAIN_I2C;
+    ctrl__.domains[ONLP_ASYNC_OP_SFP_READ] = ONLP_SYS_PM_DOMAIN_I2C;
+}
+
+#define ASYNC_CMP(_a, _b)                       \
+    do {                                        \
+        if((_a) != (_b)) {                      \
+            return ((_a) < (_b)) ? -1 : 1;      \
+        }                                       \
+    } while(0)
+
+/*
+ * Requests which compare equal are satisfied by a single access.
+ * Only the fields used by the operation are compared.
+ */
+static int
+async_compare__(const onlp_async_req_t* a, const onlp_async_req_t* b)
+{
+    ASYNC_CMP(a->op, b->op);
+    switch(a->op)
+        {
+        case ONLP_ASYNC_OP_SFP_READ:
+            ASYNC_CMP(a->port, b->port);
+            ASYNC_CMP(a->devaddr, b->devaddr);
+            ASYNC_CMP(a->page, b->page);
+            ASYNC_CMP(a->offset, b->offset);
+            ASYNC_CMP(a->len, b->len);
+            return 0;
+        case ONLP_ASYNC_OP_SFP_EEPROM_READ:
+        case ONLP_ASYNC_OP_SFP_DOM_READ:
+            ASYNC_CMP(a->port, b->port);
+            return 0;
+        default:
+            ASYNC_CMP(a->oid, b->oid);
+            return 0;
+        }
+}
+
+/*
+ * Stable insertion sort. Batches are the size of a queue
+ * drained in one go, so this is cheap in practice.
+ */
+static onlp_async_req_t*
+async_sort__(onlp_async_req_t* list)
+{
+    onlp_async_req_t* sorted = NULL;
+
+    while(list) {
+        onlp_async_req_t* r = list;
+        onlp_async_req_t** p = &sorted;
+        list = list->next;
+        while(*p && async_compare__(*p, r) <= 0) {
+            p = &(*p)->next;
+        }
+        r->next = *p;
+        *p = r;
+    }
+    return sorted;
+}
+
+static int
+async_sfp_read__(int (*readf)(int, uint8_t**), onlp_async_req_t* r)
+{
+    uint8_t* data = NULL;
+    int rv = readf(r->port, &data);
+    if(rv >= 0) {
+        memcpy(r->data, data, ONLP_ASYNC_SFP_DATA_SIZE);
+    }
+    aim_free(data);
+    return rv;
+}
+
+static void
+async_execute__(onlp_async_req_t* r)
+{
+    switch(r->op)
+        {
+        case ONLP_ASYNC_OP_THERMAL_INFO_GET:
+            r->rv = onlp_thermal_info_get(r->oid, &r->info.thermal);
+            break;
+        case ONLP_ASYNC_OP_FAN_INFO_GET:
+            r->rv = onlp_fan_info_get(r->oid, &r->info.fan);
+            break;
+        case ONLP_ASYNC_OP_PSU_INFO_GET:
+            r->rv = onlp_psu_info_get(r->oid, &r->info.psu);
+            break;
+        case ONLP_ASYNC_OP_LED_INFO_GET:
+            r->rv = onlp_led_info_get(r->oid, &r->info.led);
+            break;
+        case ONLP_ASYNC_OP_SFP_EEPROM_READ:
+            r->rv = async_sfp_read__(onlp_sfp_eeprom_read, r);
+            break;
+        case ONLP_ASYNC_OP_SFP_DOM_READ:
+            r->rv = async_sfp_read__(onlp_sfp_dom_read, r);
+            break;
+        case ONLP_ASYNC_OP_SFP_READ:
+            r->rv = onlp_sfp_read(r->port, r->devaddr, r->page,
+                                  r->offset, r->len, r->data);
+            break;
+        default:
+            r->rv = ONLP_STATUS_E_PARAM;
+            break;
+        }
+}
+
+/* Copy the result of a coalesced request. */
+static void
+async_copy__(onlp_async_req_t* dst, const onlp_async_req_t* src)
+{
+    dst->rv = src->rv;
+    switch(src->op)
+        {
+        case ONLP_ASYNC_OP_SFP_READ:
+            if(src->rv > 0) {
+                memcpy(dst->data, src->data, src->rv);
+            }
+            break;
+        case ONLP_ASYNC_OP_SFP_EEPROM_READ:
+        case ONLP_ASYNC_OP_SFP_DOM_READ:
+            if(src->rv >= 0) {
+                memcpy(dst->data, src->data, ONLP_ASYNC_SFP_DATA_SIZE);
+            }
+            break;
+        default:
+            dst->info = src->info;
+            break;
+        }
+}
+
+/* Move [first, last] to the completion list. Called with the lock held. */
+static void
+async_complete_locked__(onlp_async_req_t* first, onlp_async_req_t* last)
+{
+    uint64_t one = 1;
+
+    last->next = NULL;
+    if(ctrl__.done_tail) {
+        ctrl__.done_tail->next = first;
+    }
+    else {
+        ctrl__.done_head = first;
+    }
+    ctrl__.done_tail = last;
+
+    if(write(ctrl__.eventfd, &one, sizeof(one)) < 0) {
+        /* The counter cannot overflow in practice. */
+    }
+}
+
+static void*
+async_worker__(void* vqueue)
+{
+    async_queue_t* q = (async_queue_t*)vqueue;
+    char name[16];
+
+    snprintf(name, sizeof(name), "onlp.async.%s",
+             domain_names__[q - ctrl__.queues]);
+    os_thread_name_set(name);
+
+    pthread_mutex_lock(&ctrl__.lock);
+    for(;;) {
+        onlp_async_req_t* batch;
+
+        while(ctrl__.running && q->head == NULL) {
+            pthread_cond_wait(&q->cond, &ctrl__.lock);
+        }
+        if(!ctrl__.running) {
+            break;
+        }
+
+        batch = q->head;
+        q->head = q->tail = NULL;
+        pthread_mutex_unlock(&ctrl__.lock);
+
+        batch = async_sort__(batch);
+        while(batch) {
+            onlp_async_req_t* first = batch;
+            onlp_async_req_t* last = batch;
+
+            async_execute__(first);
+            while(last->next && async_compare__(first, last->next) == 0) {
+                last = last->next;
+                async_copy__(last, first);
+            }
+            batch = last->next;
+
+            pthread_mutex_lock(&ctrl__.lock);
+            async_complete_locked__(first, last);
+            pthread_mutex_unlock(&ctrl__.lock);
+        }
+
+        pthread_mutex_lock(&ctrl__.lock);
+    }
+    pthread_mutex_unlock(&ctrl__.lock);
+    return NULL;
+}
+
+/* Stop and join the workers. Called without the lock held. */
+static void
+async_workers_stop__(void)
+{
+    int i, workers;
+
+    pthread_mutex_lock(&ctrl__.lock);
+    ctrl__.running = 0;
+    for(i = 0; i < AIM_ARRAYSIZE(ctrl__.queues); i++) {
+        pthread_cond_signal(&ctrl__.queues[i].cond);
+    }
+    workers = ctrl__.workers;
+    ctrl__.workers = 0;
+    pthread_mutex_unlock(&ctrl__.lock);
+
+    for(i = 0; i < workers; i++) {
+        pthread_join(ctrl__.queues[i].thread, NULL);
+    }
+}
+
+/* Start the executor. Called without the lock held. */
+static int
+async_start__(void)
+{
+    int i;
+
+    pthread_mutex_lock(&ctrl__.lock);
+    if(ctrl__.running) {
+        pthread_mutex_unlock(&ctrl__.lock);
+        return 0;
+    }
+
+    if( (ctrl__.eventfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0) {
+        AIM_LOG_ERROR("eventfd: %{errno}", errno);
+        pthread_mutex_unlock(&ctrl__.lock);
+        return ONLP_STATUS_E_INTERNAL;
+    }
+
+    async_domains_init__();
+    ctrl__.running = 1;
+    for(i = 0; i < AIM_ARRAYSIZE(ctrl__.queues); i++) {
+        async_queue_t* q = ctrl__.queues + i;
+        pthread_cond_init(&q->cond, NULL);
+        if(pthread_create(&q->thread, NULL, async_worker__, q) != 0) {
+            AIM_LOG_ERROR("pthread create failed for domain %s.",
+                          domain_names__[i]);
+            pthread_mutex_unlock(&ctrl__.lock);
+            async_workers_stop__();
+            close(ctrl__.eventfd);
+            ctrl__.eventfd = -1;
+            return ONLP_STATUS_E_INTERNAL;
+        }
+        ctrl__.workers++;
+    }
+    pthread_mutex_unlock(&ctrl__.lock);
+    return 0;
+}
+
+int
+onlp_async_submit(onlp_async_req_t* req, onlp_async_cb_f cb, void* cookie)
+{
+    async_queue_t* q;
+    int rv;
+
+    if(req == NULL || req->op < 0 || req->op >= ONLP_ASYNC_OP_COUNT) {
+        return ONLP_STATUS_E_PARAM;
+    }
+    if(req->op >= ONLP_ASYNC_OP_SFP_EEPROM_READ && req->data == NULL) {
+        return ONLP_STATUS_E_PARAM;
+    }
+
+    if( (rv = async_start__()) < 0) {
+        return rv;
+    }
+
+    req->cb = cb;
+    req->cookie = cookie;
+    req->rv = ONLP_STATUS_E_BUSY;
+    req->next = NULL;
+
+    pthread_mutex_lock(&ctrl__.lock);
+    q = ctrl__.queues + ctrl__.domains[req->op];
+    if(q->tail) {
+        q->tail->next = req;
+    }
+    else {
+        q->head = req;
+    }
+    q->tail = req;
+    pthread_cond_signal(&q->cond);
+    pthread_mutex_unlock(&ctrl__.lock);
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_async_fd(void)
+{
+    int rv = async_start__();
+    return (rv < 0) ? rv : ctrl__.eventfd;
+}
+
+int
+onlp_async_poll(int max)
+{
+    onlp_async_req_t* list;
+    onlp_async_req_t* r;
+    uint64_t count;
+    int n = 0;
+
+    pthread_mutex_lock(&ctrl__.lock);
+    if(ctrl__.eventfd < 0) {
+        pthread_mutex_unlock(&ctrl__.lock);
+        return 0;
+    }
+
+    /* Reset the eventfd. It is set again below if anything is left. */
+    if(read(ctrl__.eventfd, &count, sizeof(count)) < 0) {
+        /* EAGAIN: nothing has completed since the last read. */
+    }
+
+    list = ctrl__.done_head;
+    for(r = list; r && (max <= 0 || n < max); r = r->next) {
+        n++;
+    }
+    if(r) {
+        uint64_t one = 1;
+        ctrl__.done_head = r;
+        if(write(ctrl__.eventfd, &one, sizeof(one)) < 0) {
+            /* Cannot overflow. */
+        }
+    }
+    else {
+        ctrl__.done_head = ctrl__.done_tail = NULL;
+    }
+    pthread_mutex_unlock(&ctrl__.lock);
+
+    /* Callbacks run without the lock so they may submit again. */
+    while(list != r) {
+        onlp_async_req_t* next = list->next;
+        if(list->cb) {
+            list->cb(list, list->cookie);
+        }
+        list = next;
+    }
+    return n;
+}
+
+void
+onlp_async_denit(void)
+{
+    int i;
+
+    if(ctrl__.eventfd < 0) {
+        return;
+    }
+
+    async_workers_stop__();
+
+    /* Anything not yet started is cancelled. */
+    pthread_mutex_lock(&ctrl__.lock);
+    for(i = 0; i < AIM_ARRAYSIZE(ctrl__.queues); i++) {
+        async_queue_t* q = ctrl__.queues + i;
+        if(q->head) {
+            async_complete_locked__(q->head, q->tail);
+            q->head = q->tail = NULL;
+        }
+        pthread_cond_destroy(&q->cond);
+    }
+    pthread_mutex_unlock(&ctrl__.lock);
+
+    onlp_async_poll(0);
+
+    close(ctrl__.eventfd);
+    ctrl__.eventfd = -1;
+}
+
+#endif /* ONLP_CONFIG_INCLUDE_ASYNC */
@@ -0,0 +1,897 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Structured (JSON Lines/CBOR) Platform Export.
+ *
+ * Values are encoded directly into a fixed output buffer
+ * which is written to the descriptor whenever it fills.
+ * No intermediate strings or documents are built.
+ *
+ ***********************************************************/
+#include <onlp/export.h>
+#include <onlp/sys.h>
+#include <onlp/thermal.h>
+#include <onlp/fan.h>
+#include <onlp/psu.h>
+#include <onlp/led.h>
+#include <onlp/sfp.h>
+#include <sff/sff.h>
+#include "onlp_int.h"
+#include "onlp_log.h"
+#include <unistd.h>
+#include <errno.h>
+
+#define EXPORT_BUFFER_SIZE 4096
+#define EXPORT_DEPTH_MAX   16
+
+struct onlp_export_s {
+    /** Output descriptor. Negative for memory streams. */
+    int fd;
+    /** Memory stream output */
+    uint8_t* mem;
+    int mem_len;
+    int mem_size;
+    /** All encoder calls are mirrored to this stream */
+    onlp_export_t* tee;
+    /** Export flags */
+    uint32_t flags;
+    /** Set on the first failed write. All further output is dropped. */
+    int error;
+
+    /** Current nesting depth */
+    int depth;
+    /** Whether the container at each depth already has an element (JSON) */
+    uint8_t more[EXPORT_DEPTH_MAX];
+    /** A key has been written and its value is pending (JSON) */
+    int after_key;
+
+    int len;
+    uint8_t buffer[EXPORT_BUFFER_SIZE];
+};
+
+#define CBOR(_e) ((_e)->flags & ONLP_EXPORT_F_CBOR)
+
+onlp_export_t*
+onlp_export_create(int fd, uint32_t flags)
+{
+    onlp_export_t* e = aim_zmalloc(sizeof(*e));
+    e->fd = fd;
+    e->flags = flags;
+    return e;
+}
+
+onlp_export_t*
+onlp_export_create_buffer(uint32_t flags)
+{
+    return onlp_export_create(-1, flags);
+}
+
+void
+onlp_export_tee(onlp_export_t* e, onlp_export_t* tee)
+{
+    e->tee = tee;
+}
+
+static void
+export_mem_flush__(onlp_export_t* e)
+{
+    if(e->mem_len + e->len > e->mem_size) {
+        e->mem_size = (e->mem_size) ? e->mem_size * 2 : sizeof(e->buffer);
+        while(e->mem_size < e->mem_len + e->len) {
+            e->mem_size *= 2;
+        }
+        e->mem = aim_realloc(e->mem, e->mem_size);
+    }
+    memcpy(e->mem + e->mem_len, e->buffer, e->len);
+    e->mem_len += e->len;
+    e->len = 0;
+}
+
+int
+onlp_export_buffer_take(onlp_export_t* e, uint8_t** data, int* size)
+{
+    if(e->fd >= 0) {
+        return ONLP_STATUS_E_PARAM;
+    }
+    export_mem_flush__(e);
+    *data = e->mem;
+    *size = e->mem_len;
+    e->mem = NULL;
+    e->mem_len = e->mem_size = 0;
+    return 0;
+}
+
+int
+onlp_export_flush(onlp_export_t* e)
+{
+    int offset = 0;
+
+    if(e->fd < 0) {
+        export_mem_flush__(e);
+        return 0;
+    }
+
+    while(e->error == 0 && offset < e->len) {
+        ssize_t rv = write(e->fd, e->buffer + offset, e->len - offset);
+        if(rv < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            if(errno == EPIPE) {
+                AIM_LOG_VERBOSE("export stream closed by peer.");
+            }
+            else {
+                AIM_LOG_ERROR("export write failed: %{errno}", errno);
+            }
+            e->error = ONLP_STATUS_E_INTERNAL;
+            break;
+        }
+        offset += rv;
+    }
+    e->len = 0;
+    return e->error;
+}
+
+int
+onlp_export_destroy(onlp_export_t* e)
+{
+    int rv = 0;
+    if(e) {
+        rv = onlp_export_flush(e);
+        aim_free(e->mem);
+        aim_free(e);
+    }
+    return rv;
+}
+
+static void
+export_write__(onlp_export_t* e, const void* data, int size)
+{
+    const uint8_t* p = data;
+    while(size > 0) {
+        int n;
+        if(e->len == sizeof(e->buffer)) {
+            onlp_export_flush(e);
+        }
+        n = sizeof(e->buffer) - e->len;
+        if(n > size) {
+            n = size;
+        }
+        memcpy(e->buffer + e->len, p, n);
+        e->len += n;
+        p += n;
+        size -= n;
+    }
+}
+
+static inline void
+export_byte__(onlp_export_t* e, uint8_t b)
+{
+    if(e->len == sizeof(e->buffer)) {
+        onlp_export_flush(e);
+    }
+    e->buffer[e->len++] = b;
+}
+
+/**
+ * CBOR initial byte and argument (RFC 7049, section 2.1)
+ */
+static void
+cbor_head__(onlp_export_t* e, int major, uint64_t v)
+{
+    uint8_t mt = major << 5;
+    int i, n;
+
+    if(v < 24) {
+        export_byte__(e, mt | v);
+        return;
+    }
+    else if(v <= 0xFF) {
+        export_byte__(e, mt | 24);
+        n = 1;
+    }
+    else if(v <= 0xFFFF) {
+        export_byte__(e, mt | 25);
+        n = 2;
+    }
+    else if(v <= 0xFFFFFFFF) {
+        export_byte__(e, mt | 26);
+        n = 4;
+    }
+    else {
+        export_byte__(e, mt | 27);
+        n = 8;
+    }
+    for(i = n - 1; i >= 0; i--) {
+        export_byte__(e, (v >> (i*8)) & 0xFF);
+    }
+}
+
+#define CBOR_MAJOR_UINT    0
+#define CBOR_MAJOR_NINT    1
+#define CBOR_MAJOR_BYTES   2
+#define CBOR_MAJOR_TEXT    3
+#define CBOR_INDEF_ARRAY   0x9F
+#define CBOR_INDEF_MAP     0xBF
+#define CBOR_FALSE         0xF4
+#define CBOR_TRUE          0xF5
+#define CBOR_NULL          0xF6
+#define CBOR_BREAK         0xFF
+
+/*
+ * JSON element separator handling.
+ */
+static void
+json_sep__(onlp_export_t* e)
+{
+    if(e->after_key) {
+        e->after_key = 0;
+        return;
+    }
+    if(e->more[e->depth]) {
+        export_byte__(e, ',');
+    }
+    e->more[e->depth] = 1;
+}
+
+static void
+json_string__(onlp_export_t* e, const char* s)
+{
+    static const char hex[] = "0123456789abcdef";
+    const char* run = s;
+
+    export_byte__(e, '"');
+    for(; *s; s++) {
+        uint8_t c = *s;
+        if(c >= 0x20 && c < 0x7F && c != '"' && c != '\\') {
+            continue;
+        }
+        export_write__(e, run, s - run);
+        run = s + 1;
+        export_byte__(e, '\\');
+        switch(c)
+            {
+            case '"': export_byte__(e, '"'); break;
+            case '\\': export_byte__(e, '\\'); break;
+            case '\n': export_byte__(e, 'n'); break;
+            case '\r': export_byte__(e, 'r'); break;
+            case '\t': export_byte__(e, 't'); break;
+            default:
+                /* Control characters and non-ASCII EEPROM garbage. */
+                export_write__(e, "u00", 3);
+                export_byte__(e, hex[c >> 4]);
+                export_byte__(e, hex[c & 0xF]);
+                break;
+            }
+    }
+    export_write__(e, run, s - run);
+    export_byte__(e, '"');
+}
+
+static void
+export_container_begin__(onlp_export_t* e, uint8_t cbor, char json)
+{
+    if(CBOR(e)) {
+        export_byte__(e, cbor);
+    }
+    else {
+        json_sep__(e);
+        export_byte__(e, json);
+    }
+    if(e->depth < EXPORT_DEPTH_MAX - 1) {
+        e->depth++;
+    }
+    e->more[e->depth] = 0;
+}
+
+static void
+export_container_end__(onlp_export_t* e, char json)
+{
+    export_byte__(e, CBOR(e) ? CBOR_BREAK : json);
+    if(e->depth > 0) {
+        e->depth--;
+    }
+    if(e->depth == 0) {
+        /* End of record */
+        e->more[0] = 0;
+        if(!CBOR(e)) {
+            export_byte__(e, '\n');
+        }
+    }
+}
+
+void
+onlp_export_map_begin(onlp_export_t* e)
+{
+    if(e->tee) {
+        onlp_export_map_begin(e->tee);
+    }
+    export_container_begin__(e, CBOR_INDEF_MAP, '{');
+}
+
+void
+onlp_export_map_end(onlp_export_t* e)
+{
+    if(e->tee) {
+        onlp_export_map_end(e->tee);
+    }
+    export_container_end__(e, '}');
+}
+
+void
+onlp_export_array_begin(onlp_export_t* e)
+{
+    if(e->tee) {
+        onlp_export_array_begin(e->tee);
+    }
+    export_container_begin__(e, CBOR_INDEF_ARRAY, '[');
+}
+
+void
+onlp_export_array_end(onlp_export_t* e)
+{
+    if(e->tee) {
+        onlp_export_array_end(e->tee);
+    }
+    export_container_end__(e, ']');
+}
+
+static void
+export_str__(onlp_export_t* e, const char* s)
+{
+    if(CBOR(e)) {
+        if(s == NULL) {
+            export_byte__(e, CBOR_NULL);
+        }
+        else {
+            int len = strlen(s);
+            cbor_head__(e, CBOR_MAJOR_TEXT, len);
+            export_write__(e, s, len);
+        }
+    }
+    else {
+        json_sep__(e);
+        if(s == NULL) {
+            export_write__(e, "null", 4);
+        }
+        else {
+            json_string__(e, s);
+        }
+    }
+}
+
+void
+onlp_export_str(onlp_export_t* e, const char* s)
+{
+    if(e->tee) {
+        onlp_export_str(e->tee, s);
+    }
+    export_str__(e, s);
+}
+
+void
+onlp_export_key(onlp_export_t* e, const char* key)
+{
+    if(e->tee) {
+        onlp_export_key(e->tee, key);
+    }
+    export_str__(e, key);
+    if(!CBOR(e)) {
+        export_byte__(e, ':');
+        e->after_key = 1;
+    }
+}
+
+void
+onlp_export_int(onlp_export_t* e, int64_t v)
+{
+    if(e->tee) {
+        onlp_export_int(e->tee, v);
+    }
+    if(CBOR(e)) {
+        if(v < 0) {
+            cbor_head__(e, CBOR_MAJOR_NINT, (uint64_t)(-1 - v));
+        }
+        else {
+            cbor_head__(e, CBOR_MAJOR_UINT, v);
+        }
+    }
+    else {
+        char s[24];
+        json_sep__(e);
+        export_write__(e, s, snprintf(s, sizeof(s), "%lld", (long long)v));
+    }
+}
+
+void
+onlp_export_uint(onlp_export_t* e, uint64_t v)
+{
+    if(e->tee) {
+        onlp_export_uint(e->tee, v);
+    }
+    if(CBOR(e)) {
+        cbor_head__(e, CBOR_MAJOR_UINT, v);
+    }
+    else {
+        char s[24];
+        json_sep__(e);
+        export_write__(e, s, snprintf(s, sizeof(s), "%llu", (unsigned long long)v));
+    }
+}
+
+void
+onlp_export_bool(onlp_export_t* e, int v)
+{
+    if(e->tee) {
+        onlp_export_bool(e->tee, v);
+    }
+    if(CBOR(e)) {
+        export_byte__(e, v ? CBOR_TRUE : CBOR_FALSE);
+    }
+    else {
+        json_sep__(e);
+        if(v) {
+            export_write__(e, "true", 4);
+        }
+        else {
+            export_write__(e, "false", 5);
+        }
+    }
+}
+
+void
+onlp_export_bytes(onlp_export_t* e, const uint8_t* data, int size)
+{
+    if(e->tee) {
+        onlp_export_bytes(e->tee, data, size);
+    }
+    if(CBOR(e)) {
+        cbor_head__(e, CBOR_MAJOR_BYTES, size);
+        export_write__(e, data, size);
+    }
+    else {
+        /* Hex string */
+        static const char hex[] = "0123456789abcdef";
+        int i;
+        json_sep__(e);
+        export_byte__(e, '"');
+        for(i = 0; i < size; i++) {
+            export_byte__(e, hex[data[i] >> 4]);
+            export_byte__(e, hex[data[i] & 0xF]);
+        }
+        export_byte__(e, '"');
+    }
+}
+
+void
+onlp_export_raw(onlp_export_t* e, const uint8_t* data, int size)
+{
+    if(e->tee) {
+        onlp_export_raw(e->tee, data, size);
+    }
+    export_write__(e, data, size);
+}
+
+#define KV(_type, _e, _k, _v)                   \
+    do {                                        \
+        onlp_export_key(_e, _k);                \
+        onlp_export_##_type(_e, _v);            \
+    } while(0)
+
+
+/************************************************************
+ *
+ * OID Records
+ *
+ ***********************************************************/
+
+static void
+export_hdr__(onlp_export_t* e, onlp_oid_t oid, onlp_oid_hdr_t* hdr)
+{
+    KV(uint, e, "oid", oid);
+    KV(str, e, "type", onlp_oid_type_name(ONLP_OID_TYPE_GET(oid)));
+    KV(uint, e, "id", ONLP_OID_ID_GET(oid));
+    if(hdr) {
+        KV(str, e, "description", hdr->description);
+        if(hdr->poid) {
+            KV(uint, e, "parent", hdr->poid);
+        }
+    }
+}
+
+static void
+export_status__(onlp_export_t* e, uint32_t status, uint32_t caps,
+                uint32_t failed)
+{
+    KV(bool, e, "present", status & 0x1);
+    KV(bool, e, "failed", status & failed);
+    KV(uint, e, "status", status);
+    KV(uint, e, "caps", caps);
+}
+
+static void
+export_error__(onlp_export_t* e, int rv)
+{
+    KV(str, e, "error", onlp_status_name(rv));
+}
+
+static void
+export_thermal__(onlp_export_t* e, onlp_oid_t oid)
+{
+    onlp_thermal_info_t ti;
+    int rv = onlp_thermal_info_get(oid, &ti);
+
+    export_hdr__(e, oid, (rv < 0) ? NULL : &ti.hdr);
+    if(rv < 0) {
+        export_error__(e, rv);
+        return;
+    }
+    export_status__(e, ti.status, ti.caps, ONLP_THERMAL_STATUS_FAILED);
+    if(ti.caps & ONLP_THERMAL_CAPS_GET_TEMPERATURE) {
+        KV(int, e, "mcelsius", ti.mcelsius);
+    }
+    if(ti.caps & ONLP_THERMAL_CAPS_GET_ANY_THRESHOLD) {
+        onlp_export_key(e, "thresholds");
+        onlp_export_map_begin(e);
+        if(ti.caps & ONLP_THERMAL_CAPS_GET_WARNING_THRESHOLD) {
+            KV(int, e, "warning", ti.thresholds.warning);
+        }
+        if(ti.caps & ONLP_THERMAL_CAPS_GET_ERROR_THRESHOLD) {
+            KV(int, e, "error", ti.thresholds.error);
+        }
+        if(ti.caps & ONLP_THERMAL_CAPS_GET_SHUTDOWN_THRESHOLD) {
+            KV(int, e, "shutdown", ti.thresholds.shutdown);
+        }
+        onlp_export_map_end(e);
+    }
+}
+
+static void
+export_fan__(onlp_export_t* e, onlp_oid_t oid)
+{
+    onlp_fan_info_t fi;
+    int rv = onlp_fan_info_get(oid, &fi);
+
+    export_hdr__(e, oid, (rv < 0) ? NULL : &fi.hdr);
+    if(rv < 0) {
+        export_error__(e, rv);
+        return;
+    }
+    export_status__(e, fi.status, fi.caps, ONLP_FAN_STATUS_FAILED);
+    if(fi.caps & ONLP_FAN_CAPS_GET_RPM) {
+        KV(int, e, "rpm", fi.rpm);
+    }
+    if(fi.caps & ONLP_FAN_CAPS_GET_PERCENTAGE) {
+        KV(int, e, "percentage", fi.percentage);
+    }
+    KV(str, e, "mode", onlp_fan_mode_name(fi.mode));
+    if(fi.status & ONLP_FAN_STATUS_B2F) {
+        KV(str, e, "airflow", "B2F");
+    }
+    else if(fi.status & ONLP_FAN_STATUS_F2B) {
+        KV(str, e, "airflow", "F2B");
+    }
+    if(fi.model[0]) {
+        KV(str, e, "model", fi.model);
+    }
+    if(fi.serial[0]) {
+        KV(str, e, "serial", fi.serial);
+    }
+}
+
+static void
+export_psu__(onlp_export_t* e, onlp_oid_t oid)
+{
+    onlp_psu_info_t pi;
+    onlp_psu_power_stats_t ps;
+    int rv = onlp_psu_info_get(oid, &pi);
+
+    export_hdr__(e, oid, (rv < 0) ? NULL : &pi.hdr);
+    if(rv < 0) {
+        export_error__(e, rv);
+        return;
+    }
+    export_status__(e, pi.status, pi.caps, ONLP_PSU_STATUS_FAILED);
+    KV(bool, e, "unplugged", pi.status & ONLP_PSU_STATUS_UNPLUGGED);
+    if(pi.model[0]) {
+        KV(str, e, "model", pi.model);
+    }
+    if(pi.serial[0]) {
+        KV(str, e, "serial", pi.serial);
+    }
+    if(pi.caps & ONLP_PSU_CAPS_VIN) {
+        KV(int, e, "mvin", pi.mvin);
+    }
+    if(pi.caps & ONLP_PSU_CAPS_VOUT) {
+        KV(int, e, "mvout", pi.mvout);
+    }
+    if(pi.caps & ONLP_PSU_CAPS_IIN) {
+        KV(int, e, "miin", pi.miin);
+    }
+    if(pi.caps & ONLP_PSU_CAPS_IOUT) {
+        KV(int, e, "miout", pi.miout);
+    }
+    if(pi.caps & ONLP_PSU_CAPS_PIN) {
+        KV(int, e, "mpin", pi.mpin);
+    }
+    if(pi.caps & ONLP_PSU_CAPS_POUT) {
+        KV(int, e, "mpout", pi.mpout);
+    }
+    if(onlp_psu_power_stats_get(oid, &ps) >= 0 && ps.samples) {
+        onlp_export_key(e, "power");
+        onlp_export_map_begin(e);
+        KV(uint, e, "samples", ps.samples);
+        KV(int, e, "mpin_min", ps.mpin_min);
+        KV(int, e, "mpin_avg", ps.mpin_avg);
+        KV(int, e, "mpin_max", ps.mpin_max);
+        KV(int, e, "mpout_min", ps.mpout_min);
+        KV(int, e, "mpout_avg", ps.mpout_avg);
+        KV(int, e, "mpout_max", ps.mpout_max);
+        KV(uint, e, "mjin", ps.mjin);
+        KV(uint, e, "mjout", ps.mjout);
+        onlp_export_map_end(e);
+    }
+}
+
+static void
+export_led__(onlp_export_t* e, onlp_oid_t oid)
+{
+    onlp_led_info_t li;
+    int rv = onlp_led_info_get(oid, &li);
+
+    export_hdr__(e, oid, (rv < 0) ? NULL : &li.hdr);
+    if(rv < 0) {
+        export_error__(e, rv);
+        return;
+    }
+    export_status__(e, li.status, li.caps, ONLP_LED_STATUS_FAILED);
+    KV(str, e, "mode", onlp_led_mode_name(li.mode));
+    if(li.caps & ONLP_LED_CAPS_CHAR) {
+        char c[2] = { li.character, 0 };
+        KV(str, e, "character", c);
+    }
+}
+
+static void
+export_sys__(onlp_export_t* e, onlp_oid_t oid)
+{
+    char mac[18];
+    onlp_sys_info_t si;
+    onlp_onie_info_t* onie = &si.onie_info;
+    int rv = onlp_sys_info_get(&si);
+
+    export_hdr__(e, oid, NULL);
+    if(rv < 0) {
+        export_error__(e, rv);
+        return;
+    }
+
+    onlp_export_key(e, "onie");
+    onlp_export_map_begin(e);
+    KV(str, e, "product_name", onie->product_name);
+    KV(str, e, "part_number", onie->part_number);
+    KV(str, e, "serial_number", onie->serial_number);
+    snprintf(mac, sizeof(mac), "%.2x:%.2x:%.2x:%.2x:%.2x:%.2x",
+                  onie->mac[0], onie->mac[1], onie->mac[2],
+                  onie->mac[3], onie->mac[4], onie->mac[5]);
+    KV(str, e, "mac", mac);
+    KV(uint, e, "mac_range", onie->mac_range);
+    KV(str, e, "manufacture_date", onie->manufacture_date);
+    KV(uint, e, "device_version", onie->device_version);
+    KV(str, e, "label_revision", onie->label_revision);
+    KV(str, e, "platform_name", onie->platform_name);
+    KV(str, e, "onie_version", onie->onie_version);
+    KV(str, e, "manufacturer", onie->manufacturer);
+    KV(str, e, "country_code", onie->country_code);
+    KV(str, e, "vendor", onie->vendor);
+    KV(str, e, "diag_version", onie->diag_version);
+    KV(str, e, "service_tag", onie->service_tag);
+    onlp_export_map_end(e);
+
+    onlp_export_key(e, "platform");
+    onlp_export_map_begin(e);
+    KV(str, e, "cpld_versions", si.platform_info.cpld_versions);
+    KV(str, e, "other_versions", si.platform_info.other_versions);
+    onlp_export_map_end(e);
+
+    onlp_sys_info_free(&si);
+}
+
+int
+onlp_export_oid(onlp_export_t* e, onlp_oid_t oid)
+{
+    if(oid == 0) {
+        oid = ONLP_OID_SYS;
+    }
+
+    onlp_export_map_begin(e);
+    switch(ONLP_OID_TYPE_GET(oid))
+        {
+        case ONLP_OID_TYPE_SYS: export_sys__(e, oid); break;
+        case ONLP_OID_TYPE_THERMAL: export_thermal__(e, oid); break;
+        case ONLP_OID_TYPE_FAN: export_fan__(e, oid); break;
+        case ONLP_OID_TYPE_PSU: export_psu__(e, oid); break;
+        case ONLP_OID_TYPE_LED: export_led__(e, oid); break;
+        default:
+            export_hdr__(e, oid, NULL);
+            export_error__(e, ONLP_STATUS_E_UNSUPPORTED);
+            break;
+        }
+    onlp_export_map_end(e);
+
+    if(e->flags & ONLP_EXPORT_F_RECURSE) {
+        onlp_oid_t* oidp;
+        onlp_oid_list_t coids = ONLP_OID_LIST_INIT;
+
+        if(onlp_oid_coids_get(oid, &coids) >= 0) {
+            ONLP_OID_LIST_ITER(&coids, oidp) {
+                onlp_export_oid(e, *oidp);
+            }
+        }
+        onlp_oid_list_free(&coids);
+    }
+    return e->error;
+}
+
+
+/************************************************************
+ *
+ * SFP Records
+ *
+ ***********************************************************/
+
+static int
+export_sfp_page_read__(void* cookie, int page, int offset, int len,
+                       uint8_t* dst)
+{
+    return onlp_sfp_read(*(int*)cookie, 0x50, page, offset, len, dst);
+}
+
+static void
+export_sfp_dom__(onlp_export_t* e, int port, sff_eeprom_t* se)
+{
+    int i;
+    int rv;
+    uint8_t* a2 = NULL;
+    sff_dom_info_t dom;
+
+    if(se->info.sfp_type == SFF_SFP_TYPE_SFP) {
+        /* The SFF-8472 monitors live in a separate A2 page. */
+        if(onlp_sfp_dom_read(port, &a2) < 0) {
+            a2 = NULL;
+        }
+    }
+
+    if(SFF_SFP_TYPE_IS_CMIS(se->info.sfp_type)) {
+        /* CMIS lane monitors are read from banked pages on demand. */
+        rv = sff_cmis_dom_info_get(&dom, se, export_sfp_page_read__, &port);
+    }
+    else {
+        rv = sff_dom_info_get(&dom, se, a2);
+    }
+    aim_free(a2);
+
+    if(rv < 0 || !dom.supported) {
+        return;
+    }
+
+    onlp_export_key(e, "dom");
+    onlp_export_map_begin(e);
+    KV(int, e, "temp", dom.temp);
+    KV(uint, e, "voltage", dom.voltage);
+    onlp_export_key(e, "channels");
+    onlp_export_array_begin(e);
+    for(i = 0; i < dom.nchannels; i++) {
+        onlp_export_map_begin(e);
+        KV(uint, e, "bias_cur", dom.bias_cur[i]);
+        KV(uint, e, "tx_power", dom.tx_power[i]);
+        KV(uint, e, "rx_power", dom.rx_power[i]);
+        onlp_export_map_end(e);
+    }
+    onlp_export_array_end(e);
+    onlp_export_map_end(e);
+}
+
+int
+onlp_export_sfp(onlp_export_t* e, int port)
+{
+    int rv;
+    uint32_t flags;
+    uint8_t* data = NULL;
+    sff_eeprom_t se;
+
+    onlp_export_map_begin(e);
+    KV(str, e, "type", "SFP");
+    KV(int, e, "port", port);
+
+    rv = onlp_sfp_is_present(port);
+    if(rv < 0) {
+        export_error__(e, rv);
+        goto done;
+    }
+    KV(bool, e, "present", rv);
+    if(rv == 0) {
+        goto done;
+    }
+
+    if(onlp_sfp_control_flags_get(port, &flags) >= 0) {
+        KV(uint, e, "control_flags", flags);
+    }
+
+    rv = onlp_sfp_eeprom_read(port, &data);
+    if(rv < 0) {
+        export_error__(e, rv);
+        goto done;
+    }
+
+    sff_eeprom_parse(&se, data);
+    aim_free(data);
+    KV(bool, e, "identified", se.identified);
+    if(!se.identified) {
+        onlp_export_key(e, "eeprom");
+        onlp_export_bytes(e, se.eeprom, sizeof(se.eeprom));
+        goto done;
+    }
+
+    KV(str, e, "sfp_type", se.info.sfp_type_name);
+    KV(str, e, "module_type", se.info.module_type_name);
+    KV(str, e, "media_type", se.info.media_type_name);
+    KV(uint, e, "caps", se.info.caps);
+    KV(int, e, "length", se.info.length);
+    KV(str, e, "vendor", se.info.vendor);
+    KV(str, e, "model", se.info.model);
+    KV(str, e, "serial", se.info.serial);
+
+    if(e->flags & ONLP_EXPORT_F_SFP_DOM) {
+        export_sfp_dom__(e, port, &se);
+    }
+
+ done:
+    onlp_export_map_end(e);
+    return e->error;
+}
+
+int
+onlp_export_sfps(onlp_export_t* e)
+{
+    int port;
+    onlp_sfp_bitmap_t bitmap;
+
+    onlp_sfp_bitmap_t_init(&bitmap);
+    onlp_sfp_bitmap_get(&bitmap);
+
+    AIM_BITMAP_ITER(&bitmap, port) {
+        onlp_export_sfp(e, port);
+        if(e->error) {
+            break;
+        }
+    }
+    return e->error;
+}
+
+int
+onlp_export_platform(int fd, uint32_t flags)
+{
+    onlp_export_t* e = onlp_export_create(fd, flags | ONLP_EXPORT_F_RECURSE);
+    onlp_export_oid(e, ONLP_OID_SYS);
+    onlp_export_sfps(e);
+    return onlp_export_destroy(e);
+}
@@ -26,6 +26,9 @@
 #include <onlp/platformi/fani.h>
 #include <onlp/oids.h>
 #include "onlp_int.h"
+/* The fan subsystem is initialized on first use. */
+static int onlp_fan_init_locked__(void);
+#define ONLP_LOCKED_API_INIT onlp_fan_init_locked__
 #include "onlp_locks.h"
 #include "onlp_log.h"
 #include "onlp_json.h"
@@ -45,10 +48,18 @@
     } while(0)
 
 
+static int fan_init__ = 0;
+static int fan_init_rv__;
+
 static int
 onlp_fan_init_locked__(void)
 {
-    return onlp_fani_init();
+    if(!fan_init__) {
+        onlp_sys_init_once();
+        fan_init_rv__ = onlp_fani_init();
+        fan_init__ = 1;
+    }
+    return fan_init_rv__;
 }
 ONLP_LOCKED_API0(onlp_fan_init)
 
@@ -101,12 +112,10 @@ onlp_fan_info_get_locked__(onlp_oid_t oid, onlp_fan_info_t* fip)
          * Optional override from the config file.
          * This is usually just for testing.
          */
-        int id = ONLP_OID_ID_GET(oid);
-        cJSON* entry = NULL;
-
-
-        cjson_util_lookup(onlp_json_get(0), &entry, "overrides.fan.%d", id);
-        onlp_fani_info_from_json__(entry, fip, 0);
+        cJSON* entry = onlp_json_override_get(oid);
+        if(entry) {
+            onlp_fani_info_from_json__(entry, fip, 0);
+        }
 #endif
 
         if(fip->percentage && fip->rpm == 0) {
@@ -26,7 +26,14 @@
 #include <onlp/oids.h>
 #include <onlp/led.h>
 #include <onlp/platformi/ledi.h>
+#include <onlplib/shlocks.h>
+#include <signal.h>
+#include <unistd.h>
+#include <errno.h>
 #include "onlp_int.h"
+/* The LED subsystem is initialized on first use. */
+static int onlp_led_init_locked__(void);
+#define ONLP_LOCKED_API_INIT onlp_led_init_locked__
 #include "onlp_locks.h"
 
 #define VALIDATE(_id)                           \
@@ -69,18 +76,259 @@ onlp_led_present__(onlp_oid_t id, onlp_led_info_t* info)
         }                                               \
     } while(0)
 
+/*
+ * Software blink engine.
+ *
+ * A blinking mode which the LED does not support is emulated by
+ * alternating between the matching solid color and OFF. All emulated
+ * LEDs toggle together from a single platform manager task so the
+ * whole panel is refreshed with one onlp_ledi_set_many() call.
+ *
+ * The set of emulated LEDs is kept in shared memory, so any process
+ * may request an emulated mode while the process which hosts the
+ * platform manager runs the engine. All state is protected by the
+ * API lock.
+ */
+#define LED_SOLID_COLOR_CAPS                                    \
+    (ONLP_LED_CAPS_RED | ONLP_LED_CAPS_ORANGE |                 \
+     ONLP_LED_CAPS_YELLOW | ONLP_LED_CAPS_GREEN |               \
+     ONLP_LED_CAPS_BLUE | ONLP_LED_CAPS_PURPLE)
+
+typedef struct led_blink_s {
+    onlp_oid_t id;
+    /** The requested blinking mode */
+    onlp_led_mode_t mode;
+} led_blink_t;
+
+typedef struct led_blink_table_s {
+    uint32_t magic;
+    uint32_t size;
+    /** The process running the engine, or 0 */
+    pid_t engine;
+    /** Non-zero while emulated LEDs are lit */
+    int lit;
+    int count;
+    led_blink_t leds[ONLP_CONFIG_LED_BLINK_MAX];
+} led_blink_table_t;
+
+#define LED_BLINK_MAGIC 0xB1B1B1B1
+
+static led_blink_table_t* blink__ = NULL;
+
+/** Scratch update list for each toggle */
+static onlp_led_update_t blink_updates__[ONLP_CONFIG_LED_BLINK_MAX];
+
+static led_blink_table_t*
+led_blink_table__(void)
+{
+    led_blink_table_t* t = NULL;
+    int rv = ONLP_STATUS_E_UNSUPPORTED;
+
+#if ONLP_CONFIG_INCLUDE_API_LOCK == 1 && ONLP_CONFIG_API_LOCK_GLOBAL_SHARED == 1
+    /* The table is only shared when the API lock is. */
+    rv = onlp_shmem_create(ONLP_CONFIG_LED_BLINK_SHM_KEY, sizeof(*t), (void**)&t);
+#endif
+    if(rv < 0 || (t->magic == LED_BLINK_MAGIC && t->size != ONLP_CONFIG_LED_BLINK_MAX)) {
+        if(rv >= 0) {
+            AIM_LOG_WARN("The shared LED blink table is not compatible. Emulated blinking is local to this process.");
+        }
+        t = aim_zmalloc(sizeof(*t));
+    }
+    if(t->magic != LED_BLINK_MAGIC) {
+        t->size = ONLP_CONFIG_LED_BLINK_MAX;
+        t->magic = LED_BLINK_MAGIC;
+    }
+    return t;
+}
+
+/*
+ * Whether an engine is running, in this or another process.
+ */
+static int
+led_blink_enabled__(void)
+{
+    pid_t pid = blink__->engine;
+    if(pid == 0) {
+        return 0;
+    }
+    if(pid == getpid()) {
+        return 1;
+    }
+    /* The engine process may have exited without stopping the engine. */
+    return kill(pid, 0) == 0 || errno == EPERM;
+}
+
+/*
+ * The solid mode for a blinking color mode, or OFF if the
+ * mode cannot be emulated.
+ */
+static onlp_led_mode_t
+led_blink_solid__(onlp_led_mode_t mode)
+{
+    onlp_led_mode_t solid = mode - 1;
+    if(mode > ONLP_LED_MODE_BLINKING && (mode & 1) &&
+       (LED_SOLID_COLOR_CAPS & (1 << solid))) {
+        return solid;
+    }
+    return ONLP_LED_MODE_OFF;
+}
+
+static led_blink_t*
+led_blink_find__(onlp_oid_t id)
+{
+    int i;
+    for(i = 0; i < blink__->count; i++) {
+        if(blink__->leds[i].id == id) {
+            return blink__->leds + i;
+        }
+    }
+    return NULL;
+}
+
+static void
+led_blink_remove__(onlp_oid_t id)
+{
+    led_blink_t* b = led_blink_find__(id);
+    if(b) {
+        *b = blink__->leds[--blink__->count];
+    }
+}
+
+/*
+ * Apply updates through the platform, one LED at a time
+ * if the platform does not support batched updates.
+ */
+static int
+led_set_many__(onlp_led_update_t* updates, int count)
+{
+    int i;
+    int rv = onlp_ledi_set_many(updates, count);
+
+    if(ONLP_UNSUPPORTED(rv)) {
+        rv = ONLP_STATUS_OK;
+        for(i = 0; i < count; i++) {
+            updates[i].rv = onlp_ledi_mode_set(updates[i].id, updates[i].mode);
+        }
+    }
+    else if(rv < 0) {
+        return rv;
+    }
+
+    for(i = 0; i < count; i++) {
+        if(updates[i].rv < 0) {
+            return updates[i].rv;
+        }
+    }
+    return rv;
+}
+
+/*
+ * Start emulating a blinking mode on an LED which
+ * advertises the solid color.
+ */
+static int
+led_blink_start__(onlp_oid_t id, onlp_led_mode_t mode, uint32_t caps)
+{
+    int rv;
+    onlp_led_update_t u;
+    led_blink_t* b = led_blink_find__(id);
+    onlp_led_mode_t solid = led_blink_solid__(mode);
+
+    if(!led_blink_enabled__() || solid == ONLP_LED_MODE_OFF ||
+       !(caps & (1 << solid))) {
+        return ONLP_STATUS_E_UNSUPPORTED;
+    }
+    if(b == NULL && blink__->count == blink__->size) {
+        AIM_LOG_WARN("The LED blink table is full. Mode %d cannot be emulated on LED 0x%x.",
+                     mode, id);
+        return ONLP_STATUS_E_UNSUPPORTED;
+    }
+
+    /* Join the current phase so all emulated LEDs blink together. */
+    u.id = id;
+    u.mode = blink__->lit ? solid : ONLP_LED_MODE_OFF;
+    u.rv = 0;
+    if((rv = led_set_many__(&u, 1)) < 0) {
+        return rv;
+    }
+    if(b == NULL) {
+        b = blink__->leds + blink__->count++;
+        b->id = id;
+    }
+    b->mode = mode;
+    return ONLP_STATUS_OK;
+}
+
+static int
+onlp_led_blink_manage_locked__(void)
+{
+    int i;
+
+    if(blink__->engine != getpid() || blink__->count == 0) {
+        return ONLP_STATUS_OK;
+    }
+
+    blink__->lit = !blink__->lit;
+    for(i = 0; i < blink__->count; i++) {
+        blink_updates__[i].id = blink__->leds[i].id;
+        blink_updates__[i].mode = blink__->lit ?
+            led_blink_solid__(blink__->leds[i].mode) : ONLP_LED_MODE_OFF;
+        blink_updates__[i].rv = 0;
+    }
+    return led_set_many__(blink_updates__, blink__->count);
+}
+ONLP_LOCKED_API0(onlp_led_blink_manage);
+
+static int
+onlp_led_blink_engine_set_locked__(int enable)
+{
+    if(!enable && blink__->engine == getpid()) {
+        /* Leave emulated LEDs lit. */
+        blink__->lit = 0;
+        onlp_led_blink_manage_locked__();
+        blink__->count = 0;
+        blink__->engine = 0;
+    }
+    if(enable && ONLP_CONFIG_INCLUDE_LED_SOFT_BLINK) {
+        /* Emulated LEDs left by a previous engine resume blinking. */
+        blink__->engine = getpid();
+    }
+    return ONLP_STATUS_OK;
+}
+ONLP_LOCKED_API1(onlp_led_blink_engine_set, int, enable);
+
+static int led_init__ = 0;
+static int led_init_rv__;
+
 static int
 onlp_led_init_locked__(void)
 {
-    return onlp_ledi_init();
+    if(!led_init__) {
+        onlp_sys_init_once();
+        blink__ = led_blink_table__();
+        led_init_rv__ = onlp_ledi_init();
+        led_init__ = 1;
+    }
+    return led_init_rv__;
 }
 ONLP_LOCKED_API0(onlp_led_init);
 
 static int
 onlp_led_info_get_locked__(onlp_oid_t id, onlp_led_info_t* info)
 {
+    int rv;
+    led_blink_t* b;
+
     VALIDATE(id);
-    return onlp_ledi_info_get(id, info);
+    rv = onlp_ledi_info_get(id, info);
+    if(rv >= 0 && led_blink_enabled__()) {
+        /* Advertise the blinking modes we can emulate. */
+        info->caps |= (info->caps & LED_SOLID_COLOR_CAPS) << 1;
+        if((b = led_blink_find__(id))) {
+            info->mode = b->mode;
+        }
+    }
+    return rv;
 }
 ONLP_LOCKED_API2(onlp_led_info_get, onlp_oid_t, id, onlp_led_info_t*, info);
 
@@ -122,6 +370,7 @@ onlp_led_set_locked__(onlp_oid_t id, int on_or_off)
     onlp_led_info_t info;
     ONLP_LED_PRESENT_OR_RETURN(id, &info);
     if(info.caps & ONLP_LED_CAPS_ON_OFF) {
+        led_blink_remove__(id);
         return onlp_ledi_set(id, on_or_off);
     }
     else {
@@ -141,14 +390,71 @@ onlp_led_mode_set_locked__(onlp_oid_t id, onlp_led_mode_t mode)
      * the capability bit positions.
      */
     if(info.caps & (1 << mode)) {
+        led_blink_remove__(id);
         return onlp_ledi_mode_set(id, mode);
     }
     else {
-        return ONLP_STATUS_E_UNSUPPORTED;
+        return led_blink_start__(id, mode, info.caps);
     }
 }
 ONLP_LOCKED_API2(onlp_led_mode_set, onlp_oid_t, id, onlp_led_mode_t, mode);
 
+static int
+onlp_led_set_many_locked__(onlp_led_update_t* updates, int count)
+{
+    int i;
+    int rv = ONLP_STATUS_OK;
+
+    if(updates == NULL || count < 0) {
+        return ONLP_STATUS_E_PARAM;
+    }
+
+    for(i = 0; i < count; i++) {
+        VALIDATE(updates[i].id);
+        updates[i].rv = ONLP_STATUS_OK;
+    }
+
+    /*
+     * Capabilities are checked by the platform so that a batch
+     * does not cost one info read per LED.
+     */
+    rv = onlp_ledi_set_many(updates, count);
+    if(ONLP_UNSUPPORTED(rv)) {
+        rv = ONLP_STATUS_OK;
+        for(i = 0; i < count; i++) {
+            updates[i].rv = onlp_led_mode_set_locked__(updates[i].id,
+                                                       updates[i].mode);
+        }
+    }
+    else if(rv < 0) {
+        return rv;
+    }
+    else {
+        for(i = 0; i < count; i++) {
+            if(ONLP_SUCCESS(updates[i].rv)) {
+                led_blink_remove__(updates[i].id);
+            }
+            else if(ONLP_UNSUPPORTED(updates[i].rv) && led_blink_enabled__()) {
+                onlp_led_info_t info;
+                updates[i].rv = onlp_led_present__(updates[i].id, &info);
+                if(ONLP_SUCCESS(updates[i].rv)) {
+                    updates[i].rv = led_blink_start__(updates[i].id,
+                                                      updates[i].mode,
+                                                      info.caps);
+                }
+            }
+        }
+    }
+
+    for(i = 0; i < count; i++) {
+        if(updates[i].rv < 0) {
+            return updates[i].rv;
+        }
+    }
+    return rv;
+}
+ONLP_LOCKED_API2(onlp_led_set_many, onlp_led_update_t*, updates, int, count);
+
 static int
 onlp_led_char_set_locked__(onlp_oid_t id, char c)
 {
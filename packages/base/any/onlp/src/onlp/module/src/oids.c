@@ -203,29 +203,174 @@ onlp_oid_iterate(onlp_oid_t oid, onlp_oid_type_t type,
                  onlp_oid_iterate_f itf, void* cookie)
 {
     int rv;
-    onlp_oid_hdr_t hdr;
+    onlp_oid_list_t list;
     onlp_oid_t* oidp;
 
     if(oid == 0) {
         oid = ONLP_OID_SYS;
     }
 
-    rv = onlp_oid_hdr_get(oid, &hdr);
+    onlp_oid_list_init(&list);
+    rv = onlp_oid_coids_get(oid, &list);
     if(rv < 0) {
+        onlp_oid_list_free(&list);
         return rv;
     }
 
-    ONLP_OID_TABLE_ITER(hdr.coids, oidp) {
-        if(type == 0 || ONLP_OID_IS_TYPE(*oidp, type)) {
-            int rv = itf(*oidp, cookie);
+    ONLP_OID_LIST_ITER(&list, oidp) {
+        if(type == 0 || ONLP_OID_IS_TYPE(type, *oidp)) {
+            rv = itf(*oidp, cookie);
             if(rv < 0) {
-                return rv;
+                break;
             }
             rv = onlp_oid_iterate(*oidp, type, itf, cookie);
             if(rv < 0) {
-                return rv;
+                break;
             }
         }
     }
+    onlp_oid_list_free(&list);
+    return (rv < 0) ? rv : ONLP_STATUS_OK;
+}
+
+int
+onlp_oid_coids_get(onlp_oid_t oid, onlp_oid_list_t* list)
+{
+    int rv;
+    onlp_oid_hdr_t hdr;
+
+    if(list == NULL) {
+        return ONLP_STATUS_E_PARAM;
+    }
+
+    onlp_oid_list_clear(list);
+
+    if(oid == 0) {
+        oid = ONLP_OID_SYS;
+    }
+
+    if(ONLP_OID_IS_TYPE(ONLP_OID_TYPE_SYS, oid)) {
+        /* The system is the only object large enough to outgrow the header table. */
+        return onlp_sys_coids_get(list);
+    }
+
+    rv = onlp_oid_hdr_get(oid, &hdr);
+    if(rv < 0) {
+        return rv;
+    }
+    return onlp_oid_list_append_table(list, hdr.coids);
+}
+
+
+/************************************************************
+ *
+ * Variable-length OID lists
+ *
+ ***********************************************************/
+
+void
+onlp_oid_list_init(onlp_oid_list_t* list)
+{
+    list->count = 0;
+    list->size = 0;
+    list->oids = NULL;
+}
+
+void
+onlp_oid_list_free(onlp_oid_list_t* list)
+{
+    aim_free(list->oids);
+    onlp_oid_list_init(list);
+}
+
+void
+onlp_oid_list_clear(onlp_oid_list_t* list)
+{
+    list->count = 0;
+}
+
+int
+onlp_oid_list_reserve(onlp_oid_list_t* list, int size)
+{
+    int nsize;
+    onlp_oid_t* oids;
+
+    if(size <= list->size) {
+        return ONLP_STATUS_OK;
+    }
+
+    /* Grow geometrically to keep appends amortized. */
+    nsize = list->size ? list->size : ONLP_OID_TABLE_SIZE;
+    while(nsize < size) {
+        nsize *= 2;
+    }
+
+    oids = aim_realloc(list->oids, nsize*sizeof(onlp_oid_t));
+    if(oids == NULL) {
+        return ONLP_STATUS_E_INTERNAL;
+    }
+    list->oids = oids;
+    list->size = nsize;
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_oid_list_append(onlp_oid_list_t* list, onlp_oid_t oid)
+{
+    int rv = onlp_oid_list_reserve(list, list->count + 1);
+    if(rv < 0) {
+        return rv;
+    }
+    list->oids[list->count++] = oid;
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_oid_list_append_table(onlp_oid_list_t* list, onlp_oid_table_t table)
+{
+    int rv;
+    onlp_oid_t* oidp;
+
+    rv = onlp_oid_list_reserve(list, list->count + ONLP_OID_TABLE_SIZE);
+    if(rv < 0) {
+        return rv;
+    }
+    ONLP_OID_TABLE_ITER(table, oidp) {
+        list->oids[list->count++] = *oidp;
+    }
     return ONLP_STATUS_OK;
 }
+
+int
+onlp_oid_list_to_table(onlp_oid_list_t* list, onlp_oid_table_t table)
+{
+    int count = 0;
+    onlp_oid_t* oidp;
+
+    ONLP_OID_TABLE_CLEAR(table);
+    ONLP_OID_LIST_ITER(list, oidp) {
+        if(count == ONLP_OID_TABLE_SIZE) {
+            break;
+        }
+        table[count++] = *oidp;
+    }
+    return count;
+}
+
+void
+onlp_oid_list_dump(onlp_oid_list_t* list, aim_pvs_t* pvs, uint32_t flags)
+{
+    onlp_oid_t* oidp;
+    ONLP_OID_LIST_ITER(list, oidp) {
+        onlp_oid_dump(*oidp, pvs, flags);
+    }
+}
+
+void
+onlp_oid_list_show(onlp_oid_list_t* list, aim_pvs_t* pvs, uint32_t flags)
+{
+    onlp_oid_t* oidp;
+    ONLP_OID_LIST_ITER(list, oidp) {
+        onlp_oid_show(*oidp, pvs, flags);
+    }
+}
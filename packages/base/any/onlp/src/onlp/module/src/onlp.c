@@ -52,13 +52,21 @@ onlp_init(void)
     onlp_api_lock_init();
 #endif
 
-
+    /*
+     * The configuration file and each subsystem are
+     * initialized the first time they are used.
+     */
     onlp_json_init(cfile);
+    return 0;
+}
+
+void
+onlp_subsystems_init(void)
+{
     onlp_sys_init();
     onlp_sfp_init();
     onlp_led_init();
     onlp_psu_init();
     onlp_fan_init();
     onlp_thermal_init();
-    return 0;
 }
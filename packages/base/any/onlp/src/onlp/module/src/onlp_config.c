@@ -120,6 +120,11 @@ onlp_config_settings_t onlp_config_settings[] =
 #else
 { ONLP_CONFIG_API_LOCK_TIMEOUT(__onlp_config_STRINGIFY_NAME), "__undefined__" },
 #endif
+#ifdef ONLP_CONFIG_API_LOCK_SHARED_TIMEOUT_FATAL
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_API_LOCK_SHARED_TIMEOUT_FATAL), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_API_LOCK_SHARED_TIMEOUT_FATAL) },
+#else
+{ ONLP_CONFIG_API_LOCK_SHARED_TIMEOUT_FATAL(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
 #ifdef ONLP_CONFIG_INFO_STR_MAX
     { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_INFO_STR_MAX), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_INFO_STR_MAX) },
 #else
@@ -134,6 +139,111 @@ onlp_config_settings_t onlp_config_settings[] =
     { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_INCLUDE_API_PROFILING), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_INCLUDE_API_PROFILING) },
 #else
 { ONLP_CONFIG_INCLUDE_API_PROFILING(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_OID_TABLE_SIZE
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_OID_TABLE_SIZE), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_OID_TABLE_SIZE) },
+#else
+{ ONLP_CONFIG_OID_TABLE_SIZE(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_SERVER_SOCKET_PATH
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_SERVER_SOCKET_PATH), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_SERVER_SOCKET_PATH) },
+#else
+{ ONLP_CONFIG_SERVER_SOCKET_PATH(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_SERVER_REFRESH_INTERVAL
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_SERVER_REFRESH_INTERVAL), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_SERVER_REFRESH_INTERVAL) },
+#else
+{ ONLP_CONFIG_SERVER_REFRESH_INTERVAL(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_SERVER_SFP_DOM_REFRESH_INTERVAL
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_SERVER_SFP_DOM_REFRESH_INTERVAL), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_SERVER_SFP_DOM_REFRESH_INTERVAL) },
+#else
+{ ONLP_CONFIG_SERVER_SFP_DOM_REFRESH_INTERVAL(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_SERVER_CLIENTS_MAX
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_SERVER_CLIENTS_MAX), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_SERVER_CLIENTS_MAX) },
+#else
+{ ONLP_CONFIG_SERVER_CLIENTS_MAX(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_SERVER_REQUEST_MAX
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_SERVER_REQUEST_MAX), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_SERVER_REQUEST_MAX) },
+#else
+{ ONLP_CONFIG_SERVER_REQUEST_MAX(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_INCLUDE_API_STATS
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_INCLUDE_API_STATS), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_INCLUDE_API_STATS) },
+#else
+{ ONLP_CONFIG_INCLUDE_API_STATS(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_API_STATS_MAX
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_API_STATS_MAX), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_API_STATS_MAX) },
+#else
+{ ONLP_CONFIG_API_STATS_MAX(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_API_STATS_SHM_KEY
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_API_STATS_SHM_KEY), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_API_STATS_SHM_KEY) },
+#else
+{ ONLP_CONFIG_API_STATS_SHM_KEY(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_INCLUDE_LED_SOFT_BLINK
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_INCLUDE_LED_SOFT_BLINK), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_INCLUDE_LED_SOFT_BLINK) },
+#else
+{ ONLP_CONFIG_INCLUDE_LED_SOFT_BLINK(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_LED_BLINK_PERIOD_MS
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_LED_BLINK_PERIOD_MS), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_LED_BLINK_PERIOD_MS) },
+#else
+{ ONLP_CONFIG_LED_BLINK_PERIOD_MS(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_LED_BLINK_MAX
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_LED_BLINK_MAX), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_LED_BLINK_MAX) },
+#else
+{ ONLP_CONFIG_LED_BLINK_MAX(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_LED_BLINK_SHM_KEY
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_LED_BLINK_SHM_KEY), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_LED_BLINK_SHM_KEY) },
+#else
+{ ONLP_CONFIG_LED_BLINK_SHM_KEY(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_PSU_POWER_WINDOW
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_PSU_POWER_WINDOW), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_PSU_POWER_WINDOW) },
+#else
+{ ONLP_CONFIG_PSU_POWER_WINDOW(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_PSU_POWER_MAX
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_PSU_POWER_MAX), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_PSU_POWER_MAX) },
+#else
+{ ONLP_CONFIG_PSU_POWER_MAX(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_PSU_POWER_SHM_KEY
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_PSU_POWER_SHM_KEY), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_PSU_POWER_SHM_KEY) },
+#else
+{ ONLP_CONFIG_PSU_POWER_SHM_KEY(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_INCLUDE_PLATFORM_PLUGINS
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_INCLUDE_PLATFORM_PLUGINS), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_INCLUDE_PLATFORM_PLUGINS) },
+#else
+{ ONLP_CONFIG_INCLUDE_PLATFORM_PLUGINS(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_PLATFORM_PLUGIN_PATH
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_PLATFORM_PLUGIN_PATH), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_PLATFORM_PLUGIN_PATH) },
+#else
+{ ONLP_CONFIG_PLATFORM_PLUGIN_PATH(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_PLATFORM_PLUGIN_ENV
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_PLATFORM_PLUGIN_ENV), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_PLATFORM_PLUGIN_ENV) },
+#else
+{ ONLP_CONFIG_PLATFORM_PLUGIN_ENV(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_PLATFORM_SHIMS_ENV
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_PLATFORM_SHIMS_ENV), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_PLATFORM_SHIMS_ENV) },
+#else
+{ ONLP_CONFIG_PLATFORM_SHIMS_ENV(__onlp_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLP_CONFIG_INCLUDE_ASYNC
+    { __onlp_config_STRINGIFY_NAME(ONLP_CONFIG_INCLUDE_ASYNC), __onlp_config_STRINGIFY_VALUE(ONLP_CONFIG_INCLUDE_ASYNC) },
+#else
+{ ONLP_CONFIG_INCLUDE_ASYNC(__onlp_config_STRINGIFY_NAME), "__undefined__" },
 #endif
     { NULL, NULL }
 };
@@ -871,6 +871,7 @@ aim_map_si_t onlp_status_map[] =
     { "E_INTERNAL", ONLP_STATUS_E_INTERNAL },
     { "E_PARAM", ONLP_STATUS_E_PARAM },
     { "E_I2C", ONLP_STATUS_E_I2C },
+    { "E_BUSY", ONLP_STATUS_E_BUSY },
     { NULL, 0 }
 };
 
@@ -884,6 +885,7 @@ aim_map_si_t onlp_status_desc_map[] =
     { "None", ONLP_STATUS_E_INTERNAL },
     { "None", ONLP_STATUS_E_PARAM },
     { "None", ONLP_STATUS_E_I2C },
+    { "None", ONLP_STATUS_E_BUSY },
     { NULL, 0 }
 };
 
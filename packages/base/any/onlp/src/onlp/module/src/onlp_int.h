@@ -31,6 +31,7 @@
 #include <onlp/oids.h>
 #include <cjson/cJSON.h>
 #include "onlp_json.h"
+#include <onlp/export.h>
 
 /** Default IOF initializations for dump() and show() routines */
 void onlp_oid_show_iof_init_default(iof_t* iof, aim_pvs_t* pvs, uint32_t flags);
@@ -44,4 +45,49 @@ void onlp_oid_show_description(iof_t* iof, onlp_oid_hdr_t* hdr);
 /** Standard message when an OID is missing. */
 void onlp_oid_show_state_missing(iof_t* iof);
 
+/** Determine the current platform name (sys.c). The caller frees the result. */
+char* onlp_sys_platform_detect(void);
+
+/**
+ * Subsystems are initialized on first use rather than by onlp_init().
+ * Each initializer runs once and returns the cached result thereafter.
+ * They are called with the API lock held (see ONLP_LOCKED_API_INIT).
+ * Every subsystem initializes the platform (sys.c) first.
+ */
+int onlp_sys_init_once(void);
+
+/**
+ * Initialize every subsystem now (onlp.c).
+ * Required before calling platform interfaces directly, as the
+ * platform manager and sysi debug commands do, since platform
+ * code calls its own raw fani/ledi/... functions and expects
+ * them to be initialized.
+ */
+void onlp_subsystems_init(void);
+
+/** Software LED blink engine (led.c). Only active while enabled by the platform manager. */
+int onlp_led_blink_engine_set(int enable);
+int onlp_led_blink_manage(void);
+
+/** Export into a memory buffer. The buffer is retrieved with onlp_export_buffer_take(). */
+onlp_export_t* onlp_export_create_buffer(uint32_t flags);
+/** Retrieve (and reset) the contents of a memory export stream. The caller frees the data. */
+int onlp_export_buffer_take(onlp_export_t* e, uint8_t** data, int* size);
+/** Mirror all encoder calls on the given stream to a second stream. */
+void onlp_export_tee(onlp_export_t* e, onlp_export_t* tee);
+
+/** Structured export encoders (export.c) */
+void onlp_export_map_begin(onlp_export_t* e);
+void onlp_export_map_end(onlp_export_t* e);
+void onlp_export_array_begin(onlp_export_t* e);
+void onlp_export_array_end(onlp_export_t* e);
+void onlp_export_key(onlp_export_t* e, const char* key);
+void onlp_export_str(onlp_export_t* e, const char* s);
+void onlp_export_int(onlp_export_t* e, int64_t v);
+void onlp_export_uint(onlp_export_t* e, uint64_t v);
+void onlp_export_bool(onlp_export_t* e, int v);
+void onlp_export_bytes(onlp_export_t* e, const uint8_t* data, int size);
+/** Write previously encoded data */
+void onlp_export_raw(onlp_export_t* e, const uint8_t* data, int size);
+
 #endif /* __ONLP_INT_H__ */
@@ -1,21 +1,21 @@
 /************************************************************
  * <bsn.cl fy=2014 v=onl>
- * 
- *        Copyright 2014, 2015 Big Switch Networks, Inc.       
- * 
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
  * Licensed under the Eclipse Public License, Version 1.0 (the
  * "License"); you may not use this file except in compliance
  * with the License. You may obtain a copy of the License at
- * 
+ *
  *        http://www.eclipse.org/legal/epl-v10.html
- * 
+ *
  * Unless required by applicable law or agreed to in writing,
  * software distributed under the License is distributed on an
  * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
  * either express or implied. See the License for the specific
  * language governing permissions and limitations under the
  * License.
- * 
+ *
  * </bsn.cl>
  ************************************************************
  *
@@ -25,38 +25,183 @@
 #include "onlp_json.h"
 #include "onlp_log.h"
 #include <onlp/onlp.h>
+#include <signal.h>
+#include <stdlib.h>
 
 static cJSON* root__ = NULL;
 static char* file__ = NULL;
 
-void
-onlp_json_init(const char* fname)
+/** Set by onlp_config_reload(). */
+static volatile sig_atomic_t reload__ = 0;
+
+#if ONLP_CONFIG_INCLUDE_PLATFORM_OVERRIDES == 1
+
+/*
+ * Platform overrides are resolved when the configuration is loaded
+ * into a table per OID type, indexed by id. An OID without an
+ * override costs a single bit test.
+ */
+typedef struct override_table_s {
+    /** The section name under "overrides" */
+    const char* name;
+    /** Ids [0, size) are covered */
+    int size;
+    /** One bit per id which has an override */
+    uint32_t* bits;
+    /** The override entries, indexed by id */
+    cJSON** entries;
+} override_table_t;
+
+static override_table_t overrides__[] = {
+    [ONLP_OID_TYPE_THERMAL] = { "thermal" },
+    [ONLP_OID_TYPE_FAN] = { "fan" },
+};
+
+/* Larger ids are ignored rather than sizing the table to them. */
+#define OVERRIDE_ID_MAX 4096
+
+static int
+override_id__(const char* key)
 {
-    int rv;
-    onlp_json_denit();
+    char* end;
+    long id;
+
+    if(key == NULL) {
+        return -1;
+    }
+    id = strtol(key, &end, 0);
+    if(end == key || *end || id <= 0 || id > OVERRIDE_ID_MAX) {
+        return -1;
+    }
+    return id;
+}
+
+static void
+overrides_clear__(void)
+{
+    int i;
+    for(i = 0; i < AIM_ARRAYSIZE(overrides__); i++) {
+        override_table_t* t = overrides__ + i;
+        aim_free(t->bits);
+        aim_free(t->entries);
+        t->bits = NULL;
+        t->entries = NULL;
+        t->size = 0;
+    }
+}
 
-    rv = cjson_util_parse_file(fname, &root__);
-    if(rv < 0 || root__ == NULL) {
+static void
+overrides_load__(cJSON* root)
+{
+    int i;
+
+    overrides_clear__();
+
+    for(i = 0; i < AIM_ARRAYSIZE(overrides__); i++) {
+        override_table_t* t = overrides__ + i;
+        cJSON* section = NULL;
+        cJSON* e;
+        int id, max = 0;
+
+        if(t->name == NULL ||
+           cjson_util_lookup(root, &section, "overrides.%s", t->name) < 0 ||
+           section == NULL) {
+            continue;
+        }
+
+        for(e = section->child; e; e = e->next) {
+            if( (id = override_id__(e->string)) < 0) {
+                AIM_LOG_WARN("ignoring %s override '%s'", t->name, e->string);
+            }
+            else if(id > max) {
+                max = id;
+            }
+        }
+        if(max == 0) {
+            continue;
+        }
+
+        t->size = max + 1;
+        t->bits = aim_zmalloc(((t->size + 31) / 32) * sizeof(uint32_t));
+        t->entries = aim_zmalloc(t->size * sizeof(cJSON*));
+        for(e = section->child; e; e = e->next) {
+            if( (id = override_id__(e->string)) > 0) {
+                t->bits[id / 32] |= (1U << (id % 32));
+                t->entries[id] = e;
+            }
+        }
+    }
+}
+
+cJSON*
+onlp_json_override_get(onlp_oid_t oid)
+{
+    override_table_t* t;
+    int type = ONLP_OID_TYPE_GET(oid);
+    int id = ONLP_OID_ID_GET(oid);
+
+    /* Loads (or reloads) the configuration if necessary. */
+    onlp_json_get(0);
+
+    if(type >= AIM_ARRAYSIZE(overrides__)) {
+        return NULL;
+    }
+    t = overrides__ + type;
+    if(id >= t->size || !(t->bits[id / 32] & (1U << (id % 32)))) {
+        return NULL;
+    }
+    return t->entries[id];
+}
+
+#endif /* ONLP_CONFIG_INCLUDE_PLATFORM_OVERRIDES */
+
+static void
+onlp_json_load__(void)
+{
+    if(root__) {
+        cJSON_Delete(root__);
+        root__ = NULL;
+    }
+    if(file__ == NULL || cjson_util_parse_file(file__, &root__) < 0 || root__ == NULL) {
         root__ = cJSON_Parse("{}");
     }
-    else {
+#if ONLP_CONFIG_INCLUDE_PLATFORM_OVERRIDES == 1
+    overrides_load__(root__);
+#endif
+}
+
+void
+onlp_json_init(const char* fname)
+{
+    onlp_json_denit();
+    /* The file is parsed on first use. */
+    if(fname) {
         file__ = aim_strdup(fname);
     }
-
 }
 
 cJSON*
 onlp_json_get(int reload)
 {
-    if(reload) {
-        onlp_json_init(file__);
+    if(reload || reload__ || root__ == NULL) {
+        reload__ = 0;
+        onlp_json_load__();
     }
     return root__;
 }
 
+void
+onlp_config_reload(void)
+{
+    reload__ = 1;
+}
+
 void
 onlp_json_denit(void)
 {
+#if ONLP_CONFIG_INCLUDE_PLATFORM_OVERRIDES == 1
+    overrides_clear__();
+#endif
     if(root__) {
         cJSON_Delete(root__);
         root__ = NULL;
@@ -42,6 +42,16 @@ void onlp_json_init(const char* fname);
  */
 cJSON* onlp_json_get(int reload);
 
+#if ONLP_CONFIG_INCLUDE_PLATFORM_OVERRIDES == 1
+/**
+ * @brief Get the platform override entry for an OID.
+ * @param oid The OID.
+ * @returns NULL if the OID has no override.
+ * @note The entry is valid until the configuration is reloaded.
+ */
+cJSON* onlp_json_override_get(onlp_oid_t oid);
+#endif
+
 void onlp_json_denit(void);
 
 
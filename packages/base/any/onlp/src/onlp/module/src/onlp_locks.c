@@ -24,10 +24,35 @@
  ***********************************************************/
 #include <onlp/onlp_config.h>
 #include <onlp/onlp.h>
+#include <onlp/stats.h>
 #include "onlp_locks.h"
 
+/**
+ * The calling thread's API lock wait policy.
+ */
+static __thread int64_t lock_timeout__ = ONLP_API_LOCK_TIMEOUT_DEFAULT;
+
+int64_t
+onlp_api_lock_timeout_set(int64_t timeout)
+{
+    int64_t rv = lock_timeout__;
+    lock_timeout__ = (timeout < 0) ? ONLP_API_LOCK_TIMEOUT_DEFAULT : timeout;
+    return rv;
+}
+
 #if ONLP_CONFIG_INCLUDE_API_LOCK == 1
 
+/**
+ * Non-zero while another thread holds the API lock for the calling thread.
+ */
+static __thread int delegated__ = 0;
+
+void
+onlp_api_lock_delegate(int delegated)
+{
+    delegated__ = delegated;
+}
+
 #if ONLP_CONFIG_API_LOCK_GLOBAL_SHARED == 0
 
 #include <OS/os_sem.h>
@@ -45,22 +70,49 @@ onlp_api_lock_init(void)
     api_sem__ = os_sem_create_flags(1, OS_SEM_CREATE_F_TRUE_RELATIVE_TIMEOUTS);
 }
 
-void
+int
 onlp_api_lock(const char* api)
 {
-    if(os_sem_take_timeout(api_sem__, ONLP_CONFIG_API_LOCK_TIMEOUT) != 0) {
+    if(delegated__) {
+        return 0;
+    }
+    if(lock_timeout__ >= 0) {
+        /* A zero timeout waits forever. */
+        if(os_sem_take_timeout(api_sem__, (lock_timeout__) ? lock_timeout__ : 1) != 0) {
+            return ONLP_STATUS_E_BUSY;
+        }
+    }
+    else if(os_sem_take_timeout(api_sem__, ONLP_CONFIG_API_LOCK_TIMEOUT) != 0) {
         AIM_DIE("The ONLP API lock in %s could not be acquired after %d microseconds. It appears to be currently owned by call to %s. This is considered fatal.",
                 api, ONLP_CONFIG_API_LOCK_TIMEOUT, owner__ ? owner__ : "(none)");
     }
     owner__ = api;
+    return 0;
 }
 
 void
 onlp_api_unlock(void)
 {
+    if(delegated__) {
+        return;
+    }
+    owner__ = NULL;
     os_sem_give(api_sem__);
 }
 
+void
+onlp_api_lock_show(aim_pvs_t* pvs)
+{
+    aim_printf(pvs, "API lock owner: %s\n", owner__ ? owner__ : "(none)");
+    aim_printf(pvs, "API lock statistics are only available with the shared API lock.\n");
+}
+
+int
+onlp_api_lock_stats_clear(void)
+{
+    return ONLP_STATUS_E_UNSUPPORTED;
+}
+
 #else
 
 #include <onlplib/shlocks.h>
@@ -71,17 +123,74 @@ onlp_api_lock_init(void)
     onlp_shlock_global_init();
 }
 
-void
+int
 onlp_api_lock(const char* api)
 {
-    onlp_shlock_global_take();
+    onlp_shlock_owner_t owner;
+
+    if(delegated__) {
+        return 0;
+    }
+    if(lock_timeout__ >= 0) {
+        return onlp_shlock_global_take_timeout(api, lock_timeout__);
+    }
+
+    if(ONLP_CONFIG_API_LOCK_SHARED_TIMEOUT_FATAL == 0 ||
+       ONLP_CONFIG_API_LOCK_TIMEOUT == 0) {
+        /*
+         * Wait forever. The lock is shared by all ONLP processes,
+         * and some operations legitimately hold it for a long time.
+         */
+        return onlp_shlock_global_take_timeout(api, UINT64_MAX);
+    }
+
+    if(onlp_shlock_global_take_timeout(api, ONLP_CONFIG_API_LOCK_TIMEOUT) < 0) {
+        onlp_shlock_global_info_get(&owner, NULL);
+        AIM_DIE("The ONLP API lock in %s could not be acquired after %d microseconds. It appears to be currently owned by pid %d tid %d in %s. This is considered fatal.",
+                api, ONLP_CONFIG_API_LOCK_TIMEOUT, owner.pid, owner.tid,
+                owner.what[0] ? owner.what : "(none)");
+    }
+    return 0;
 }
 void
 onlp_api_unlock(void)
 {
+    if(delegated__) {
+        return;
+    }
     onlp_shlock_global_give();
 }
 
+void
+onlp_api_lock_show(aim_pvs_t* pvs)
+{
+    onlp_shlock_owner_t o;
+    onlp_shlock_stats_t s;
+
+    onlp_shlock_global_info_get(&o, &s);
+
+    if(o.pid) {
+        aim_printf(pvs, "API lock owner: pid %d tid %d in %s for %"PRIu64" usecs\n",
+                   o.pid, o.tid, o.what[0] ? o.what : "(none)",
+                   aim_time_monotonic() - o.since);
+    }
+    else {
+        aim_printf(pvs, "API lock owner: (none)\n");
+    }
+    aim_printf(pvs, "API lock takes: %"PRIu64" contended: %"PRIu64" timeouts: %"PRIu64" owner died: %"PRIu64"\n",
+               s.takes, s.contended, s.timeouts, s.owner_died);
+    aim_printf(pvs, "API lock wait (usecs): avg %"PRIu64" max %"PRIu64"\n",
+               (s.contended) ? s.wait_total / s.contended : 0, s.wait_max);
+    aim_printf(pvs, "API lock hold (usecs): avg %"PRIu64" max %"PRIu64"\n",
+               (s.takes) ? s.hold_total / s.takes : 0, s.hold_max);
+}
+
+int
+onlp_api_lock_stats_clear(void)
+{
+    return onlp_shlock_global_stats_clear();
+}
+
 #endif
 
 
@@ -118,6 +227,18 @@ onlp_api_lock_test(void)
     return 2;
 }
 
+void
+onlp_api_lock_show(aim_pvs_t* pvs)
+{
+    aim_printf(pvs, "API locking is not available in this build.\n");
+}
+
+int
+onlp_api_lock_stats_clear(void)
+{
+    return ONLP_STATUS_E_UNSUPPORTED;
+}
+
 #endif /* ONLP_CONFIG_INCLUDE_API_LOCK */
 
 
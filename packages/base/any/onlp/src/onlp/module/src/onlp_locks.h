@@ -26,6 +26,7 @@
 #define __ONLP_LOCKS_H__
 
 #include <onlp/onlp_config.h>
+#include <onlp/onlp.h>
 
 #if ONLP_CONFIG_INCLUDE_API_LOCK == 1
 
@@ -36,14 +37,26 @@ void onlp_api_lock_init();
 
 /**
  * @brief Take the ONLP API lock.
+ * @param api The calling API.
+ * @returns ONLP_STATUS_E_BUSY if the calling thread has selected a
+ * bounded wait (see onlp_api_lock_timeout_set()) and it expired.
  */
-void onlp_api_lock(const char* api);
+int onlp_api_lock(const char* api);
 
 /**
  * @brief Give the ONLP API lock.
  */
 void onlp_api_unlock(void);
 
+/**
+ * @brief Run the calling thread under another thread's API lock.
+ * @param delegated Non-zero while another thread holds the API lock
+ * on behalf of the calling thread.
+ * @note While set, the calling thread's API calls do not take the lock.
+ * The holder must serialize everything those calls share.
+ */
+void onlp_api_lock_delegate(int delegated);
+
 
 #define ONLP_API_LOCK_INIT() onlp_api_lock_init()
 #define ONLP_API_LOCK(_api)      onlp_api_lock(_api)
@@ -52,8 +65,9 @@ void onlp_api_unlock(void);
 #else
 
 #define ONLP_API_LOCK_INIT()
-#define ONLP_API_LOCK(_api)
+#define ONLP_API_LOCK(_api) 0
 #define ONLP_API_UNLOCK()
+#define onlp_api_lock_delegate(_delegated)
 
 #endif /** ONLP_CONFIG_INCLUDE_API_LOCK */
 
@@ -70,7 +84,51 @@ void onlp_api_unlock(void);
 
 #define ONLP_LOCKED_API_NAME(_name) _name##_locked__
 
+#if ONLP_CONFIG_INCLUDE_API_STATS == 1
+
+/**
+ * Per-entry point statistics slot (see stats.c).
+ */
+typedef struct onlp_api_stats_site_s {
+    const char* name;
+    int index;
+} onlp_api_stats_site_t;
+
+#define ONLP_API_STATS_SITE_UNRESOLVED -1
+#define ONLP_API_STATS_SITE_UNTRACKED  -2
+
+/**
+ * @brief Record a single API call.
+ * @param site The entry point.
+ * @param t0 Time of entry.
+ * @param t1 Time the API lock was acquired.
+ * @param t2 Time the implementation returned.
+ * @param rv The return value.
+ * @note This is called while the API lock is still held.
+ */
+void onlp_api_stats_update(onlp_api_stats_site_t* site,
+                           uint64_t t0, uint64_t t1, uint64_t t2, int rv);
+
+#define ONLP_API_STATS_UPDATE(_name, _rv)                               \
+    do {                                                                \
+        static onlp_api_stats_site_t _site = {                          \
+            #_name, ONLP_API_STATS_SITE_UNRESOLVED                      \
+        };                                                              \
+        onlp_api_stats_update(&_site, t0, t1, t2, _rv);                 \
+    } while(0)
+
+#else
+#define ONLP_API_STATS_UPDATE(_name, _rv)
+#endif
+
 #if ONLP_CONFIG_INCLUDE_API_PROFILING == 1
+#define ONLP_API_PROFILE_LOG(_name)                                     \
+    AIM_LOG_MSG("API '%s' : (total=%"PRId64", ltime=%"PRId64" ftime=%"PRId64")", #_name, t2-t0, t1-t0, t2-t1)
+#else
+#define ONLP_API_PROFILE_LOG(_name)
+#endif
+
+#if ONLP_CONFIG_INCLUDE_API_PROFILING == 1 || ONLP_CONFIG_INCLUDE_API_STATS == 1
 
 #define ONLP_API_T0(_name)                              \
     uint64_t t0, t1, t2; t0 = aim_time_monotonic()
@@ -78,53 +136,85 @@ void onlp_api_unlock(void);
 #define ONLP_API_T1(_name)                      \
     t1 = aim_time_monotonic();
 
-#define ONLP_API_T2(_name)                                              \
+#define ONLP_API_T2(_name, _rv)                                         \
     do {                                                                \
         t2 = aim_time_monotonic();                                      \
-        AIM_LOG_MSG("API '%s' : (total=%"PRId64", ltime=%"PRId64" ftime=%"PRId64")", #_name, t2-t0, t1-t0, t2-t1); \
+        ONLP_API_STATS_UPDATE(_name, _rv);                              \
+        ONLP_API_PROFILE_LOG(_name);                                    \
     } while(0)
 
 #else
 
 #define ONLP_API_T0(_name)
 #define ONLP_API_T1(_name)
-#define ONLP_API_T2(_name)
+#define ONLP_API_T2(_name, _rv)
+
+#endif
 
+/*
+ * A subsystem which is initialized on first use defines
+ * ONLP_LOCKED_API_INIT as its initializer before including this
+ * file. Each of its entry points calls the initializer once the
+ * API lock is held, so the initializer must be cheap once it has run.
+ */
+#ifdef ONLP_LOCKED_API_INIT
+#define ONLP_API_INIT() ((void)ONLP_LOCKED_API_INIT())
+#else
+#define ONLP_API_INIT()
 #endif
 
-#define ONLP_LOCKED_API0(_name)                            \
-    int _name (void)                                       \
-    {                                                      \
-        ONLP_API_T0(_name);                                \
-        ONLP_API_LOCK(#_name);                             \
-        ONLP_API_T1(_name);                                \
-        int _rv = ONLP_LOCKED_API_NAME(_name)();           \
-        ONLP_API_UNLOCK();                                 \
-        ONLP_API_T2(_name);                                \
-        return _rv;                                        \
+/*
+ * ONLP_API_T2() is invoked before the API lock is released so that
+ * statistics updates are serialized by the lock.
+ *
+ * If the API lock cannot be acquired within the calling thread's
+ * bounded wait the implementation is not called and the API returns
+ * ONLP_STATUS_E_BUSY. The void APIs cannot report this, so they log
+ * a warning instead.
+ */
+
+#define ONLP_LOCKED_API0(_name)                                         \
+    int _name (void)                                                    \
+    {                                                                   \
+        ONLP_API_T0(_name);                                             \
+        if(ONLP_API_LOCK(#_name) < 0) {                                 \
+            return ONLP_STATUS_E_BUSY;                                  \
+        }                                                               \
+        ONLP_API_T1(_name);                                             \
+        ONLP_API_INIT();                                                \
+        int _rv = ONLP_LOCKED_API_NAME(_name)();                        \
+        ONLP_API_T2(_name, _rv);                                        \
+        ONLP_API_UNLOCK();                                              \
+        return _rv;                                                     \
     }
 
-#define ONLP_LOCKED_API1(_name, _t, _v)                         \
-    int _name (_t _v)                                           \
-    {                                                           \
-        ONLP_API_T0(_name);                                     \
-        ONLP_API_LOCK(#_name);                                  \
-        ONLP_API_T1(_name);                                     \
-        int _rv = ONLP_LOCKED_API_NAME(_name)(_v);              \
-        ONLP_API_UNLOCK();                                      \
-        ONLP_API_T2(_name);                                     \
-        return _rv;                                             \
+#define ONLP_LOCKED_API1(_name, _t, _v)                                 \
+    int _name (_t _v)                                                   \
+    {                                                                   \
+        ONLP_API_T0(_name);                                             \
+        if(ONLP_API_LOCK(#_name) < 0) {                                 \
+            return ONLP_STATUS_E_BUSY;                                  \
+        }                                                               \
+        ONLP_API_T1(_name);                                             \
+        ONLP_API_INIT();                                                \
+        int _rv = ONLP_LOCKED_API_NAME(_name)(_v);                      \
+        ONLP_API_T2(_name, _rv);                                        \
+        ONLP_API_UNLOCK();                                              \
+        return _rv;                                                     \
     }
 
 #define ONLP_LOCKED_API2(_name, _t1, _v1, _t2, _v2)                     \
     int _name (_t1 _v1, _t2 _v2)                                        \
     {                                                                   \
         ONLP_API_T0(_name);                                             \
-        ONLP_API_LOCK(#_name);                                          \
+        if(ONLP_API_LOCK(#_name) < 0) {                                 \
+            return ONLP_STATUS_E_BUSY;                                  \
+        }                                                               \
         ONLP_API_T1(_name);                                             \
-        int _rv = ONLP_LOCKED_API_NAME(_name) (_v1, _v2);               \
+        ONLP_API_INIT();                                                \
+        int _rv = ONLP_LOCKED_API_NAME(_name)(_v1, _v2);                \
+        ONLP_API_T2(_name, _rv);                                        \
         ONLP_API_UNLOCK();                                              \
-        ONLP_API_T2(_name);                                             \
         return _rv;                                                     \
     }
 
@@ -132,11 +222,14 @@ void onlp_api_unlock(void);
     int _name (_t1 _v1, _t2 _v2, _t3 _v3)                               \
     {                                                                   \
         ONLP_API_T0(_name);                                             \
-        ONLP_API_LOCK(#_name);                                          \
+        if(ONLP_API_LOCK(#_name) < 0) {                                 \
+            return ONLP_STATUS_E_BUSY;                                  \
+        }                                                               \
         ONLP_API_T1(_name);                                             \
-        int _rv = ONLP_LOCKED_API_NAME(_name) (_v1, _v2, _v3);          \
+        ONLP_API_INIT();                                                \
+        int _rv = ONLP_LOCKED_API_NAME(_name)(_v1, _v2, _v3);           \
+        ONLP_API_T2(_name, _rv);                                        \
         ONLP_API_UNLOCK();                                              \
-        ONLP_API_T2(_name);                                             \
         return _rv;                                                     \
     }
 
@@ -144,11 +237,14 @@ void onlp_api_unlock(void);
     int _name (_t1 _v1, _t2 _v2, _t3 _v3, _t4 _v4)                      \
     {                                                                   \
         ONLP_API_T0(_name);                                             \
-        ONLP_API_LOCK(#_name);                                          \
+        if(ONLP_API_LOCK(#_name) < 0) {                                 \
+            return ONLP_STATUS_E_BUSY;                                  \
+        }                                                               \
         ONLP_API_T1(_name);                                             \
-        int _rv = ONLP_LOCKED_API_NAME(_name) (_v1, _v2, _v3, _v4);     \
+        ONLP_API_INIT();                                                \
+        int _rv = ONLP_LOCKED_API_NAME(_name)(_v1, _v2, _v3, _v4);      \
+        ONLP_API_T2(_name, _rv);                                        \
         ONLP_API_UNLOCK();                                              \
-        ONLP_API_T2(_name);                                             \
         return _rv;                                                     \
     }
 
@@ -156,78 +252,126 @@ void onlp_api_unlock(void);
     int _name (_t1 _v1, _t2 _v2, _t3 _v3, _t4 _v4, _t5 _v5)             \
     {                                                                   \
         ONLP_API_T0(_name);                                             \
-        ONLP_API_LOCK(#_name);                                          \
+        if(ONLP_API_LOCK(#_name) < 0) {                                 \
+            return ONLP_STATUS_E_BUSY;                                  \
+        }                                                               \
+        ONLP_API_T1(_name);                                             \
+        ONLP_API_INIT();                                                \
+        int _rv = ONLP_LOCKED_API_NAME(_name)(_v1, _v2, _v3, _v4, _v5); \
+        ONLP_API_T2(_name, _rv);                                        \
+        ONLP_API_UNLOCK();                                              \
+        return _rv;                                                     \
+    }
+
+#define ONLP_LOCKED_API6(_name, _t1, _v1, _t2, _v2, _t3, _v3, _t4, _v4, _t5, _v5, _t6, _v6) \
+    int _name (_t1 _v1, _t2 _v2, _t3 _v3, _t4 _v4, _t5 _v5, _t6 _v6)    \
+    {                                                                   \
+        ONLP_API_T0(_name);                                             \
+        if(ONLP_API_LOCK(#_name) < 0) {                                 \
+            return ONLP_STATUS_E_BUSY;                                  \
+        }                                                               \
         ONLP_API_T1(_name);                                             \
-        int _rv = ONLP_LOCKED_API_NAME(_name) (_v1, _v2, _v3, _v4, _v5); \
+        ONLP_API_INIT();                                                \
+        int _rv = ONLP_LOCKED_API_NAME(_name)(_v1, _v2, _v3, _v4, _v5, _v6); \
+        ONLP_API_T2(_name, _rv);                                        \
         ONLP_API_UNLOCK();                                              \
-        ONLP_API_T2(_name);                                             \
         return _rv;                                                     \
     }
 
-#define ONLP_LOCKED_VAPI0(_name)                                 \
-    void _name (void)                                            \
-    {                                                            \
-        ONLP_API_T0(_name);                                      \
-        ONLP_API_LOCK(#_name);                                   \
-        ONLP_API_T1(_name);                                      \
-        ONLP_LOCKED_API_NAME(_name)();                           \
-        ONLP_API_UNLOCK();                                       \
-        ONLP_API_T2(_name);                                      \
+#define ONLP_LOCKED_VAPI0(_name)                                        \
+    void _name (void)                                                   \
+    {                                                                   \
+        ONLP_API_T0(_name);                                             \
+        if(ONLP_API_LOCK(#_name) < 0) {                                 \
+            AIM_LOG_WARN("%s: the API lock is busy. The call was dropped.", \
+                         #_name);                                       \
+            return;                                                     \
+        }                                                               \
+        ONLP_API_T1(_name);                                             \
+        ONLP_API_INIT();                                                \
+        ONLP_LOCKED_API_NAME(_name)();                                  \
+        ONLP_API_T2(_name, 0);                                          \
+        ONLP_API_UNLOCK();                                              \
     }
 
-#define ONLP_LOCKED_VAPI1(_name, _t, _v)                  \
-    void _name (_t _v)                                    \
-    {                                                     \
-        ONLP_API_T0(_name);                               \
-        ONLP_API_LOCK(#_name);                            \
-        ONLP_API_T1(_name);                               \
-        ONLP_LOCKED_API_NAME(_name)(_v);                  \
-        ONLP_API_UNLOCK();                                \
-        ONLP_API_T2(_name);                               \
+#define ONLP_LOCKED_VAPI1(_name, _t, _v)                                \
+    void _name (_t _v)                                                  \
+    {                                                                   \
+        ONLP_API_T0(_name);                                             \
+        if(ONLP_API_LOCK(#_name) < 0) {                                 \
+            AIM_LOG_WARN("%s: the API lock is busy. The call was dropped.", \
+                         #_name);                                       \
+            return;                                                     \
+        }                                                               \
+        ONLP_API_T1(_name);                                             \
+        ONLP_API_INIT();                                                \
+        ONLP_LOCKED_API_NAME(_name)(_v);                                \
+        ONLP_API_T2(_name, 0);                                          \
+        ONLP_API_UNLOCK();                                              \
     }
 
-#define ONLP_LOCKED_VAPI2(_name, _t1, _v1, _t2, _v2)              \
-    void _name (_t1 _v1, _t2 _v2)                                 \
-    {                                                             \
-        ONLP_API_T0(_name);                                       \
-        ONLP_API_LOCK(#_name);                                    \
-        ONLP_API_T1(_name);                                       \
-        ONLP_LOCKED_API_NAME(_name) (_v1, _v2);                   \
-        ONLP_API_UNLOCK();                                        \
-        ONLP_API_T2(_name);                                       \
+#define ONLP_LOCKED_VAPI2(_name, _t1, _v1, _t2, _v2)                    \
+    void _name (_t1 _v1, _t2 _v2)                                       \
+    {                                                                   \
+        ONLP_API_T0(_name);                                             \
+        if(ONLP_API_LOCK(#_name) < 0) {                                 \
+            AIM_LOG_WARN("%s: the API lock is busy. The call was dropped.", \
+                         #_name);                                       \
+            return;                                                     \
+        }                                                               \
+        ONLP_API_T1(_name);                                             \
+        ONLP_API_INIT();                                                \
+        ONLP_LOCKED_API_NAME(_name)(_v1, _v2);                          \
+        ONLP_API_T2(_name, 0);                                          \
+        ONLP_API_UNLOCK();                                              \
     }
 
 #define ONLP_LOCKED_VAPI3(_name, _t1, _v1, _t2, _v2, _t3, _v3)          \
     void _name (_t1 _v1, _t2 _v2, _t3 _v3)                              \
     {                                                                   \
         ONLP_API_T0(_name);                                             \
-        ONLP_API_LOCK(#_name);                                          \
+        if(ONLP_API_LOCK(#_name) < 0) {                                 \
+            AIM_LOG_WARN("%s: the API lock is busy. The call was dropped.", \
+                         #_name);                                       \
+            return;                                                     \
+        }                                                               \
         ONLP_API_T1(_name);                                             \
-        ONLP_LOCKED_API_NAME(_name) (_v1, _v2, _v3);                    \
+        ONLP_API_INIT();                                                \
+        ONLP_LOCKED_API_NAME(_name)(_v1, _v2, _v3);                     \
+        ONLP_API_T2(_name, 0);                                          \
         ONLP_API_UNLOCK();                                              \
-        ONLP_API_T2_(name);                                             \
     }
 
 #define ONLP_LOCKED_VAPI4(_name, _t1, _v1, _t2, _v2, _t3, _v3, _t4, _v4) \
     void _name (_t1 _v1, _t2 _v2, _t3 _v3, _t4 _v4)                     \
     {                                                                   \
         ONLP_API_T0(_name);                                             \
-        ONLP_API_LOCK(#_name);                                          \
+        if(ONLP_API_LOCK(#_name) < 0) {                                 \
+            AIM_LOG_WARN("%s: the API lock is busy. The call was dropped.", \
+                         #_name);                                       \
+            return;                                                     \
+        }                                                               \
         ONLP_API_T1(_name);                                             \
-        ONLP_LOCKED_API_NAME(_name) (_v1, _v2, _v3, _v4);               \
+        ONLP_API_INIT();                                                \
+        ONLP_LOCKED_API_NAME(_name)(_v1, _v2, _v3, _v4);                \
+        ONLP_API_T2(_name, 0);                                          \
         ONLP_API_UNLOCK();                                              \
-        ONLP_API_T2(_name);                                             \
     }
 
 #define ONLP_LOCKED_VAPI5(_name, _t1, _v1, _t2, _v2, _t3, _v3, _t4, _v4, _t5, _v5) \
     void _name (_t1 _v1, _t2 _v2, _t3 _v3, _t4 _v4, _t5 _v5)            \
     {                                                                   \
         ONLP_API_T0(_name);                                             \
-        ONLP_API_LOCK(#_name);                                          \
+        if(ONLP_API_LOCK(#_name) < 0) {                                 \
+            AIM_LOG_WARN("%s: the API lock is busy. The call was dropped.", \
+                         #_name);                                       \
+            return;                                                     \
+        }                                                               \
         ONLP_API_T1(_name);                                             \
-        ONLP_LOCKED_API_NAME(_name) (_v1, _v2, _v3, _v4, _v5);          \
+        ONLP_API_INIT();                                                \
+        ONLP_LOCKED_API_NAME(_name)(_v1, _v2, _v3, _v4, _v5);           \
+        ONLP_API_T2(_name, 0);                                          \
         ONLP_API_UNLOCK();                                              \
-        ONLP_API_T2(_name);                                             \
     }
 
 
@@ -27,13 +27,54 @@
 #include <unistd.h>
 #include <onlp/sys.h>
 #include <onlp/sfp.h>
+#include <onlp/export.h>
+#include <onlp/server.h>
+#include <onlp/stats.h>
 #include <sff/sff.h>
 #include <sff/sff_db.h>
 #include <AIM/aim_log_handler.h>
 #include <syslog.h>
 #include <onlp/platformi/sysi.h>
+#include "onlp_int.h"
 
-static void platform_manager_daemon__(const char* pidfile, char** argv);
+static void platform_manager_daemon__(const char* pidfile, int serve, char** argv);
+
+/**
+ * SFP database entries for the installed modules.
+ */
+static void
+show_inventory_database__(aim_pvs_t* pvs, onlp_sfp_bitmap_t* bitmap)
+{
+    int port;
+
+    AIM_BITMAP_ITER(bitmap, port) {
+        int rv;
+        uint8_t* data;
+        sff_eeprom_t sff;
+
+        rv = onlp_sfp_is_present(port);
+        if(rv == 0) {
+            continue;
+        }
+        if(rv > 0) {
+            rv = onlp_sfp_eeprom_read(port, &data);
+        }
+        if(rv < 0) {
+            aim_printf(pvs, "%4d  Error %{onlp_status}\n", port, rv);
+            continue;
+        }
+
+        sff_eeprom_parse(&sff, data);
+        aim_free(data);
+
+        if(!sff.identified) {
+            /* Present but unidentified. */
+            aim_printf(pvs, "%13d  UNK\n", port);
+            continue;
+        }
+        sff_db_entry_struct(&sff, &aim_pvs_stdout);
+    }
+}
 
 /**
  * Human-readable SFP inventory.
@@ -42,87 +83,80 @@ static void platform_manager_daemon__(const char* pidfile, char** argv);
 static void
 show_inventory__(aim_pvs_t* pvs, int database)
 {
-    int port;
+    int i, count;
     onlp_sfp_bitmap_t bitmap;
+    onlp_sfp_inventory_t records[256];
 
     onlp_sfp_bitmap_t_init(&bitmap);
     onlp_sfp_bitmap_get(&bitmap);
 
     if(AIM_BITMAP_COUNT(&bitmap) == 0) {
         aim_printf(pvs, "No SFPs on this platform.\n");
+        return;
     }
-    else {
-        if(!database) {
-            aim_printf(pvs, "Port  Type            Media   Status  Len    Vendor            Model             S/N             \n");
-            aim_printf(pvs, "----  --------------  ------  ------  -----  ----------------  ----------------  ----------------\n");
-        }
-
-        AIM_BITMAP_ITER(&bitmap, port) {
-            int rv;
-            uint8_t* data;
 
-            rv = onlp_sfp_is_present(port);
-
-            if(rv == 0) {
-                if(!database) {
-                    aim_printf(pvs, "%4d  NONE\n", port);
-                }
-                continue;
-            }
-
-            if(rv < 0) {
-                aim_printf(pvs, "%4d  Error %{onlp_status}\n", port, rv);
-                continue;
-            }
+    if(database) {
+        show_inventory_database__(pvs, &bitmap);
+        return;
+    }
 
-            rv = onlp_sfp_eeprom_read(port, &data);
+    count = onlp_sfp_inventory_get(records, AIM_ARRAYSIZE(records));
+    if(count < 0) {
+        aim_printf(pvs, "Error %{onlp_status}\n", count);
+        return;
+    }
 
-            if(rv < 0) {
-                aim_printf(pvs, "%4d  Error %{onlp_status}\n", port, rv);
-                continue;
-            }
+    aim_printf(pvs, "Port  Type            Media   Status  Len    Vendor            Model             S/N             \n");
+    aim_printf(pvs, "----  --------------  ------  ------  -----  ----------------  ----------------  ----------------\n");
 
-            sff_eeprom_t sff;
-            char status_str[32] = {0};
+    for(i = 0; i < count; i++) {
+        onlp_sfp_inventory_t* r = records + i;
+        char status_str[32] = {0};
+        char length_str[16] = {0};
 
-            sff_eeprom_parse(&sff, data);
+        if(!r->present) {
+            aim_printf(pvs, "%4d  NONE\n", r->port);
+            continue;
+        }
 
-            if(!sff.identified) {
-                /* Present but unidentified. */
-                aim_printf(pvs, "%13d  UNK\n", port);
-                continue;
-            }
+        if(r->status < 0) {
+            aim_printf(pvs, "%4d  Error %{onlp_status}\n", r->port, r->status);
+            continue;
+        }
 
-            if(database) {
-                sff_db_entry_struct(&sff, &aim_pvs_stdout);
-                continue;
-            }
+        if(!r->identified) {
+            /* Present but unidentified. */
+            aim_printf(pvs, "%13d  UNK\n", r->port);
+            continue;
+        }
 
-            uint32_t status = 0;
-            char* cp = status_str;
-            onlp_sfp_control_flags_get(port, &status);
-            if(status & ONLP_SFP_CONTROL_FLAG_RX_LOS) {
-                *cp++ = 'R';
-            }
-            if(status & ONLP_SFP_CONTROL_FLAG_TX_FAULT) {
-                *cp++ = 'T';
-            }
-            if(status & ONLP_SFP_CONTROL_FLAG_TX_DISABLE) {
-                *cp++ = 'X';
-            }
-            if(status & ONLP_SFP_CONTROL_FLAG_LP_MODE) {
-                *cp++ = 'L';
-            }
-            aim_printf(pvs, "%4d  %-14s  %-6s  %-6.6s  %-5.5s  %-16.16s  %-16.16s  %16.16s\n",
-                       port,
-                       sff.info.module_type_name,
-                       sff.info.media_type_name,
-                       status_str,
-                       sff.info.length_desc,
-                       sff.info.vendor,
-                       sff.info.model,
-                       sff.info.serial);
+        uint32_t status = 0;
+        char* cp = status_str;
+        onlp_sfp_control_flags_get(r->port, &status);
+        if(status & ONLP_SFP_CONTROL_FLAG_RX_LOS) {
+            *cp++ = 'R';
+        }
+        if(status & ONLP_SFP_CONTROL_FLAG_TX_FAULT) {
+            *cp++ = 'T';
+        }
+        if(status & ONLP_SFP_CONTROL_FLAG_TX_DISABLE) {
+            *cp++ = 'X';
+        }
+        if(status & ONLP_SFP_CONTROL_FLAG_LP_MODE) {
+            *cp++ = 'L';
+        }
+        if(r->length >= 0) {
+            snprintf(length_str, sizeof(length_str), "%dm", r->length);
         }
+        aim_printf(pvs, "%4d  %-14s  %-6s  %-6.6s  %-5.5s  %-16.16s  %-16.16s  %16.16s\n",
+                   r->port,
+                   sff_module_type_desc(r->module_type),
+                   sff_media_type_desc(r->media_type),
+                   status_str,
+                   length_str,
+                   r->vendor,
+                   r->model,
+                   r->serial);
     }
 }
 
@@ -180,11 +214,16 @@ onlpdump_main(int argc, char* argv[])
     int S = 0;
     int l = 0;
     int M = 0;
+    int R = 0;
     int b = 0;
     char* pidfile = NULL;
     const char* O = NULL;
     const char* t = NULL;
     const char* J = NULL;
+    const char* E = NULL;
+    const char* Q = NULL;
+    int A = 0;
+    int Z = 0;
 
     /**
      * debug trap
@@ -192,6 +231,7 @@ onlpdump_main(int argc, char* argv[])
     if(argc > 1 && (!strcmp(argv[1], "debug") || !strcmp(argv[1], "debugi"))) {
         if(!strcmp(argv[1], "debug")) {
             onlp_init();
+            onlp_subsystems_init();
             return onlp_sys_debug(&aim_pvs_stdout, argc-2, argv+2);
         }
         else {
@@ -199,7 +239,7 @@ onlpdump_main(int argc, char* argv[])
         }
     }
 
-    while( (c = getopt(argc, argv, "srehdojmyM:ipxlSt:O:bJ:")) != -1) {
+    while( (c = getopt(argc, argv, "srehdojmyM:RipxlSt:O:bJ:E:Q:AZ")) != -1) {
         switch(c)
             {
             case 's': show=1; break;
@@ -212,6 +252,7 @@ onlpdump_main(int argc, char* argv[])
             case 'x': x=1; break;
             case 'm': m=1; break;
             case 'M': M=1; pidfile = optarg; break;
+            case 'R': R=1; break;
             case 'i': i=1; break;
             case 'p': p=1; show=-1; break;
             case 't': t = optarg; break;
@@ -220,6 +261,10 @@ onlpdump_main(int argc, char* argv[])
             case 'l': l=1; break;
             case 'b': b=1; break;
             case 'J': J = optarg; break;
+            case 'E': E = optarg; break;
+            case 'Q': Q = optarg; break;
+            case 'A': A=1; break;
+            case 'Z': Z=1; break;
             case 'y': show=1; showflags |= ONLP_OID_SHOW_F_YAML; break;
             default: help=1; rv = 1; break;
             }
@@ -237,6 +282,7 @@ onlpdump_main(int argc, char* argv[])
         printf("  -j   Dump ONIE data in JSON format.\n");
         printf("  -m   Run platform manager.\n");
         printf("  -M   Run as platform manager daemon.\n");
+        printf("  -R   Serve cached platform state from the daemon (see onlp/server.h). Use with -M.\n");
         printf("  -i   Iterate OIDs.\n");
         printf("  -p   Show SFP presence.\n");
         printf("  -t   <file>  Decode TlvInfo data.\n");
@@ -245,6 +291,10 @@ onlpdump_main(int argc, char* argv[])
         printf("  -b   Decode SFP Inventory into SFF database entries.\n");
         printf("  -l   API Lock test.\n");
         printf("  -J   Decode ONIE JSON data.\n");
+        printf("  -E   <json|cbor> Export the platform (or the -O <oid> subtree) as JSON Lines or CBOR.\n");
+        printf("  -A   Show API lock and call statistics. Add -e for latency histograms.\n");
+        printf("  -Z   Clear API lock and call statistics.\n");
+        printf("  -Q   <request> Query the platform manager daemon (see onlp/server.h).\n");
         return rv;
     }
 
@@ -263,6 +313,26 @@ onlpdump_main(int argc, char* argv[])
         }
     }
 
+    if(Q) {
+        /* Answered by the daemon. No local initialization is required. */
+        return (onlp_server_request(NULL, Q, STDOUT_FILENO) < 0) ? 1 : 0;
+    }
+
+    if(A || Z) {
+        /* The statistics are in shared memory. No initialization is required. */
+        if(Z) {
+            onlp_api_stats_clear();
+            onlp_api_lock_stats_clear();
+        }
+        if(A) {
+            onlp_api_lock_show(&aim_pvs_stdout);
+            onlp_api_stats_show(&aim_pvs_stdout,
+                                (showflags & ONLP_OID_SHOW_F_EXTENDED) ?
+                                ONLP_API_STATS_SHOW_F_HISTOGRAMS : 0);
+        }
+        return 0;
+    }
+
     if(t) {
         int rv;
         onlp_onie_info_t onie;
@@ -281,7 +351,7 @@ onlpdump_main(int argc, char* argv[])
     onlp_init();
 
     if(M) {
-        platform_manager_daemon__(pidfile, argv);
+        platform_manager_daemon__(pidfile, R, argv);
         exit(0);
     }
 
@@ -296,6 +366,33 @@ onlpdump_main(int argc, char* argv[])
         }
     }
 
+    if(E) {
+        uint32_t flags = ONLP_EXPORT_F_RECURSE | ONLP_EXPORT_F_SFP_DOM;
+        if(!strcmp(E, "cbor")) {
+            flags |= ONLP_EXPORT_F_CBOR;
+        }
+        else if(strcmp(E, "json")) {
+            fprintf(stderr, "unknown export format '%s'\n", E);
+            return 1;
+        }
+
+        if(O) {
+            int oid;
+            onlp_export_t* e;
+            if(sscanf(O, "0x%x", &oid) != 1) {
+                fprintf(stderr, "invalid oid '%s'\n", O);
+                return 1;
+            }
+            e = onlp_export_create(STDOUT_FILENO, flags);
+            onlp_export_oid(e, oid);
+            rv = onlp_export_destroy(e);
+        }
+        else {
+            rv = onlp_export_platform(STDOUT_FILENO, flags);
+        }
+        return (rv < 0) ? 1 : 0;
+    }
+
     if(S) {
         show_inventory__(&aim_pvs_stdout, b);
         return 0;
@@ -396,7 +493,13 @@ sighandler__(int signal)
 }
 
 static void
-platform_manager_daemon__(const char* pidfile, char** argv)
+sighup__(int signal)
+{
+    onlp_config_reload();
+}
+
+static void
+platform_manager_daemon__(const char* pidfile, int serve, char** argv)
 {
     aim_pvs_t* aim_pvs_syslog = NULL;
     aim_daemon_restart_config_t rconfig;
@@ -434,11 +537,20 @@ platform_manager_daemon__(const char* pidfile, char** argv)
     /** Signal handler for terminating the platform manager */
     signal(SIGTERM, sighandler__);
 
+    /** Reload the configuration (and platform overrides) on SIGHUP */
+    signal(SIGHUP, sighup__);
+
+    /** Serve cached platform state to clients. Failures are logged but not fatal. */
+    if(serve) {
+        onlp_server_start(NULL);
+    }
+
     /** Start and block in platform manager. */
     onlp_sys_platform_manage_start(1);
 
     /** Terminated via signal. Cleanup and exit. */
     onlp_sys_platform_manage_stop(1);
+    onlp_server_stop();
 
     aim_log_handler_basic_denit_all();
     exit(0);
@@ -447,7 +559,7 @@ platform_manager_daemon__(const char* pidfile, char** argv)
 
 #else
 static void
-platform_manager_daemon__(const char* pidfile, char** argv)
+platform_manager_daemon__(const char* pidfile, int serve, char** argv)
 {
     fprintf(stderr, "Daemon mode not supported in this build.\n");
     exit(1);
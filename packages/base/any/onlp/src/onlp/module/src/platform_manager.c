@@ -21,20 +21,36 @@
  *
  * This file implements the Platform Management infrastructure.
  *
+ * The management thread owns the timer wheel. When task
+ * deadlines expire the thread takes the API lock and queues
+ * the tasks on the workers for their I/O domains. The workers
+ * run their tasks under that lock without taking it themselves,
+ * so a slow PMBus transaction does not hold up CPLD or sysfs
+ * tasks, while every other API caller in any process is still
+ * excluded. The lock is released once the batch has completed.
+ * A task is never queued twice; a deadline which expires while
+ * the task is still pending is dropped and counted.
+ *
  ***********************************************************/
 #include <onlp/sys.h>
 #include <onlp/psu.h>
 #include <onlp/fan.h>
 #include <onlp/platformi/sysi.h>
 #include <onlplib/mmap.h>
+#include <onlplib/shlocks.h>
 #include <timer_wheel/timer_wheel.h>
 #include <OS/os_time.h>
 #include <OS/os_thread.h>
 #include <AIM/aim.h>
 #include "onlp_log.h"
 #include "onlp_int.h"
+#include "onlp_locks.h"
 #include <sys/eventfd.h>
+#include <signal.h>
+#include <sched.h>
+#include <unistd.h>
 #include <errno.h>
+#include <limits.h>
 #include <pthread.h>
 
 /**
@@ -56,21 +72,117 @@ typedef struct management_entry_s {
     /** The number of times this has been called. */
     int calls;
 
+    /** The task identifier */
+    onlp_sys_pm_task_t task;
+
+    /** The I/O domain this task runs in */
+    onlp_sys_pm_domain_t domain;
+
+    /** Non-zero while queued or running. Protected by the domain lock. */
+    int pending;
+
+    /** Next entry on the domain queue */
+    struct management_entry_s* next;
+
 } management_entry_t;
 
+/**
+ * Platform management domain worker.
+ */
+typedef struct management_domain_s {
+    pthread_t thread;
+
+    /** Protects everything below */
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+
+    /** Non-zero while the worker should run */
+    int running;
+
+    /** FIFO of pending entries */
+    management_entry_t* head;
+    management_entry_t* tail;
+
+    onlp_sys_pm_domain_stats_t stats;
+
+} management_domain_t;
+
 /**
  * Platform management control structure.
  */
 typedef struct management_ctrl_s {
     timer_wheel_t* tw;
 
+    /** Protects the timer wheel */
+    pthread_mutex_t lock;
+
     int eventfd;
     pthread_t thread;
 
+    /** Non-zero while the domain workers are running */
+    int workers;
+    management_domain_t domains[ONLP_SYS_PM_DOMAIN_COUNT];
+
+    /** Protects outstanding */
+    pthread_mutex_t batch_lock;
+    pthread_cond_t batch_done;
+    /** Tasks queued or running in the current batch */
+    int outstanding;
+
 } management_ctrl_t;
 
 /* This is the global control state */
-static management_ctrl_t control__ = { NULL };
+static management_ctrl_t control__ = { NULL, PTHREAD_MUTEX_INITIALIZER };
+
+static const char* domain_names__[ONLP_SYS_PM_DOMAIN_COUNT] = {
+    "sysfs", "i2c", "cpld",
+};
+
+/**
+ * PSU power samples, collected by the PSU notification task.
+ *
+ * The table lives in a SysV shared memory segment so the statistics
+ * can be read from any process. The sampling process is the only
+ * writer. Readers retry while the sequence number is odd or changes
+ * under them.
+ */
+typedef struct psu_power_s {
+    onlp_oid_t id;
+
+    /** Time of the previous sample, or 0 after a gap */
+    uint64_t last;
+
+    /** Sample ring */
+    int mpin[ONLP_CONFIG_PSU_POWER_WINDOW];
+    int mpout[ONLP_CONFIG_PSU_POWER_WINDOW];
+    uint32_t head;
+    uint32_t samples;
+
+    /** Energy in microjoules */
+    uint64_t ujin;
+    uint64_t ujout;
+
+} psu_power_t;
+
+typedef struct psu_power_table_s {
+    uint32_t magic;
+    uint32_t window;
+    uint32_t size;
+    /** Odd while the sampling process is updating the table */
+    uint32_t seq;
+    /** The sampling process, or 0 */
+    pid_t sampler;
+    int count;
+    psu_power_t psus[ONLP_CONFIG_PSU_POWER_MAX];
+} psu_power_table_t;
+
+#define PSU_POWER_MAGIC 0x90E290E2
+
+static struct {
+    /** Serializes writers in the sampling process */
+    pthread_mutex_t lock;
+    psu_power_table_t* table;
+} power__ = { PTHREAD_MUTEX_INITIALIZER };
 
 
 /*
@@ -87,28 +199,61 @@ static int platform_psus_notify__(void);
 static int platform_fans_notify__(void);
 
 
+/*
+ * The platform's own management callbacks call the raw platform
+ * interfaces, which assume they are serialized by the API lock.
+ * This is a no-op on the domain workers, which already run under
+ * the management thread's lock.
+ */
+#define PLATFORM_MANAGE_LOCKED(_fn)                     \
+    static int                                          \
+    _fn##_locked__(void)                                \
+    {                                                   \
+        int rv;                                         \
+        if( (rv = ONLP_API_LOCK(#_fn)) < 0) {           \
+            return rv;                                  \
+        }                                               \
+        rv = _fn();                                     \
+        ONLP_API_UNLOCK();                              \
+        return rv;                                      \
+    }
+
+PLATFORM_MANAGE_LOCKED(onlp_sysi_platform_manage_init)
+PLATFORM_MANAGE_LOCKED(onlp_sysi_platform_manage_fans)
+PLATFORM_MANAGE_LOCKED(onlp_sysi_platform_manage_leds)
+
+
 
 /*
  * First Version : Static callback rates.
  * TODO: Allow individual platform callbacks to reregister
  * themselves at whatever rate they want.
+ *
+ * The default domains can be changed by the platform
+ * with onlp_sysi_platform_manage_domain_get().
  */
 static management_entry_t management_entries[] =
     {
         {
             { },
-            onlp_sysi_platform_manage_fans,
+            onlp_sysi_platform_manage_fans_locked__,
             /* Every 10 seconds */
             10*1000*1000,
             "Fans",
+            0,
+            ONLP_SYS_PM_TASK_FANS,
+            ONLP_SYS_PM_DOMAIN_CPLD,
         },
         {
             { },
-            onlp_sysi_platform_manage_leds,
+            onlp_sysi_platform_manage_leds_locked__,
             /* Every 2 seconds */
             2*1000*1000,
             "LEDs",
-
+            0,
+            ONLP_SYS_PM_TASK_LEDS,
+            /* Shares platform state with the fan management task */
+            ONLP_SYS_PM_DOMAIN_CPLD,
         },
         {
             { },
@@ -116,6 +261,9 @@ static management_entry_t management_entries[] =
             /* Every second */
             1*1000*1000,
             "PSUs",
+            0,
+            ONLP_SYS_PM_TASK_PSU_NOTIFY,
+            ONLP_SYS_PM_DOMAIN_I2C,
         },
         {
             { },
@@ -123,7 +271,22 @@ static management_entry_t management_entries[] =
             /* Every second */
             1*1000*1000,
             "Fans",
-        }
+            0,
+            ONLP_SYS_PM_TASK_FAN_NOTIFY,
+            ONLP_SYS_PM_DOMAIN_CPLD,
+        },
+#if ONLP_CONFIG_INCLUDE_LED_SOFT_BLINK == 1
+        {
+            { },
+            onlp_led_blink_manage,
+            /* Twice per blink period */
+            ONLP_CONFIG_LED_BLINK_PERIOD_MS*1000/2,
+            "LED Blink",
+            0,
+            ONLP_SYS_PM_TASK_LED_BLINK,
+            ONLP_SYS_PM_DOMAIN_CPLD,
+        },
+#endif
     };
 
 
@@ -134,32 +297,238 @@ onlp_sys_platform_manage_init(void)
         int i;
         uint64_t now = os_time_monotonic();
 
-        onlp_sysi_platform_manage_init();
+        /* Platform management calls the raw platform interfaces. */
+        onlp_subsystems_init();
+        onlp_sysi_platform_manage_init_locked__();
         control__.tw = timer_wheel_create(4, 512, now);
 
+        for(i = 0; i < AIM_ARRAYSIZE(control__.domains); i++) {
+            management_domain_t* d = control__.domains + i;
+            pthread_mutex_init(&d->lock, NULL);
+            pthread_cond_init(&d->cond, NULL);
+        }
+        pthread_mutex_init(&control__.batch_lock, NULL);
+        pthread_cond_init(&control__.batch_done, NULL);
+
         for(i = 0; i < AIM_ARRAYSIZE(management_entries); i++) {
             management_entry_t* e = management_entries+i;
+            int domain = onlp_sysi_platform_manage_domain_get(e->task);
+            if(domain >= 0 && domain < ONLP_SYS_PM_DOMAIN_COUNT) {
+                e->domain = domain;
+            }
             timer_wheel_insert(control__.tw,  &e->twe, now + e->rate);
         }
     }
 }
 
+static void
+management_entry_run__(management_entry_t* e)
+{
+    if(e->manage) {
+        e->manage();
+    }
+    e->calls++;
+}
+
+/*
+ * Account for batch entries which have completed or were discarded.
+ */
+static void
+management_batch_complete__(int count)
+{
+    pthread_mutex_lock(&control__.batch_lock);
+    control__.outstanding -= count;
+    if(control__.outstanding == 0) {
+        pthread_cond_broadcast(&control__.batch_done);
+    }
+    pthread_mutex_unlock(&control__.batch_lock);
+}
+
+/*
+ * Queue an entry on its domain worker.
+ */
+static void
+management_entry_queue__(management_entry_t* e)
+{
+    management_domain_t* d = control__.domains + e->domain;
+
+    pthread_mutex_lock(&d->lock);
+    if(e->pending || !d->running) {
+        d->stats.skipped++;
+    }
+    else {
+        pthread_mutex_lock(&control__.batch_lock);
+        control__.outstanding++;
+        pthread_mutex_unlock(&control__.batch_lock);
+        e->pending = 1;
+        e->next = NULL;
+        if(d->tail) {
+            d->tail->next = e;
+        }
+        else {
+            d->head = e;
+        }
+        d->tail = e;
+        if(++d->stats.depth > d->stats.depth_max) {
+            d->stats.depth_max = d->stats.depth;
+        }
+        pthread_cond_signal(&d->cond);
+    }
+    pthread_mutex_unlock(&d->lock);
+}
+
+static void*
+management_worker__(void* vdomain)
+{
+    management_domain_t* d = (management_domain_t*)vdomain;
+    char name[16];
+
+    snprintf(name, sizeof(name), "onlp.pm.%s",
+             domain_names__[d - control__.domains]);
+    os_thread_name_set(name);
+
+    /* Tasks are only queued while the management thread holds the API lock. */
+    onlp_api_lock_delegate(1);
+
+    pthread_mutex_lock(&d->lock);
+    for(;;) {
+        management_entry_t* e;
+
+        while(d->running && d->head == NULL) {
+            pthread_cond_wait(&d->cond, &d->lock);
+        }
+        if(!d->running) {
+            break;
+        }
+
+        e = d->head;
+        d->head = e->next;
+        if(d->head == NULL) {
+            d->tail = NULL;
+        }
+
+        pthread_mutex_unlock(&d->lock);
+        management_entry_run__(e);
+        pthread_mutex_lock(&d->lock);
+
+        e->pending = 0;
+        d->stats.depth--;
+        d->stats.runs++;
+        management_batch_complete__(1);
+    }
+
+    /* Discard anything still queued. */
+    while(d->head) {
+        d->head->pending = 0;
+        d->head = d->head->next;
+        management_batch_complete__(1);
+    }
+    d->tail = NULL;
+    d->stats.depth = 0;
+    pthread_mutex_unlock(&d->lock);
+    return NULL;
+}
+
+static void
+management_workers_stop__(void)
+{
+    int i;
+
+    for(i = 0; i < AIM_ARRAYSIZE(control__.domains); i++) {
+        management_domain_t* d = control__.domains + i;
+        pthread_mutex_lock(&d->lock);
+        d->running = 0;
+        pthread_cond_signal(&d->cond);
+        pthread_mutex_unlock(&d->lock);
+    }
+
+    for(i = 0; i < control__.workers; i++) {
+        pthread_join(control__.domains[i].thread, NULL);
+    }
+    control__.workers = 0;
+}
+
+static int
+management_workers_start__(void)
+{
+    int i;
+
+    for(i = 0; i < AIM_ARRAYSIZE(control__.domains); i++) {
+        management_domain_t* d = control__.domains + i;
+        d->running = 1;
+        if(pthread_create(&d->thread, NULL, management_worker__, d) != 0) {
+            AIM_LOG_ERROR("pthread create failed for domain %s.",
+                          domain_names__[i]);
+            d->running = 0;
+            management_workers_stop__();
+            return -1;
+        }
+        control__.workers++;
+    }
+    return 0;
+}
+
 
 void
 onlp_sys_platform_manage_now(void)
 {
+    int batch = 0;
     management_entry_t* e;
 
     onlp_sys_platform_manage_init();
 
+    pthread_mutex_lock(&control__.lock);
     while( (e = (management_entry_t*) timer_wheel_next(control__.tw,
                                                        os_time_monotonic())) ) {
-        if(e->manage) {
-            e->manage();
+        if(control__.workers) {
+            if(!batch) {
+                /* Held for the workers until the whole batch has run. */
+                if(ONLP_API_LOCK("onlp_sys_platform_manage_now") < 0) {
+                    timer_wheel_insert(control__.tw, &e->twe, os_time_monotonic());
+                    break;
+                }
+                batch = 1;
+            }
+            management_entry_queue__(e);
+        }
+        else {
+            management_entry_run__(e);
         }
-        e->calls++;
         timer_wheel_insert(control__.tw, &e->twe, os_time_monotonic() + e->rate);
     }
+    pthread_mutex_unlock(&control__.lock);
+
+    if(batch) {
+        pthread_mutex_lock(&control__.batch_lock);
+        while(control__.outstanding) {
+            pthread_cond_wait(&control__.batch_done, &control__.batch_lock);
+        }
+        pthread_mutex_unlock(&control__.batch_lock);
+        ONLP_API_UNLOCK();
+    }
+}
+
+int
+onlp_sys_platform_manage_domain_stats_get(onlp_sys_pm_domain_t domain,
+                                          onlp_sys_pm_domain_stats_t* stats)
+{
+    management_domain_t* d;
+
+    if(domain < 0 || domain >= ONLP_SYS_PM_DOMAIN_COUNT || stats == NULL) {
+        return ONLP_STATUS_E_PARAM;
+    }
+
+    if(control__.tw == NULL) {
+        /* Nothing has been scheduled yet. */
+        memset(stats, 0, sizeof(*stats));
+        return ONLP_STATUS_OK;
+    }
+
+    d = control__.domains + domain;
+    pthread_mutex_lock(&d->lock);
+    *stats = d->stats;
+    pthread_mutex_unlock(&d->lock);
+    return ONLP_STATUS_OK;
 }
 
 static void*
@@ -186,6 +555,7 @@ onlp_sys_platform_manage_thread__(void* vctrl)
          * Ask the timer wheel if there is an expiration in the next 2 seconds.
          */
         now = os_time_monotonic();
+        pthread_mutex_lock(&control__.lock);
         twe = timer_wheel_peek(ctrl->tw, now + 20000000);
 
         if(twe == NULL) {
@@ -205,11 +575,14 @@ onlp_sys_platform_manage_thread__(void* vctrl)
                 tv.tv_usec = 0;
             }
         }
+        pthread_mutex_unlock(&control__.lock);
 
         int rv = select(ctrl->eventfd+1, &fds, NULL, NULL, &tv);
         if(rv == 1 && FD_ISSET(ctrl->eventfd, &fds)) {
             /* We've been asked to terminate. */
             AIM_LOG_MSG("Terminating.");
+            management_workers_stop__();
+            onlp_led_blink_engine_set(0);
             /* Also signifies that we have exit */
             close(ctrl->eventfd);
             ctrl->eventfd = -1;
@@ -243,14 +616,23 @@ onlp_sys_platform_manage_start(int block)
         return -1;
     }
 
+    if(management_workers_start__() < 0) {
+        close(control__.eventfd);
+        control__.eventfd = -1;
+        return -1;
+    }
+
     if( (pthread_create(&control__.thread, NULL, onlp_sys_platform_manage_thread__,
                         &control__)) != 0) {
         AIM_LOG_ERROR("pthread create failed.");
+        management_workers_stop__();
         close(control__.eventfd);
         control__.eventfd = -1;
         return -1;
     }
 
+    onlp_led_blink_engine_set(1);
+
     if(block) {
         onlp_sys_platform_manage_join();
     }
@@ -286,29 +668,228 @@ onlp_sys_platform_manage_join(void)
 }
 
 
+static psu_power_table_t*
+psu_power_table__(void)
+{
+    psu_power_table_t* t = NULL;
+    int rv;
+
+    pthread_mutex_lock(&power__.lock);
+    if(power__.table == NULL) {
+        rv = onlp_shmem_create(ONLP_CONFIG_PSU_POWER_SHM_KEY, sizeof(*t), (void**)&t);
+        if(rv < 0 || (t->magic == PSU_POWER_MAGIC &&
+                      (t->window != ONLP_CONFIG_PSU_POWER_WINDOW ||
+                       t->size != ONLP_CONFIG_PSU_POWER_MAX))) {
+            /* Unavailable, or created by an incompatible build. */
+            AIM_LOG_WARN("The shared PSU power table is not available. Power statistics are local to this process.");
+            t = aim_zmalloc(sizeof(*t));
+        }
+        if(t->magic != PSU_POWER_MAGIC) {
+            t->window = ONLP_CONFIG_PSU_POWER_WINDOW;
+            t->size = ONLP_CONFIG_PSU_POWER_MAX;
+            __atomic_store_n(&t->magic, PSU_POWER_MAGIC, __ATOMIC_RELEASE);
+        }
+        power__.table = t;
+    }
+    pthread_mutex_unlock(&power__.lock);
+    return power__.table;
+}
+
+static void
+psu_power_write_begin__(psu_power_table_t* t)
+{
+    pthread_mutex_lock(&power__.lock);
+    __atomic_add_fetch(&t->seq, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void
+psu_power_write_end__(psu_power_table_t* t)
+{
+    __atomic_add_fetch(&t->seq, 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&power__.lock);
+}
+
+/*
+ * Claim the table for this process and start sampling the given PSUs.
+ */
+static void
+psu_power_start__(onlp_oid_list_t* psus)
+{
+    int i;
+    psu_power_table_t* t = psu_power_table__();
+
+    if(psus->count > t->size) {
+        AIM_LOG_WARN("Power statistics are only collected for the first %d PSUs.",
+                     t->size);
+    }
+
+    psu_power_write_begin__(t);
+    memset(t->psus, 0, sizeof(t->psus));
+    for(i = 0; i < psus->count && i < t->size; i++) {
+        t->psus[i].id = psus->oids[i];
+    }
+    t->count = i;
+    t->sampler = getpid();
+    psu_power_write_end__(t);
+}
+
+static void
+psu_power_sample__(int index, onlp_psu_info_t* pi)
+{
+    uint64_t now = os_time_monotonic();
+    psu_power_table_t* t = power__.table;
+    psu_power_t* p;
+
+    if(t == NULL || index >= t->count || t->sampler != getpid()) {
+        return;
+    }
+    p = t->psus + index;
+
+    psu_power_write_begin__(t);
+    if(pi == NULL || !(pi->status & ONLP_PSU_STATUS_PRESENT) ||
+       !(pi->caps & (ONLP_PSU_CAPS_PIN | ONLP_PSU_CAPS_POUT))) {
+        /* Do not integrate across the gap. */
+        p->last = 0;
+    }
+    else {
+        if(p->last) {
+            /* milliwatts * microseconds / 1000 = microjoules */
+            if(pi->mpin > 0) {
+                p->ujin += (uint64_t)pi->mpin * (now - p->last) / 1000;
+            }
+            if(pi->mpout > 0) {
+                p->ujout += (uint64_t)pi->mpout * (now - p->last) / 1000;
+            }
+        }
+        p->last = now;
+        p->mpin[p->head] = pi->mpin;
+        p->mpout[p->head] = pi->mpout;
+        p->head = (p->head + 1) % ONLP_CONFIG_PSU_POWER_WINDOW;
+        if(p->samples < ONLP_CONFIG_PSU_POWER_WINDOW) {
+            p->samples++;
+        }
+    }
+    psu_power_write_end__(t);
+}
+
+/*
+ * Copy the samples for the given PSU out of the table.
+ */
+static int
+psu_power_read__(psu_power_table_t* t, onlp_oid_t id, psu_power_t* p)
+{
+    int i, tries;
+
+    for(tries = 0; tries < 100; tries++) {
+        int rv = ONLP_STATUS_E_UNSUPPORTED;
+        uint32_t seq = __atomic_load_n(&t->seq, __ATOMIC_ACQUIRE);
+
+        if(seq & 1) {
+            sched_yield();
+            continue;
+        }
+        for(i = 0; i < t->count && i < t->size; i++) {
+            if(t->psus[i].id == id) {
+                memcpy(p, t->psus + i, sizeof(*p));
+                rv = ONLP_STATUS_OK;
+                break;
+            }
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if(__atomic_load_n(&t->seq, __ATOMIC_RELAXED) == seq) {
+            return rv;
+        }
+    }
+    return ONLP_STATUS_E_BUSY;
+}
+
+int
+onlp_psu_power_stats_get(onlp_oid_t id, onlp_psu_power_stats_t* stats)
+{
+    int rv;
+    uint32_t s;
+    int64_t in = 0, out = 0;
+    psu_power_t p;
+    psu_power_table_t* t;
+
+    if(!ONLP_OID_IS_PSU(id) || stats == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+
+    t = psu_power_table__();
+    if(t->sampler == 0 ||
+       (t->sampler != getpid() && kill(t->sampler, 0) < 0 && errno != EPERM)) {
+        /* No platform manager is sampling. */
+        return ONLP_STATUS_E_UNSUPPORTED;
+    }
+    if( (rv = psu_power_read__(t, id, &p)) < 0) {
+        return rv;
+    }
+
+    stats->samples = p.samples;
+    stats->mpin_min = stats->mpout_min = INT_MAX;
+    stats->mpin_max = stats->mpout_max = INT_MIN;
+    for(s = 0; s < p.samples; s++) {
+        if(p.mpin[s] < stats->mpin_min) stats->mpin_min = p.mpin[s];
+        if(p.mpin[s] > stats->mpin_max) stats->mpin_max = p.mpin[s];
+        if(p.mpout[s] < stats->mpout_min) stats->mpout_min = p.mpout[s];
+        if(p.mpout[s] > stats->mpout_max) stats->mpout_max = p.mpout[s];
+        in += p.mpin[s];
+        out += p.mpout[s];
+    }
+    if(p.samples) {
+        stats->mpin_avg = in / p.samples;
+        stats->mpout_avg = out / p.samples;
+    }
+    else {
+        stats->mpin_min = stats->mpout_min = 0;
+        stats->mpin_max = stats->mpout_max = 0;
+    }
+    stats->mjin = p.ujin / 1000;
+    stats->mjout = p.ujout / 1000;
+    return ONLP_STATUS_OK;
+}
+
 static int
 platform_psus_notify__(void)
 {
-    static onlp_oid_t psu_oid_table[ONLP_OID_TABLE_SIZE] = {0};
-    static onlp_psu_info_t psu_info_table[ONLP_OID_TABLE_SIZE];
+    static onlp_oid_list_t psu_oid_list = ONLP_OID_LIST_INIT;
+    static onlp_psu_info_t* psu_info_table = NULL;
+    static int* flag = NULL;
+    onlp_oid_t* psu_oid_table;
     int i = 0;
-    static int flag[ONLP_OID_TABLE_SIZE] = {0};
 
-    if(psu_oid_table[0] == 0) {
+    if(psu_info_table == NULL) {
         /* We haven't retreived the system PSU oids yet. */
-        onlp_sys_info_t si;
+        onlp_oid_list_t coids = ONLP_OID_LIST_INIT;
         onlp_oid_t* oidp;
 
-        if(onlp_sys_info_get(&si) < 0) {
-            AIM_LOG_ERROR("onlp_sys_info_get() failed.");
+        if(onlp_sys_coids_get(&coids) < 0) {
+            AIM_LOG_ERROR("onlp_sys_coids_get() failed.");
+            onlp_oid_list_free(&coids);
             return -1;
         }
-        ONLP_OID_TABLE_ITER_TYPE(si.hdr.coids, oidp, PSU) {
-            psu_oid_table[i++] = *oidp;
+        ONLP_OID_LIST_ITER_TYPE(&coids, oidp, PSU) {
+            if(onlp_oid_list_append(&psu_oid_list, *oidp) < 0) {
+                AIM_LOG_ERROR("onlp_oid_list_append() failed.");
+                onlp_oid_list_clear(&psu_oid_list);
+                onlp_oid_list_free(&coids);
+                return -1;
+            }
         }
+        onlp_oid_list_free(&coids);
+
+        psu_info_table = aim_zmalloc((psu_oid_list.count+1)*sizeof(psu_info_table[0]));
+        flag = aim_zmalloc((psu_oid_list.count+1)*sizeof(flag[0]));
+
+        psu_power_start__(&psu_oid_list);
     }
 
-    for(i = 0; i < AIM_ARRAYSIZE(psu_oid_table); i++) {
+    psu_oid_table = psu_oid_list.oids;
+    for(i = 0; i < psu_oid_list.count; i++) {
         onlp_psu_info_t pi;
         int pid = ONLP_OID_ID_GET(psu_oid_table[i]);
 
@@ -319,9 +900,12 @@ platform_psus_notify__(void)
         if(onlp_psu_info_get(psu_oid_table[i], &pi) < 0) {
             AIM_LOG_ERROR("Failure retreiving status of PSU ID %d",
                           pid);
+            psu_power_sample__(i, NULL);
             continue;
         }
 
+        psu_power_sample__(i, &pi);
+
         /* report initial failed state */
         if ( !flag[i] ) {
             if ( !(pi.status & 0x1) ) {
@@ -400,26 +984,38 @@ platform_psus_notify__(void)
 static int
 platform_fans_notify__(void)
 {
-    static onlp_oid_t fan_oid_table[ONLP_OID_TABLE_SIZE] = {0};
-    static onlp_fan_info_t fan_info_table[ONLP_OID_TABLE_SIZE];
+    static onlp_oid_list_t fan_oid_list = ONLP_OID_LIST_INIT;
+    static onlp_fan_info_t* fan_info_table = NULL;
+    static int* flag = NULL;
+    onlp_oid_t* fan_oid_table;
     int i = 0;
-    static int flag[ONLP_OID_TABLE_SIZE] = {0};
 
-    if(fan_oid_table[0] == 0) {
+    if(fan_info_table == NULL) {
         /* We haven't retreived the system FAN oids yet. */
-        onlp_sys_info_t si;
+        onlp_oid_list_t coids = ONLP_OID_LIST_INIT;
         onlp_oid_t* oidp;
 
-        if(onlp_sys_info_get(&si) < 0) {
-            AIM_LOG_ERROR("onlp_sys_info_get() failed.");
+        if(onlp_sys_coids_get(&coids) < 0) {
+            AIM_LOG_ERROR("onlp_sys_coids_get() failed.");
+            onlp_oid_list_free(&coids);
             return -1;
         }
-        ONLP_OID_TABLE_ITER_TYPE(si.hdr.coids, oidp, FAN) {
-            fan_oid_table[i++] = *oidp;
+        ONLP_OID_LIST_ITER_TYPE(&coids, oidp, FAN) {
+            if(onlp_oid_list_append(&fan_oid_list, *oidp) < 0) {
+                AIM_LOG_ERROR("onlp_oid_list_append() failed.");
+                onlp_oid_list_clear(&fan_oid_list);
+                onlp_oid_list_free(&coids);
+                return -1;
+            }
         }
+        onlp_oid_list_free(&coids);
+
+        fan_info_table = aim_zmalloc((fan_oid_list.count+1)*sizeof(fan_info_table[0]));
+        flag = aim_zmalloc((fan_oid_list.count+1)*sizeof(flag[0]));
     }
 
-    for(i = 0; i < AIM_ARRAYSIZE(fan_oid_table); i++) {
+    fan_oid_table = fan_oid_list.oids;
+    for(i = 0; i < fan_oid_list.count; i++) {
         onlp_fan_info_t fi;
         int fid = ONLP_OID_ID_GET(fan_oid_table[i]);
 
@@ -0,0 +1,284 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Platform Driver Plugins
+ *
+ * When ONLP_CONFIG_INCLUDE_PLATFORM_PLUGINS is set libonlp is
+ * not linked against a platform driver. Instead it provides
+ * every onlp_*i_* function as a trampoline into the interface
+ * table of a driver loaded on first use:
+ *
+ *   1. The path in ONLP_CONFIG_PLATFORM_PLUGIN_ENV, if set.
+ *   2. ONLP_CONFIG_PLATFORM_PLUGIN_PATH for the platform.
+ *   3. ONLP_CONFIG_PLATFORM_PLUGIN_PATH for the base platform
+ *      (the platform name without its revision suffix).
+ *
+ * Only the driver that is selected stays mapped. Shims listed
+ * in ONLP_CONFIG_PLATFORM_SHIMS_ENV are then stacked on top of
+ * the driver table.
+ *
+ ***********************************************************/
+#include <onlp/onlp_config.h>
+
+#if ONLP_CONFIG_INCLUDE_PLATFORM_PLUGINS == 1
+
+#include <onlp/platformi/platformi.h>
+#include <AIM/aim.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <ctype.h>
+#include "onlp_log.h"
+#include "onlp_int.h"
+
+typedef const onlp_platformi_t* (*platformi_get_f)(void);
+typedef const onlp_platformi_t* (*platformi_shim_f)(const onlp_platformi_t* inner);
+
+/** The driver table, zero extended to our table size. */
+static onlp_platformi_t driver__;
+
+/** The table after shims have been applied. */
+static const onlp_platformi_t* stack__ = &driver__;
+
+/** The active table. */
+static const onlp_platformi_t* table__ = &driver__;
+
+static pthread_once_t load_once__ = PTHREAD_ONCE_INIT;
+
+static int
+driver_open__(const char* path)
+{
+    void* handle;
+    platformi_get_f get;
+    const onlp_platformi_t* t;
+
+    if( (handle = dlopen(path, RTLD_NOW | RTLD_LOCAL)) == NULL) {
+        AIM_LOG_VERBOSE("%s", dlerror());
+        return -1;
+    }
+
+    get = (platformi_get_f)dlsym(handle, ONLP_PLATFORMI_ENTRY);
+    t = (get) ? get() : NULL;
+
+    if(t == NULL) {
+        AIM_LOG_ERROR("%s: no platform interface table.", path);
+    }
+    else if(t->version != ONLP_PLATFORMI_VERSION) {
+        AIM_LOG_ERROR("%s: platform interface version %u is not supported (expected %u).",
+                      path, t->version, ONLP_PLATFORMI_VERSION);
+    }
+    else {
+        /* Entries appended after the driver was built remain NULL. */
+        memcpy(&driver__, t,
+               (t->size < sizeof(driver__)) ? t->size : sizeof(driver__));
+        driver__.size = sizeof(driver__);
+        AIM_LOG_VERBOSE("loaded platform driver %s", path);
+        return 0;
+    }
+
+    dlclose(handle);
+    return -1;
+}
+
+static int
+driver_open_platform__(const char* dir, const char* name)
+{
+    char path[512];
+    int len = snprintf(path, sizeof(path), ONLP_CONFIG_PLATFORM_PLUGIN_PATH, dir, name);
+    if(len < 0 || len >= sizeof(path)) {
+        return -1;
+    }
+    return driver_open__(path);
+}
+
+/*
+ * The base platform drops the revision suffix,
+ * e.g. x86-64-accton-as7712-32x-r0 -> x86-64-accton-as7712-32x.
+ */
+static char*
+base_platform__(const char* platform)
+{
+    const char* r = strrchr(platform, '-');
+    const char* p;
+
+    if(r == NULL || r[1] != 'r' || r[2] == 0) {
+        return NULL;
+    }
+    for(p = r + 2; *p; p++) {
+        if(!isdigit((unsigned char)*p)) {
+            return NULL;
+        }
+    }
+    char* base = aim_strdup(platform);
+    base[r - platform] = 0;
+    return base;
+}
+
+static void
+shims_apply__(const char* shims)
+{
+    char* list = aim_strdup(shims);
+    char* saveptr = NULL;
+    char* path;
+
+    for(path = strtok_r(list, ":", &saveptr); path;
+        path = strtok_r(NULL, ":", &saveptr)) {
+        void* handle;
+        platformi_shim_f shim;
+        const onlp_platformi_t* t;
+
+        if( (handle = dlopen(path, RTLD_NOW | RTLD_LOCAL)) == NULL) {
+            AIM_LOG_ERROR("%s", dlerror());
+            continue;
+        }
+        if( (shim = (platformi_shim_f)dlsym(handle, ONLP_PLATFORMI_SHIM_ENTRY)) == NULL) {
+            AIM_LOG_ERROR("%s: no platform interface shim.", path);
+            dlclose(handle);
+            continue;
+        }
+        if( (t = shim(stack__)) == NULL) {
+            dlclose(handle);
+            continue;
+        }
+        if(t->version != ONLP_PLATFORMI_VERSION || t->size < sizeof(*t)) {
+            /* The shim may call through the inner table, so it stays mapped. */
+            AIM_LOG_ERROR("%s: the shim table does not match this version of ONLP.", path);
+            continue;
+        }
+        AIM_LOG_VERBOSE("applied platform shim %s", path);
+        stack__ = t;
+    }
+    aim_free(list);
+}
+
+static void
+platformi_load__(void)
+{
+    const char* path = getenv(ONLP_CONFIG_PLATFORM_PLUGIN_ENV);
+    const char* shims = getenv(ONLP_CONFIG_PLATFORM_SHIMS_ENV);
+    int rv = -1;
+
+    if(path && path[0]) {
+        rv = driver_open__(path);
+    }
+    else {
+        char* platform = onlp_sys_platform_detect();
+        if(platform) {
+            rv = driver_open_platform__(platform, platform);
+            if(rv < 0) {
+                char* base = base_platform__(platform);
+                if(base) {
+                    rv = driver_open_platform__(platform, base);
+                    aim_free(base);
+                }
+            }
+            aim_free(platform);
+        }
+    }
+
+    if(rv < 0) {
+        /* Every call will return ONLP_STATUS_E_UNSUPPORTED. */
+        AIM_LOG_ERROR("No platform driver could be loaded.");
+        driver__.version = ONLP_PLATFORMI_VERSION;
+        driver__.size = sizeof(driver__);
+    }
+
+    if(shims && shims[0]) {
+        shims_apply__(shims);
+    }
+    table__ = stack__;
+}
+
+static const onlp_platformi_t*
+platformi__(void)
+{
+    pthread_once(&load_once__, platformi_load__);
+    return table__;
+}
+
+const onlp_platformi_t*
+onlp_platformi_table_get(void)
+{
+    return platformi__();
+}
+
+int
+onlp_platformi_table_set(const onlp_platformi_t* table)
+{
+    platformi__();
+    if(table == NULL) {
+        table__ = stack__;
+        return ONLP_STATUS_OK;
+    }
+    if(table->version != ONLP_PLATFORMI_VERSION || table->size < sizeof(*table)) {
+        return ONLP_STATUS_E_PARAM;
+    }
+    table__ = table;
+    return ONLP_STATUS_OK;
+}
+
+/*
+ * The platform interface trampolines.
+ */
+const char*
+onlp_sysi_platform_get(void)
+{
+    const onlp_platformi_t* t = platformi__();
+    return (t->onlp_sysi_platform_get) ? t->onlp_sysi_platform_get() : NULL;
+}
+
+#define ONLP_PLATFORMI_FUNCTION(_name, _params, _args)                  \
+    int _name _params                                                   \
+    {                                                                   \
+        const onlp_platformi_t* t = platformi__();                      \
+        return (t->_name) ? t->_name _args : ONLP_STATUS_E_UNSUPPORTED; \
+    }
+
+#define ONLP_PLATFORMI_VFUNCTION(_name, _params, _args)                 \
+    void _name _params                                                  \
+    {                                                                   \
+        const onlp_platformi_t* t = platformi__();                      \
+        if(t->_name) {                                                  \
+            t->_name _args;                                             \
+        }                                                               \
+    }
+
+#include <onlp/platformi/platformi.x>
+
+#else
+
+#include <onlp/platformi/platformi.h>
+
+const onlp_platformi_t*
+onlp_platformi_table_get(void)
+{
+    return NULL;
+}
+
+int
+onlp_platformi_table_set(const onlp_platformi_t* table)
+{
+    return ONLP_STATUS_E_UNSUPPORTED;
+}
+
+#endif /* ONLP_CONFIG_INCLUDE_PLATFORM_PLUGINS */
@@ -28,7 +28,11 @@
 #include <onlp/psu.h>
 #include <onlp/platformi/psui.h>
 #include "onlp_int.h"
+/* The PSU subsystem is initialized on first use. */
+static int onlp_psu_init_locked__(void);
+#define ONLP_LOCKED_API_INIT onlp_psu_init_locked__
 #include "onlp_locks.h"
+#include <inttypes.h>
 
 #define VALIDATE(_id)                           \
     do {                                        \
@@ -45,10 +49,18 @@
     } while(0)
 
 
+static int psu_init__ = 0;
+static int psu_init_rv__;
+
 static int
 onlp_psu_init_locked__(void)
 {
-    return onlp_psui_init();
+    if(!psu_init__) {
+        onlp_sys_init_once();
+        psu_init_rv__ = onlp_psui_init();
+        psu_init__ = 1;
+    }
+    return psu_init_rv__;
 }
 ONLP_LOCKED_API0(onlp_psu_init);
 
@@ -120,6 +132,7 @@ onlp_psu_dump(onlp_oid_t id, aim_pvs_t* pvs, uint32_t flags)
     int rv;
     iof_t iof;
     onlp_psu_info_t info;
+    onlp_psu_power_stats_t ps;
 
     VALIDATENR(id);
     onlp_oid_dump_iof_init_default(&iof, pvs);
@@ -143,6 +156,14 @@ onlp_psu_dump(onlp_oid_t id, aim_pvs_t* pvs, uint32_t flags)
             iof_iprintf(&iof, "Iout:   %d", info.miout);
             iof_iprintf(&iof, "Pin:    %d", info.mpin);
             iof_iprintf(&iof, "Pout:   %d", info.mpout);
+            if(onlp_psu_power_stats_get(id, &ps) >= 0 && ps.samples) {
+                iof_iprintf(&iof, "Pin min/avg/max:  %d/%d/%d",
+                            ps.mpin_min, ps.mpin_avg, ps.mpin_max);
+                iof_iprintf(&iof, "Pout min/avg/max: %d/%d/%d",
+                            ps.mpout_min, ps.mpout_avg, ps.mpout_max);
+                iof_iprintf(&iof, "Ein:    %"PRIu64, ps.mjin);
+                iof_iprintf(&iof, "Eout:   %"PRIu64, ps.mjout);
+            }
             if(flags & ONLP_OID_DUMP_F_RECURSE) {
                 onlp_oid_table_dump(info.hdr.coids, &iof.inherit, flags);
             }
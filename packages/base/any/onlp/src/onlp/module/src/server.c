@@ -0,0 +1,934 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Platform State Server.
+ *
+ * The refresh thread periodically rebuilds a snapshot of every
+ * OID and SFP record, pre-encoded in both JSON and CBOR. The
+ * server thread answers client requests by copying records
+ * out of the current snapshot.
+ *
+ ***********************************************************/
+#include <onlp/server.h>
+#include <onlp/export.h>
+#include <onlp/oids.h>
+#include <onlp/sfp.h>
+#include <OS/os_time.h>
+#include <OS/os_thread.h>
+#include <AIM/aim.h>
+#include "onlp_log.h"
+#include "onlp_int.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <errno.h>
+
+#define FORMAT_JSON 0
+#define FORMAT_CBOR 1
+#define FORMAT_COUNT 2
+
+/** OID trees deeper than this are assumed to be broken. */
+#define SNAPSHOT_DEPTH_MAX 16
+
+/** Clients which do not drain their responses in this time are dropped. */
+#define CLIENT_SEND_TIMEOUT_SECONDS 1
+
+typedef struct server_record_s {
+    /** The OID or SFP port number */
+    uint32_t key;
+    /** OID records: the index of the first record after this OID's subtree */
+    int end;
+    /** SFP records: the presence the record was exported with */
+    int present;
+    /** The encoded record, per format */
+    uint8_t* data[FORMAT_COUNT];
+    int size[FORMAT_COUNT];
+} server_record_t;
+
+typedef struct server_records_s {
+    server_record_t* records;
+    int count;
+    int size;
+} server_records_t;
+
+typedef struct server_snapshot_s {
+    /** Protected by the control lock */
+    int refcount;
+    /** Monotonic time at which this snapshot was completed */
+    uint64_t timestamp;
+    /** OID records in depth-first order, starting with the system */
+    server_records_t oids;
+    /** SFP records in port order */
+    server_records_t sfps;
+} server_snapshot_t;
+
+typedef struct server_client_s {
+    int fd;
+    int format;
+    int subscribed;
+    /** The client has closed its write side */
+    int eof;
+    int len;
+    char request[ONLP_CONFIG_SERVER_REQUEST_MAX+1];
+} server_client_t;
+
+typedef struct server_ctrl_s {
+    /** The socket path. Non-NULL while the server is running. */
+    char* path;
+    int listen_fd;
+    /** Signals both threads to exit. This is never read. */
+    int stop_fd;
+    /** Signals the server thread that a new snapshot is available. */
+    int update_fd;
+
+    pthread_t refresh_thread;
+    pthread_t server_thread;
+
+    /** Protects the current snapshot and all snapshot reference counts */
+    pthread_mutex_t lock;
+    server_snapshot_t* snapshot;
+
+    /** Only accessed by the server thread */
+    server_client_t* clients[ONLP_CONFIG_SERVER_CLIENTS_MAX];
+} server_ctrl_t;
+
+static server_ctrl_t control__ = { NULL, -1, -1, -1 };
+
+
+/************************************************************
+ *
+ * Snapshots
+ *
+ ***********************************************************/
+
+static server_record_t*
+records_add__(server_records_t* r, uint32_t key)
+{
+    server_record_t* rec;
+
+    if(r->count == r->size) {
+        r->size = (r->size) ? r->size * 2 : 32;
+        r->records = aim_realloc(r->records, r->size * sizeof(r->records[0]));
+    }
+    rec = r->records + r->count++;
+    memset(rec, 0, sizeof(*rec));
+    rec->key = key;
+    rec->end = r->count;
+    return rec;
+}
+
+static server_record_t*
+records_find__(server_records_t* r, uint32_t key, int hint)
+{
+    int i;
+
+    /* The layout rarely changes between snapshots. */
+    if(hint >= 0 && hint < r->count && r->records[hint].key == key) {
+        return r->records + hint;
+    }
+    for(i = 0; i < r->count; i++) {
+        if(r->records[i].key == key) {
+            return r->records + i;
+        }
+    }
+    return NULL;
+}
+
+static void
+records_free__(server_records_t* r)
+{
+    int i;
+    for(i = 0; i < r->count; i++) {
+        aim_free(r->records[i].data[FORMAT_JSON]);
+        aim_free(r->records[i].data[FORMAT_CBOR]);
+    }
+    aim_free(r->records);
+}
+
+static server_snapshot_t*
+snapshot_get__(void)
+{
+    server_snapshot_t* s;
+
+    pthread_mutex_lock(&control__.lock);
+    s = control__.snapshot;
+    if(s) {
+        s->refcount++;
+    }
+    pthread_mutex_unlock(&control__.lock);
+    return s;
+}
+
+static void
+snapshot_release__(server_snapshot_t* s)
+{
+    int last;
+
+    if(s == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&control__.lock);
+    last = (--s->refcount == 0);
+    pthread_mutex_unlock(&control__.lock);
+
+    if(last) {
+        records_free__(&s->oids);
+        records_free__(&s->sfps);
+        aim_free(s);
+    }
+}
+
+/*
+ * The JSON stream mirrors all encoder calls to the CBOR stream
+ * so each record is read from the platform only once.
+ */
+static void
+snapshot_record_take__(onlp_export_t** e, server_record_t* rec)
+{
+    int f;
+    for(f = 0; f < FORMAT_COUNT; f++) {
+        onlp_export_buffer_take(e[f], &rec->data[f], &rec->size[f]);
+    }
+}
+
+static void
+snapshot_add_oid__(server_snapshot_t* s, onlp_export_t** e,
+                   onlp_oid_t oid, int depth)
+{
+    int index = s->oids.count;
+    onlp_oid_t* oidp;
+    onlp_oid_list_t coids = ONLP_OID_LIST_INIT;
+
+    onlp_export_oid(e[FORMAT_JSON], oid);
+    snapshot_record_take__(e, records_add__(&s->oids, oid));
+
+    if(depth < SNAPSHOT_DEPTH_MAX && onlp_oid_coids_get(oid, &coids) >= 0) {
+        ONLP_OID_LIST_ITER(&coids, oidp) {
+            snapshot_add_oid__(s, e, *oidp, depth + 1);
+        }
+    }
+    onlp_oid_list_free(&coids);
+
+    /* records may have been reallocated */
+    s->oids.records[index].end = s->oids.count;
+}
+
+/*
+ * Reuse an SFP record from the previous snapshot.
+ */
+static void
+snapshot_record_copy__(server_record_t* rec, server_record_t* old)
+{
+    int f;
+    for(f = 0; f < FORMAT_COUNT; f++) {
+        rec->size[f] = old->size[f];
+        rec->data[f] = aim_malloc(old->size[f] ? old->size[f] : 1);
+        memcpy(rec->data[f], old->data[f], old->size[f]);
+    }
+}
+
+/*
+ * SFP records are reused from the previous snapshot unless the
+ * module presence has changed or a DOM refresh is due. The DOM
+ * monitors are read with the EEPROM, so a DOM refresh re-exports
+ * the whole record.
+ */
+static server_snapshot_t*
+snapshot_build__(server_snapshot_t* prev, int dom)
+{
+    int port;
+    onlp_sfp_bitmap_t bitmap;
+    onlp_sfp_bitmap_t present;
+    onlp_export_t* e[FORMAT_COUNT];
+    server_snapshot_t* s = aim_zmalloc(sizeof(*s));
+
+    e[FORMAT_JSON] = onlp_export_create_buffer(ONLP_EXPORT_F_SFP_DOM);
+    e[FORMAT_CBOR] = onlp_export_create_buffer(ONLP_EXPORT_F_SFP_DOM |
+                                               ONLP_EXPORT_F_CBOR);
+    onlp_export_tee(e[FORMAT_JSON], e[FORMAT_CBOR]);
+
+    snapshot_add_oid__(s, e, ONLP_OID_SYS, 0);
+
+    onlp_sfp_bitmap_t_init(&bitmap);
+    onlp_sfp_bitmap_get(&bitmap);
+    onlp_sfp_bitmap_t_init(&present);
+    if(onlp_sfp_presence_bitmap_get(&present) < 0) {
+        dom = 1;
+    }
+    AIM_BITMAP_ITER(&bitmap, port) {
+        int p = AIM_BITMAP_GET(&present, port) ? 1 : 0;
+        server_record_t* old = (prev) ? records_find__(&prev->sfps, port, port) : NULL;
+        server_record_t* rec = records_add__(&s->sfps, port);
+
+        rec->present = p;
+        if(!dom && old && old->present == p) {
+            snapshot_record_copy__(rec, old);
+        }
+        else {
+            onlp_export_sfp(e[FORMAT_JSON], port);
+            snapshot_record_take__(e, rec);
+        }
+    }
+
+    onlp_export_destroy(e[FORMAT_JSON]);
+    onlp_export_destroy(e[FORMAT_CBOR]);
+
+    s->refcount = 1;
+    s->timestamp = os_time_monotonic();
+    return s;
+}
+
+static void*
+server_refresh_thread__(void* arg)
+{
+    uint64_t dom_last = os_time_monotonic();
+
+    os_thread_name_set("onlp.server.rf");
+
+    for(;;) {
+        int dom;
+        uint64_t now;
+        uint64_t one = 1;
+        server_snapshot_t* s;
+        server_snapshot_t* old;
+        struct pollfd pfd = { control__.stop_fd, POLLIN, 0 };
+
+        int rv = poll(&pfd, 1, ONLP_CONFIG_SERVER_REFRESH_INTERVAL / 1000);
+        if(rv > 0) {
+            /* Stopped */
+            return NULL;
+        }
+        if(rv < 0 && errno == EINTR) {
+            continue;
+        }
+
+        now = os_time_monotonic();
+        dom = (now - dom_last >= ONLP_CONFIG_SERVER_SFP_DOM_REFRESH_INTERVAL);
+        if(dom) {
+            dom_last = now;
+        }
+
+        /* Only this thread replaces the snapshot, so the current one stays valid. */
+        s = snapshot_build__(control__.snapshot, dom);
+
+        pthread_mutex_lock(&control__.lock);
+        old = control__.snapshot;
+        control__.snapshot = s;
+        pthread_mutex_unlock(&control__.lock);
+
+        snapshot_release__(old);
+        if(write(control__.update_fd, &one, sizeof(one)) < 0) {
+            AIM_LOG_ERROR("server update notification failed: %{errno}", errno);
+        }
+    }
+}
+
+
+/************************************************************
+ *
+ * Clients
+ *
+ ***********************************************************/
+
+static void
+client_close__(int slot)
+{
+    server_client_t* c = control__.clients[slot];
+    if(c) {
+        close(c->fd);
+        aim_free(c);
+        control__.clients[slot] = NULL;
+    }
+}
+
+static onlp_export_t*
+client_export__(server_client_t* c)
+{
+    return onlp_export_create(c->fd,
+                              (c->format == FORMAT_CBOR) ? ONLP_EXPORT_F_CBOR : 0);
+}
+
+static void
+client_record__(onlp_export_t* e, server_client_t* c, server_record_t* r)
+{
+    onlp_export_raw(e, r->data[c->format], r->size[c->format]);
+}
+
+static void
+client_reply__(onlp_export_t* e, const char* reply, const char* status,
+               int count, server_snapshot_t* s)
+{
+    onlp_export_map_begin(e);
+    onlp_export_key(e, "reply");
+    onlp_export_str(e, reply);
+    onlp_export_key(e, "status");
+    onlp_export_str(e, status);
+    onlp_export_key(e, "count");
+    onlp_export_int(e, count);
+    if(s) {
+        onlp_export_key(e, "age");
+        onlp_export_uint(e, os_time_monotonic() - s->timestamp);
+    }
+    onlp_export_map_end(e);
+}
+
+#define DELIMITERS " \t\r"
+
+/**
+ * Execute a single command.
+ * Returns < 0 if the response could not be written.
+ */
+static int
+client_command__(server_client_t* c, char* cmd)
+{
+    int i;
+    int count = 0;
+    char* arg;
+    char* saveptr = NULL;
+    const char* status = "OK";
+    server_record_t* r;
+    server_snapshot_t* s;
+    onlp_export_t* e;
+    char* name = strtok_r(cmd, DELIMITERS, &saveptr);
+
+    if(name == NULL) {
+        return 0;
+    }
+
+    if(!strcmp(name, "format")) {
+        arg = strtok_r(NULL, DELIMITERS, &saveptr);
+        if(arg && !strcmp(arg, "json")) {
+            c->format = FORMAT_JSON;
+        }
+        else if(arg && !strcmp(arg, "cbor")) {
+            c->format = FORMAT_CBOR;
+        }
+        else {
+            status = "invalid format";
+        }
+    }
+
+    e = client_export__(c);
+    s = snapshot_get__();
+
+    if(s == NULL) {
+        status = "unavailable";
+    }
+    else if(!strcmp(name, "format") || !strcmp(name, "ping")) {
+        /* Reply only */
+    }
+    else if(!strcmp(name, "get") || !strcmp(name, "tree")) {
+        int tree = !strcmp(name, "tree");
+        int args = 0;
+        while( (arg = strtok_r(NULL, DELIMITERS, &saveptr)) || (tree && args == 0) ) {
+            onlp_oid_t oid = ONLP_OID_SYS;
+            char* end = NULL;
+
+            args++;
+            if(arg) {
+                oid = strtoul(arg, &end, 0);
+                if(*end) {
+                    status = "invalid oid";
+                    continue;
+                }
+            }
+            if( (r = records_find__(&s->oids, oid, -1)) == NULL) {
+                status = "not found";
+                continue;
+            }
+            for(i = r - s->oids.records; i < (tree ? r->end : r - s->oids.records + 1); i++) {
+                client_record__(e, c, s->oids.records + i);
+                count++;
+            }
+            if(arg == NULL) {
+                break;
+            }
+        }
+    }
+    else if(!strcmp(name, "sfp")) {
+        while( (arg = strtok_r(NULL, DELIMITERS, &saveptr)) ) {
+            char* end = NULL;
+            int port = strtol(arg, &end, 0);
+            if(*end) {
+                status = "invalid port";
+                continue;
+            }
+            if( (r = records_find__(&s->sfps, port, port)) == NULL) {
+                status = "not found";
+                continue;
+            }
+            client_record__(e, c, r);
+            count++;
+        }
+    }
+    else if(!strcmp(name, "sfps") || !strcmp(name, "all")) {
+        if(!strcmp(name, "all")) {
+            for(i = 0; i < s->oids.count; i++) {
+                client_record__(e, c, s->oids.records + i);
+                count++;
+            }
+        }
+        for(i = 0; i < s->sfps.count; i++) {
+            client_record__(e, c, s->sfps.records + i);
+            count++;
+        }
+    }
+    else if(!strcmp(name, "subscribe")) {
+        c->subscribed = 1;
+    }
+    else if(!strcmp(name, "unsubscribe")) {
+        c->subscribed = 0;
+    }
+    else {
+        status = "unknown command";
+    }
+
+    client_reply__(e, name, status, count, s);
+    snapshot_release__(s);
+    return onlp_export_destroy(e);
+}
+
+static int
+client_line__(server_client_t* c, char* line)
+{
+    char* saveptr = NULL;
+    char* cmd;
+
+    for(cmd = strtok_r(line, ";", &saveptr); cmd;
+        cmd = strtok_r(NULL, ";", &saveptr)) {
+        if(client_command__(c, cmd) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void
+client_read__(int slot)
+{
+    int i, start, rv;
+    server_client_t* c = control__.clients[slot];
+
+    rv = read(c->fd, c->request + c->len, ONLP_CONFIG_SERVER_REQUEST_MAX - c->len);
+    if(rv < 0) {
+        if(errno == EINTR || errno == EAGAIN) {
+            return;
+        }
+        client_close__(slot);
+        return;
+    }
+    if(rv == 0) {
+        c->eof = 1;
+    }
+    c->len += rv;
+
+    for(i = start = 0; i < c->len; i++) {
+        if(c->request[i] == '\n') {
+            c->request[i] = 0;
+            if(client_line__(c, c->request + start) < 0) {
+                client_close__(slot);
+                return;
+            }
+            start = i + 1;
+        }
+    }
+
+    if(c->eof && start < c->len) {
+        /* Unterminated final request */
+        c->request[c->len] = 0;
+        if(client_line__(c, c->request + start) < 0) {
+            client_close__(slot);
+            return;
+        }
+        start = c->len;
+    }
+
+    memmove(c->request, c->request + start, c->len - start);
+    c->len -= start;
+
+    if(c->len == ONLP_CONFIG_SERVER_REQUEST_MAX) {
+        onlp_export_t* e = client_export__(c);
+        client_reply__(e, "", "request too long", 0, NULL);
+        onlp_export_destroy(e);
+        client_close__(slot);
+        return;
+    }
+
+    if(c->eof && !c->subscribed) {
+        client_close__(slot);
+    }
+}
+
+static void
+client_accept__(void)
+{
+    int slot;
+    int fd = accept(control__.listen_fd, NULL, NULL);
+    struct timeval tv = { CLIENT_SEND_TIMEOUT_SECONDS, 0 };
+
+    if(fd < 0) {
+        if(errno != EINTR && errno != EAGAIN) {
+            AIM_LOG_ERROR("accept failed: %{errno}", errno);
+        }
+        return;
+    }
+
+    for(slot = 0; slot < AIM_ARRAYSIZE(control__.clients); slot++) {
+        if(control__.clients[slot] == NULL) {
+            break;
+        }
+    }
+    if(slot == AIM_ARRAYSIZE(control__.clients)) {
+        AIM_LOG_WARN("Maximum number of server clients reached.");
+        close(fd);
+        return;
+    }
+
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    control__.clients[slot] = aim_zmalloc(sizeof(server_client_t));
+    control__.clients[slot]->fd = fd;
+}
+
+/**
+ * Send all records which have changed between the given snapshots
+ * to all subscribed clients.
+ */
+static int
+client_publish_records__(onlp_export_t* e, server_client_t* c,
+                         server_records_t* old, server_records_t* new)
+{
+    int i;
+    int count = 0;
+    int f = c->format;
+
+    for(i = 0; i < new->count; i++) {
+        server_record_t* r = new->records + i;
+        server_record_t* o = (old) ? records_find__(old, r->key, i) : NULL;
+        if(o == NULL || o->size[f] != r->size[f] ||
+           memcmp(o->data[f], r->data[f], r->size[f])) {
+            client_record__(e, c, r);
+            count++;
+        }
+    }
+    return count;
+}
+
+static void
+client_publish__(server_snapshot_t* old, server_snapshot_t* new)
+{
+    int slot;
+
+    for(slot = 0; slot < AIM_ARRAYSIZE(control__.clients); slot++) {
+        int count;
+        onlp_export_t* e;
+        server_client_t* c = control__.clients[slot];
+
+        if(c == NULL || !c->subscribed) {
+            continue;
+        }
+
+        e = client_export__(c);
+        count = client_publish_records__(e, c, (old) ? &old->oids : NULL, &new->oids);
+        count += client_publish_records__(e, c, (old) ? &old->sfps : NULL, &new->sfps);
+        if(count) {
+            client_reply__(e, "update", "OK", count, new);
+        }
+        if(onlp_export_destroy(e) < 0) {
+            client_close__(slot);
+        }
+    }
+}
+
+static void*
+server_thread__(void* arg)
+{
+    int slot;
+    server_snapshot_t* last = snapshot_get__();
+
+    os_thread_name_set("onlp.server");
+
+    for(;;) {
+        int n = 0;
+        int slots[AIM_ARRAYSIZE(control__.clients)];
+        struct pollfd pfds[3 + AIM_ARRAYSIZE(control__.clients)];
+
+        pfds[n].fd = control__.stop_fd; pfds[n++].events = POLLIN;
+        pfds[n].fd = control__.update_fd; pfds[n++].events = POLLIN;
+        pfds[n].fd = control__.listen_fd; pfds[n++].events = POLLIN;
+
+        for(slot = 0; slot < AIM_ARRAYSIZE(control__.clients); slot++) {
+            server_client_t* c = control__.clients[slot];
+            if(c) {
+                /* Half-closed subscribers are only watched for hangup. */
+                slots[n-3] = slot;
+                pfds[n].fd = c->fd;
+                pfds[n++].events = (c->eof) ? 0 : POLLIN;
+            }
+        }
+
+        if(poll(pfds, n, -1) < 0) {
+            if(errno != EINTR) {
+                AIM_LOG_ERROR("poll() failed: %{errno}", errno);
+                sleep(1);
+            }
+            continue;
+        }
+
+        if(pfds[0].revents) {
+            break;
+        }
+
+        /*
+         * Client events are handled first. Publishing and accepting
+         * can close and reuse client slots, which would leave the
+         * polled events referring to the wrong client.
+         */
+        for(slot = 3; slot < n; slot++) {
+            server_client_t* c = control__.clients[slots[slot-3]];
+            if(pfds[slot].revents == 0 || c == NULL || c->fd != pfds[slot].fd) {
+                continue;
+            }
+            if(c->eof) {
+                client_close__(slots[slot-3]);
+            }
+            else {
+                client_read__(slots[slot-3]);
+            }
+        }
+
+        if(pfds[1].revents & POLLIN) {
+            uint64_t v;
+            server_snapshot_t* s;
+            if(read(control__.update_fd, &v, sizeof(v)) > 0 &&
+               (s = snapshot_get__())) {
+                client_publish__(last, s);
+                snapshot_release__(last);
+                last = s;
+            }
+        }
+
+        if(pfds[2].revents & POLLIN) {
+            client_accept__();
+        }
+    }
+
+    for(slot = 0; slot < AIM_ARRAYSIZE(control__.clients); slot++) {
+        client_close__(slot);
+    }
+    snapshot_release__(last);
+    return NULL;
+}
+
+
+/************************************************************
+ *
+ * Public API
+ *
+ ***********************************************************/
+
+int
+onlp_server_start(const char* path)
+{
+    int fd;
+    struct sockaddr_un addr;
+
+    if(control__.path) {
+        /* Already running */
+        return 0;
+    }
+
+    if(path == NULL) {
+        path = ONLP_CONFIG_SERVER_SOCKET_PATH;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    if(strlen(path) >= sizeof(addr.sun_path)) {
+        AIM_LOG_ERROR("server socket path '%s' is too long.", path);
+        return ONLP_STATUS_E_PARAM;
+    }
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    /* Writes to disconnected clients must not terminate the process. */
+    signal(SIGPIPE, SIG_IGN);
+
+    if( (fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0) {
+        AIM_LOG_ERROR("socket() failed: %{errno}", errno);
+        return ONLP_STATUS_E_INTERNAL;
+    }
+
+    unlink(path);
+    if(bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+       listen(fd, AIM_ARRAYSIZE(control__.clients)) < 0) {
+        AIM_LOG_ERROR("server socket %s: %{errno}", path, errno);
+        close(fd);
+        return ONLP_STATUS_E_INTERNAL;
+    }
+
+    control__.listen_fd = fd;
+    control__.stop_fd = eventfd(0, 0);
+    control__.update_fd = eventfd(0, 0);
+    if(control__.stop_fd < 0 || control__.update_fd < 0) {
+        AIM_LOG_ERROR("eventfd create failed: %{errno}", errno);
+        goto error;
+    }
+
+    pthread_mutex_init(&control__.lock, NULL);
+
+    /* Queries are always answered from a complete snapshot. */
+    control__.snapshot = snapshot_build__(NULL, 1);
+
+    if(pthread_create(&control__.refresh_thread, NULL,
+                      server_refresh_thread__, NULL) != 0) {
+        AIM_LOG_ERROR("pthread create failed.");
+        goto error;
+    }
+    if(pthread_create(&control__.server_thread, NULL,
+                      server_thread__, NULL) != 0) {
+        uint64_t one = 1;
+        AIM_LOG_ERROR("pthread create failed.");
+        write(control__.stop_fd, &one, sizeof(one));
+        pthread_join(control__.refresh_thread, NULL);
+        goto error;
+    }
+
+    control__.path = aim_strdup(path);
+    return 0;
+
+ error:
+    snapshot_release__(control__.snapshot);
+    control__.snapshot = NULL;
+    if(control__.stop_fd >= 0) {
+        close(control__.stop_fd);
+    }
+    if(control__.update_fd >= 0) {
+        close(control__.update_fd);
+    }
+    close(fd);
+    unlink(path);
+    control__.listen_fd = control__.stop_fd = control__.update_fd = -1;
+    return ONLP_STATUS_E_INTERNAL;
+}
+
+int
+onlp_server_stop(void)
+{
+    uint64_t one = 1;
+
+    if(control__.path == NULL) {
+        return 0;
+    }
+
+    write(control__.stop_fd, &one, sizeof(one));
+    pthread_join(control__.refresh_thread, NULL);
+    pthread_join(control__.server_thread, NULL);
+
+    close(control__.listen_fd);
+    close(control__.stop_fd);
+    close(control__.update_fd);
+    unlink(control__.path);
+
+    snapshot_release__(control__.snapshot);
+    control__.snapshot = NULL;
+
+    aim_free(control__.path);
+    control__.path = NULL;
+    control__.listen_fd = control__.stop_fd = control__.update_fd = -1;
+    return 0;
+}
+
+static int
+write_all__(int fd, const void* data, int size)
+{
+    const uint8_t* p = data;
+    while(size > 0) {
+        ssize_t rv = write(fd, p, size);
+        if(rv < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        p += rv;
+        size -= rv;
+    }
+    return 0;
+}
+
+int
+onlp_server_request(const char* path, const char* request, int fd)
+{
+    int s;
+    int len;
+    ssize_t rv;
+    char buffer[4096];
+    struct sockaddr_un addr;
+
+    if(path == NULL) {
+        path = ONLP_CONFIG_SERVER_SOCKET_PATH;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    if(strlen(path) >= sizeof(addr.sun_path)) {
+        return ONLP_STATUS_E_PARAM;
+    }
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    if( (s = socket(AF_UNIX, SOCK_STREAM, 0)) < 0) {
+        return ONLP_STATUS_E_INTERNAL;
+    }
+    if(connect(s, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        AIM_LOG_ERROR("connect(%s): %{errno}", path, errno);
+        close(s);
+        return ONLP_STATUS_E_MISSING;
+    }
+
+    len = strlen(request);
+    if(write_all__(s, request, len) < 0 ||
+       (len && request[len-1] != '\n' && write_all__(s, "\n", 1) < 0)) {
+        close(s);
+        return ONLP_STATUS_E_INTERNAL;
+    }
+
+    /* No more requests. The server closes the connection once they are answered. */
+    shutdown(s, SHUT_WR);
+
+    while( (rv = read(s, buffer, sizeof(buffer))) != 0) {
+        if(rv < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if(write_all__(fd, buffer, rv) < 0) {
+            break;
+        }
+    }
+
+    close(s);
+    return (rv == 0) ? 0 : ONLP_STATUS_E_INTERNAL;
+}
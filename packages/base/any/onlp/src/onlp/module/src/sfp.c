@@ -25,6 +25,11 @@
 #include <onlp/sfp.h>
 #include <onlp/platformi/sfpi.h>
 #include "onlp_log.h"
+#include "onlp_int.h"
+
+/* The SFP subsystem is initialized on first use. */
+static int onlp_sfp_init_locked__(void);
+#define ONLP_LOCKED_API_INIT onlp_sfp_init_locked__
 #include "onlp_locks.h"
 
 /**
@@ -39,10 +44,159 @@ onlp_sfp_bitmap_t_init(onlp_sfp_bitmap_t* bmap)
     AIM_BITMAP_CLR_ALL(bmap);
 }
 
+#define ONLP_SFP_BITMAP_WORD_BITS  (sizeof(aim_bitmap_word_t) * 8)
+#define ONLP_SFP_BITMAP_WORDS                                   \
+    ((int)(sizeof(((onlp_sfp_bitmap_t*)0)->words) /             \
+           sizeof(aim_bitmap_word_t)))
+
+void
+onlp_sfp_bitmap_xor(onlp_sfp_bitmap_t* dst, const onlp_sfp_bitmap_t* a,
+                    const onlp_sfp_bitmap_t* b)
+{
+    int i;
+    for(i = 0; i < ONLP_SFP_BITMAP_WORDS; i++) {
+        dst->words[i] = a->words[i] ^ b->words[i];
+    }
+}
+
+void
+onlp_sfp_bitmap_or(onlp_sfp_bitmap_t* dst, const onlp_sfp_bitmap_t* a,
+                   const onlp_sfp_bitmap_t* b)
+{
+    int i;
+    for(i = 0; i < ONLP_SFP_BITMAP_WORDS; i++) {
+        dst->words[i] = a->words[i] | b->words[i];
+    }
+}
+
+void
+onlp_sfp_bitmap_and(onlp_sfp_bitmap_t* dst, const onlp_sfp_bitmap_t* a,
+                    const onlp_sfp_bitmap_t* b)
+{
+    int i;
+    for(i = 0; i < ONLP_SFP_BITMAP_WORDS; i++) {
+        dst->words[i] = a->words[i] & b->words[i];
+    }
+}
+
+int
+onlp_sfp_bitmap_popcount(const onlp_sfp_bitmap_t* bmap)
+{
+    int i, count = 0;
+    for(i = 0; i < ONLP_SFP_BITMAP_WORDS; i++) {
+        count += __builtin_popcountll(bmap->words[i]);
+    }
+    return count;
+}
+
+int
+onlp_sfp_bitmap_next(const onlp_sfp_bitmap_t* bmap, int port)
+{
+    int i;
+    aim_bitmap_word_t w;
+
+    if(port < 0) {
+        port = 0;
+    }
+
+    i = port / ONLP_SFP_BITMAP_WORD_BITS;
+    if(i >= ONLP_SFP_BITMAP_WORDS) {
+        return -1;
+    }
+
+    /* Mask off the bits below port in the first word. */
+    w = bmap->words[i] & (~(aim_bitmap_word_t)0 << (port % ONLP_SFP_BITMAP_WORD_BITS));
+    for(;;) {
+        if(w) {
+            return i * ONLP_SFP_BITMAP_WORD_BITS + __builtin_ctzll(w);
+        }
+        if(++i == ONLP_SFP_BITMAP_WORDS) {
+            return -1;
+        }
+        w = bmap->words[i];
+    }
+}
+
+/**
+ * Change tracking for a port bitmap.
+ *
+ * The difference between consecutive samples is kept for the last
+ * ONLP_SFP_CHANGE_HISTORY generations. A change set is the union of
+ * the differences since the caller's generation.
+ */
+#define ONLP_SFP_CHANGE_HISTORY 16
+
+typedef struct onlp_sfp_tracker_s {
+    /** Current generation. 0 until the first sample. */
+    uint32_t generation;
+
+    /** The last sample */
+    onlp_sfp_bitmap_t current;
+
+    /** The difference that started generation g is at g % ONLP_SFP_CHANGE_HISTORY */
+    onlp_sfp_bitmap_t history[ONLP_SFP_CHANGE_HISTORY];
+} onlp_sfp_tracker_t;
+
+static onlp_sfp_tracker_t presence_tracker__;
+static onlp_sfp_tracker_t rx_los_tracker__;
+
+static void
+onlp_sfp_tracker_init__(onlp_sfp_tracker_t* t)
+{
+    int i;
+    t->generation = 0;
+    onlp_sfp_bitmap_t_init(&t->current);
+    for(i = 0; i < ONLP_SFP_CHANGE_HISTORY; i++) {
+        onlp_sfp_bitmap_t_init(t->history + i);
+    }
+}
+
 static int
-onlp_sfp_init_locked__(void)
+onlp_sfp_tracker_update__(onlp_sfp_tracker_t* t, const onlp_sfp_bitmap_t* sample,
+                          uint32_t* generation, onlp_sfp_bitmap_t* changed)
+{
+    uint32_t g;
+    uint32_t since = *generation;
+
+    if(t->generation == 0) {
+        t->generation = 1;
+        onlp_sfp_bitmap_or(&t->current, sample, sample);
+    }
+    else {
+        onlp_sfp_bitmap_t* diff = t->history + ((t->generation + 1) % ONLP_SFP_CHANGE_HISTORY);
+        onlp_sfp_bitmap_xor(diff, &t->current, sample);
+        if(onlp_sfp_bitmap_popcount(diff)) {
+            t->generation++;
+            onlp_sfp_bitmap_or(&t->current, sample, sample);
+        }
+    }
+
+    if(since == 0 || since > t->generation ||
+       t->generation - since >= ONLP_SFP_CHANGE_HISTORY) {
+        /* Unknown or expired generation. Everything may have changed. */
+        onlp_sfp_bitmap_or(changed, &sfpi_bitmap__, &sfpi_bitmap__);
+    }
+    else {
+        AIM_BITMAP_CLR_ALL(changed);
+        for(g = since + 1; g <= t->generation; g++) {
+            onlp_sfp_bitmap_or(changed, changed,
+                               t->history + (g % ONLP_SFP_CHANGE_HISTORY));
+        }
+    }
+
+    *generation = t->generation;
+    return onlp_sfp_bitmap_popcount(changed);
+}
+
+static int sfp_init__ = 0;
+static int sfp_init_rv__;
+
+static int
+onlp_sfp_init__(void)
 {
     onlp_sfp_bitmap_t_init(&sfpi_bitmap__);
+    onlp_sfp_tracker_init__(&presence_tracker__);
+    onlp_sfp_tracker_init__(&rx_los_tracker__);
 
     int rv = onlp_sfpi_init();
     if(rv < 0) {
@@ -67,6 +221,17 @@ onlp_sfp_init_locked__(void)
         return ONLP_STATUS_OK;
     }
 }
+
+static int
+onlp_sfp_init_locked__(void)
+{
+    if(!sfp_init__) {
+        onlp_sys_init_once();
+        sfp_init_rv__ = onlp_sfp_init__();
+        sfp_init__ = 1;
+    }
+    return sfp_init_rv__;
+}
 ONLP_LOCKED_API0(onlp_sfp_init)
 
 
@@ -83,6 +248,8 @@ ONLP_LOCKED_API1(onlp_sfp_bitmap_get, onlp_sfp_bitmap_t*, bmap);
 static int
 onlp_sfp_denit_locked__(void)
 {
+    /* The next SFP call initializes the driver again. */
+    sfp_init__ = 0;
     return onlp_sfpi_denit();
 }
 ONLP_LOCKED_API0(onlp_sfp_denit);
@@ -116,7 +283,7 @@ onlp_sfp_presence_bitmap_get_locked__(onlp_sfp_bitmap_t* dst)
         /* Generate from single-port API */
         int p;
         AIM_BITMAP_CLR_ALL(dst);
-        AIM_BITMAP_ITER(&sfpi_bitmap__, p) {
+        ONLP_SFP_BITMAP_ITER(&sfpi_bitmap__, p) {
             rv = onlp_sfp_is_present_locked__(p);
             if(rv < 0) {
                 return rv;
@@ -132,21 +299,54 @@ onlp_sfp_presence_bitmap_get_locked__(onlp_sfp_bitmap_t* dst)
 }
 ONLP_LOCKED_API1(onlp_sfp_presence_bitmap_get, onlp_sfp_bitmap_t*, dst);
 
+static int
+onlp_sfp_presence_changes_get_locked__(uint32_t* generation,
+                                       onlp_sfp_bitmap_t* changed,
+                                       onlp_sfp_bitmap_t* current)
+{
+    int rv;
+    onlp_sfp_bitmap_t sample;
+
+    if(generation == NULL || changed == NULL) {
+        return ONLP_STATUS_E_PARAM;
+    }
+
+    onlp_sfp_bitmap_t_init(&sample);
+    if((rv = onlp_sfp_presence_bitmap_get_locked__(&sample)) < 0) {
+        return rv;
+    }
+    if(current) {
+        onlp_sfp_bitmap_or(current, &sample, &sample);
+    }
+    return onlp_sfp_tracker_update__(&presence_tracker__, &sample,
+                                     generation, changed);
+}
+ONLP_LOCKED_API3(onlp_sfp_presence_changes_get, uint32_t*, generation,
+                 onlp_sfp_bitmap_t*, changed, onlp_sfp_bitmap_t*, current);
+
 int
 onlp_sfp_port_valid(int port)
 {
+    onlp_sfp_init();
     return AIM_BITMAP_GET(&sfpi_bitmap__, port);
 }
 
+static int
+onlp_sfp_eeprom_read_buf__(int port, uint8_t* data)
+{
+    ONLP_SFP_PORT_VALIDATE_AND_MAP(port);
+    memset(data, 0, 256);
+    return onlp_sfpi_eeprom_read(port, data);
+}
+
 static int
 onlp_sfp_eeprom_read_locked__(int port, uint8_t** datap)
 {
     int rv;
     uint8_t* data;
-    ONLP_SFP_PORT_VALIDATE_AND_MAP(port);
 
     data = aim_zmalloc(256);
-    if((rv = onlp_sfpi_eeprom_read(port, data)) < 0) {
+    if((rv = onlp_sfp_eeprom_read_buf__(port, data)) < 0) {
         aim_free(data);
         data = NULL;
     }
@@ -155,6 +355,65 @@ onlp_sfp_eeprom_read_locked__(int port, uint8_t** datap)
 }
 ONLP_LOCKED_API2(onlp_sfp_eeprom_read, int, port, uint8_t**, rv);
 
+static int
+onlp_sfp_inventory_get_locked__(onlp_sfp_inventory_t* records, int max)
+{
+    int p, rv;
+    int count = 0;
+    uint8_t data[256];
+    sff_info_t info;
+    onlp_sfp_bitmap_t present;
+
+    if(records == NULL || max < 0) {
+        return ONLP_STATUS_E_PARAM;
+    }
+
+    onlp_sfp_bitmap_t_init(&present);
+    if((rv = onlp_sfp_presence_bitmap_get_locked__(&present)) < 0) {
+        return rv;
+    }
+
+    AIM_BITMAP_ITER(&sfpi_bitmap__, p) {
+        onlp_sfp_inventory_t* r;
+
+        if(count == max) {
+            break;
+        }
+        r = records + count++;
+        memset(r, 0, sizeof(*r));
+        r->port = p;
+        r->sfp_type = SFF_SFP_TYPE_INVALID;
+        r->module_type = SFF_MODULE_TYPE_INVALID;
+        r->media_type = SFF_MEDIA_TYPE_INVALID;
+        r->length = -1;
+
+        if(!AIM_BITMAP_GET(&present, p)) {
+            continue;
+        }
+        r->present = 1;
+
+        if((r->status = onlp_sfp_eeprom_read_buf__(p, data)) < 0) {
+            continue;
+        }
+        r->status = ONLP_STATUS_OK;
+
+        if(sff_info_parse(&info, data) < 0) {
+            continue;
+        }
+        r->identified = 1;
+        r->sfp_type = info.sfp_type;
+        r->module_type = info.module_type;
+        r->media_type = info.media_type;
+        r->caps = info.caps;
+        r->length = info.length;
+        memcpy(r->vendor, info.vendor, sizeof(r->vendor));
+        memcpy(r->model, info.model, sizeof(r->model));
+        memcpy(r->serial, info.serial, sizeof(r->serial));
+    }
+    return count;
+}
+ONLP_LOCKED_API2(onlp_sfp_inventory_get, onlp_sfp_inventory_t*, records, int, max);
+
 static int
 onlp_sfp_dom_read_locked__(int port, uint8_t** datap)
 {
@@ -172,12 +431,66 @@ onlp_sfp_dom_read_locked__(int port, uint8_t** datap)
 }
 ONLP_LOCKED_API2(onlp_sfp_dom_read, int, port, uint8_t**, rv);
 
+static int
+onlp_sfp_read_bytes__(int port, uint8_t devaddr, int page, int offset, int len,
+                      uint8_t* buf)
+{
+    int i, rv;
+    int paged = (page > 0 && offset + len > ONLP_SFP_PAGE_UPPER);
+
+    if(paged) {
+        rv = onlp_sfpi_dev_writeb(port, devaddr, ONLP_SFP_PAGE_SELECT, page);
+        if(rv < 0) {
+            return rv;
+        }
+    }
+
+    for(i = 0; i < len; i++) {
+        rv = onlp_sfpi_dev_readb(port, devaddr, offset + i);
+        if(rv < 0) {
+            break;
+        }
+        buf[i] = rv;
+    }
+
+    if(paged) {
+        onlp_sfpi_dev_writeb(port, devaddr, ONLP_SFP_PAGE_SELECT, 0);
+    }
+
+    return (rv < 0) ? rv : len;
+}
+
+static int
+onlp_sfp_read_locked__(int port, uint8_t devaddr, int page, int offset, int len,
+                       uint8_t* buf)
+{
+    int rv;
+    ONLP_SFP_PORT_VALIDATE_AND_MAP(port);
+
+    if(buf == NULL || page < ONLP_SFP_PAGE_NONE || page > 255 ||
+       offset < 0 || len < 0 || offset + len > 256) {
+        return ONLP_STATUS_E_PARAM;
+    }
+    if(len == 0) {
+        return 0;
+    }
+
+    rv = onlp_sfpi_read(port, devaddr, page, offset, len, buf);
+    if(rv == ONLP_STATUS_E_UNSUPPORTED) {
+        rv = onlp_sfp_read_bytes__(port, devaddr, page, offset, len, buf);
+    }
+    return rv;
+}
+ONLP_LOCKED_API6(onlp_sfp_read, int, port, uint8_t, devaddr, int, page,
+                 int, offset, int, len, uint8_t*, buf);
+
 void
 onlp_sfp_dump(aim_pvs_t* pvs)
 {
     int p;
     int rv;
 
+    onlp_sfp_init();
     if(AIM_BITMAP_COUNT(&sfpi_bitmap__) == 0) {
         aim_printf(pvs, "There are no SFP capable ports.\n");
         return;
@@ -324,7 +637,7 @@ onlp_sfp_rx_los_bitmap_get_locked__(onlp_sfp_bitmap_t* dst)
         /* Generate from control API */
         int p;
         AIM_BITMAP_CLR_ALL(dst);
-        AIM_BITMAP_ITER(&sfpi_bitmap__, p) {
+        ONLP_SFP_BITMAP_ITER(&sfpi_bitmap__, p) {
             int v;
             rv = onlp_sfp_control_get_locked__(p, ONLP_SFP_CONTROL_RX_LOS, &v);
             if(rv < 0) {
@@ -340,6 +653,31 @@ onlp_sfp_rx_los_bitmap_get_locked__(onlp_sfp_bitmap_t* dst)
 }
 ONLP_LOCKED_API1(onlp_sfp_rx_los_bitmap_get, onlp_sfp_bitmap_t*, dst);
 
+static int
+onlp_sfp_rx_los_changes_get_locked__(uint32_t* generation,
+                                     onlp_sfp_bitmap_t* changed,
+                                     onlp_sfp_bitmap_t* current)
+{
+    int rv;
+    onlp_sfp_bitmap_t sample;
+
+    if(generation == NULL || changed == NULL) {
+        return ONLP_STATUS_E_PARAM;
+    }
+
+    onlp_sfp_bitmap_t_init(&sample);
+    if((rv = onlp_sfp_rx_los_bitmap_get_locked__(&sample)) < 0) {
+        return rv;
+    }
+    if(current) {
+        onlp_sfp_bitmap_or(current, &sample, &sample);
+    }
+    return onlp_sfp_tracker_update__(&rx_los_tracker__, &sample,
+                                     generation, changed);
+}
+ONLP_LOCKED_API3(onlp_sfp_rx_los_changes_get, uint32_t*, generation,
+                 onlp_sfp_bitmap_t*, changed, onlp_sfp_bitmap_t*, current);
+
 
 int
 onlp_sfp_control_flags_get(int port, uint32_t* flags)
@@ -0,0 +1,273 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * ONLP API Statistics
+ *
+ * The statistics table lives in a SysV shared memory segment.
+ * Each API claims a table slot on its first call. Counters
+ * are updated with relaxed atomics while the API lock is
+ * still held, so updates are almost never contended.
+ *
+ ***********************************************************/
+#include <onlp/stats.h>
+#include <onlplib/shlocks.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <sched.h>
+#include "onlp_locks.h"
+#include "onlp_log.h"
+
+#if ONLP_CONFIG_INCLUDE_API_STATS == 1
+
+/*
+ * A slot is claimed before its name is written and only becomes
+ * ready once the name is complete, so lookups never match a
+ * partially written name.
+ */
+#define API_STATS_SLOT_FREE     0
+#define API_STATS_SLOT_CLAIMING 1
+#define API_STATS_SLOT_READY    2
+
+/* A claimer which died mid-claim must not block lookups forever. */
+#define API_STATS_CLAIM_SPINS 1000
+
+typedef struct api_stats_entry_s {
+    /** API_STATS_SLOT_* */
+    uint32_t state;
+    onlp_api_stats_t stats;
+} api_stats_entry_t;
+
+typedef struct api_stats_table_s {
+    uint32_t magic;
+    uint32_t size;
+    api_stats_entry_t entries[ONLP_CONFIG_API_STATS_MAX];
+} api_stats_table_t;
+
+/* Changed whenever the table layout or slot protocol changes */
+#define API_STATS_MAGIC 0x57A75058
+
+static api_stats_table_t* table__ = NULL;
+
+static api_stats_table_t*
+api_stats_table__(void)
+{
+    api_stats_table_t* t = NULL;
+    int rv;
+
+    if(table__) {
+        return table__;
+    }
+
+    rv = onlp_shmem_create(ONLP_CONFIG_API_STATS_SHM_KEY, sizeof(*t), (void**)&t);
+    if(rv < 0 || (t->magic && t->magic != API_STATS_MAGIC) ||
+       (t->magic == API_STATS_MAGIC && t->size != ONLP_CONFIG_API_STATS_MAX)) {
+        /* Unavailable, or created by an incompatible build. */
+        AIM_LOG_WARN("The shared API statistics table is not available. Statistics are local to this process.");
+        t = aim_zmalloc(sizeof(*t));
+    }
+    if(t->magic != API_STATS_MAGIC) {
+        t->size = ONLP_CONFIG_API_STATS_MAX;
+        __atomic_store_n(&t->magic, API_STATS_MAGIC, __ATOMIC_RELEASE);
+    }
+    table__ = t;
+    return t;
+}
+
+static int
+api_stats_slot__(const char* name)
+{
+    int i;
+    api_stats_table_t* t = api_stats_table__();
+
+    for(i = 0; i < ONLP_CONFIG_API_STATS_MAX; i++) {
+        int spins = 0;
+        api_stats_entry_t* e = t->entries + i;
+        uint32_t state = __atomic_load_n(&e->state, __ATOMIC_ACQUIRE);
+
+        while(state == API_STATS_SLOT_CLAIMING && spins++ < API_STATS_CLAIM_SPINS) {
+            /* Another caller is writing the name, which may be ours. */
+            sched_yield();
+            state = __atomic_load_n(&e->state, __ATOMIC_ACQUIRE);
+        }
+
+        if(state == API_STATS_SLOT_READY) {
+            if(!strncmp(e->stats.name, name, sizeof(e->stats.name) - 1)) {
+                return i;
+            }
+        }
+        else if(state == API_STATS_SLOT_FREE) {
+            if(__atomic_compare_exchange_n(&e->state, &state, API_STATS_SLOT_CLAIMING, 0,
+                                           __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                aim_strlcpy(e->stats.name, name, sizeof(e->stats.name));
+                __atomic_store_n(&e->state, API_STATS_SLOT_READY, __ATOMIC_RELEASE);
+                return i;
+            }
+            /* Lost the race for this slot. Look at it again. */
+            i--;
+        }
+    }
+
+    AIM_LOG_WARN("The API statistics table is full. '%s' will not be tracked.", name);
+    return -1;
+}
+
+static inline int
+api_stats_bucket__(uint64_t usecs)
+{
+    int b = (usecs) ? 64 - __builtin_clzll(usecs) : 0;
+    return (b < ONLP_API_STATS_BUCKETS) ? b : ONLP_API_STATS_BUCKETS - 1;
+}
+
+#define STAT_ADD(_p, _v) __atomic_fetch_add(_p, _v, __ATOMIC_RELAXED)
+
+static inline void
+api_timer_update__(onlp_api_timer_stats_t* ts, uint64_t usecs)
+{
+    STAT_ADD(&ts->total, usecs);
+    STAT_ADD(&ts->buckets[api_stats_bucket__(usecs)], 1);
+    if(usecs > __atomic_load_n(&ts->max, __ATOMIC_RELAXED)) {
+        /* A concurrent larger maximum may be lost. */
+        __atomic_store_n(&ts->max, usecs, __ATOMIC_RELAXED);
+    }
+}
+
+void
+onlp_api_stats_update(onlp_api_stats_site_t* site,
+                      uint64_t t0, uint64_t t1, uint64_t t2, int rv)
+{
+    onlp_api_stats_t* s;
+
+    if(site->index == ONLP_API_STATS_SITE_UNRESOLVED) {
+        int slot = api_stats_slot__(site->name);
+        site->index = (slot < 0) ? ONLP_API_STATS_SITE_UNTRACKED : slot;
+    }
+    if(site->index < 0) {
+        return;
+    }
+
+    s = &table__->entries[site->index].stats;
+    STAT_ADD(&s->calls, 1);
+    if(rv < 0) {
+        STAT_ADD(&s->errors, 1);
+    }
+    api_timer_update__(&s->lock, t1 - t0);
+    api_timer_update__(&s->call, t2 - t1);
+}
+
+int
+onlp_api_stats_get(int index, onlp_api_stats_t* stats)
+{
+    api_stats_table_t* t = api_stats_table__();
+
+    if(index < 0 || index >= ONLP_CONFIG_API_STATS_MAX || stats == NULL) {
+        return ONLP_STATUS_E_PARAM;
+    }
+    if(__atomic_load_n(&t->entries[index].state, __ATOMIC_ACQUIRE) != API_STATS_SLOT_READY) {
+        return ONLP_STATUS_E_MISSING;
+    }
+    memcpy(stats, &t->entries[index].stats, sizeof(*stats));
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_api_stats_clear(void)
+{
+    int i;
+    api_stats_table_t* t = api_stats_table__();
+
+    for(i = 0; i < ONLP_CONFIG_API_STATS_MAX; i++) {
+        onlp_api_stats_t* s = &t->entries[i].stats;
+        /* Keep the name. The slot remains claimed. */
+        memset(&s->calls, 0, sizeof(*s) - offsetof(onlp_api_stats_t, calls));
+    }
+    return ONLP_STATUS_OK;
+}
+
+#else
+
+int
+onlp_api_stats_get(int index, onlp_api_stats_t* stats)
+{
+    return ONLP_STATUS_E_UNSUPPORTED;
+}
+
+int
+onlp_api_stats_clear(void)
+{
+    return ONLP_STATUS_E_UNSUPPORTED;
+}
+
+#endif /* ONLP_CONFIG_INCLUDE_API_STATS */
+
+uint64_t
+onlp_api_stats_bucket_floor(int bucket)
+{
+    return (bucket <= 0) ? 0 : (1ULL << (bucket - 1));
+}
+
+static void
+api_timer_show__(aim_pvs_t* pvs, const char* name, onlp_api_timer_stats_t* ts)
+{
+    int b;
+
+    aim_printf(pvs, "    %-5s", name);
+    for(b = 0; b < ONLP_API_STATS_BUCKETS; b++) {
+        uint64_t floor = onlp_api_stats_bucket_floor(b);
+        if(ts->buckets[b] == 0) {
+            continue;
+        }
+        if(floor >= 1000000) {
+            aim_printf(pvs, " %"PRIu64"s:%"PRIu64, floor / 1000000, ts->buckets[b]);
+        }
+        else if(floor >= 1000) {
+            aim_printf(pvs, " %"PRIu64"ms:%"PRIu64, floor / 1000, ts->buckets[b]);
+        }
+        else {
+            aim_printf(pvs, " %"PRIu64"us:%"PRIu64, floor, ts->buckets[b]);
+        }
+    }
+    aim_printf(pvs, "\n");
+}
+
+void
+onlp_api_stats_show(aim_pvs_t* pvs, uint32_t flags)
+{
+    int i;
+    onlp_api_stats_t s;
+
+    aim_printf(pvs, "%-40s %10s %8s %10s %10s %10s %10s\n",
+               "API", "Calls", "Errors",
+               "Lock(avg)", "Lock(max)", "Call(avg)", "Call(max)");
+
+    for(i = 0; i < ONLP_CONFIG_API_STATS_MAX; i++) {
+        if(onlp_api_stats_get(i, &s) < 0 || s.calls == 0) {
+            continue;
+        }
+        aim_printf(pvs, "%-40s %10"PRIu64" %8"PRIu64" %10"PRIu64" %10"PRIu64" %10"PRIu64" %10"PRIu64"\n",
+                   s.name, s.calls, s.errors,
+                   s.lock.total / s.calls, s.lock.max,
+                   s.call.total / s.calls, s.call.max);
+        if(flags & ONLP_API_STATS_SHOW_F_HISTOGRAMS) {
+            api_timer_show__(pvs, "lock", &s.lock);
+            api_timer_show__(pvs, "call", &s.call);
+        }
+    }
+}
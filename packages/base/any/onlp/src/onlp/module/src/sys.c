@@ -24,10 +24,16 @@
  ***********************************************************/
 #include <onlp/sys.h>
 #include <onlp/platformi/sysi.h>
-#include <onlplib/mmap.h>
+#include <onlplib/regmap.h>
 #include <AIM/aim.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include "onlp_log.h"
 #include "onlp_int.h"
+
+/* The platform is initialized on first use. */
+#define ONLP_LOCKED_API_INIT onlp_sys_init_once
 #include "onlp_locks.h"
 
 static char*
@@ -35,22 +41,23 @@ platform_detect_fs__(int warn)
 {
     /*
      * Check the filesystem for the platform identifier.
+     * This is a single read(), without stdio buffering.
      */
     char* rv = NULL;
     if(ONLP_CONFIG_PLATFORM_FILENAME) {
-        FILE* fp;
-        if((fp=fopen(ONLP_CONFIG_PLATFORM_FILENAME, "r"))) {
+        int fd;
+        if((fd=open(ONLP_CONFIG_PLATFORM_FILENAME, O_RDONLY)) >= 0) {
             char platform[256];
-            if(fgets(platform, sizeof(platform), fp) == platform) {
+            int len = read(fd, platform, sizeof(platform)-1);
+            if(len > 0) {
                 /* TODO: Base this detection on the global platform registry. */
+                platform[len] = 0;
+                platform[strcspn(platform, "\n")] = 0;
                 if(platform[0]) {
-                    if(platform[ONLP_STRLEN(platform)-1] == '\n') {
-                        platform[ONLP_STRLEN(platform)-1] = 0;
-                    }
                     rv = aim_strdup(platform);
                 }
             }
-            fclose(fp);
+            close(fd);
         }
         else {
             if(warn) {
@@ -61,21 +68,36 @@ platform_detect_fs__(int warn)
     return rv;
 }
 
-static char*
-platform_detect__(void)
+/** The platform identity does not change while we are running. */
+static char* platform__ = NULL;
+static pthread_once_t platform_once__ = PTHREAD_ONCE_INIT;
+
+static void
+platform_detect_once__(void)
 {
 #if ONLP_CONFIG_INCLUDE_PLATFORM_STATIC == 1
-    return aim_strdup(ONLP_CONFIG_PLATFORM_STATIC);
+    platform__ = aim_strdup(ONLP_CONFIG_PLATFORM_STATIC);
+#else
+    platform__ = platform_detect_fs__(1);
 #endif
-    return platform_detect_fs__(1);
 }
 
+char*
+onlp_sys_platform_detect(void)
+{
+    pthread_once(&platform_once__, platform_detect_once__);
+    return (platform__) ? aim_strdup(platform__) : NULL;
+}
+
+static int sys_init__ = 0;
+static int sys_init_rv__;
+
 static int
-onlp_sys_init_locked__(void)
+onlp_sys_init__(void)
 {
     int rv;
 
-    const char* current_platform = platform_detect__();
+    const char* current_platform = onlp_sys_platform_detect();
     if(current_platform == NULL) {
         AIM_DIE("Could not determine the current platform.");
     }
@@ -98,16 +120,36 @@ onlp_sys_init_locked__(void)
     rv = onlp_sysi_init();
     return rv;
 }
+
+int
+onlp_sys_init_once(void)
+{
+    if(!sys_init__) {
+        sys_init_rv__ = onlp_sys_init__();
+        sys_init__ = 1;
+    }
+    return sys_init_rv__;
+}
+
+static int
+onlp_sys_init_locked__(void)
+{
+    return onlp_sys_init_once();
+}
 ONLP_LOCKED_API0(onlp_sys_init);
 
 static uint8_t*
-onie_data_get__(int* free)
+onie_data_get__(int* free, onlp_regmap_t** rm)
 {
     void* pa;
     uint8_t* ma = NULL;
     int size;
+    *rm = NULL;
     if(onlp_sysi_onie_data_phys_addr_get(&pa) == 0) {
-        ma = onlp_mmap((off_t)pa, 64*1024, "onie_data_get__");
+        /* The mapping is released once the data has been decoded. */
+        if( (*rm = onlp_regmap_open((off_t)pa, 64*1024, "onie_data_get__")) ) {
+            ma = (uint8_t*)(*rm)->base;
+        }
         *free = 0;
     }
     else if(onlp_sysi_onie_data_get(&ma, &size) == 0) {
@@ -120,9 +162,61 @@ onie_data_get__(int* free)
     return ma;
 }
 
+/*
+ * The largest child set we will ask the platform for.
+ * OID ids are 24 bits but nothing real comes close to this.
+ */
+#define ONLP_SYS_COIDS_MAX (64*1024)
+
+static int
+onlp_sys_coids_get_locked__(onlp_oid_list_t* list)
+{
+    int rv;
+    int size;
+
+    onlp_oid_list_clear(list);
+
+    for(size = ONLP_OID_TABLE_SIZE; size <= ONLP_SYS_COIDS_MAX; size *= 2) {
+        int i;
+
+        if((rv = onlp_oid_list_reserve(list, size)) < 0) {
+            return rv;
+        }
+        memset(list->oids, 0, size*sizeof(onlp_oid_t));
+
+        rv = onlp_sysi_oids_get(list->oids, size);
+        if(rv < 0) {
+            return rv;
+        }
+
+        /* Compact the result and look for unused entries. */
+        list->count = 0;
+        for(i = 0; i < size; i++) {
+            if(list->oids[i]) {
+                list->oids[list->count++] = list->oids[i];
+            }
+        }
+
+        if(list->count < size) {
+            /*
+             * The platform did not fill the table so this is the complete set.
+             * A full table may have been truncated -- try again with a larger one.
+             */
+            return ONLP_STATUS_OK;
+        }
+    }
+
+    AIM_LOG_ERROR("Platform reported more than %d system OIDs. The list has been truncated.",
+                  ONLP_SYS_COIDS_MAX);
+    return ONLP_STATUS_OK;
+}
+ONLP_LOCKED_API1(onlp_sys_coids_get, onlp_oid_list_t*, list);
+
 static int
 onlp_sys_info_get_locked__(onlp_sys_info_t* rv)
 {
+    onlp_oid_list_t list = ONLP_OID_LIST_INIT;
+
     if(rv == NULL) {
         return -1;
     }
@@ -133,13 +227,15 @@ onlp_sys_info_get_locked__(onlp_sys_info_t* rv)
      * Get the system ONIE information.
      */
     int free;
-    uint8_t* onie_data = onie_data_get__(&free);
+    onlp_regmap_t* onie_rm;
+    uint8_t* onie_data = onie_data_get__(&free, &onie_rm);
 
     if(onie_data) {
         onlp_onie_decode(&rv->onie_info, onie_data, -1);
         if(free) {
             onlp_sysi_onie_data_free(onie_data);
         }
+        onlp_regmap_close(onie_rm);
     }
     else {
         if(onlp_sysi_onie_info_get(&rv->onie_info) != 0) {
@@ -148,9 +244,13 @@ onlp_sys_info_get_locked__(onlp_sys_info_t* rv)
     }
 
     /*
-     * Query the sys oids
+     * Query the sys oids.
+     * Only the first ONLP_OID_TABLE_SIZE are reported in the header.
+     * Use onlp_sys_coids_get() for the complete set.
      */
-    onlp_sysi_oids_get(rv->hdr.coids, AIM_ARRAYSIZE(rv->hdr.coids));
+    onlp_sys_coids_get_locked__(&list);
+    onlp_oid_list_to_table(&list, rv->hdr.coids);
+    onlp_oid_list_free(&list);
 
     /*
      * Platform Information
@@ -171,8 +271,16 @@ onlp_sys_info_free(onlp_sys_info_t* info)
 static int
 onlp_sys_hdr_get_locked__(onlp_oid_hdr_t* hdr)
 {
+    int rv;
+    onlp_oid_list_t list = ONLP_OID_LIST_INIT;
+
     memset(hdr, 0, sizeof(*hdr));
-    return onlp_sysi_oids_get(hdr->coids, AIM_ARRAYSIZE(hdr->coids));
+    rv = onlp_sys_coids_get_locked__(&list);
+    if(rv >= 0) {
+        onlp_oid_list_to_table(&list, hdr->coids);
+    }
+    onlp_oid_list_free(&list);
+    return rv;
 }
 ONLP_LOCKED_API1(onlp_sys_hdr_get, onlp_oid_hdr_t*, hdr);
 
@@ -183,6 +291,7 @@ onlp_sys_dump(onlp_oid_t id, aim_pvs_t* pvs, uint32_t flags)
     int rv;
     iof_t iof;
     onlp_sys_info_t si;
+    onlp_oid_list_t coids = ONLP_OID_LIST_INIT;
 
     onlp_oid_dump_iof_init_default(&iof, pvs);
 
@@ -201,7 +310,10 @@ onlp_sys_dump(onlp_oid_t id, aim_pvs_t* pvs, uint32_t flags)
         onlp_onie_show(&si.onie_info, &iof.inherit);
         iof_pop(&iof);
     }
-    onlp_oid_table_dump(si.hdr.coids, pvs, flags);
+    if(onlp_sys_coids_get(&coids) >= 0) {
+        onlp_oid_list_dump(&coids, pvs, flags);
+    }
+    onlp_oid_list_free(&coids);
     onlp_sys_info_free(&si);
 }
 
@@ -244,24 +356,27 @@ onlp_sys_show(onlp_oid_t id, aim_pvs_t* pvs, uint32_t flags)
     if(flags & ONLP_OID_SHOW_F_RECURSE) {
 
         onlp_oid_t* oidp;
+        onlp_oid_list_t coids = ONLP_OID_LIST_INIT;
+
+        onlp_sys_coids_get(&coids);
 
         /** Show all Chassis Fans */
         YPUSH("Fans:");
-        ONLP_OID_TABLE_ITER_TYPE(si.hdr.coids, oidp, FAN) {
+        ONLP_OID_LIST_ITER_TYPE(&coids, oidp, FAN) {
             onlp_oid_show(*oidp, &iof.inherit, flags);
         }
         YPOP();
 
         /** Show all System Thermals */
         YPUSH("Thermals:");
-        ONLP_OID_TABLE_ITER_TYPE(si.hdr.coids, oidp, THERMAL) {
+        ONLP_OID_LIST_ITER_TYPE(&coids, oidp, THERMAL) {
             onlp_oid_show(*oidp, &iof.inherit, flags);
         }
         YPOP();
 
         /** Show all PSUs */
         YPUSH("PSUs:");
-        ONLP_OID_TABLE_ITER_TYPE(si.hdr.coids, oidp, PSU) {
+        ONLP_OID_LIST_ITER_TYPE(&coids, oidp, PSU) {
             onlp_oid_show(*oidp, &iof.inherit, flags);
         }
         YPOP();
@@ -269,11 +384,12 @@ onlp_sys_show(onlp_oid_t id, aim_pvs_t* pvs, uint32_t flags)
         if(flags & ONLP_OID_SHOW_F_EXTENDED) {
             /** Show all LEDs */
             YPUSH("LEDs:");
-            ONLP_OID_TABLE_ITER_TYPE(si.hdr.coids, oidp, LED) {
+            ONLP_OID_LIST_ITER_TYPE(&coids, oidp, LED) {
                 onlp_oid_show(*oidp, &iof.inherit, flags);
             }
             YPOP();
         }
+        onlp_oid_list_free(&coids);
     }
     onlp_sys_info_free(&si);
 }
@@ -26,6 +26,9 @@
 #include <onlp/platformi/thermali.h>
 #include <onlp/oids.h>
 #include "onlp_int.h"
+/* The thermal subsystem is initialized on first use. */
+static int onlp_thermal_init_locked__(void);
+#define ONLP_LOCKED_API_INIT onlp_thermal_init_locked__
 #include "onlp_locks.h"
 
 #define VALIDATE(_id)                           \
@@ -43,10 +46,18 @@
     } while(0)
 
 
+static int thermal_init__ = 0;
+static int thermal_init_rv__;
+
 static int
 onlp_thermal_init_locked__(void)
 {
-    return onlp_thermali_init();
+    if(!thermal_init__) {
+        onlp_sys_init_once();
+        thermal_init_rv__ = onlp_thermali_init();
+        thermal_init__ = 1;
+    }
+    return thermal_init_rv__;
 }
 ONLP_LOCKED_API0(onlp_thermal_init);
 
@@ -84,11 +95,10 @@ onlp_thermal_info_get_locked__(onlp_oid_t oid, onlp_thermal_info_t* info)
     if(rv >= 0) {
 
 #if ONLP_CONFIG_INCLUDE_PLATFORM_OVERRIDES == 1
-        int id = ONLP_OID_ID_GET(oid);
-        cJSON* entry = NULL;
-
-        cjson_util_lookup(onlp_json_get(0), &entry, "overrides.thermal.%d", id);
-        onlp_thermali_info_from_json__(entry, info, 0);
+        cJSON* entry = onlp_json_override_get(oid);
+        if(entry) {
+            onlp_thermali_info_from_json__(entry, info, 0);
+        }
 #endif
 
     }
@@ -70,12 +70,29 @@ void
 shlock_test(void)
 {
     onlp_shlock_t* lock = NULL;
+    onlp_shlock_owner_t owner;
+    onlp_shlock_stats_t stats;
 
     TRY(onlp_shlock_create(0xEEEF, &lock, "utest-lock:%d", 1));
     TRY(onlp_shlock_take(lock));
     TRY(onlp_shlock_give(lock));
     TRY(onlp_shlock_take(lock));
     TRY(onlp_shlock_give(lock));
+    TRY(onlp_shlock_stats_clear(lock));
+    TRY(onlp_shlock_take_timeout(lock, "utest", 1000));
+    TRY(onlp_shlock_info_get(lock, &owner, &stats));
+    if(owner.pid != getpid() || strcmp(owner.what, "utest")) {
+        AIM_DIE("lock owner does not match (%d, %s)", owner.pid, owner.what);
+    }
+    if(onlp_shlock_try_take(lock, "utest") != ONLP_STATUS_E_BUSY) {
+        AIM_DIE("try_take succeeded on a held lock.");
+    }
+    TRY(onlp_shlock_give(lock));
+    TRY(onlp_shlock_info_get(lock, &owner, &stats));
+    if(owner.pid != 0 || stats.takes != 1 || stats.timeouts != 1) {
+        AIM_DIE("lock statistics do not match (pid=%d takes=%d timeouts=%d)",
+                owner.pid, (int)stats.takes, (int)stats.timeouts);
+    }
     TRY(onlp_shlock_global_take());
     TRY(onlp_shlock_global_give());
     TRY(onlp_shlock_global_take());
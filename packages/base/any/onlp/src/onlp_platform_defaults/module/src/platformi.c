@@ -0,0 +1,45 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * The platform interface table for driver plugins.
+ *
+ * A driver plugin links this module with -Bsymbolic-functions
+ * so the table refers to the driver's own implementations, or
+ * to this module's defaults for anything the driver does not provide.
+ *
+ ***********************************************************/
+#include <onlp/platformi/platformi.h>
+#include "onlp_platform_defaults_int.h"
+
+static const onlp_platformi_t platformi__ = {
+    ONLP_PLATFORMI_VERSION,
+    sizeof(onlp_platformi_t),
+    onlp_sysi_platform_get,
+#define ONLP_PLATFORMI_FUNCTION(_name, _params, _args) _name,
+#define ONLP_PLATFORMI_VFUNCTION(_name, _params, _args) _name,
+#include <onlp/platformi/platformi.x>
+};
+
+const onlp_platformi_t*
+onlp_platformi_get(void)
+{
+    return &platformi__;
+}
@@ -0,0 +1,43 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * ONLP API Microbenchmarks
+ *
+ * Each benchmark calls one public ONLP entry point repeatedly
+ * from every worker thread of every worker process, so that
+ * workers contend on the API lock the way concurrent ONLP
+ * clients do. Per-call latency percentiles, syscalls and heap
+ * allocations are reported as JSON.
+ *
+ ***********************************************************/
+#ifndef __ONLPBENCH_H__
+#define __ONLPBENCH_H__
+
+#include <onlpbench/onlpbench_config.h>
+
+/**
+ * @brief Benchmark entry point.
+ * @param argc Argument count.
+ * @param argv Arguments. Run with -h for usage.
+ */
+int onlpbench_main(int argc, char* argv[]);
+
+#endif /* __ONLPBENCH_H__ */
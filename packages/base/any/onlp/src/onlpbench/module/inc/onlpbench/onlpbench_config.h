@@ -0,0 +1,172 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ * 
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.       
+ * 
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ * 
+ *        http://www.eclipse.org/legal/epl-v10.html
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ * 
+ * </bsn.cl>
+ ************************************************************
+ *
+ *
+ *
+ ***********************************************************/
+
+/**************************************************************************//**
+ *
+ * @file
+ * @brief onlpbench Configuration Header
+ *
+ * @addtogroup onlpbench-config
+ * @{
+ *
+ *****************************************************************************/
+#ifndef __ONLPBENCH_CONFIG_H__
+#define __ONLPBENCH_CONFIG_H__
+
+#ifdef GLOBAL_INCLUDE_CUSTOM_CONFIG
+#include <global_custom_config.h>
+#endif
+#ifdef ONLPBENCH_INCLUDE_CUSTOM_CONFIG
+#include <onlpbench_custom_config.h>
+#endif
+
+/* <auto.start.cdefs(ONLPBENCH_CONFIG_HEADER).header> */
+#include <AIM/aim.h>
+/**
+ * ONLPBENCH_CONFIG_INCLUDE_LOGGING
+ *
+ * Include or exclude logging. */
+
+
+#ifndef ONLPBENCH_CONFIG_INCLUDE_LOGGING
+#define ONLPBENCH_CONFIG_INCLUDE_LOGGING 1
+#endif
+
+/**
+ * ONLPBENCH_CONFIG_LOG_OPTIONS_DEFAULT
+ *
+ * Default enabled log options. */
+
+
+#ifndef ONLPBENCH_CONFIG_LOG_OPTIONS_DEFAULT
+#define ONLPBENCH_CONFIG_LOG_OPTIONS_DEFAULT AIM_LOG_OPTIONS_DEFAULT
+#endif
+
+/**
+ * ONLPBENCH_CONFIG_LOG_BITS_DEFAULT
+ *
+ * Default enabled log bits. */
+
+
+#ifndef ONLPBENCH_CONFIG_LOG_BITS_DEFAULT
+#define ONLPBENCH_CONFIG_LOG_BITS_DEFAULT AIM_LOG_BITS_DEFAULT
+#endif
+
+/**
+ * ONLPBENCH_CONFIG_LOG_CUSTOM_BITS_DEFAULT
+ *
+ * Default enabled custom log bits. */
+
+
+#ifndef ONLPBENCH_CONFIG_LOG_CUSTOM_BITS_DEFAULT
+#define ONLPBENCH_CONFIG_LOG_CUSTOM_BITS_DEFAULT 0
+#endif
+
+/**
+ * ONLPBENCH_CONFIG_PORTING_STDLIB
+ *
+ * Default all porting macros to use the C standard libraries. */
+
+
+#ifndef ONLPBENCH_CONFIG_PORTING_STDLIB
+#define ONLPBENCH_CONFIG_PORTING_STDLIB 1
+#endif
+
+/**
+ * ONLPBENCH_CONFIG_PORTING_INCLUDE_STDLIB_HEADERS
+ *
+ * Include standard library headers for stdlib porting macros. */
+
+
+#ifndef ONLPBENCH_CONFIG_PORTING_INCLUDE_STDLIB_HEADERS
+#define ONLPBENCH_CONFIG_PORTING_INCLUDE_STDLIB_HEADERS ONLPBENCH_CONFIG_PORTING_STDLIB
+#endif
+
+/**
+ * ONLPBENCH_CONFIG_INCLUDE_UCLI
+ *
+ * Include generic uCli support. */
+
+
+#ifndef ONLPBENCH_CONFIG_INCLUDE_UCLI
+#define ONLPBENCH_CONFIG_INCLUDE_UCLI 0
+#endif
+
+/**
+ * ONLPBENCH_CONFIG_INCLUDE_MALLOC_COUNTERS
+ *
+ * Interpose malloc() to count allocations per call. */
+
+
+#ifndef ONLPBENCH_CONFIG_INCLUDE_MALLOC_COUNTERS
+#define ONLPBENCH_CONFIG_INCLUDE_MALLOC_COUNTERS 1
+#endif
+
+/**
+ * ONLPBENCH_CONFIG_ITERATIONS_DEFAULT
+ *
+ * Default number of calls per worker thread for each benchmark. */
+
+
+#ifndef ONLPBENCH_CONFIG_ITERATIONS_DEFAULT
+#define ONLPBENCH_CONFIG_ITERATIONS_DEFAULT 1000
+#endif
+
+
+
+/**
+ * All compile time options can be queried or displayed
+ */
+
+/** Configuration settings structure. */
+typedef struct onlpbench_config_settings_s {
+    /** name */
+    const char* name;
+    /** value */
+    const char* value;
+} onlpbench_config_settings_t;
+
+/** Configuration settings table. */
+/** onlpbench_config_settings table. */
+extern onlpbench_config_settings_t onlpbench_config_settings[];
+
+/**
+ * @brief Lookup a configuration setting.
+ * @param setting The name of the configuration option to lookup.
+ */
+const char* onlpbench_config_lookup(const char* setting);
+
+/**
+ * @brief Show the compile-time configuration.
+ * @param pvs The output stream.
+ */
+int onlpbench_config_show(struct aim_pvs_s* pvs);
+
+/* <auto.end.cdefs(ONLPBENCH_CONFIG_HEADER).header> */
+
+#include "onlpbench_porting.h"
+
+#endif /* __ONLPBENCH_CONFIG_H__ */
+/* @} */
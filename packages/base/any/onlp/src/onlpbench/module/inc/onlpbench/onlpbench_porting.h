@@ -0,0 +1,132 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ * 
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.       
+ * 
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ * 
+ *        http://www.eclipse.org/legal/epl-v10.html
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ * 
+ * </bsn.cl>
+ ************************************************************
+ *
+ *
+ *
+ ***********************************************************/
+
+/********************************************************//**
+ *
+ * @file
+ * @brief onlpbench Porting Macros.
+ *
+ * @addtogroup onlpbench-porting
+ * @{
+ *
+ ***********************************************************/
+#ifndef __ONLPBENCH_PORTING_H__
+#define __ONLPBENCH_PORTING_H__
+
+
+/* <auto.start.portingmacro(ALL).define> */
+#if ONLPBENCH_CONFIG_PORTING_INCLUDE_STDLIB_HEADERS == 1
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <memory.h>
+#endif
+
+#ifndef ONLPBENCH_MALLOC
+    #if defined(GLOBAL_MALLOC)
+        #define ONLPBENCH_MALLOC GLOBAL_MALLOC
+    #elif ONLPBENCH_CONFIG_PORTING_STDLIB == 1
+        #define ONLPBENCH_MALLOC malloc
+    #else
+        #error The macro ONLPBENCH_MALLOC is required but cannot be defined.
+    #endif
+#endif
+
+#ifndef ONLPBENCH_FREE
+    #if defined(GLOBAL_FREE)
+        #define ONLPBENCH_FREE GLOBAL_FREE
+    #elif ONLPBENCH_CONFIG_PORTING_STDLIB == 1
+        #define ONLPBENCH_FREE free
+    #else
+        #error The macro ONLPBENCH_FREE is required but cannot be defined.
+    #endif
+#endif
+
+#ifndef ONLPBENCH_MEMSET
+    #if defined(GLOBAL_MEMSET)
+        #define ONLPBENCH_MEMSET GLOBAL_MEMSET
+    #elif ONLPBENCH_CONFIG_PORTING_STDLIB == 1
+        #define ONLPBENCH_MEMSET memset
+    #else
+        #error The macro ONLPBENCH_MEMSET is required but cannot be defined.
+    #endif
+#endif
+
+#ifndef ONLPBENCH_MEMCPY
+    #if defined(GLOBAL_MEMCPY)
+        #define ONLPBENCH_MEMCPY GLOBAL_MEMCPY
+    #elif ONLPBENCH_CONFIG_PORTING_STDLIB == 1
+        #define ONLPBENCH_MEMCPY memcpy
+    #else
+        #error The macro ONLPBENCH_MEMCPY is required but cannot be defined.
+    #endif
+#endif
+
+#ifndef ONLPBENCH_STRNCPY
+    #if defined(GLOBAL_STRNCPY)
+        #define ONLPBENCH_STRNCPY GLOBAL_STRNCPY
+    #elif ONLPBENCH_CONFIG_PORTING_STDLIB == 1
+        #define ONLPBENCH_STRNCPY strncpy
+    #else
+        #error The macro ONLPBENCH_STRNCPY is required but cannot be defined.
+    #endif
+#endif
+
+#ifndef ONLPBENCH_VSNPRINTF
+    #if defined(GLOBAL_VSNPRINTF)
+        #define ONLPBENCH_VSNPRINTF GLOBAL_VSNPRINTF
+    #elif ONLPBENCH_CONFIG_PORTING_STDLIB == 1
+        #define ONLPBENCH_VSNPRINTF vsnprintf
+    #else
+        #error The macro ONLPBENCH_VSNPRINTF is required but cannot be defined.
+    #endif
+#endif
+
+#ifndef ONLPBENCH_SNPRINTF
+    #if defined(GLOBAL_SNPRINTF)
+        #define ONLPBENCH_SNPRINTF GLOBAL_SNPRINTF
+    #elif ONLPBENCH_CONFIG_PORTING_STDLIB == 1
+        #define ONLPBENCH_SNPRINTF snprintf
+    #else
+        #error The macro ONLPBENCH_SNPRINTF is required but cannot be defined.
+    #endif
+#endif
+
+#ifndef ONLPBENCH_STRLEN
+    #if defined(GLOBAL_STRLEN)
+        #define ONLPBENCH_STRLEN GLOBAL_STRLEN
+    #elif ONLPBENCH_CONFIG_PORTING_STDLIB == 1
+        #define ONLPBENCH_STRLEN strlen
+    #else
+        #error The macro ONLPBENCH_STRLEN is required but cannot be defined.
+    #endif
+#endif
+
+/* <auto.end.portingmacro(ALL).define> */
+
+
+#endif /* __ONLPBENCH_PORTING_H__ */
+/* @} */
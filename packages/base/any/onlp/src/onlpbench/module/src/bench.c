@@ -0,0 +1,907 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * ONLP API Microbenchmarks
+ *
+ * The parent forks the worker processes and only aggregates.
+ * Every worker process initializes ONLP on its own and runs
+ * the same sequence of benchmarks on each of its threads. All
+ * worker threads in all processes meet at a process-shared
+ * barrier before and after each benchmark so they contend on
+ * the same entry point at the same time.
+ *
+ * Latency samples and counters are written to a shared
+ * anonymous mapping which the parent reads once all workers
+ * have exited.
+ *
+ ***********************************************************/
+#include <onlpbench/onlpbench_config.h>
+#include <onlp/onlp.h>
+#include <onlp/oids.h>
+#include <onlp/sys.h>
+#include <onlp/thermal.h>
+#include <onlp/fan.h>
+#include <onlp/psu.h>
+#include <onlp/led.h>
+#include <onlp/sfp.h>
+#include <onlplib/onie.h>
+#include <onlplib/file.h>
+#include <onlplib/crc32.h>
+#include <sff/sff.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "onlpbench_int.h"
+#include "onlpbench_log.h"
+
+/************************************************************
+ *
+ * Per-process benchmark environment
+ *
+ ***********************************************************/
+#define BENCH_OIDS_MAX 256
+#define BENCH_PORTS_MAX 256
+
+typedef struct bench_env_s {
+    onlp_oid_t oids[ONLP_OID_TYPE_LED + 1][BENCH_OIDS_MAX];
+    int oid_count[ONLP_OID_TYPE_LED + 1];
+
+    int ports[BENCH_PORTS_MAX];
+    int port_count;
+    int present[BENCH_PORTS_MAX];
+    int present_count;
+
+    /** SFP EEPROM image for the decoder benchmark. */
+    uint8_t sff[256];
+    /** ONIE TLV image for the decoder benchmark. */
+    uint8_t onie[256];
+    int onie_size;
+    /** Scratch file for the onlp_file_* benchmarks. */
+    char file[64];
+} bench_env_t;
+
+static int
+env_oid__(onlp_oid_t oid, void* cookie)
+{
+    bench_env_t* env = cookie;
+    int type = ONLP_OID_TYPE_GET(oid);
+
+    if(type > 0 && type <= ONLP_OID_TYPE_LED &&
+       env->oid_count[type] < BENCH_OIDS_MAX) {
+        env->oids[type][env->oid_count[type]++] = oid;
+    }
+    return 0;
+}
+
+/*
+ * A 10GBASE-SR SFP+ with valid checksums, used when no
+ * module is present to provide a real EEPROM.
+ */
+static void
+env_sff_build__(uint8_t* e)
+{
+    int i;
+
+    memset(e, 0, 256);
+    e[0] = 0x03;    /* SFP */
+    e[1] = 0x04;
+    e[2] = 0x07;    /* LC */
+    e[3] = 0x10;    /* 10GBASE-SR */
+    e[11] = 0x06;   /* 64B/66B */
+    e[12] = 0x67;   /* 10.3Gbps */
+    e[16] = 0x08;
+    e[17] = 0x03;
+    memcpy(e + 20, "ONLPBENCH       ", 16);
+    memcpy(e + 40, "SFP-10G-SR      ", 16);
+    memcpy(e + 68, "BENCH0000000001 ", 16);
+    memcpy(e + 84, "200101  ", 8);
+    for(i = 0; i < 63; i++) {
+        e[63] += e[i];
+    }
+    for(i = 64; i < 95; i++) {
+        e[95] += e[i];
+    }
+}
+
+static int
+onie_tlv__(uint8_t* p, uint8_t code, const void* value, int len)
+{
+    p[0] = code;
+    p[1] = len;
+    memcpy(p + 2, value, len);
+    return len + 2;
+}
+
+static int
+env_onie_build__(uint8_t* d)
+{
+    static const uint8_t mac[6] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55 };
+    uint32_t crc;
+    int n = 11, len;
+
+    memcpy(d, "TlvInfo", 8);
+    d[8] = 0x01;
+    n += onie_tlv__(d + n, 0x21, "onlpbench", 9);
+    n += onie_tlv__(d + n, 0x22, "BENCH-PN-01", 11);
+    n += onie_tlv__(d + n, 0x23, "BENCH0000000001", 15);
+    n += onie_tlv__(d + n, 0x24, mac, 6);
+    n += onie_tlv__(d + n, 0x25, "01/01/2020 00:00:00", 19);
+    n += onie_tlv__(d + n, 0x28, "x86-64-onlpbench-r0", 19);
+    n += onie_tlv__(d + n, 0x2B, "Open Network Linux", 18);
+
+    /* CRC TLV. The CRC covers everything up to its own value. */
+    len = n + 6 - 11;
+    d[9] = (len >> 8) & 0xFF;
+    d[10] = len & 0xFF;
+    d[n] = 0xFE;
+    d[n + 1] = 4;
+    crc = onlp_crc32(0, d, n + 2);
+    d[n + 2] = (crc >> 24) & 0xFF;
+    d[n + 3] = (crc >> 16) & 0xFF;
+    d[n + 4] = (crc >> 8) & 0xFF;
+    d[n + 5] = crc & 0xFF;
+    return n + 6;
+}
+
+static int
+env_init__(bench_env_t* env)
+{
+    int p, fd;
+    onlp_sfp_bitmap_t bmap;
+    uint8_t* data = NULL;
+
+    memset(env, 0, sizeof(*env));
+
+    onlp_oid_iterate(0, 0, env_oid__, env);
+
+    onlp_sfp_bitmap_t_init(&bmap);
+    onlp_sfp_bitmap_get(&bmap);
+    ONLP_SFP_BITMAP_ITER(&bmap, p) {
+        if(env->port_count < BENCH_PORTS_MAX) {
+            env->ports[env->port_count++] = p;
+        }
+        if(onlp_sfp_is_present(p) > 0 && env->present_count < BENCH_PORTS_MAX) {
+            env->present[env->present_count++] = p;
+        }
+    }
+
+    env_sff_build__(env->sff);
+    if(env->present_count && onlp_sfp_eeprom_read(env->present[0], &data) >= 0) {
+        memcpy(env->sff, data, 256);
+    }
+    aim_free(data);
+
+    env->onie_size = env_onie_build__(env->onie);
+
+    snprintf(env->file, sizeof(env->file), "/tmp/onlpbench.%d", getpid());
+    if((fd = open(env->file, O_CREAT|O_TRUNC|O_WRONLY, 0600)) < 0) {
+        AIM_LOG_ERROR("Could not create %s: %{errno}", env->file, errno);
+        return ONLP_STATUS_E_INTERNAL;
+    }
+    if(write(fd, "12345\n", 6) != 6) {
+        close(fd);
+        return ONLP_STATUS_E_INTERNAL;
+    }
+    close(fd);
+    return 0;
+}
+
+
+/************************************************************
+ *
+ * Benchmarks
+ *
+ ***********************************************************/
+typedef struct bench_s {
+    const char* name;
+    /** Returns the number of targets, or 0 if the benchmark does not apply. */
+    int (*targets)(bench_env_t* env);
+    /** Performs the i'th call. */
+    int (*call)(bench_env_t* env, int i);
+} bench_t;
+
+#define BENCH_OID_TARGETS(_type)                                \
+    static int targets_##_type##__(bench_env_t* env)            \
+    {                                                           \
+        return env->oid_count[ONLP_OID_TYPE_##_type];           \
+    }
+BENCH_OID_TARGETS(THERMAL)
+BENCH_OID_TARGETS(FAN)
+BENCH_OID_TARGETS(PSU)
+BENCH_OID_TARGETS(LED)
+
+#define BENCH_OID(_env, _type, _i)                                      \
+    ((_env)->oids[ONLP_OID_TYPE_##_type][(_i) % (_env)->oid_count[ONLP_OID_TYPE_##_type]])
+
+static int
+targets_one__(bench_env_t* env)
+{
+    return 1;
+}
+
+static int
+targets_ports__(bench_env_t* env)
+{
+    return env->port_count;
+}
+
+static int
+targets_present__(bench_env_t* env)
+{
+    return env->present_count;
+}
+
+static int
+call_thermal__(bench_env_t* env, int i)
+{
+    onlp_thermal_info_t info;
+    return onlp_thermal_info_get(BENCH_OID(env, THERMAL, i), &info);
+}
+
+static int
+call_fan__(bench_env_t* env, int i)
+{
+    onlp_fan_info_t info;
+    return onlp_fan_info_get(BENCH_OID(env, FAN, i), &info);
+}
+
+static int
+call_psu__(bench_env_t* env, int i)
+{
+    onlp_psu_info_t info;
+    return onlp_psu_info_get(BENCH_OID(env, PSU, i), &info);
+}
+
+static int
+call_led__(bench_env_t* env, int i)
+{
+    onlp_led_info_t info;
+    return onlp_led_info_get(BENCH_OID(env, LED, i), &info);
+}
+
+static int
+call_sys__(bench_env_t* env, int i)
+{
+    onlp_sys_info_t info;
+    int rv = onlp_sys_info_get(&info);
+    if(rv >= 0) {
+        onlp_sys_info_free(&info);
+    }
+    return rv;
+}
+
+static int
+iterate_noop__(onlp_oid_t oid, void* cookie)
+{
+    return 0;
+}
+
+static int
+call_oid_iterate__(bench_env_t* env, int i)
+{
+    return onlp_oid_iterate(0, 0, iterate_noop__, NULL);
+}
+
+static int
+call_sfp_present__(bench_env_t* env, int i)
+{
+    return onlp_sfp_is_present(env->ports[i % env->port_count]);
+}
+
+static int
+call_sfp_presence_bitmap__(bench_env_t* env, int i)
+{
+    onlp_sfp_bitmap_t bmap;
+    onlp_sfp_bitmap_t_init(&bmap);
+    return onlp_sfp_presence_bitmap_get(&bmap);
+}
+
+static int
+call_sfp_eeprom__(bench_env_t* env, int i)
+{
+    uint8_t* data = NULL;
+    int rv = onlp_sfp_eeprom_read(env->present[i % env->present_count], &data);
+    aim_free(data);
+    return rv;
+}
+
+static int
+call_sff_parse__(bench_env_t* env, int i)
+{
+    sff_eeprom_t se;
+    return sff_eeprom_parse(&se, env->sff);
+}
+
+static int
+call_onie_decode__(bench_env_t* env, int i)
+{
+    onlp_onie_info_t info;
+    int rv = onlp_onie_decode(&info, env->onie, env->onie_size);
+    if(rv >= 0) {
+        onlp_onie_info_free(&info);
+    }
+    return rv;
+}
+
+static int
+call_file_read__(bench_env_t* env, int i)
+{
+    uint8_t buf[32];
+    int len;
+    return onlp_file_read(buf, sizeof(buf), &len, "%s", env->file);
+}
+
+static int
+call_file_read_int__(bench_env_t* env, int i)
+{
+    int v;
+    return onlp_file_read_int(&v, "%s", env->file);
+}
+
+static const bench_t benches__[] = {
+    { "thermal_info_get", targets_THERMAL__, call_thermal__ },
+    { "fan_info_get", targets_FAN__, call_fan__ },
+    { "psu_info_get", targets_PSU__, call_psu__ },
+    { "led_info_get", targets_LED__, call_led__ },
+    { "sys_info_get", targets_one__, call_sys__ },
+    { "oid_iterate", targets_one__, call_oid_iterate__ },
+    { "sfp_is_present", targets_ports__, call_sfp_present__ },
+    { "sfp_presence_bitmap_get", targets_ports__, call_sfp_presence_bitmap__ },
+    { "sfp_eeprom_read", targets_present__, call_sfp_eeprom__ },
+    { "sff_eeprom_parse", targets_one__, call_sff_parse__ },
+    { "onie_decode", targets_one__, call_onie_decode__ },
+    { "file_read", targets_one__, call_file_read__ },
+    { "file_read_int", targets_one__, call_file_read_int__ },
+};
+
+#define BENCH_COUNT AIM_ARRAYSIZE(benches__)
+
+
+/************************************************************
+ *
+ * Syscall counting
+ *
+ * The raw_syscalls:sys_enter tracepoint is counted for the
+ * calling thread when perf events are available. Otherwise
+ * the read and write syscall counts from the task's I/O
+ * accounting are used, which miss ioctl() and friends.
+ *
+ ***********************************************************/
+typedef enum syscall_source_e {
+    SYSCALL_SOURCE_NONE,
+    SYSCALL_SOURCE_PERF,
+    SYSCALL_SOURCE_IO,
+} syscall_source_t;
+
+static const char* syscall_source_names__[] = { "none", "perf", "io" };
+
+typedef struct syscall_counter_s {
+    syscall_source_t source;
+    int fd;
+    /** Syscalls made by one snapshot pair itself. */
+    uint64_t overhead;
+} syscall_counter_t;
+
+static int
+tracepoint_id__(void)
+{
+    static const char* paths[] = {
+        "/sys/kernel/tracing/events/raw_syscalls/sys_enter/id",
+        "/sys/kernel/debug/tracing/events/raw_syscalls/sys_enter/id",
+        NULL
+    };
+    const char** p;
+    int id;
+
+    for(p = paths; *p; p++) {
+        FILE* fp = fopen(*p, "r");
+        if(fp) {
+            int rv = fscanf(fp, "%d", &id);
+            fclose(fp);
+            if(rv == 1) {
+                return id;
+            }
+        }
+    }
+    return -1;
+}
+
+static uint64_t
+syscall_snapshot__(syscall_counter_t* sc)
+{
+    uint64_t v = 0;
+
+    if(sc->source == SYSCALL_SOURCE_PERF) {
+        if(read(sc->fd, &v, sizeof(v)) != sizeof(v)) {
+            v = 0;
+        }
+    }
+    else if(sc->source == SYSCALL_SOURCE_IO) {
+        char buf[256];
+        char* s;
+        int n;
+
+        if(lseek(sc->fd, 0, SEEK_SET) == 0 &&
+           (n = read(sc->fd, buf, sizeof(buf) - 1)) > 0) {
+            buf[n] = 0;
+            if((s = strstr(buf, "syscr:"))) {
+                v += strtoull(s + 6, NULL, 10);
+            }
+            if((s = strstr(buf, "syscw:"))) {
+                v += strtoull(s + 6, NULL, 10);
+            }
+        }
+    }
+    return v;
+}
+
+/* Must be called by the thread to be measured. */
+static void
+syscall_counter_init__(syscall_counter_t* sc, int tpid)
+{
+    uint64_t a, b;
+
+    memset(sc, 0, sizeof(*sc));
+    sc->fd = -1;
+
+    if(tpid >= 0) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_TRACEPOINT;
+        attr.size = sizeof(attr);
+        attr.config = tpid;
+        attr.sample_period = 1;
+        sc->fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if(sc->fd >= 0) {
+            sc->source = SYSCALL_SOURCE_PERF;
+        }
+    }
+
+    if(sc->fd < 0) {
+        char path[64];
+        snprintf(path, sizeof(path), "/proc/self/task/%ld/io", (long)syscall(SYS_gettid));
+        if((sc->fd = open(path, O_RDONLY)) >= 0) {
+            sc->source = SYSCALL_SOURCE_IO;
+        }
+    }
+
+    a = syscall_snapshot__(sc);
+    b = syscall_snapshot__(sc);
+    sc->overhead = b - a;
+}
+
+static void
+syscall_counter_denit__(syscall_counter_t* sc)
+{
+    if(sc->fd >= 0) {
+        close(sc->fd);
+    }
+}
+
+
+/************************************************************
+ *
+ * Shared results
+ *
+ ***********************************************************/
+typedef struct worker_result_s {
+    uint64_t calls;
+    uint64_t errors;
+    uint64_t total_ns;
+    uint64_t syscalls;
+    uint64_t allocs;
+    uint64_t alloc_bytes;
+} worker_result_t;
+
+typedef struct bench_shared_s {
+    pthread_barrier_t barrier;
+    int skipped[BENCH_COUNT];
+    syscall_source_t syscall_source;
+    int allocs_counted;
+    /** [bench][worker] */
+    worker_result_t results[];
+} bench_shared_t;
+
+typedef struct bench_config_s {
+    int processes;
+    int threads;
+    int iterations;
+    int warmup;
+    /** Selected benchmarks. */
+    int selected[BENCH_COUNT];
+    int tpid;
+
+    int workers;
+    bench_shared_t* shared;
+    /** [bench][worker][iteration] latency in nanoseconds */
+    uint32_t* samples;
+} bench_config_t;
+
+#define RESULT(_cfg, _b, _w) \
+    ((_cfg)->shared->results + (_b) * (_cfg)->workers + (_w))
+
+#define SAMPLES(_cfg, _b, _w) \
+    ((_cfg)->samples + ((uint64_t)(_b) * (_cfg)->workers + (_w)) * (_cfg)->iterations)
+
+static inline uint64_t
+now_ns__(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+
+/************************************************************
+ *
+ * Workers
+ *
+ ***********************************************************/
+typedef struct worker_s {
+    bench_config_t* cfg;
+    bench_env_t* env;
+    int id;
+    pthread_t thread;
+} worker_t;
+
+static void*
+worker_thread__(void* arg)
+{
+    worker_t* w = arg;
+    bench_config_t* cfg = w->cfg;
+    syscall_counter_t sc;
+    int b, i;
+
+    syscall_counter_init__(&sc, cfg->tpid);
+    if(w->id == 0) {
+        cfg->shared->syscall_source = sc.source;
+    }
+
+    for(b = 0; b < BENCH_COUNT; b++) {
+        const bench_t* bench = benches__ + b;
+        worker_result_t* r = RESULT(cfg, b, w->id);
+        uint32_t* samples = SAMPLES(cfg, b, w->id);
+        onlpbench_alloc_counters_t a0, a1;
+        uint64_t s0, s1;
+
+        if(!cfg->selected[b]) {
+            continue;
+        }
+
+        if(bench->targets(w->env) == 0) {
+            if(w->id == 0) {
+                cfg->shared->skipped[b] = 1;
+            }
+            pthread_barrier_wait(&cfg->shared->barrier);
+            pthread_barrier_wait(&cfg->shared->barrier);
+            continue;
+        }
+
+        for(i = 0; i < cfg->warmup; i++) {
+            bench->call(w->env, i);
+        }
+
+        pthread_barrier_wait(&cfg->shared->barrier);
+
+        cfg->shared->allocs_counted = onlpbench_alloc_counters_get(&a0);
+        s0 = syscall_snapshot__(&sc);
+        for(i = 0; i < cfg->iterations; i++) {
+            uint64_t t0 = now_ns__();
+            int rv = bench->call(w->env, i);
+            uint64_t ns = now_ns__() - t0;
+            samples[i] = (ns > UINT32_MAX) ? UINT32_MAX : ns;
+            r->total_ns += ns;
+            if(rv < 0) {
+                r->errors++;
+            }
+        }
+        s1 = syscall_snapshot__(&sc);
+        onlpbench_alloc_counters_get(&a1);
+
+        r->calls = cfg->iterations;
+        r->syscalls = (s1 - s0 > sc.overhead) ? s1 - s0 - sc.overhead : 0;
+        r->allocs = a1.count - a0.count;
+        r->alloc_bytes = a1.bytes - a0.bytes;
+
+        pthread_barrier_wait(&cfg->shared->barrier);
+    }
+
+    syscall_counter_denit__(&sc);
+    return NULL;
+}
+
+static int
+worker_process__(bench_config_t* cfg, int p)
+{
+    bench_env_t* env = aim_zmalloc(sizeof(*env));
+    worker_t* workers = aim_zmalloc(sizeof(worker_t) * cfg->threads);
+    int t, rv;
+
+    onlp_init();
+    if((rv = env_init__(env)) < 0) {
+        return rv;
+    }
+
+    for(t = 0; t < cfg->threads; t++) {
+        workers[t].cfg = cfg;
+        workers[t].env = env;
+        workers[t].id = p * cfg->threads + t;
+        pthread_create(&workers[t].thread, NULL, worker_thread__, workers + t);
+    }
+    for(t = 0; t < cfg->threads; t++) {
+        pthread_join(workers[t].thread, NULL);
+    }
+
+    unlink(env->file);
+    aim_free(workers);
+    aim_free(env);
+    return 0;
+}
+
+
+/************************************************************
+ *
+ * Reporting
+ *
+ ***********************************************************/
+static int
+sample_compare__(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void
+report__(bench_config_t* cfg, aim_pvs_t* pvs)
+{
+    int b, w, first = 1;
+    uint64_t n = (uint64_t)cfg->workers * cfg->iterations;
+    uint32_t* all = aim_malloc(n * sizeof(uint32_t));
+
+    aim_printf(pvs, "{\n");
+    aim_printf(pvs, "  \"processes\": %d,\n", cfg->processes);
+    aim_printf(pvs, "  \"threads\": %d,\n", cfg->threads);
+    aim_printf(pvs, "  \"iterations\": %d,\n", cfg->iterations);
+    aim_printf(pvs, "  \"syscall_source\": \"%s\",\n",
+               syscall_source_names__[cfg->shared->syscall_source]);
+    aim_printf(pvs, "  \"alloc_counters\": %s,\n",
+               cfg->shared->allocs_counted ? "true" : "false");
+    aim_printf(pvs, "  \"results\": [");
+
+    for(b = 0; b < BENCH_COUNT; b++) {
+        worker_result_t sum;
+
+        if(!cfg->selected[b]) {
+            continue;
+        }
+
+        aim_printf(pvs, "%s\n    { \"name\": \"%s\"", first ? "" : ",", benches__[b].name);
+        first = 0;
+
+        if(cfg->shared->skipped[b]) {
+            aim_printf(pvs, ", \"skipped\": true }");
+            continue;
+        }
+
+        memset(&sum, 0, sizeof(sum));
+        for(w = 0; w < cfg->workers; w++) {
+            worker_result_t* r = RESULT(cfg, b, w);
+            memcpy(all + (uint64_t)w * cfg->iterations, SAMPLES(cfg, b, w),
+                   cfg->iterations * sizeof(uint32_t));
+            sum.calls += r->calls;
+            sum.errors += r->errors;
+            sum.total_ns += r->total_ns;
+            sum.syscalls += r->syscalls;
+            sum.allocs += r->allocs;
+            sum.alloc_bytes += r->alloc_bytes;
+        }
+        qsort(all, n, sizeof(uint32_t), sample_compare__);
+
+        aim_printf(pvs, ", \"calls\": %" PRIu64 ", \"errors\": %" PRIu64,
+                   sum.calls, sum.errors);
+        aim_printf(pvs, ", \"mean_ns\": %" PRIu64 ", \"p50_ns\": %u, \"p99_ns\": %u, \"max_ns\": %u",
+                   sum.calls ? sum.total_ns / sum.calls : 0,
+                   all[n * 50 / 100], all[n * 99 / 100], all[n - 1]);
+        aim_printf(pvs, ", \"syscalls_per_call\": %.2f, \"allocs_per_call\": %.2f, \"alloc_bytes_per_call\": %.1f }",
+                   sum.calls ? (double)sum.syscalls / sum.calls : 0.0,
+                   sum.calls ? (double)sum.allocs / sum.calls : 0.0,
+                   sum.calls ? (double)sum.alloc_bytes / sum.calls : 0.0);
+    }
+    aim_printf(pvs, "\n  ]\n}\n");
+    aim_free(all);
+}
+
+
+/************************************************************
+ *
+ * Main
+ *
+ ***********************************************************/
+static int
+select__(bench_config_t* cfg, char* list)
+{
+    char* saveptr = NULL;
+    char* name;
+    int b;
+
+    memset(cfg->selected, 0, sizeof(cfg->selected));
+    for(name = strtok_r(list, ",", &saveptr); name; name = strtok_r(NULL, ",", &saveptr)) {
+        for(b = 0; b < BENCH_COUNT; b++) {
+            if(!strcmp(name, benches__[b].name)) {
+                cfg->selected[b] = 1;
+                break;
+            }
+        }
+        if(b == BENCH_COUNT) {
+            fprintf(stderr, "Unknown benchmark '%s'\n", name);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void
+usage__(const char* name)
+{
+    int b;
+    printf("usage: %s [-p processes] [-t threads] [-n iterations] [-w warmup] [-b bench,...]\n", name);
+    printf("  -p  Worker processes (default 1).\n");
+    printf("  -t  Worker threads per process (default 1).\n");
+    printf("  -n  Measured calls per worker thread (default %d).\n",
+           ONLPBENCH_CONFIG_ITERATIONS_DEFAULT);
+    printf("  -w  Unmeasured calls per worker thread before each benchmark (default 10).\n");
+    printf("  -b  Comma-separated benchmarks to run (default all).\n");
+    printf("benchmarks:\n");
+    for(b = 0; b < BENCH_COUNT; b++) {
+        printf("  %s\n", benches__[b].name);
+    }
+}
+
+int
+onlpbench_main(int argc, char* argv[])
+{
+    bench_config_t cfg;
+    pthread_barrierattr_t attr;
+    size_t shared_size, samples_size;
+    pid_t* pids;
+    int c, p, b, running, rv = 0;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.processes = 1;
+    cfg.threads = 1;
+    cfg.iterations = ONLPBENCH_CONFIG_ITERATIONS_DEFAULT;
+    cfg.warmup = 10;
+    for(b = 0; b < BENCH_COUNT; b++) {
+        cfg.selected[b] = 1;
+    }
+
+    while((c = getopt(argc, argv, "p:t:n:w:b:h")) != -1) {
+        switch(c)
+            {
+            case 'p': cfg.processes = atoi(optarg); break;
+            case 't': cfg.threads = atoi(optarg); break;
+            case 'n': cfg.iterations = atoi(optarg); break;
+            case 'w': cfg.warmup = atoi(optarg); break;
+            case 'b':
+                if(select__(&cfg, optarg) < 0) {
+                    return 1;
+                }
+                break;
+            case 'h': usage__(argv[0]); return 0;
+            default: usage__(argv[0]); return 1;
+            }
+    }
+
+    if(cfg.processes < 1 || cfg.threads < 1 || cfg.iterations < 1 || cfg.warmup < 0) {
+        usage__(argv[0]);
+        return 1;
+    }
+
+    cfg.workers = cfg.processes * cfg.threads;
+    cfg.tpid = tracepoint_id__();
+
+    shared_size = sizeof(bench_shared_t) + sizeof(worker_result_t) * BENCH_COUNT * cfg.workers;
+    samples_size = sizeof(uint32_t) * BENCH_COUNT * cfg.workers * (size_t)cfg.iterations;
+
+    cfg.shared = mmap(NULL, shared_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+    cfg.samples = mmap(NULL, samples_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+    if(cfg.shared == MAP_FAILED || cfg.samples == MAP_FAILED) {
+        AIM_LOG_ERROR("Could not map %zu bytes of results.", shared_size + samples_size);
+        return 1;
+    }
+
+    pthread_barrierattr_init(&attr);
+    pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_barrier_init(&cfg.shared->barrier, &attr, cfg.workers);
+    pthread_barrierattr_destroy(&attr);
+
+    /* Flush before forking so buffered output is not duplicated. */
+    fflush(stdout);
+    fflush(stderr);
+
+    pids = aim_zmalloc(sizeof(pid_t) * cfg.processes);
+    for(p = 0, running = 0; p < cfg.processes; p++, running++) {
+        if((pids[p] = fork()) == 0) {
+            _exit(worker_process__(&cfg, p) < 0 ? 1 : 0);
+        }
+        if(pids[p] < 0) {
+            AIM_LOG_ERROR("fork() failed: %{errno}", errno);
+            rv = 1;
+            break;
+        }
+    }
+
+    /*
+     * The remaining workers would wait at the barrier forever if
+     * any worker process failed, so the first failure ends the run.
+     */
+    if(rv) {
+        for(c = 0; c < running; c++) {
+            kill(pids[c], SIGKILL);
+        }
+    }
+    for(; running > 0; running--) {
+        int status;
+        pid_t pid = wait(&status);
+        if(pid < 0) {
+            break;
+        }
+        for(p = 0; p < cfg.processes; p++) {
+            if(pids[p] == pid) {
+                pids[p] = 0;
+            }
+        }
+        if((!WIFEXITED(status) || WEXITSTATUS(status) != 0) && rv == 0) {
+            AIM_LOG_ERROR("Worker process %d failed.", (int)pid);
+            rv = 1;
+            for(c = 0; c < cfg.processes; c++) {
+                if(pids[c] > 0) {
+                    kill(pids[c], SIGKILL);
+                }
+            }
+        }
+    }
+
+    if(rv == 0) {
+        report__(&cfg, &aim_pvs_stdout);
+    }
+
+    pthread_barrier_destroy(&cfg.shared->barrier);
+    munmap(cfg.samples, samples_size);
+    munmap(cfg.shared, shared_size);
+    aim_free(pids);
+    return rv;
+}
@@ -0,0 +1,91 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Allocation Counters
+ *
+ * malloc() and friends are interposed in the benchmark binary
+ * and forwarded to the C library. Counters are thread local so
+ * workers do not share cache lines on every allocation.
+ *
+ ***********************************************************/
+#include <onlpbench/onlpbench_config.h>
+#include <string.h>
+#include "onlpbench_int.h"
+
+#if ONLPBENCH_CONFIG_INCLUDE_MALLOC_COUNTERS == 1
+
+#include <stddef.h>
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t nmemb, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void __libc_free(void* ptr);
+
+static __thread onlpbench_alloc_counters_t counters__
+__attribute__((tls_model("initial-exec")));
+
+void*
+malloc(size_t size)
+{
+    counters__.count++;
+    counters__.bytes += size;
+    return __libc_malloc(size);
+}
+
+void*
+calloc(size_t nmemb, size_t size)
+{
+    counters__.count++;
+    counters__.bytes += nmemb * size;
+    return __libc_calloc(nmemb, size);
+}
+
+void*
+realloc(void* ptr, size_t size)
+{
+    counters__.count++;
+    counters__.bytes += size;
+    return __libc_realloc(ptr, size);
+}
+
+void
+free(void* ptr)
+{
+    __libc_free(ptr);
+}
+
+int
+onlpbench_alloc_counters_get(onlpbench_alloc_counters_t* counters)
+{
+    *counters = counters__;
+    return 1;
+}
+
+#else
+
+int
+onlpbench_alloc_counters_get(onlpbench_alloc_counters_t* counters)
+{
+    memset(counters, 0, sizeof(*counters));
+    return 0;
+}
+
+#endif
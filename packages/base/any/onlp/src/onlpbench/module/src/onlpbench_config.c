@@ -0,0 +1,106 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ * 
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.       
+ * 
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ * 
+ *        http://www.eclipse.org/legal/epl-v10.html
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ * 
+ * </bsn.cl>
+ ************************************************************
+ *
+ *
+ *
+ ***********************************************************/
+
+#include <onlpbench/onlpbench_config.h>
+
+/* <auto.start.cdefs(ONLPBENCH_CONFIG_HEADER).source> */
+#define __onlpbench_config_STRINGIFY_NAME(_x) #_x
+#define __onlpbench_config_STRINGIFY_VALUE(_x) __onlpbench_config_STRINGIFY_NAME(_x)
+onlpbench_config_settings_t onlpbench_config_settings[] =
+{
+#ifdef ONLPBENCH_CONFIG_INCLUDE_LOGGING
+    { __onlpbench_config_STRINGIFY_NAME(ONLPBENCH_CONFIG_INCLUDE_LOGGING), __onlpbench_config_STRINGIFY_VALUE(ONLPBENCH_CONFIG_INCLUDE_LOGGING) },
+#else
+{ ONLPBENCH_CONFIG_INCLUDE_LOGGING(__onlpbench_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLPBENCH_CONFIG_LOG_OPTIONS_DEFAULT
+    { __onlpbench_config_STRINGIFY_NAME(ONLPBENCH_CONFIG_LOG_OPTIONS_DEFAULT), __onlpbench_config_STRINGIFY_VALUE(ONLPBENCH_CONFIG_LOG_OPTIONS_DEFAULT) },
+#else
+{ ONLPBENCH_CONFIG_LOG_OPTIONS_DEFAULT(__onlpbench_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLPBENCH_CONFIG_LOG_BITS_DEFAULT
+    { __onlpbench_config_STRINGIFY_NAME(ONLPBENCH_CONFIG_LOG_BITS_DEFAULT), __onlpbench_config_STRINGIFY_VALUE(ONLPBENCH_CONFIG_LOG_BITS_DEFAULT) },
+#else
+{ ONLPBENCH_CONFIG_LOG_BITS_DEFAULT(__onlpbench_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLPBENCH_CONFIG_LOG_CUSTOM_BITS_DEFAULT
+    { __onlpbench_config_STRINGIFY_NAME(ONLPBENCH_CONFIG_LOG_CUSTOM_BITS_DEFAULT), __onlpbench_config_STRINGIFY_VALUE(ONLPBENCH_CONFIG_LOG_CUSTOM_BITS_DEFAULT) },
+#else
+{ ONLPBENCH_CONFIG_LOG_CUSTOM_BITS_DEFAULT(__onlpbench_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLPBENCH_CONFIG_PORTING_STDLIB
+    { __onlpbench_config_STRINGIFY_NAME(ONLPBENCH_CONFIG_PORTING_STDLIB), __onlpbench_config_STRINGIFY_VALUE(ONLPBENCH_CONFIG_PORTING_STDLIB) },
+#else
+{ ONLPBENCH_CONFIG_PORTING_STDLIB(__onlpbench_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLPBENCH_CONFIG_PORTING_INCLUDE_STDLIB_HEADERS
+    { __onlpbench_config_STRINGIFY_NAME(ONLPBENCH_CONFIG_PORTING_INCLUDE_STDLIB_HEADERS), __onlpbench_config_STRINGIFY_VALUE(ONLPBENCH_CONFIG_PORTING_INCLUDE_STDLIB_HEADERS) },
+#else
+{ ONLPBENCH_CONFIG_PORTING_INCLUDE_STDLIB_HEADERS(__onlpbench_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLPBENCH_CONFIG_INCLUDE_UCLI
+    { __onlpbench_config_STRINGIFY_NAME(ONLPBENCH_CONFIG_INCLUDE_UCLI), __onlpbench_config_STRINGIFY_VALUE(ONLPBENCH_CONFIG_INCLUDE_UCLI) },
+#else
+{ ONLPBENCH_CONFIG_INCLUDE_UCLI(__onlpbench_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLPBENCH_CONFIG_INCLUDE_MALLOC_COUNTERS
+    { __onlpbench_config_STRINGIFY_NAME(ONLPBENCH_CONFIG_INCLUDE_MALLOC_COUNTERS), __onlpbench_config_STRINGIFY_VALUE(ONLPBENCH_CONFIG_INCLUDE_MALLOC_COUNTERS) },
+#else
+{ ONLPBENCH_CONFIG_INCLUDE_MALLOC_COUNTERS(__onlpbench_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+#ifdef ONLPBENCH_CONFIG_ITERATIONS_DEFAULT
+    { __onlpbench_config_STRINGIFY_NAME(ONLPBENCH_CONFIG_ITERATIONS_DEFAULT), __onlpbench_config_STRINGIFY_VALUE(ONLPBENCH_CONFIG_ITERATIONS_DEFAULT) },
+#else
+{ ONLPBENCH_CONFIG_ITERATIONS_DEFAULT(__onlpbench_config_STRINGIFY_NAME), "__undefined__" },
+#endif
+    { NULL, NULL }
+};
+#undef __onlpbench_config_STRINGIFY_VALUE
+#undef __onlpbench_config_STRINGIFY_NAME
+
+const char*
+onlpbench_config_lookup(const char* setting)
+{
+    int i;
+    for(i = 0; onlpbench_config_settings[i].name; i++) {
+        if(strcmp(onlpbench_config_settings[i].name, setting)) {
+            return onlpbench_config_settings[i].value;
+        }
+    }
+    return NULL;
+}
+
+int
+onlpbench_config_show(struct aim_pvs_s* pvs)
+{
+    int i;
+    for(i = 0; onlpbench_config_settings[i].name; i++) {
+        aim_printf(pvs, "%s = %s\n", onlpbench_config_settings[i].name, onlpbench_config_settings[i].value);
+    }
+    return i;
+}
+
+/* <auto.end.cdefs(ONLPBENCH_CONFIG_HEADER).source> */
+
@@ -0,0 +1,48 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ * 
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.       
+ * 
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ * 
+ *        http://www.eclipse.org/legal/epl-v10.html
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ * 
+ * </bsn.cl>
+ ************************************************************
+ *
+ *
+ *
+ ***********************************************************/
+
+#ifndef __ONLPBENCH_INT_H__
+#define __ONLPBENCH_INT_H__
+
+#include <onlpbench/onlpbench_config.h>
+#include <onlpbench/onlpbench.h>
+#include <stdint.h>
+
+/**
+ * Heap allocations made by the calling thread.
+ */
+typedef struct onlpbench_alloc_counters_s {
+    uint64_t count;
+    uint64_t bytes;
+} onlpbench_alloc_counters_t;
+
+/**
+ * @brief Get the calling thread's allocation counters.
+ * @returns 0 if allocations are not being counted.
+ */
+int onlpbench_alloc_counters_get(onlpbench_alloc_counters_t* counters);
+
+
+#endif /* __ONLPBENCH_INT_H__ */
@@ -0,0 +1,8 @@
+###############################################################################
+#
+# onlpbench Unit Test Makefile.
+#
+###############################################################################
+UMODULE := onlpbench
+UMODULE_SUBDIR := $(dir $(lastword $(MAKEFILE_LIST)))
+include $(BUILDER)/utest.mk
@@ -0,0 +1,141 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Common PMBus telemetry support.
+ *
+ * The standard PSU telemetry commands are read with a single
+ * combined I2C transfer where the adapter allows it and decoded
+ * in one pass.
+ *
+ ***********************************************************/
+#ifndef __ONLPLIB_PMBUS_H__
+#define __ONLPLIB_PMBUS_H__
+
+#include <onlplib/onlplib_config.h>
+
+#if ONLPLIB_CONFIG_INCLUDE_I2C == 1
+
+#include <onlplib/i2c.h>
+#include <onlp/psu.h>
+
+/** Standard PMBus command codes. */
+#define ONLP_PMBUS_VOUT_MODE            0x20
+#define ONLP_PMBUS_READ_VIN             0x88
+#define ONLP_PMBUS_READ_IIN             0x89
+#define ONLP_PMBUS_READ_VOUT            0x8B
+#define ONLP_PMBUS_READ_IOUT            0x8C
+#define ONLP_PMBUS_READ_POUT            0x96
+#define ONLP_PMBUS_READ_PIN             0x97
+
+/**
+ * Telemetry values.
+ */
+typedef enum onlp_pmbus_telemetry_e {
+    ONLP_PMBUS_TELEMETRY_VIN,
+    ONLP_PMBUS_TELEMETRY_IIN,
+    ONLP_PMBUS_TELEMETRY_VOUT,
+    ONLP_PMBUS_TELEMETRY_IOUT,
+    ONLP_PMBUS_TELEMETRY_PIN,
+    ONLP_PMBUS_TELEMETRY_POUT,
+    ONLP_PMBUS_TELEMETRY_COUNT,
+} onlp_pmbus_telemetry_t;
+
+/** All telemetry values. */
+#define ONLP_PMBUS_TELEMETRY_ALL ((1 << ONLP_PMBUS_TELEMETRY_COUNT) - 1)
+
+/**
+ * A telemetry sample.
+ */
+typedef struct onlp_pmbus_sample_s {
+    /** Raw register values */
+    uint16_t raw[ONLP_PMBUS_TELEMETRY_COUNT];
+
+    /** Decoded values in millivolts, milliamps and milliwatts */
+    int value[ONLP_PMBUS_TELEMETRY_COUNT];
+
+    /** The values which were read, as (1 << ONLP_PMBUS_TELEMETRY_*) */
+    uint32_t valid;
+
+    /** VOUT_MODE, used to decode VOUT */
+    uint8_t vout_mode;
+
+} onlp_pmbus_sample_t;
+
+/**
+ * @brief Decode LINEAR11 values.
+ * @param raw The raw register values.
+ * @param values [out] Receives the values in milli-units.
+ * @param count The number of values.
+ */
+void onlp_pmbus_linear11_decode_many(const uint16_t* raw, int* values, int count);
+
+/**
+ * @brief Decode a LINEAR11 value.
+ * @param raw The raw register value.
+ * @returns The value in milli-units.
+ */
+int onlp_pmbus_linear11_decode(uint16_t raw);
+
+/**
+ * @brief Decode a LINEAR16 value.
+ * @param raw The raw register value.
+ * @param vout_mode The VOUT_MODE register value.
+ * @param value [out] Receives the value in milli-units.
+ * @returns ONLP_STATUS_E_UNSUPPORTED if VOUT_MODE is not linear.
+ */
+int onlp_pmbus_linear16_decode(uint16_t raw, uint8_t vout_mode, int* value);
+
+/**
+ * @brief Read PMBus telemetry.
+ * @param bus The i2c bus number.
+ * @param addr The PMBus device address.
+ * @param which The values to read, as (1 << ONLP_PMBUS_TELEMETRY_*).
+ * @param sample [out] Receives the sample.
+ * @param flags See ONLP_I2C_F_*
+ * @returns ONLP_STATUS_OK if any value was read.
+ * @note All values are read with one combined transfer if the
+ * adapter supports it and PEC is not requested. Otherwise each
+ * value is read with an SMBus word read on the same descriptor.
+ */
+int onlp_pmbus_read(int bus, uint8_t addr, uint32_t which,
+                    onlp_pmbus_sample_t* sample, uint32_t flags);
+
+/**
+ * @brief Read PMBus telemetry from a device behind muxes.
+ * @param dev The device.
+ * @param which The values to read, as (1 << ONLP_PMBUS_TELEMETRY_*).
+ * @param sample [out] Receives the sample.
+ * @param flags See ONLP_I2C_F_*
+ */
+int onlp_pmbus_dev_read(onlp_i2c_dev_t* dev, uint32_t which,
+                        onlp_pmbus_sample_t* sample, uint32_t flags);
+
+/**
+ * @brief Copy a sample into a PSU info structure.
+ * @param sample The sample.
+ * @param info [out] Receives the values and the matching capabilities.
+ */
+void onlp_pmbus_psu_info_update(const onlp_pmbus_sample_t* sample,
+                                onlp_psu_info_t* info);
+
+#endif /* ONLPLIB_CONFIG_INCLUDE_I2C */
+
+#endif /* __ONLPLIB_PMBUS_H__ */
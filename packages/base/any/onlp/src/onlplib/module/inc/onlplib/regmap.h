@@ -0,0 +1,113 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Persistent register window access.
+ *
+ * A register window is mapped once and shared by every caller
+ * that opens the same physical range. Accesses go straight to
+ * the mapping without any system calls.
+ *
+ ***********************************************************/
+#ifndef __ONLPLIB_REGMAP_H__
+#define __ONLPLIB_REGMAP_H__
+
+#include <onlplib/onlplib_config.h>
+#include <unistd.h>
+#include <sys/types.h>
+
+typedef struct onlp_regmap_s {
+    /** The register window */
+    volatile uint8_t* base;
+
+    /** The size of the register window */
+    uint32_t size;
+
+    /** The physical address of the register window */
+    off_t pa;
+
+    /** The name of the window for debugging/logging purposes */
+    const char* name;
+
+    /* Internal */
+    void* map;
+    size_t maplen;
+    int refs;
+    struct onlp_regmap_s* next;
+} onlp_regmap_t;
+
+/**
+ * @brief Open a register window.
+ * @param pa The physical address of the window.
+ * @param size The size of the window.
+ * @param name The name of the window for debugging/logging purposes.
+ * @returns The window, or NULL on error.
+ * @note The window is mapped on the first open and shared
+ * by all later opens which fit inside it.
+ */
+onlp_regmap_t* onlp_regmap_open(off_t pa, uint32_t size, const char* name);
+
+/**
+ * @brief Close a register window.
+ * @param rm The window.
+ * @note The window is unmapped when the last reference is closed.
+ */
+void onlp_regmap_close(onlp_regmap_t* rm);
+
+/**
+ * @brief Copy a block of registers.
+ * @param rm The window.
+ * @param offset The first register offset.
+ * @param[out] dst Receives the register values.
+ * @param len The number of registers to read.
+ * @returns The number of registers read, or < 0 on error.
+ * @note Each register is read exactly once, in ascending order.
+ */
+int onlp_regmap_snapshot(onlp_regmap_t* rm, uint32_t offset, uint8_t* dst, int len);
+
+/*
+ * Register accessors.
+ * The offset must be inside the window.
+ */
+static inline uint8_t
+onlp_regmap_read8(onlp_regmap_t* rm, uint32_t offset)
+{
+    return rm->base[offset];
+}
+
+static inline void
+onlp_regmap_write8(onlp_regmap_t* rm, uint32_t offset, uint8_t value)
+{
+    rm->base[offset] = value;
+}
+
+/**
+ * @brief Replace the masked bits of an 8 bit register.
+ * @returns The value written.
+ */
+static inline uint8_t
+onlp_regmap_modify8(onlp_regmap_t* rm, uint32_t offset, uint8_t mask, uint8_t value)
+{
+    uint8_t v = (onlp_regmap_read8(rm, offset) & ~mask) | (value & mask);
+    onlp_regmap_write8(rm, offset, v);
+    return v;
+}
+
+#endif /* __ONLPLIB_REGMAP_H__ */
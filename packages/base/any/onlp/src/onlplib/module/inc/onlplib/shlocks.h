@@ -31,6 +31,42 @@
 
 typedef struct onlp_shlock_s onlp_shlock_t;
 
+/**
+ * Shared lock owner information.
+ */
+typedef struct onlp_shlock_owner_s {
+    /** Owning process. Zero if the lock is not held. */
+    pid_t pid;
+    /** Owning thread */
+    pid_t tid;
+    /** What the owner is doing (e.g. the API name). May be empty. */
+    char what[64];
+    /** Monotonic time (usecs) at which the lock was taken */
+    uint64_t since;
+} onlp_shlock_owner_t;
+
+/**
+ * Shared lock contention statistics.
+ * These are shared by all processes using the global lock.
+ * Locks from onlp_shlock_create() track them per process.
+ */
+typedef struct onlp_shlock_stats_s {
+    /** Successful acquisitions */
+    uint64_t takes;
+    /** Acquisitions which had to wait for another owner */
+    uint64_t contended;
+    /** Timed or try acquisitions which failed */
+    uint64_t timeouts;
+    /** Acquisitions which recovered the lock from a dead owner */
+    uint64_t owner_died;
+    /** Total and maximum wait times for contended acquisitions (usecs) */
+    uint64_t wait_total;
+    uint64_t wait_max;
+    /** Total and maximum hold times (usecs) */
+    uint64_t hold_total;
+    uint64_t hold_max;
+} onlp_shlock_stats_t;
+
 /**
  * @brief Create or retreive a shared memory region.
  * @param id The shared memory id.
@@ -63,6 +99,43 @@ int onlp_shlock_destroy(onlp_shlock_t* shlock);
  */
 int onlp_shlock_take(onlp_shlock_t* shlock);
 
+/**
+ * @brief Take a shared memory lock with a bounded wait.
+ * @param shlock The shared lock.
+ * @param what Describes the new owner (e.g. the API name). May be NULL.
+ * @param timeout The maximum wait in microseconds. Zero only tries once.
+ * UINT64_MAX waits forever.
+ * @returns 0 if the lock was taken.
+ * @returns ONLP_STATUS_E_BUSY if the lock could not be taken in time.
+ */
+int onlp_shlock_take_timeout(onlp_shlock_t* shlock, const char* what,
+                             uint64_t timeout);
+
+/**
+ * @brief Take a shared memory lock only if it is available.
+ * @param shlock The shared lock.
+ * @param what Describes the new owner. May be NULL.
+ * @returns ONLP_STATUS_E_BUSY if the lock is held.
+ */
+int onlp_shlock_try_take(onlp_shlock_t* shlock, const char* what);
+
+/**
+ * @brief Get a shared lock's current owner and statistics.
+ * @param shlock The shared lock.
+ * @param owner Receives the owner information. May be NULL.
+ * @param stats Receives the statistics. May be NULL.
+ * @note The owner information is a snapshot and may be stale.
+ * Owners using a libonlp without owner tracking are not reported.
+ */
+int onlp_shlock_info_get(onlp_shlock_t* shlock, onlp_shlock_owner_t* owner,
+                         onlp_shlock_stats_t* stats);
+
+/**
+ * @brief Clear a shared lock's statistics.
+ * @param shlock The shared lock.
+ */
+int onlp_shlock_stats_clear(onlp_shlock_t* shlock);
+
 /**
  * @brief Give a shared memory lock.
  * @param shlock The shared lock.
@@ -82,6 +155,12 @@ const char* onlp_shlock_name(onlp_shlock_t* lock);
  */
 #define ONLP_SHLOCK_GLOBAL_KEY 0xF00DF00D
 
+/**
+ * The global lock's owner and statistics are kept in
+ * a separate segment so the lock segment layout is unchanged.
+ */
+#define ONLP_SHLOCK_GLOBAL_INFO_KEY 0xF00DF013
+
 /**
  * @brief Initialize the global lock.
  * @note You don't normally need to call this as
@@ -94,10 +173,29 @@ void onlp_shlock_global_init(void);
  */
 int onlp_shlock_global_take(void);
 
+/**
+ * @brief Take the global lock with a bounded wait.
+ * @param what Describes the new owner. May be NULL.
+ * @param timeout The maximum wait in microseconds. Zero only tries once.
+ * UINT64_MAX waits forever.
+ */
+int onlp_shlock_global_take_timeout(const char* what, uint64_t timeout);
+
 /**
  * @brief Give the global lock.
  */
 int onlp_shlock_global_give(void);
 
+/**
+ * @brief Get the global lock's owner and statistics.
+ */
+int onlp_shlock_global_info_get(onlp_shlock_owner_t* owner,
+                                onlp_shlock_stats_t* stats);
+
+/**
+ * @brief Clear the global lock's statistics.
+ */
+int onlp_shlock_global_stats_clear(void);
+
 
 #endif /* __ONLP_SHLOCKS_H__ */
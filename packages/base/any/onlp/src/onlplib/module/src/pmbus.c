@@ -0,0 +1,273 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Common PMBus telemetry support.
+ *
+ ***********************************************************/
+#include <onlplib/pmbus.h>
+
+#if ONLPLIB_CONFIG_INCLUDE_I2C == 1
+
+#include <onlp/onlp.h>
+#include "onlplib_log.h"
+#include <unistd.h>
+#include <limits.h>
+#include <sys/ioctl.h>
+
+#if ONLPLIB_CONFIG_I2C_USE_CUSTOM_HEADER == 1
+#include <linux/i2c-devices.h>
+#else
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#endif
+
+static const uint8_t telemetry_commands__[ONLP_PMBUS_TELEMETRY_COUNT] = {
+    ONLP_PMBUS_READ_VIN,
+    ONLP_PMBUS_READ_IIN,
+    ONLP_PMBUS_READ_VOUT,
+    ONLP_PMBUS_READ_IOUT,
+    ONLP_PMBUS_READ_PIN,
+    ONLP_PMBUS_READ_POUT,
+};
+
+static int
+pmbus_clamp__(int64_t v)
+{
+    return (v > INT_MAX) ? INT_MAX : (v < INT_MIN) ? INT_MIN : (int)v;
+}
+
+void
+onlp_pmbus_linear11_decode_many(const uint16_t* raw, int* values, int count)
+{
+    int i;
+
+    /* Y * 2^N with an 11 bit signed Y and a 5 bit signed N. */
+    for(i = 0; i < count; i++) {
+        int64_t y = (int16_t)(raw[i] << 5) >> 5;
+        int n = (int16_t)raw[i] >> 11;
+        int64_t v = y * 1000;
+        values[i] = pmbus_clamp__((n >= 0) ? (v << n) : (v / (1 << -n)));
+    }
+}
+
+int
+onlp_pmbus_linear11_decode(uint16_t raw)
+{
+    int v;
+    onlp_pmbus_linear11_decode_many(&raw, &v, 1);
+    return v;
+}
+
+int
+onlp_pmbus_linear16_decode(uint16_t raw, uint8_t vout_mode, int* value)
+{
+    int64_t v = (int64_t)raw * 1000;
+    int n;
+
+    /* The upper three bits select the format. Zero is linear. */
+    if(vout_mode >> 5) {
+        return ONLP_STATUS_E_UNSUPPORTED;
+    }
+
+    n = (int8_t)(vout_mode << 3) >> 3;
+    *value = pmbus_clamp__((n >= 0) ? (v << n) : (v / (1 << -n)));
+    return ONLP_STATUS_OK;
+}
+
+/*
+ * All requested commands as one I2C_RDWR transfer. This costs
+ * one bus arbitration and one system call for the whole sample.
+ */
+static int
+pmbus_read_combined__(int fd, uint8_t addr, uint32_t which,
+                      onlp_pmbus_sample_t* sample, uint32_t flags)
+{
+    struct i2c_msg msgs[2*(ONLP_PMBUS_TELEMETRY_COUNT+1)];
+    struct i2c_rdwr_ioctl_data rdwr;
+    uint8_t cmds[ONLP_PMBUS_TELEMETRY_COUNT+1];
+    uint8_t data[ONLP_PMBUS_TELEMETRY_COUNT+1][2];
+    int tids[ONLP_PMBUS_TELEMETRY_COUNT+1];
+    uint16_t mflags = (flags & ONLP_I2C_F_TENBIT) ? I2C_M_TEN : 0;
+    unsigned long funcs;
+    int i, n = 0;
+
+    if(ioctl(fd, I2C_FUNCS, &funcs) < 0 || !(funcs & I2C_FUNC_I2C)) {
+        return ONLP_STATUS_E_UNSUPPORTED;
+    }
+
+    for(i = 0; i <= ONLP_PMBUS_TELEMETRY_COUNT; i++) {
+        if(i == ONLP_PMBUS_TELEMETRY_COUNT) {
+            if(!(which & (1 << ONLP_PMBUS_TELEMETRY_VOUT))) {
+                break;
+            }
+            cmds[n] = ONLP_PMBUS_VOUT_MODE;
+        }
+        else if(which & (1 << i)) {
+            cmds[n] = telemetry_commands__[i];
+        }
+        else {
+            continue;
+        }
+        tids[n] = i;
+        msgs[2*n].addr = addr;
+        msgs[2*n].flags = mflags;
+        msgs[2*n].len = 1;
+        msgs[2*n].buf = cmds + n;
+        msgs[2*n+1].addr = addr;
+        msgs[2*n+1].flags = mflags | I2C_M_RD;
+        msgs[2*n+1].len = (i == ONLP_PMBUS_TELEMETRY_COUNT) ? 1 : 2;
+        msgs[2*n+1].buf = data[n];
+        n++;
+    }
+
+    rdwr.msgs = msgs;
+    rdwr.nmsgs = 2*n;
+    if(ioctl(fd, I2C_RDWR, &rdwr) < 0) {
+        return ONLP_STATUS_E_I2C;
+    }
+
+    for(i = 0; i < n; i++) {
+        if(tids[i] == ONLP_PMBUS_TELEMETRY_COUNT) {
+            sample->vout_mode = data[i][0];
+        }
+        else {
+            /* PMBus words are little endian. */
+            sample->raw[tids[i]] = data[i][0] | (data[i][1] << 8);
+            sample->valid |= (1 << tids[i]);
+        }
+    }
+    return ONLP_STATUS_OK;
+}
+
+/*
+ * One SMBus transaction per command. Commands which the device
+ * does not implement do not fail the sample.
+ */
+static void
+pmbus_read_smbus__(int fd, uint32_t which, onlp_pmbus_sample_t* sample)
+{
+    int i, rv;
+
+    for(i = 0; i < ONLP_PMBUS_TELEMETRY_COUNT; i++) {
+        if(which & (1 << i)) {
+            if((rv = i2c_smbus_read_word_data(fd, telemetry_commands__[i])) >= 0) {
+                sample->raw[i] = rv;
+                sample->valid |= (1 << i);
+            }
+        }
+    }
+
+    if(sample->valid & (1 << ONLP_PMBUS_TELEMETRY_VOUT)) {
+        if((rv = i2c_smbus_read_byte_data(fd, ONLP_PMBUS_VOUT_MODE)) >= 0) {
+            sample->vout_mode = rv;
+        }
+        else {
+            sample->valid &= ~(1 << ONLP_PMBUS_TELEMETRY_VOUT);
+        }
+    }
+}
+
+int
+onlp_pmbus_read(int bus, uint8_t addr, uint32_t which,
+                onlp_pmbus_sample_t* sample, uint32_t flags)
+{
+    int fd, rv = ONLP_STATUS_E_UNSUPPORTED;
+
+    ONLPLIB_MEMSET(sample, 0, sizeof(*sample));
+    which &= ONLP_PMBUS_TELEMETRY_ALL;
+
+    if((fd = onlp_i2c_open(bus, addr, flags)) < 0) {
+        return fd;
+    }
+
+    if(!(flags & ONLP_I2C_F_PEC)) {
+        rv = pmbus_read_combined__(fd, addr, which, sample, flags);
+    }
+    if(rv < 0) {
+        /* Retry each command so one unsupported command does not fail the rest. */
+        pmbus_read_smbus__(fd, which, sample);
+    }
+    close(fd);
+
+    if(sample->valid == 0) {
+        AIM_LOG_ERROR("i2c-%d: PMBus read from address 0x%x failed.", bus, addr);
+        return ONLP_STATUS_E_I2C;
+    }
+
+    onlp_pmbus_linear11_decode_many(sample->raw, sample->value,
+                                    ONLP_PMBUS_TELEMETRY_COUNT);
+    if(sample->valid & (1 << ONLP_PMBUS_TELEMETRY_VOUT)) {
+        if(onlp_pmbus_linear16_decode(sample->raw[ONLP_PMBUS_TELEMETRY_VOUT],
+                                      sample->vout_mode,
+                                      sample->value + ONLP_PMBUS_TELEMETRY_VOUT) < 0) {
+            sample->valid &= ~(1 << ONLP_PMBUS_TELEMETRY_VOUT);
+        }
+    }
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_pmbus_dev_read(onlp_i2c_dev_t* dev, uint32_t which,
+                    onlp_pmbus_sample_t* sample, uint32_t flags)
+{
+    int error, rv;
+
+    if(!(flags & ONLP_I2C_F_NO_MUX_SELECT) &&
+       (error = onlp_i2c_dev_mux_channels_select(dev)) < 0) {
+        return error;
+    }
+
+    if( (rv = onlp_pmbus_read(dev->bus, dev->addr, which, sample, flags)) < 0) {
+        AIM_LOG_ERROR("Device %s: PMBus read failed: %d", dev->name, rv);
+        return rv;
+    }
+
+    if(!(flags & ONLP_I2C_F_NO_MUX_DESELECT) &&
+       (error = onlp_i2c_dev_mux_channels_deselect(dev)) < 0) {
+        return error;
+    }
+
+    return rv;
+}
+
+void
+onlp_pmbus_psu_info_update(const onlp_pmbus_sample_t* sample,
+                           onlp_psu_info_t* info)
+{
+#define PMBUS_PSU_VALUE(_t, _field, _cap)                               \
+    do {                                                                \
+        if(sample->valid & (1 << ONLP_PMBUS_TELEMETRY_##_t)) {          \
+            info->_field = sample->value[ONLP_PMBUS_TELEMETRY_##_t];    \
+            info->caps |= ONLP_PSU_CAPS_##_cap;                         \
+        }                                                               \
+    } while(0)
+
+    PMBUS_PSU_VALUE(VIN, mvin, VIN);
+    PMBUS_PSU_VALUE(IIN, miin, IIN);
+    PMBUS_PSU_VALUE(VOUT, mvout, VOUT);
+    PMBUS_PSU_VALUE(IOUT, miout, IOUT);
+    PMBUS_PSU_VALUE(PIN, mpin, PIN);
+    PMBUS_PSU_VALUE(POUT, mpout, POUT);
+
+#undef PMBUS_PSU_VALUE
+}
+
+#endif /* ONLPLIB_CONFIG_INCLUDE_I2C */
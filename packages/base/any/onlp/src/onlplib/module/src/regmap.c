@@ -0,0 +1,173 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Persistent register window access.
+ *
+ ***********************************************************/
+#include <onlplib/regmap.h>
+#include <onlp/onlp.h>
+#include "onlplib_log.h"
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+
+/* Open windows. Protected by regmap_lock__. */
+static onlp_regmap_t* regmap_list__ = NULL;
+static pthread_mutex_t regmap_lock__ = PTHREAD_MUTEX_INITIALIZER;
+
+static onlp_regmap_t*
+regmap_find__(off_t pa, uint32_t size)
+{
+    onlp_regmap_t* rm;
+    for(rm = regmap_list__; rm; rm = rm->next) {
+        if(pa >= rm->pa && pa + size <= rm->pa + rm->size) {
+            return rm;
+        }
+    }
+    return NULL;
+}
+
+static onlp_regmap_t*
+regmap_create__(off_t pa, uint32_t size, const char* name)
+{
+    onlp_regmap_t* rm;
+    long psize = getpagesize();
+    off_t start = pa & ~((off_t)psize - 1);
+    size_t maplen = ((pa - start) + size + psize - 1) & ~(psize - 1);
+    void* map;
+    int fd;
+
+    if( (fd = open("/dev/mem", O_RDWR | O_SYNC)) < 0) {
+        AIM_LOG_ERROR("open(/dev/mem) failed: %{errno}", errno);
+        return NULL;
+    }
+
+    map = mmap(NULL, maplen, PROT_READ | PROT_WRITE, MAP_SHARED, fd, start);
+    close(fd);
+
+    if(map == MAP_FAILED) {
+        AIM_LOG_ERROR("mmap() pa=0x%llx size=%u name=%s failed: %{errno}",
+                      (unsigned long long)pa, size, name, errno);
+        return NULL;
+    }
+
+    rm = aim_zmalloc(sizeof(*rm));
+    rm->map = map;
+    rm->maplen = maplen;
+    rm->base = (volatile uint8_t*)map + (pa - start);
+    rm->pa = pa;
+    rm->size = size;
+    rm->name = name;
+    return rm;
+}
+
+onlp_regmap_t*
+onlp_regmap_open(off_t pa, uint32_t size, const char* name)
+{
+    onlp_regmap_t* rm;
+
+    if(size == 0) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&regmap_lock__);
+    if( (rm = regmap_find__(pa, size)) == NULL) {
+        if( (rm = regmap_create__(pa, size, name)) != NULL) {
+            rm->next = regmap_list__;
+            regmap_list__ = rm;
+        }
+    }
+    else if(rm->pa != pa) {
+        /*
+         * A sub-window of an existing mapping. The caller gets its
+         * own handle so offsets are relative to its own base.
+         */
+        onlp_regmap_t* parent = rm;
+        rm = aim_zmalloc(sizeof(*rm));
+        rm->base = parent->base + (pa - parent->pa);
+        rm->pa = pa;
+        rm->size = size;
+        rm->name = name;
+        rm->next = regmap_list__;
+        regmap_list__ = rm;
+        /* The sub-window keeps the parent mapping alive. */
+        parent->refs++;
+        rm->map = parent;
+    }
+    if(rm) {
+        rm->refs++;
+    }
+    pthread_mutex_unlock(&regmap_lock__);
+    return rm;
+}
+
+static void
+regmap_release__(onlp_regmap_t* rm)
+{
+    onlp_regmap_t** p;
+
+    if(--rm->refs > 0) {
+        return;
+    }
+
+    for(p = &regmap_list__; *p; p = &(*p)->next) {
+        if(*p == rm) {
+            *p = rm->next;
+            break;
+        }
+    }
+
+    if(rm->maplen) {
+        munmap(rm->map, rm->maplen);
+    }
+    else {
+        /* Sub-window */
+        regmap_release__((onlp_regmap_t*)rm->map);
+    }
+    aim_free(rm);
+}
+
+void
+onlp_regmap_close(onlp_regmap_t* rm)
+{
+    if(rm) {
+        pthread_mutex_lock(&regmap_lock__);
+        regmap_release__(rm);
+        pthread_mutex_unlock(&regmap_lock__);
+    }
+}
+
+int
+onlp_regmap_snapshot(onlp_regmap_t* rm, uint32_t offset, uint8_t* dst, int len)
+{
+    int i;
+
+    if(rm == NULL || dst == NULL || len < 0 ||
+       offset > rm->size || len > rm->size - offset) {
+        return ONLP_STATUS_E_PARAM;
+    }
+
+    for(i = 0; i < len; i++) {
+        dst[i] = rm->base[offset + i];
+    }
+    return len;
+}
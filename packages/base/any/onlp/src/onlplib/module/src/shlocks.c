@@ -24,7 +24,12 @@
  ***********************************************************/
 #include <onlplib/shlocks.h>
 #include "onlplib_log.h"
+#include <onlp/onlp.h>
+#include <AIM/aim_time.h>
 #include <sys/ipc.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <time.h>
 #include <errno.h>
 
 static int
@@ -100,17 +105,42 @@ onlp_shmem_create(key_t key, uint32_t size, void** rvmem)
 }
 
 
-struct onlp_shlock_s {
+/*
+ * The lock segment. This layout is shared with every
+ * existing libonlp binary and must not change.
+ */
+typedef struct shlock_shared_s {
     uint32_t magic;
     char name[64];
 
     pthread_mutex_t mutex;
-};
+} shlock_shared_t;
 
 #define SHLOCK_MAGIC 0xDEADBEEF
 
+/*
+ * Owner and statistics are kept in their own segment
+ * so the lock segment keeps its original layout.
+ */
+typedef struct shlock_info_s {
+    uint32_t magic;
+    /** Only modified by the owner */
+    onlp_shlock_owner_t owner;
+    /** Only modified by the owner, except for timeouts */
+    onlp_shlock_stats_t stats;
+} shlock_info_t;
+
+#define SHLOCK_INFO_MAGIC 0x5EC0DE01
+
+struct onlp_shlock_s {
+    shlock_shared_t* shared;
+    shlock_info_t* info;
+    /** Set if the info block is private to this process */
+    int info_local;
+};
+
 static void
-onlp_shlock_init__(onlp_shlock_t* l, const char* fmt, va_list vargs)
+onlp_shlock_init__(shlock_shared_t* l, const char* fmt, va_list vargs)
 {
     if(l->magic != SHLOCK_MAGIC) {
         if(shared_pthread_mutex_init__(&l->mutex) != 0) {
@@ -123,66 +153,187 @@ onlp_shlock_init__(onlp_shlock_t* l, const char* fmt, va_list vargs)
     }
 }
 
-
-int
-onlp_shlock_create(key_t id, onlp_shlock_t** rvl, const char* fmt, ...)
+/*
+ * info_id == 0 keeps the owner and statistics in this process only.
+ */
+static int
+shlock_create__(key_t id, key_t info_id, onlp_shlock_t** rvl,
+                const char* fmt, va_list vargs)
 {
+    shlock_shared_t* l = NULL;
+    onlp_shlock_t* h;
+    int rv = onlp_shmem_create(id, sizeof(shlock_shared_t), (void**)&l);
 
-    onlp_shlock_t* l = NULL;
-    int rv = onlp_shmem_create(id, sizeof(onlp_shlock_t), (void**)&l);
+    if(rv < 0) {
+        AIM_DIE("shlock_create(): shmem_create failed\n");
+        return -1;
+    }
+
+    /* Initialize if necessary */
+    onlp_shlock_init__(l, fmt, vargs);
 
-    if(rv >= 0) {
-        va_list vargs;
-        va_start(vargs, fmt);
-        /* Initialize if necessary */
-        onlp_shlock_init__(l, fmt, vargs);
-        va_end(vargs);
-        *rvl = l;
+    h = aim_zmalloc(sizeof(*h));
+    h->shared = l;
+    if(info_id == 0 ||
+       onlp_shmem_create(info_id, sizeof(shlock_info_t), (void**)&h->info) < 0) {
+        h->info = aim_zmalloc(sizeof(*h->info));
+        h->info_local = 1;
     }
-    else {
-        AIM_DIE("shlock_create(): shmem_create failed\n");
-        rv = -1;
+    if(h->info->magic != SHLOCK_INFO_MAGIC) {
+        memset(h->info, 0, sizeof(*h->info));
+        h->info->magic = SHLOCK_INFO_MAGIC;
     }
+    *rvl = h;
+    return rv;
+}
+
+int
+onlp_shlock_create(key_t id, onlp_shlock_t** rvl, const char* fmt, ...)
+{
+    int rv;
+    va_list vargs;
+    va_start(vargs, fmt);
+    rv = shlock_create__(id, 0, rvl, fmt, vargs);
+    va_end(vargs);
     return rv;
 }
 
 int
 onlp_shlock_destroy(onlp_shlock_t* shlock)
 {
-    /* Nothing at the moment. */
+    /* The shared segments are left in place for other processes. */
+    if(shlock) {
+        if(shlock->info_local) {
+            aim_free(shlock->info);
+        }
+        aim_free(shlock);
+    }
     return 0;
 }
 
-int
-onlp_shlock_take(onlp_shlock_t* shlock)
+static void
+shlock_owner_set__(onlp_shlock_t* l, const char* what, int contended,
+                   uint64_t waited)
+{
+    uint64_t now = aim_time_monotonic();
+
+    l->info->stats.takes++;
+    if(contended) {
+        l->info->stats.contended++;
+        l->info->stats.wait_total += waited;
+        if(waited > l->info->stats.wait_max) {
+            l->info->stats.wait_max = waited;
+        }
+    }
+
+    l->info->owner.pid = getpid();
+    l->info->owner.tid = syscall(SYS_gettid);
+    l->info->owner.since = now;
+    if(what) {
+        aim_strlcpy(l->info->owner.what, what, sizeof(l->info->owner.what));
+    }
+    else {
+        l->info->owner.what[0] = 0;
+    }
+}
+
+/*
+ * timeout < 0 waits forever.
+ */
+static int
+shlock_take__(onlp_shlock_t* l, const char* what, int64_t timeout)
 {
     int rv;
+    int contended = 0;
+    uint64_t t0 = 0;
+    onlp_shlock_owner_t previous;
 
-    if(shlock == NULL) {
+    if(l == NULL) {
         AIM_DIE("shlock_take(): lock is NULL");
     }
 
-    rv = pthread_mutex_lock(&shlock->mutex);
-    if(rv == 0) {
-        /* All good. */
-        return 0;
+    rv = pthread_mutex_trylock(&l->shared->mutex);
+    if(rv == EBUSY && timeout != 0) {
+        contended = 1;
+        t0 = aim_time_monotonic();
+        if(timeout < 0) {
+            rv = pthread_mutex_lock(&l->shared->mutex);
+        }
+        else {
+            /* timedlock only supports absolute CLOCK_REALTIME deadlines. */
+            struct timespec ts;
+            int64_t sec;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            sec = (int64_t)ts.tv_sec + timeout / 1000000 + 1;
+            if((time_t)sec != sec) {
+                /* The deadline does not fit in time_t (32 bit platforms). */
+                rv = pthread_mutex_lock(&l->shared->mutex);
+            }
+            else {
+                ts.tv_sec += timeout / 1000000;
+                ts.tv_nsec += (timeout % 1000000) * 1000;
+                if(ts.tv_nsec >= 1000000000) {
+                    ts.tv_sec++;
+                    ts.tv_nsec -= 1000000000;
+                }
+                rv = pthread_mutex_timedlock(&l->shared->mutex, &ts);
+            }
+        }
+    }
+
+    if(rv == EBUSY || rv == ETIMEDOUT) {
+        __atomic_fetch_add(&l->info->stats.timeouts, 1, __ATOMIC_RELAXED);
+        return ONLP_STATUS_E_BUSY;
     }
+
     if(rv == EOWNERDEAD) {
         /*
          * We got the lock, but someone else aborted while holding it.
          * No explicit recovery actions at this point.
          */
-        AIM_LOG_WARN("Detected EOWNERDEAD on take.");
-        pthread_mutex_consistent(&shlock->mutex);
-        return 0;
+        memcpy(&previous, &l->info->owner, sizeof(previous));
+        AIM_LOG_WARN("Detected EOWNERDEAD on take. The previous owner was pid %d tid %d (%s).",
+                     previous.pid, previous.tid, previous.what);
+        pthread_mutex_consistent(&l->shared->mutex);
+        l->info->stats.owner_died++;
+        rv = 0;
+    }
+
+    if(rv != 0) {
+        /*
+         * No other runtime conditions are allowed.
+         * abort to make that obvious during debugging and development.
+         */
+        AIM_DIE("mutex_lock failed: %s", strerror(rv));
+        return -1;
     }
 
-    /*
-     * No other runtime conditions are allowed.
-     * abort to make that obvious during debugging and development.
-     */
-    AIM_DIE("mutex_lock failed: %{errno}", errno);
-    return -1;
+    shlock_owner_set__(l, what, contended,
+                       (contended) ? aim_time_monotonic() - t0 : 0);
+    return 0;
+}
+
+int
+onlp_shlock_take(onlp_shlock_t* shlock)
+{
+    return shlock_take__(shlock, NULL, -1);
+}
+
+int
+onlp_shlock_take_timeout(onlp_shlock_t* shlock, const char* what,
+                         uint64_t timeout)
+{
+    /* UINT64_MAX (or anything not representable) waits forever. */
+    if(timeout > INT64_MAX) {
+        return shlock_take__(shlock, what, -1);
+    }
+    return shlock_take__(shlock, what, timeout);
+}
+
+int
+onlp_shlock_try_take(onlp_shlock_t* shlock, const char* what)
+{
+    return shlock_take__(shlock, what, 0);
 }
 
 
@@ -193,33 +344,82 @@ onlp_shlock_take(onlp_shlock_t* shlock)
 int
 onlp_shlock_give(onlp_shlock_t* shlock)
 {
+    uint64_t held;
+
     if(shlock == NULL) {
         AIM_DIE("shlock_give(): lock is NULL");
     }
 
-    if(pthread_mutex_unlock(&shlock->mutex) != 0) {
+    held = aim_time_monotonic() - shlock->info->owner.since;
+    shlock->info->stats.hold_total += held;
+    if(held > shlock->info->stats.hold_max) {
+        shlock->info->stats.hold_max = held;
+    }
+    shlock->info->owner.pid = 0;
+
+    if(pthread_mutex_unlock(&shlock->shared->mutex) != 0) {
         AIM_DIE("mutex_unlock() failed: %{errno}", errno);
         return -1;
     }
     return 0;
 }
 
+int
+onlp_shlock_info_get(onlp_shlock_t* shlock, onlp_shlock_owner_t* owner,
+                     onlp_shlock_stats_t* stats)
+{
+    if(shlock == NULL) {
+        return ONLP_STATUS_E_PARAM;
+    }
+    if(owner) {
+        memcpy(owner, &shlock->info->owner, sizeof(*owner));
+        if(owner->pid == 0) {
+            memset(owner, 0, sizeof(*owner));
+        }
+    }
+    if(stats) {
+        memcpy(stats, &shlock->info->stats, sizeof(*stats));
+    }
+    return 0;
+}
+
+int
+onlp_shlock_stats_clear(onlp_shlock_t* shlock)
+{
+    if(shlock == NULL) {
+        return ONLP_STATUS_E_PARAM;
+    }
+    memset(&shlock->info->stats, 0, sizeof(shlock->info->stats));
+    return 0;
+}
+
 const char*
 onlp_shlock_name(onlp_shlock_t* lock)
 {
-    return lock->name;
+    return lock->shared->name;
 }
 
 
 static onlp_shlock_t* global_lock__ = NULL;
 
+static int
+shlock_create_global__(onlp_shlock_t** rvl, const char* fmt, ...)
+{
+    int rv;
+    va_list vargs;
+    va_start(vargs, fmt);
+    rv = shlock_create__(ONLP_SHLOCK_GLOBAL_KEY, ONLP_SHLOCK_GLOBAL_INFO_KEY,
+                         rvl, fmt, vargs);
+    va_end(vargs);
+    return rv;
+}
+
 
 void
 onlp_shlock_global_init(void)
 {
     if(global_lock__ == NULL) {
-        if(onlp_shlock_create(ONLP_SHLOCK_GLOBAL_KEY, &global_lock__,
-                              "onlp-global-lock") < 0) {
+        if(shlock_create_global__(&global_lock__, "onlp-global-lock") < 0) {
             AIM_DIE("Global lock created failed.");
         }
     }
@@ -236,8 +436,33 @@ onlp_shlock_global_take(void)
     return onlp_shlock_take(global_lock__);
 }
 
+int
+onlp_shlock_global_take_timeout(const char* what, uint64_t timeout)
+{
+#if ONLP_CONFIG_INCLUDE_SHLOCK_GLOBAL_INIT == 0
+    onlp_shlock_global_init();
+#endif
+
+    return onlp_shlock_take_timeout(global_lock__, what, timeout);
+}
+
 int
 onlp_shlock_global_give(void)
 {
     return onlp_shlock_give(global_lock__);
 }
+
+int
+onlp_shlock_global_info_get(onlp_shlock_owner_t* owner,
+                            onlp_shlock_stats_t* stats)
+{
+    onlp_shlock_global_init();
+    return onlp_shlock_info_get(global_lock__, owner, stats);
+}
+
+int
+onlp_shlock_global_stats_clear(void)
+{
+    onlp_shlock_global_init();
+    return onlp_shlock_stats_clear(global_lock__);
+}
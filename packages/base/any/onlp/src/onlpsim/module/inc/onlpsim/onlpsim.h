@@ -0,0 +1,95 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Simulated Platform
+ *
+ * The simulated platform implements the ONLP platform interfaces
+ * against an in-memory model of a switch described by a JSON
+ * topology file. Each hardware access is charged the latency
+ * configured for its backend so that ONLP and its clients can be
+ * measured without a switch.
+ *
+ ***********************************************************/
+#ifndef __ONLPSIM_H__
+#define __ONLPSIM_H__
+
+#include <onlpsim/onlpsim_config.h>
+#include <AIM/aim_pvs.h>
+#include <stdint.h>
+
+/**
+ * Simulated hardware backends.
+ */
+typedef enum onlpsim_backend_e {
+    ONLPSIM_BACKEND_SYSFS,
+    ONLPSIM_BACKEND_I2C,
+    ONLPSIM_BACKEND_CPLD,
+    ONLPSIM_BACKEND_COUNT,
+} onlpsim_backend_t;
+
+/**
+ * Access counters for a single backend.
+ */
+typedef struct onlpsim_backend_stats_s {
+    /** Number of accesses, including failed accesses. */
+    uint64_t accesses;
+    /** Number of bytes transferred. */
+    uint64_t bytes;
+    /** Number of accesses which failed. */
+    uint64_t errors;
+    /** Total modeled latency in microseconds. */
+    uint64_t latency_us;
+} onlpsim_backend_stats_t;
+
+/**
+ * @brief Load the simulation topology.
+ * @param filename The topology file. If NULL the file named by
+ * ONLPSIM_CONFIG_TOPOLOGY_ENV or ONLPSIM_CONFIG_TOPOLOGY_FILENAME is used.
+ * @note The topology is loaded automatically on first use.
+ * Calling this again replaces the current topology.
+ */
+int onlpsim_topology_load(const char* filename);
+
+/**
+ * @brief Get the name of a backend.
+ * @param backend The backend.
+ */
+const char* onlpsim_backend_name(onlpsim_backend_t backend);
+
+/**
+ * @brief Get the access counters for a backend.
+ * @param backend The backend.
+ * @param stats [out] Receives the counters.
+ */
+int onlpsim_stats_get(onlpsim_backend_t backend, onlpsim_backend_stats_t* stats);
+
+/**
+ * @brief Clear the access counters for all backends.
+ */
+void onlpsim_stats_clear(void);
+
+/**
+ * @brief Show the access counters for all backends.
+ * @param pvs The output pvs.
+ */
+void onlpsim_stats_show(aim_pvs_t* pvs);
+
+#endif /* __ONLPSIM_H__ */
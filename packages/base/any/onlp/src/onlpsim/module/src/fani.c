@@ -0,0 +1,102 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Simulated Fans
+ *
+ ***********************************************************/
+#include <onlp/platformi/fani.h>
+#include <string.h>
+#include "onlpsim_int.h"
+#include "onlpsim_log.h"
+
+static onlpsim_fan_t*
+fan_get__(onlp_oid_t id)
+{
+    int fid = ONLP_OID_ID_GET(id);
+    onlpsim_topology_t* t = onlpsim_topology_get();
+    return (fid >= 1 && fid <= t->fan_count) ? t->fans + fid - 1 : NULL;
+}
+
+int
+onlp_fani_init(void)
+{
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_fani_info_get(onlp_oid_t id, onlp_fan_info_t* info)
+{
+    int rv;
+    onlpsim_fan_t* fan = fan_get__(id);
+
+    if(fan == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+
+    memset(info, 0, sizeof(*info));
+    info->hdr.id = id;
+    ONLPSIM_STRNCPY(info->hdr.description, fan->description,
+                    sizeof(info->hdr.description) - 1);
+
+    /* Fans without a presence bit are always present. */
+    if((rv = onlpsim_cpld_bit_get(&fan->present, 1)) < 0) {
+        return rv;
+    }
+    if(rv == 0) {
+        return ONLP_STATUS_OK;
+    }
+    info->status |= ONLP_FAN_STATUS_PRESENT;
+
+    if((rv = onlpsim_cpld_bit_get(&fan->failed, 0)) < 0) {
+        return rv;
+    }
+    if(rv) {
+        info->status |= ONLP_FAN_STATUS_FAILED;
+    }
+
+    if(fan->rpm_path) {
+        info->caps |= ONLP_FAN_CAPS_GET_RPM;
+        if((rv = onlpsim_sysfs_read_int(fan->rpm_path, &info->rpm)) < 0) {
+            return rv;
+        }
+    }
+    if(fan->percentage_path) {
+        info->caps |= ONLP_FAN_CAPS_GET_PERCENTAGE | ONLP_FAN_CAPS_SET_PERCENTAGE;
+        if((rv = onlpsim_sysfs_read_int(fan->percentage_path, &info->percentage)) < 0) {
+            return rv;
+        }
+    }
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_fani_percentage_set(onlp_oid_t id, int p)
+{
+    onlpsim_fan_t* fan = fan_get__(id);
+
+    if(fan == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+    if(fan->percentage_path == NULL) {
+        return ONLP_STATUS_E_UNSUPPORTED;
+    }
+    return onlpsim_sysfs_write_int(fan->percentage_path, p);
+}
@@ -0,0 +1,170 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Simulated LEDs
+ *
+ ***********************************************************/
+#include <onlp/platformi/ledi.h>
+#include <string.h>
+#include "onlpsim_int.h"
+#include "onlpsim_log.h"
+
+static onlpsim_led_t*
+led_get__(onlp_oid_t id)
+{
+    int lid = ONLP_OID_ID_GET(id);
+    onlpsim_topology_t* t = onlpsim_topology_get();
+    return (lid >= 1 && lid <= t->led_count) ? t->leds + lid - 1 : NULL;
+}
+
+int
+onlp_ledi_init(void)
+{
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_ledi_info_get(onlp_oid_t id, onlp_led_info_t* info)
+{
+    int v;
+    onlpsim_led_t* led = led_get__(id);
+
+    if(led == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+
+    memset(info, 0, sizeof(*info));
+    info->hdr.id = id;
+    ONLPSIM_STRNCPY(info->hdr.description, led->description,
+                    sizeof(info->hdr.description) - 1);
+    info->status = ONLP_LED_STATUS_PRESENT;
+    info->caps = ONLP_LED_CAPS_ON_OFF;
+
+    if((v = onlpsim_cpld_read(led->cpld, led->reg)) < 0) {
+        return v;
+    }
+    if((v & led->mask) == led->on) {
+        info->status |= ONLP_LED_STATUS_ON;
+        info->mode = ONLP_LED_MODE_ON;
+    }
+    else {
+        info->mode = ONLP_LED_MODE_OFF;
+    }
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_ledi_set(onlp_oid_t id, int on_or_off)
+{
+    int v;
+    onlpsim_led_t* led = led_get__(id);
+
+    if(led == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+    if((v = onlpsim_cpld_read(led->cpld, led->reg)) < 0) {
+        return v;
+    }
+    v &= ~led->mask;
+    if(on_or_off) {
+        v |= (led->on & led->mask);
+    }
+    return onlpsim_cpld_write(led->cpld, led->reg, v);
+}
+
+int
+onlp_ledi_mode_set(onlp_oid_t id, onlp_led_mode_t mode)
+{
+    switch(mode)
+        {
+        case ONLP_LED_MODE_ON: return onlp_ledi_set(id, 1);
+        case ONLP_LED_MODE_OFF: return onlp_ledi_set(id, 0);
+        default: return ONLP_STATUS_E_UNSUPPORTED;
+        }
+}
+
+/*
+ * One read and one write per (cpld, register).
+ */
+int
+onlp_ledi_set_many(onlp_led_update_t* updates, int count)
+{
+    int i, j, v;
+    onlpsim_led_t* led;
+
+    for(i = 0; i < count; i++) {
+        if(led_get__(updates[i].id) == NULL) {
+            updates[i].rv = ONLP_STATUS_E_INVALID;
+        }
+        else if(updates[i].mode != ONLP_LED_MODE_ON &&
+                updates[i].mode != ONLP_LED_MODE_OFF) {
+            updates[i].rv = ONLP_STATUS_E_UNSUPPORTED;
+        }
+        else {
+            updates[i].rv = ONLP_STATUS_OK;
+        }
+    }
+
+    for(i = 0; i < count; i++) {
+        if(updates[i].rv != ONLP_STATUS_OK) {
+            continue;
+        }
+        led = led_get__(updates[i].id);
+
+        /* Skip registers already written for an earlier update. */
+        for(j = 0; j < i; j++) {
+            onlpsim_led_t* l = led_get__(updates[j].id);
+            if(updates[j].rv == ONLP_STATUS_OK &&
+               l->cpld == led->cpld && l->reg == led->reg) {
+                break;
+            }
+        }
+        if(j < i) {
+            continue;
+        }
+
+        if((v = onlpsim_cpld_read(led->cpld, led->reg)) >= 0) {
+            for(j = i; j < count; j++) {
+                onlpsim_led_t* l = led_get__(updates[j].id);
+                if(updates[j].rv == ONLP_STATUS_OK &&
+                   l->cpld == led->cpld && l->reg == led->reg) {
+                    v &= ~l->mask;
+                    if(updates[j].mode == ONLP_LED_MODE_ON) {
+                        v |= (l->on & l->mask);
+                    }
+                }
+            }
+            v = onlpsim_cpld_write(led->cpld, led->reg, v);
+        }
+
+        if(v < 0) {
+            /* The whole register failed. */
+            for(j = i; j < count; j++) {
+                onlpsim_led_t* l = led_get__(updates[j].id);
+                if(updates[j].rv == ONLP_STATUS_OK &&
+                   l->cpld == led->cpld && l->reg == led->reg) {
+                    updates[j].rv = v;
+                }
+            }
+        }
+    }
+    return ONLP_STATUS_OK;
+}
@@ -0,0 +1,150 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ * 
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.       
+ * 
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ * 
+ *        http://www.eclipse.org/legal/epl-v10.html
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ * 
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Simulated Platform Internals
+ *
+ ***********************************************************/
+
+#ifndef __ONLPSIM_INT_H__
+#define __ONLPSIM_INT_H__
+
+#include <onlpsim/onlpsim_config.h>
+#include <onlpsim/onlpsim.h>
+#include <onlpsim/onlpsim_porting.h>
+#include <onlp/onlp.h>
+#include <onlp/oids.h>
+
+/**
+ * A single bit in a simulated CPLD register.
+ */
+typedef struct onlpsim_bit_s {
+    int valid;
+    int cpld;
+    int reg;
+    int bit;
+    int active_low;
+} onlpsim_bit_t;
+
+typedef struct onlpsim_thermal_s {
+    char* description;
+    /** sysfs path reporting millidegrees */
+    char* path;
+    int warning;
+    int error;
+    int shutdown;
+} onlpsim_thermal_t;
+
+typedef struct onlpsim_fan_s {
+    char* description;
+    /** sysfs path reporting the current rpm */
+    char* rpm_path;
+    /** sysfs path holding the configured percentage */
+    char* percentage_path;
+    onlpsim_bit_t present;
+    onlpsim_bit_t failed;
+} onlpsim_fan_t;
+
+typedef struct onlpsim_psu_s {
+    char* description;
+    char* model;
+    char* serial;
+    onlpsim_bit_t present;
+    onlpsim_bit_t pgood;
+} onlpsim_psu_t;
+
+typedef struct onlpsim_led_s {
+    char* description;
+    int cpld;
+    int reg;
+    int mask;
+    /** Register value (within mask) when the LED is on. */
+    int on;
+} onlpsim_led_t;
+
+typedef struct onlpsim_port_s {
+    int port;
+    onlpsim_bit_t present;
+    onlpsim_bit_t rx_los;
+    onlpsim_bit_t tx_disable;
+    /** EEPROM location */
+    int bus;
+    int address;
+} onlpsim_port_t;
+
+/**
+ * The platform model described by the topology.
+ */
+typedef struct onlpsim_topology_s {
+    char* platform;
+    char* onie;
+
+    onlpsim_thermal_t* thermals;
+    int thermal_count;
+    onlpsim_fan_t* fans;
+    int fan_count;
+    onlpsim_psu_t* psus;
+    int psu_count;
+    onlpsim_led_t* leds;
+    int led_count;
+    onlpsim_port_t* ports;
+    int port_count;
+} onlpsim_topology_t;
+
+/**
+ * @brief Get the current topology, loading it if necessary.
+ */
+onlpsim_topology_t* onlpsim_topology_get(void);
+
+/**
+ * @brief Look up the port model for an ONLP port number.
+ */
+onlpsim_port_t* onlpsim_port_get(int port);
+
+
+/* Simulated sysfs. Values are kept as strings keyed by path. */
+int onlpsim_sysfs_read(const char* path, char* dst, int len);
+int onlpsim_sysfs_read_int(const char* path, int* value);
+int onlpsim_sysfs_write(const char* path, const char* value);
+int onlpsim_sysfs_write_int(const char* path, int value);
+
+/* Simulated memory-mapped CPLDs. */
+int onlpsim_cpld_read(int cpld, int reg);
+int onlpsim_cpld_write(int cpld, int reg, uint8_t value);
+
+/**
+ * @brief Read a CPLD bit.
+ * @returns 1 if asserted, 0 if not, or < 0 on error.
+ * An invalid bit reads as 'dflt'.
+ */
+int onlpsim_cpld_bit_get(const onlpsim_bit_t* bit, int dflt);
+int onlpsim_cpld_bit_set(const onlpsim_bit_t* bit, int value);
+
+/* Simulated I2C devices. */
+int onlpsim_i2c_read(int bus, int addr, int offset, int len, uint8_t* dst);
+int onlpsim_i2c_write(int bus, int addr, int offset, int len, const uint8_t* src);
+
+/**
+ * @brief The largest I2C transfer the simulated adapter supports.
+ */
+int onlpsim_i2c_block_size(void);
+
+
+#endif /* __ONLPSIM_INT_H__ */
@@ -0,0 +1,72 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Simulated Power Supplies
+ *
+ ***********************************************************/
+#include <onlp/platformi/psui.h>
+#include <string.h>
+#include "onlpsim_int.h"
+#include "onlpsim_log.h"
+
+int
+onlp_psui_init(void)
+{
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_psui_info_get(onlp_oid_t id, onlp_psu_info_t* info)
+{
+    int rv;
+    int pid = ONLP_OID_ID_GET(id);
+    onlpsim_topology_t* t = onlpsim_topology_get();
+    onlpsim_psu_t* psu;
+
+    if(pid < 1 || pid > t->psu_count) {
+        return ONLP_STATUS_E_INVALID;
+    }
+    psu = t->psus + pid - 1;
+
+    memset(info, 0, sizeof(*info));
+    info->hdr.id = id;
+    ONLPSIM_STRNCPY(info->hdr.description, psu->description,
+                    sizeof(info->hdr.description) - 1);
+
+    if((rv = onlpsim_cpld_bit_get(&psu->present, 1)) < 0) {
+        return rv;
+    }
+    if(rv == 0) {
+        return ONLP_STATUS_OK;
+    }
+    info->status |= ONLP_PSU_STATUS_PRESENT;
+
+    if((rv = onlpsim_cpld_bit_get(&psu->pgood, 1)) < 0) {
+        return rv;
+    }
+    if(rv == 0) {
+        info->status |= ONLP_PSU_STATUS_UNPLUGGED;
+    }
+
+    ONLPSIM_STRNCPY(info->model, psu->model, sizeof(info->model) - 1);
+    ONLPSIM_STRNCPY(info->serial, psu->serial, sizeof(info->serial) - 1);
+    return ONLP_STATUS_OK;
+}
@@ -0,0 +1,213 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Simulated SFP Ports
+ *
+ ***********************************************************/
+#include <onlp/platformi/sfpi.h>
+#include <string.h>
+#include "onlpsim_int.h"
+#include "onlpsim_log.h"
+
+int
+onlp_sfpi_init(void)
+{
+    onlpsim_topology_get();
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_sfpi_bitmap_get(onlp_sfp_bitmap_t* bmap)
+{
+    int i;
+    onlpsim_topology_t* t = onlpsim_topology_get();
+
+    AIM_BITMAP_CLR_ALL(bmap);
+    for(i = 0; i < t->port_count; i++) {
+        AIM_BITMAP_SET(bmap, t->ports[i].port);
+    }
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_sfpi_is_present(int port)
+{
+    onlpsim_port_t* p = onlpsim_port_get(port);
+    if(p == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+    return onlpsim_cpld_bit_get(&p->present, 1);
+}
+
+int
+onlp_sfpi_rx_los_bitmap_get(onlp_sfp_bitmap_t* dst)
+{
+    int i, rv;
+    onlpsim_topology_t* t = onlpsim_topology_get();
+
+    AIM_BITMAP_CLR_ALL(dst);
+    for(i = 0; i < t->port_count; i++) {
+        if((rv = onlpsim_cpld_bit_get(&t->ports[i].rx_los, 0)) < 0) {
+            return rv;
+        }
+        AIM_BITMAP_MOD(dst, t->ports[i].port, rv);
+    }
+    return ONLP_STATUS_OK;
+}
+
+/*
+ * The EEPROM is read in transfers no larger than the adapter allows.
+ * The simulated modules are flat, so only page 0 of the upper half
+ * exists. The lower half is the same for every page.
+ */
+int
+onlp_sfpi_read(int port, uint8_t devaddr, int page, int offset, int len,
+               uint8_t* dst)
+{
+    int rv, n, block;
+    onlpsim_port_t* p = onlpsim_port_get(port);
+
+    if(p == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+    if(p->bus < 0) {
+        return ONLP_STATUS_E_UNSUPPORTED;
+    }
+    if(page != ONLP_SFP_PAGE_NONE && page != 0 &&
+       offset + len > ONLP_SFP_PAGE_UPPER) {
+        return ONLP_STATUS_E_UNSUPPORTED;
+    }
+
+    block = onlpsim_i2c_block_size();
+    for(n = 0; n < len; n += rv) {
+        int count = (len - n < block) ? len - n : block;
+        rv = onlpsim_i2c_read(p->bus, devaddr, offset + n, count, dst + n);
+        if(rv < 0) {
+            return rv;
+        }
+    }
+    return len;
+}
+
+int
+onlp_sfpi_eeprom_read(int port, uint8_t data[256])
+{
+    int rv;
+    onlpsim_port_t* p = onlpsim_port_get(port);
+
+    if(p == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+    memset(data, 0, 256);
+    rv = onlp_sfpi_read(port, p->address, 0, 0, 256, data);
+    return (rv < 0) ? rv : ONLP_STATUS_OK;
+}
+
+int
+onlp_sfpi_dom_read(int port, uint8_t data[256])
+{
+    int rv;
+    memset(data, 0, 256);
+    rv = onlp_sfpi_read(port, 0x51, 0, 0, 256, data);
+    return (rv < 0) ? rv : ONLP_STATUS_OK;
+}
+
+int
+onlp_sfpi_dev_readb(int port, uint8_t devaddr, uint8_t addr)
+{
+    uint8_t v;
+    int rv = onlp_sfpi_read(port, devaddr, 0, addr, 1, &v);
+    return (rv < 0) ? rv : v;
+}
+
+int
+onlp_sfpi_dev_writeb(int port, uint8_t devaddr, uint8_t addr, uint8_t value)
+{
+    onlpsim_port_t* p = onlpsim_port_get(port);
+    if(p == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+    return onlpsim_i2c_write(p->bus, devaddr, addr, 1, &value);
+}
+
+int
+onlp_sfpi_control_supported(int port, onlp_sfp_control_t control, int* rv)
+{
+    onlpsim_port_t* p = onlpsim_port_get(port);
+
+    if(p == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+    switch(control)
+        {
+        case ONLP_SFP_CONTROL_TX_DISABLE: *rv = p->tx_disable.valid; break;
+        case ONLP_SFP_CONTROL_RX_LOS: *rv = p->rx_los.valid; break;
+        default: *rv = 0; break;
+        }
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_sfpi_control_set(int port, onlp_sfp_control_t control, int value)
+{
+    onlpsim_port_t* p = onlpsim_port_get(port);
+
+    if(p == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+    if(control != ONLP_SFP_CONTROL_TX_DISABLE) {
+        return ONLP_STATUS_E_UNSUPPORTED;
+    }
+    return onlpsim_cpld_bit_set(&p->tx_disable, value);
+}
+
+int
+onlp_sfpi_control_get(int port, onlp_sfp_control_t control, int* value)
+{
+    int rv;
+    onlpsim_port_t* p = onlpsim_port_get(port);
+
+    if(p == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+    switch(control)
+        {
+        case ONLP_SFP_CONTROL_TX_DISABLE:
+            rv = onlpsim_cpld_bit_get(&p->tx_disable, ONLP_STATUS_E_UNSUPPORTED);
+            break;
+        case ONLP_SFP_CONTROL_RX_LOS:
+            rv = onlpsim_cpld_bit_get(&p->rx_los, ONLP_STATUS_E_UNSUPPORTED);
+            break;
+        default:
+            return ONLP_STATUS_E_UNSUPPORTED;
+        }
+    if(rv < 0) {
+        return rv;
+    }
+    *value = rv;
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_sfpi_denit(void)
+{
+    return ONLP_STATUS_OK;
+}
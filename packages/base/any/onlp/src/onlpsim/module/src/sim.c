@@ -0,0 +1,950 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Simulated Hardware Backends
+ *
+ * Every access is charged the latency configured for its
+ * backend. Short delays are spun so that they are not rounded
+ * up to the scheduler tick. I2C accesses hold the bus lock for
+ * the duration of the transfer, including any mux selects, so
+ * concurrent callers serialize the way they would on a real
+ * adapter.
+ *
+ ***********************************************************/
+#include <onlpsim/onlpsim_config.h>
+#include <onlpsim/onlpsim.h>
+#include <cjson/cJSON.h>
+#include <cjson_util/cjson_util.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include "onlpsim_int.h"
+#include "onlpsim_log.h"
+
+/* Delays shorter than this are spun instead of slept. */
+#define ONLPSIM_SPIN_US_MAX 100
+
+#define ONLPSIM_DEFAULT_PLATFORM "x86-64-onlpsim-r0"
+
+/* sysfs values are stored as strings of at most this length. */
+#define ONLPSIM_SYSFS_VALUE_MAX 64
+
+typedef struct backend_config_s {
+    int latency_us;
+    /** Additional latency per byte transferred. */
+    int byte_latency_us;
+    /** Probability of an access failing. */
+    double error_rate;
+} backend_config_t;
+
+typedef struct sysfs_entry_s {
+    char* path;
+    char value[ONLPSIM_SYSFS_VALUE_MAX];
+} sysfs_entry_t;
+
+typedef struct cpld_s {
+    char* name;
+    int size;
+    uint8_t* regs;
+} cpld_t;
+
+typedef struct i2c_mux_s {
+    int bus;
+    int address;
+    /** Virtual bus for each channel. */
+    int* channels;
+    int channel_count;
+    /** Currently selected channel, or -1. */
+    int selected;
+} i2c_mux_t;
+
+typedef struct i2c_device_s {
+    int bus;
+    int address;
+    int size;
+    uint8_t* data;
+    double error_rate;
+} i2c_device_t;
+
+static struct {
+    int loaded;
+    onlpsim_topology_t topology;
+
+    backend_config_t backends[ONLPSIM_BACKEND_COUNT];
+    int i2c_block_size;
+    unsigned int seed;
+
+    sysfs_entry_t* sysfs;
+    int sysfs_count;
+    cpld_t* cplds;
+    int cpld_count;
+    i2c_mux_t* muxes;
+    int mux_count;
+    i2c_device_t* devices;
+    int device_count;
+
+    onlpsim_backend_stats_t stats[ONLPSIM_BACKEND_COUNT];
+
+    /** Protects the sysfs, cpld, and statistics state. */
+    pthread_mutex_t lock;
+    /** Held for the duration of an I2C transfer. */
+    pthread_mutex_t i2c_lock;
+} sim__ = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .i2c_lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static const char* backend_names__[ONLPSIM_BACKEND_COUNT] = {
+    "sysfs", "i2c", "cpld",
+};
+
+const char*
+onlpsim_backend_name(onlpsim_backend_t backend)
+{
+    if(backend < 0 || backend >= ONLPSIM_BACKEND_COUNT) {
+        return "invalid";
+    }
+    return backend_names__[backend];
+}
+
+
+/************************************************************
+ *
+ * Latency and accounting
+ *
+ ***********************************************************/
+static void
+delay__(int us)
+{
+    struct timespec ts;
+
+    if(us <= 0) {
+        return;
+    }
+
+    if(us < ONLPSIM_SPIN_US_MAX) {
+        uint64_t end;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        end = (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000 + us;
+        do {
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+        } while((uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000 < end);
+    }
+    else {
+        ts.tv_sec = us / 1000000;
+        ts.tv_nsec = (us % 1000000) * 1000;
+        while(nanosleep(&ts, &ts) < 0) {
+            ;
+        }
+    }
+}
+
+/*
+ * Charge one access to the given backend.
+ * Returns non-zero if the access should fail.
+ * Must be called with sim__.lock held.
+ */
+static int
+account__(onlpsim_backend_t backend, int bytes, double error_rate, int* latency)
+{
+    backend_config_t* cfg = sim__.backends + backend;
+    onlpsim_backend_stats_t* st = sim__.stats + backend;
+    int failed = 0;
+
+    *latency = cfg->latency_us + cfg->byte_latency_us * bytes;
+
+    if(error_rate <= 0) {
+        error_rate = cfg->error_rate;
+    }
+    if(error_rate >= 1 || (error_rate > 0 && rand_r(&sim__.seed) < error_rate * RAND_MAX)) {
+        failed = 1;
+    }
+
+    st->accesses++;
+    st->latency_us += *latency;
+    if(failed) {
+        st->errors++;
+    }
+    else {
+        st->bytes += bytes;
+    }
+    return failed;
+}
+
+int
+onlpsim_stats_get(onlpsim_backend_t backend, onlpsim_backend_stats_t* stats)
+{
+    if(backend < 0 || backend >= ONLPSIM_BACKEND_COUNT) {
+        return ONLP_STATUS_E_PARAM;
+    }
+    pthread_mutex_lock(&sim__.lock);
+    *stats = sim__.stats[backend];
+    pthread_mutex_unlock(&sim__.lock);
+    return ONLP_STATUS_OK;
+}
+
+void
+onlpsim_stats_clear(void)
+{
+    pthread_mutex_lock(&sim__.lock);
+    memset(sim__.stats, 0, sizeof(sim__.stats));
+    pthread_mutex_unlock(&sim__.lock);
+}
+
+void
+onlpsim_stats_show(aim_pvs_t* pvs)
+{
+    int b;
+    onlpsim_backend_stats_t st;
+
+    aim_printf(pvs, "%-8s %12s %12s %8s %14s\n",
+               "backend", "accesses", "bytes", "errors", "latency(us)");
+    for(b = 0; b < ONLPSIM_BACKEND_COUNT; b++) {
+        onlpsim_stats_get(b, &st);
+        aim_printf(pvs, "%-8s %12llu %12llu %8llu %14llu\n",
+                   backend_names__[b],
+                   (unsigned long long)st.accesses,
+                   (unsigned long long)st.bytes,
+                   (unsigned long long)st.errors,
+                   (unsigned long long)st.latency_us);
+    }
+}
+
+
+/************************************************************
+ *
+ * Topology
+ *
+ ***********************************************************/
+
+/* Numbers may be given as JSON numbers or as strings ("0x30"). */
+static int
+int_value__(cJSON* item, int dflt)
+{
+    if(item == NULL) {
+        return dflt;
+    }
+    if(item->type == cJSON_Number) {
+        return item->valueint;
+    }
+    if(item->type == cJSON_String && item->valuestring) {
+        return strtol(item->valuestring, NULL, 0);
+    }
+    return dflt;
+}
+
+static int
+int_get__(cJSON* cj, const char* name, int dflt)
+{
+    return int_value__(cJSON_GetObjectItem(cj, name), dflt);
+}
+
+static double
+double_get__(cJSON* cj, const char* name, double dflt)
+{
+    cJSON* item = cJSON_GetObjectItem(cj, name);
+    return (item && item->type == cJSON_Number) ? item->valuedouble : dflt;
+}
+
+static char*
+string_get__(cJSON* cj, const char* name, const char* dflt)
+{
+    cJSON* item = cJSON_GetObjectItem(cj, name);
+    if(item && item->type == cJSON_String) {
+        return aim_strdup(item->valuestring);
+    }
+    return dflt ? aim_strdup(dflt) : NULL;
+}
+
+static void
+bit_get__(cJSON* cj, const char* name, onlpsim_bit_t* bit)
+{
+    cJSON* item = cJSON_GetObjectItem(cj, name);
+
+    memset(bit, 0, sizeof(*bit));
+    if(item && item->type == cJSON_Object) {
+        bit->valid = 1;
+        bit->cpld = int_get__(item, "cpld", 0);
+        bit->reg = int_get__(item, "reg", 0);
+        bit->bit = int_get__(item, "bit", 0);
+        bit->active_low = int_get__(item, "active_low", 0);
+    }
+}
+
+/* Allocate a zeroed array with one entry per element of the named array. */
+static void*
+array_alloc__(cJSON* cj, const char* name, int esize, int* count, cJSON** array)
+{
+    *array = cJSON_GetObjectItem(cj, name);
+    *count = (*array) ? cJSON_GetArraySize(*array) : 0;
+    return (*count) ? aim_zmalloc(esize * (*count)) : NULL;
+}
+
+static int
+hex_decode__(const char* hex, uint8_t* dst, int size)
+{
+    int n = 0;
+    while(*hex && n < size) {
+        unsigned int b;
+        while(*hex == ' ' || *hex == ':') {
+            hex++;
+        }
+        if(hex[0] == 0 || hex[1] == 0 || sscanf(hex, "%2x", &b) != 1) {
+            break;
+        }
+        dst[n++] = b;
+        hex += 2;
+    }
+    return n;
+}
+
+static int
+device_load__(cJSON* cj, i2c_device_t* dev)
+{
+    char* s;
+
+    dev->bus = int_get__(cj, "bus", 0);
+    dev->address = int_get__(cj, "address", 0x50);
+    dev->size = int_get__(cj, "size", 256);
+    dev->error_rate = double_get__(cj, "error_rate", 0);
+    dev->data = aim_zmalloc(dev->size);
+
+    if(cjson_util_lookup_string(cj, &s, "data") == 0) {
+        hex_decode__(s, dev->data, dev->size);
+    }
+    else if(cjson_util_lookup_string(cj, &s, "file") == 0) {
+        FILE* fp = fopen(s, "r");
+        if(fp == NULL) {
+            AIM_LOG_ERROR("Could not open %s for device %d-%.4x",
+                          s, dev->bus, dev->address);
+            return ONLP_STATUS_E_INVALID;
+        }
+        if(fread(dev->data, 1, dev->size, fp) == 0) {
+            AIM_LOG_WARN("%s is empty.", s);
+        }
+        fclose(fp);
+    }
+    return 0;
+}
+
+static void
+topology_free__(void)
+{
+    int i;
+    onlpsim_topology_t* t = &sim__.topology;
+
+    for(i = 0; i < t->thermal_count; i++) {
+        aim_free(t->thermals[i].description);
+        aim_free(t->thermals[i].path);
+    }
+    for(i = 0; i < t->fan_count; i++) {
+        aim_free(t->fans[i].description);
+        aim_free(t->fans[i].rpm_path);
+        aim_free(t->fans[i].percentage_path);
+    }
+    for(i = 0; i < t->psu_count; i++) {
+        aim_free(t->psus[i].description);
+        aim_free(t->psus[i].model);
+        aim_free(t->psus[i].serial);
+    }
+    for(i = 0; i < t->led_count; i++) {
+        aim_free(t->leds[i].description);
+    }
+    aim_free(t->thermals);
+    aim_free(t->fans);
+    aim_free(t->psus);
+    aim_free(t->leds);
+    aim_free(t->ports);
+    aim_free(t->platform);
+    aim_free(t->onie);
+    memset(t, 0, sizeof(*t));
+
+    for(i = 0; i < sim__.sysfs_count; i++) {
+        aim_free(sim__.sysfs[i].path);
+    }
+    aim_free(sim__.sysfs);
+    for(i = 0; i < sim__.cpld_count; i++) {
+        aim_free(sim__.cplds[i].name);
+        aim_free(sim__.cplds[i].regs);
+    }
+    aim_free(sim__.cplds);
+    for(i = 0; i < sim__.mux_count; i++) {
+        aim_free(sim__.muxes[i].channels);
+    }
+    aim_free(sim__.muxes);
+    for(i = 0; i < sim__.device_count; i++) {
+        aim_free(sim__.devices[i].data);
+    }
+    aim_free(sim__.devices);
+
+    sim__.sysfs = NULL;
+    sim__.cplds = NULL;
+    sim__.muxes = NULL;
+    sim__.devices = NULL;
+    sim__.sysfs_count = sim__.cpld_count = 0;
+    sim__.mux_count = sim__.device_count = 0;
+    sim__.loaded = 0;
+}
+
+static void
+backends_load__(cJSON* root)
+{
+    int b;
+    cJSON* cj;
+
+    memset(sim__.backends, 0, sizeof(sim__.backends));
+    for(b = 0; b < ONLPSIM_BACKEND_COUNT; b++) {
+        if(cjson_util_lookup(root, &cj, "backends.%s", backend_names__[b]) == 0) {
+            sim__.backends[b].latency_us = int_get__(cj, "latency_us", 0);
+            sim__.backends[b].byte_latency_us = int_get__(cj, "byte_latency_us", 0);
+            sim__.backends[b].error_rate = double_get__(cj, "error_rate", 0);
+        }
+    }
+
+    sim__.i2c_block_size = 32;
+    if(cjson_util_lookup(root, &cj, "backends.i2c") == 0) {
+        sim__.i2c_block_size = int_get__(cj, "block_size", 32);
+    }
+    if(sim__.i2c_block_size <= 0 || sim__.i2c_block_size > 256) {
+        sim__.i2c_block_size = 256;
+    }
+    sim__.seed = int_get__(root, "seed", 1);
+}
+
+static int
+hardware_load__(cJSON* root)
+{
+    int i, rv = 0;
+    cJSON* cj;
+    cJSON* array;
+
+    /* "sysfs": { "<path>" : value, ... } */
+    if((cj = cJSON_GetObjectItem(root, "sysfs")) != NULL) {
+        cJSON* e;
+        sim__.sysfs_count = cJSON_GetArraySize(cj);
+        sim__.sysfs = aim_zmalloc(sizeof(sysfs_entry_t) * (sim__.sysfs_count + 1));
+        for(i = 0, e = cj->child; e; e = e->next, i++) {
+            sim__.sysfs[i].path = aim_strdup(e->string);
+            if(e->type == cJSON_String) {
+                snprintf(sim__.sysfs[i].value, ONLPSIM_SYSFS_VALUE_MAX, "%s", e->valuestring);
+            }
+            else {
+                snprintf(sim__.sysfs[i].value, ONLPSIM_SYSFS_VALUE_MAX, "%d", e->valueint);
+            }
+        }
+    }
+
+    /* "cplds": [ { "name", "size", "regs": { "0x30" : 255 } } ] */
+    sim__.cplds = array_alloc__(root, "cplds", sizeof(cpld_t), &sim__.cpld_count, &array);
+    for(i = 0; i < sim__.cpld_count; i++) {
+        cJSON* e;
+        cpld_t* c = sim__.cplds + i;
+        cj = cJSON_GetArrayItem(array, i);
+        c->name = string_get__(cj, "name", "cpld");
+        c->size = int_get__(cj, "size", 256);
+        c->regs = aim_zmalloc(c->size);
+        if((e = cJSON_GetObjectItem(cj, "regs")) != NULL) {
+            for(e = e->child; e; e = e->next) {
+                int reg = strtol(e->string, NULL, 0);
+                if(reg >= 0 && reg < c->size) {
+                    c->regs[reg] = int_value__(e, 0);
+                }
+            }
+        }
+    }
+
+    /* "i2c": { "muxes": [...], "devices": [...] } */
+    if(cjson_util_lookup(root, &cj, "i2c") == 0) {
+        cJSON* i2c = cj;
+
+        sim__.muxes = array_alloc__(i2c, "muxes", sizeof(i2c_mux_t), &sim__.mux_count, &array);
+        for(i = 0; i < sim__.mux_count; i++) {
+            int c;
+            cJSON* channels;
+            i2c_mux_t* m = sim__.muxes + i;
+            cj = cJSON_GetArrayItem(array, i);
+            m->bus = int_get__(cj, "bus", 0);
+            m->address = int_get__(cj, "address", 0x70);
+            m->selected = -1;
+            m->channels = array_alloc__(cj, "channels", sizeof(int), &m->channel_count, &channels);
+            for(c = 0; c < m->channel_count; c++) {
+                m->channels[c] = int_value__(cJSON_GetArrayItem(channels, c), -1);
+            }
+        }
+
+        sim__.devices = array_alloc__(i2c, "devices", sizeof(i2c_device_t), &sim__.device_count, &array);
+        for(i = 0; i < sim__.device_count && rv == 0; i++) {
+            rv = device_load__(cJSON_GetArrayItem(array, i), sim__.devices + i);
+        }
+    }
+
+    return rv;
+}
+
+static void
+platform_load__(cJSON* root)
+{
+    int i;
+    cJSON* array;
+    cJSON* cj;
+    char desc[ONLP_OID_DESC_SIZE];
+    onlpsim_topology_t* t = &sim__.topology;
+
+    t->platform = string_get__(root, "platform", ONLPSIM_DEFAULT_PLATFORM);
+    t->onie = string_get__(root, "onie", NULL);
+
+    t->thermals = array_alloc__(root, "thermals", sizeof(onlpsim_thermal_t), &t->thermal_count, &array);
+    for(i = 0; i < t->thermal_count; i++) {
+        onlpsim_thermal_t* e = t->thermals + i;
+        cj = cJSON_GetArrayItem(array, i);
+        snprintf(desc, sizeof(desc), "Thermal %d", i + 1);
+        e->description = string_get__(cj, "description", desc);
+        e->path = string_get__(cj, "path", NULL);
+        e->warning = int_get__(cj, "warning", 0);
+        e->error = int_get__(cj, "error", 0);
+        e->shutdown = int_get__(cj, "shutdown", 0);
+    }
+
+    t->fans = array_alloc__(root, "fans", sizeof(onlpsim_fan_t), &t->fan_count, &array);
+    for(i = 0; i < t->fan_count; i++) {
+        onlpsim_fan_t* e = t->fans + i;
+        cj = cJSON_GetArrayItem(array, i);
+        snprintf(desc, sizeof(desc), "Fan %d", i + 1);
+        e->description = string_get__(cj, "description", desc);
+        e->rpm_path = string_get__(cj, "rpm", NULL);
+        e->percentage_path = string_get__(cj, "percentage", NULL);
+        bit_get__(cj, "present", &e->present);
+        bit_get__(cj, "failed", &e->failed);
+    }
+
+    t->psus = array_alloc__(root, "psus", sizeof(onlpsim_psu_t), &t->psu_count, &array);
+    for(i = 0; i < t->psu_count; i++) {
+        onlpsim_psu_t* e = t->psus + i;
+        cj = cJSON_GetArrayItem(array, i);
+        snprintf(desc, sizeof(desc), "PSU %d", i + 1);
+        e->description = string_get__(cj, "description", desc);
+        e->model = string_get__(cj, "model", "");
+        e->serial = string_get__(cj, "serial", "");
+        bit_get__(cj, "present", &e->present);
+        bit_get__(cj, "pgood", &e->pgood);
+    }
+
+    t->leds = array_alloc__(root, "leds", sizeof(onlpsim_led_t), &t->led_count, &array);
+    for(i = 0; i < t->led_count; i++) {
+        onlpsim_led_t* e = t->leds + i;
+        cj = cJSON_GetArrayItem(array, i);
+        snprintf(desc, sizeof(desc), "LED %d", i + 1);
+        e->description = string_get__(cj, "description", desc);
+        e->cpld = int_get__(cj, "cpld", 0);
+        e->reg = int_get__(cj, "reg", 0);
+        e->mask = int_get__(cj, "mask", 0xFF);
+        e->on = int_get__(cj, "on", e->mask);
+    }
+
+    t->ports = array_alloc__(root, "ports", sizeof(onlpsim_port_t), &t->port_count, &array);
+    for(i = 0; i < t->port_count; i++) {
+        onlpsim_port_t* e = t->ports + i;
+        cj = cJSON_GetArrayItem(array, i);
+        e->port = int_get__(cj, "port", i);
+        e->bus = int_get__(cj, "bus", -1);
+        e->address = int_get__(cj, "address", 0x50);
+        bit_get__(cj, "present", &e->present);
+        bit_get__(cj, "rx_los", &e->rx_los);
+        bit_get__(cj, "tx_disable", &e->tx_disable);
+    }
+}
+
+int
+onlpsim_topology_load(const char* filename)
+{
+    int rv;
+    cJSON* root = NULL;
+
+    if(filename == NULL) {
+        filename = getenv(ONLPSIM_CONFIG_TOPOLOGY_ENV);
+    }
+    if(filename == NULL) {
+        filename = ONLPSIM_CONFIG_TOPOLOGY_FILENAME;
+    }
+
+    if((rv = cjson_util_parse_file(filename, &root)) < 0) {
+        AIM_LOG_ERROR("Could not load simulation topology %s: %{onlp_status}",
+                      filename, rv);
+        return rv;
+    }
+
+    pthread_mutex_lock(&sim__.i2c_lock);
+    pthread_mutex_lock(&sim__.lock);
+
+    topology_free__();
+    backends_load__(root);
+    platform_load__(root);
+    if((rv = hardware_load__(root)) < 0) {
+        topology_free__();
+    }
+    else {
+        sim__.loaded = 1;
+        AIM_LOG_INFO("Loaded simulation topology %s", filename);
+    }
+
+    pthread_mutex_unlock(&sim__.lock);
+    pthread_mutex_unlock(&sim__.i2c_lock);
+
+    cJSON_Delete(root);
+    return rv;
+}
+
+onlpsim_topology_t*
+onlpsim_topology_get(void)
+{
+    if(!sim__.loaded && onlpsim_topology_load(NULL) < 0) {
+        /* Run as an empty platform rather than retrying every call. */
+        pthread_mutex_lock(&sim__.lock);
+        if(!sim__.loaded) {
+            sim__.topology.platform = aim_strdup(ONLPSIM_DEFAULT_PLATFORM);
+            sim__.loaded = 1;
+        }
+        pthread_mutex_unlock(&sim__.lock);
+    }
+    return &sim__.topology;
+}
+
+onlpsim_port_t*
+onlpsim_port_get(int port)
+{
+    int i;
+    onlpsim_topology_t* t = onlpsim_topology_get();
+    for(i = 0; i < t->port_count; i++) {
+        if(t->ports[i].port == port) {
+            return t->ports + i;
+        }
+    }
+    return NULL;
+}
+
+
+/************************************************************
+ *
+ * sysfs
+ *
+ ***********************************************************/
+static sysfs_entry_t*
+sysfs_find__(const char* path)
+{
+    int i;
+    for(i = 0; i < sim__.sysfs_count; i++) {
+        if(!strcmp(sim__.sysfs[i].path, path)) {
+            return sim__.sysfs + i;
+        }
+    }
+    return NULL;
+}
+
+int
+onlpsim_sysfs_read(const char* path, char* dst, int len)
+{
+    int latency, rv;
+    sysfs_entry_t* e;
+
+    if(path == NULL) {
+        return ONLP_STATUS_E_UNSUPPORTED;
+    }
+
+    pthread_mutex_lock(&sim__.lock);
+    e = sysfs_find__(path);
+    if(e == NULL) {
+        account__(ONLPSIM_BACKEND_SYSFS, 0, 1, &latency);
+        rv = ONLP_STATUS_E_INTERNAL;
+    }
+    else if(account__(ONLPSIM_BACKEND_SYSFS, strlen(e->value), 0, &latency)) {
+        rv = ONLP_STATUS_E_INTERNAL;
+    }
+    else {
+        rv = snprintf(dst, len, "%s", e->value);
+    }
+    pthread_mutex_unlock(&sim__.lock);
+
+    delay__(latency);
+    return rv;
+}
+
+int
+onlpsim_sysfs_read_int(const char* path, int* value)
+{
+    char buf[ONLPSIM_SYSFS_VALUE_MAX];
+    int rv = onlpsim_sysfs_read(path, buf, sizeof(buf));
+    if(rv >= 0) {
+        *value = strtol(buf, NULL, 0);
+        rv = ONLP_STATUS_OK;
+    }
+    return rv;
+}
+
+int
+onlpsim_sysfs_write(const char* path, const char* value)
+{
+    int latency, rv = ONLP_STATUS_OK;
+    sysfs_entry_t* e;
+
+    if(path == NULL) {
+        return ONLP_STATUS_E_UNSUPPORTED;
+    }
+
+    pthread_mutex_lock(&sim__.lock);
+    e = sysfs_find__(path);
+    if(e == NULL) {
+        account__(ONLPSIM_BACKEND_SYSFS, 0, 1, &latency);
+        rv = ONLP_STATUS_E_INTERNAL;
+    }
+    else if(account__(ONLPSIM_BACKEND_SYSFS, strlen(value), 0, &latency)) {
+        rv = ONLP_STATUS_E_INTERNAL;
+    }
+    else {
+        snprintf(e->value, sizeof(e->value), "%s", value);
+    }
+    pthread_mutex_unlock(&sim__.lock);
+
+    delay__(latency);
+    return rv;
+}
+
+int
+onlpsim_sysfs_write_int(const char* path, int value)
+{
+    char buf[ONLPSIM_SYSFS_VALUE_MAX];
+    snprintf(buf, sizeof(buf), "%d", value);
+    return onlpsim_sysfs_write(path, buf);
+}
+
+
+/************************************************************
+ *
+ * CPLD
+ *
+ ***********************************************************/
+int
+onlpsim_cpld_read(int cpld, int reg)
+{
+    int latency, rv;
+
+    pthread_mutex_lock(&sim__.lock);
+    if(cpld < 0 || cpld >= sim__.cpld_count || reg < 0 || reg >= sim__.cplds[cpld].size) {
+        rv = ONLP_STATUS_E_PARAM;
+        latency = 0;
+    }
+    else if(account__(ONLPSIM_BACKEND_CPLD, 1, 0, &latency)) {
+        rv = ONLP_STATUS_E_INTERNAL;
+    }
+    else {
+        rv = sim__.cplds[cpld].regs[reg];
+    }
+    pthread_mutex_unlock(&sim__.lock);
+
+    delay__(latency);
+    return rv;
+}
+
+int
+onlpsim_cpld_write(int cpld, int reg, uint8_t value)
+{
+    int latency, rv = ONLP_STATUS_OK;
+
+    pthread_mutex_lock(&sim__.lock);
+    if(cpld < 0 || cpld >= sim__.cpld_count || reg < 0 || reg >= sim__.cplds[cpld].size) {
+        rv = ONLP_STATUS_E_PARAM;
+        latency = 0;
+    }
+    else if(account__(ONLPSIM_BACKEND_CPLD, 1, 0, &latency)) {
+        rv = ONLP_STATUS_E_INTERNAL;
+    }
+    else {
+        sim__.cplds[cpld].regs[reg] = value;
+    }
+    pthread_mutex_unlock(&sim__.lock);
+
+    delay__(latency);
+    return rv;
+}
+
+int
+onlpsim_cpld_bit_get(const onlpsim_bit_t* bit, int dflt)
+{
+    int v;
+
+    if(!bit->valid) {
+        return dflt;
+    }
+    if((v = onlpsim_cpld_read(bit->cpld, bit->reg)) < 0) {
+        return v;
+    }
+    v = (v >> bit->bit) & 1;
+    return bit->active_low ? !v : v;
+}
+
+int
+onlpsim_cpld_bit_set(const onlpsim_bit_t* bit, int value)
+{
+    int v;
+
+    if(!bit->valid) {
+        return ONLP_STATUS_E_UNSUPPORTED;
+    }
+    if((v = onlpsim_cpld_read(bit->cpld, bit->reg)) < 0) {
+        return v;
+    }
+    if(bit->active_low) {
+        value = !value;
+    }
+    v = value ? (v | (1 << bit->bit)) : (v & ~(1 << bit->bit));
+    return onlpsim_cpld_write(bit->cpld, bit->reg, v);
+}
+
+
+/************************************************************
+ *
+ * I2C
+ *
+ ***********************************************************/
+
+/*
+ * Route a transfer to the given (possibly virtual) bus,
+ * selecting the mux channels leading to it. Each channel change
+ * is charged as a one byte write to the mux.
+ * Must be called with the I2C lock held.
+ */
+static int
+i2c_route__(int bus, int depth)
+{
+    int i, c, rv, latency;
+
+    if(depth > 8) {
+        return ONLP_STATUS_E_INTERNAL;
+    }
+
+    for(i = 0; i < sim__.mux_count; i++) {
+        i2c_mux_t* m = sim__.muxes + i;
+        for(c = 0; c < m->channel_count; c++) {
+            if(m->channels[c] != bus) {
+                continue;
+            }
+            if((rv = i2c_route__(m->bus, depth + 1)) < 0) {
+                return rv;
+            }
+            if(m->selected != c) {
+                pthread_mutex_lock(&sim__.lock);
+                rv = account__(ONLPSIM_BACKEND_I2C, 1, 0, &latency);
+                pthread_mutex_unlock(&sim__.lock);
+                delay__(latency);
+                if(rv) {
+                    m->selected = -1;
+                    return ONLP_STATUS_E_I2C;
+                }
+                m->selected = c;
+            }
+            return 0;
+        }
+    }
+
+    /* Not behind a mux. */
+    return 0;
+}
+
+static i2c_device_t*
+i2c_device_find__(int bus, int addr)
+{
+    int i;
+    for(i = 0; i < sim__.device_count; i++) {
+        if(sim__.devices[i].bus == bus && sim__.devices[i].address == addr) {
+            return sim__.devices + i;
+        }
+    }
+    return NULL;
+}
+
+static int
+i2c_xfer__(int bus, int addr, int offset, int len, uint8_t* dst, const uint8_t* src)
+{
+    int rv, latency;
+    i2c_device_t* dev;
+
+    if(len <= 0 || len > sim__.i2c_block_size) {
+        return ONLP_STATUS_E_PARAM;
+    }
+
+    pthread_mutex_lock(&sim__.i2c_lock);
+
+    if((rv = i2c_route__(bus, 0)) < 0) {
+        goto done;
+    }
+
+    dev = i2c_device_find__(bus, addr);
+
+    pthread_mutex_lock(&sim__.lock);
+    if(dev == NULL) {
+        /* No acknowledge. The address phase is still on the wire. */
+        account__(ONLPSIM_BACKEND_I2C, 0, 1, &latency);
+        rv = ONLP_STATUS_E_I2C;
+    }
+    else if(offset < 0 || offset + len > dev->size) {
+        latency = 0;
+        rv = ONLP_STATUS_E_PARAM;
+    }
+    else if(account__(ONLPSIM_BACKEND_I2C, len, dev->error_rate, &latency)) {
+        rv = ONLP_STATUS_E_I2C;
+    }
+    else {
+        if(dst) {
+            memcpy(dst, dev->data + offset, len);
+        }
+        else {
+            memcpy(dev->data + offset, src, len);
+        }
+        rv = len;
+    }
+    pthread_mutex_unlock(&sim__.lock);
+
+    delay__(latency);
+
+ done:
+    pthread_mutex_unlock(&sim__.i2c_lock);
+    return rv;
+}
+
+int
+onlpsim_i2c_read(int bus, int addr, int offset, int len, uint8_t* dst)
+{
+    return i2c_xfer__(bus, addr, offset, len, dst, NULL);
+}
+
+int
+onlpsim_i2c_write(int bus, int addr, int offset, int len, const uint8_t* src)
+{
+    return i2c_xfer__(bus, addr, offset, len, NULL, src);
+}
+
+int
+onlpsim_i2c_block_size(void)
+{
+    onlpsim_topology_get();
+    return sim__.i2c_block_size;
+}
@@ -0,0 +1,191 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Simulated Platform System Interface
+ *
+ ***********************************************************/
+#include <onlp/platformi/sysi.h>
+#include <onlp/platformi/ledi.h>
+#include <onlplib/onie.h>
+#include <stdio.h>
+#include <string.h>
+#include "onlpsim_int.h"
+#include "onlpsim_log.h"
+
+const char*
+onlp_sysi_platform_get(void)
+{
+    return onlpsim_topology_get()->platform;
+}
+
+/*
+ * The simulator models whatever the topology describes,
+ * so it will stand in for any platform.
+ */
+int
+onlp_sysi_platform_set(const char* platform)
+{
+    AIM_LOG_INFO("Simulating platform %s as %s",
+                 platform, onlpsim_topology_get()->platform);
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_sysi_init(void)
+{
+    onlpsim_topology_get();
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_sysi_onie_info_get(onlp_onie_info_t* onie)
+{
+    const char* fname = onlpsim_topology_get()->onie;
+    if(fname == NULL) {
+        return ONLP_STATUS_E_UNSUPPORTED;
+    }
+    return onlp_onie_read_json(onie, fname);
+}
+
+int
+onlp_sysi_oids_get(onlp_oid_t* table, int max)
+{
+    int i;
+    onlp_oid_t* e = table;
+    onlp_oid_t* end = table + max;
+    onlpsim_topology_t* t = onlpsim_topology_get();
+    memset(table, 0, max*sizeof(onlp_oid_t));
+
+    for(i = 1; i <= t->thermal_count && e < end; i++) {
+        *e++ = ONLP_THERMAL_ID_CREATE(i);
+    }
+    for(i = 1; i <= t->led_count && e < end; i++) {
+        *e++ = ONLP_LED_ID_CREATE(i);
+    }
+    for(i = 1; i <= t->psu_count && e < end; i++) {
+        *e++ = ONLP_PSU_ID_CREATE(i);
+    }
+    for(i = 1; i <= t->fan_count && e < end; i++) {
+        *e++ = ONLP_FAN_ID_CREATE(i);
+    }
+    return 0;
+}
+
+int
+onlp_sysi_platform_info_get(onlp_platform_info_t* pi)
+{
+    pi->cpld_versions = aim_strdup("simulated");
+    return ONLP_STATUS_OK;
+}
+
+void
+onlp_sysi_platform_info_free(onlp_platform_info_t* pi)
+{
+    aim_free(pi->cpld_versions);
+}
+
+/*
+ * Fan speeds follow the hottest sensor: 40% below its warning
+ * threshold, 70% below its error threshold, 100% otherwise.
+ */
+int
+onlp_sysi_platform_manage_fans(void)
+{
+    int i, mc, percentage = 40;
+    onlpsim_topology_t* t = onlpsim_topology_get();
+
+    for(i = 0; i < t->thermal_count; i++) {
+        onlpsim_thermal_t* th = t->thermals + i;
+        if(onlpsim_sysfs_read_int(th->path, &mc) < 0) {
+            percentage = 100;
+            break;
+        }
+        if(th->error && mc >= th->error) {
+            percentage = 100;
+        }
+        else if(th->warning && mc >= th->warning && percentage < 70) {
+            percentage = 70;
+        }
+    }
+
+    for(i = 0; i < t->fan_count; i++) {
+        if(t->fans[i].percentage_path) {
+            onlpsim_sysfs_write_int(t->fans[i].percentage_path, percentage);
+        }
+    }
+    return ONLP_STATUS_OK;
+}
+
+/*
+ * The first LED is the system status LED. It is turned off
+ * while any fan reports a failure.
+ */
+int
+onlp_sysi_platform_manage_leds(void)
+{
+    int i, ok = 1;
+    onlpsim_topology_t* t = onlpsim_topology_get();
+
+    if(t->led_count == 0) {
+        return ONLP_STATUS_OK;
+    }
+
+    for(i = 0; i < t->fan_count; i++) {
+        if(onlpsim_cpld_bit_get(&t->fans[i].failed, 0) != 0) {
+            ok = 0;
+        }
+    }
+    return onlp_ledi_set(ONLP_LED_ID_CREATE(1), ok);
+}
+
+int
+onlp_sysi_platform_manage_domain_get(onlp_sys_pm_task_t task)
+{
+    switch(task)
+        {
+        case ONLP_SYS_PM_TASK_FANS: return ONLP_SYS_PM_DOMAIN_SYSFS;
+        case ONLP_SYS_PM_TASK_LEDS: return ONLP_SYS_PM_DOMAIN_CPLD;
+        default: return ONLP_STATUS_E_UNSUPPORTED;
+        }
+}
+
+/*
+ * onlpdump debug stats shows the backend counters.
+ * onlpdump debug clear resets them.
+ * onlpdump debug load <file> replaces the topology.
+ */
+int
+onlp_sysi_debug(aim_pvs_t* pvs, int argc, char** argv)
+{
+    if(argc == 0 || !strcmp(argv[0], "stats")) {
+        onlpsim_stats_show(pvs);
+        return 0;
+    }
+    if(!strcmp(argv[0], "clear")) {
+        onlpsim_stats_clear();
+        return 0;
+    }
+    if(!strcmp(argv[0], "load")) {
+        return onlpsim_topology_load((argc > 1) ? argv[1] : NULL);
+    }
+    aim_printf(pvs, "usage: stats | clear | load [file]\n");
+    return ONLP_STATUS_E_PARAM;
+}
@@ -0,0 +1,75 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Simulated Thermal Sensors
+ *
+ ***********************************************************/
+#include <onlp/platformi/thermali.h>
+#include <string.h>
+#include "onlpsim_int.h"
+#include "onlpsim_log.h"
+
+static onlpsim_thermal_t*
+thermal_get__(onlp_oid_t id)
+{
+    int tid = ONLP_OID_ID_GET(id);
+    onlpsim_topology_t* t = onlpsim_topology_get();
+    return (tid >= 1 && tid <= t->thermal_count) ? t->thermals + tid - 1 : NULL;
+}
+
+int
+onlp_thermali_init(void)
+{
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_thermali_info_get(onlp_oid_t id, onlp_thermal_info_t* info)
+{
+    int rv;
+    onlpsim_thermal_t* th = thermal_get__(id);
+
+    if(th == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+
+    memset(info, 0, sizeof(*info));
+    info->hdr.id = id;
+    ONLPSIM_STRNCPY(info->hdr.description, th->description,
+                    sizeof(info->hdr.description) - 1);
+    info->status = ONLP_THERMAL_STATUS_PRESENT;
+    info->caps = ONLP_THERMAL_CAPS_GET_TEMPERATURE;
+    if(th->warning) {
+        info->caps |= ONLP_THERMAL_CAPS_GET_WARNING_THRESHOLD;
+        info->thresholds.warning = th->warning;
+    }
+    if(th->error) {
+        info->caps |= ONLP_THERMAL_CAPS_GET_ERROR_THRESHOLD;
+        info->thresholds.error = th->error;
+    }
+    if(th->shutdown) {
+        info->caps |= ONLP_THERMAL_CAPS_GET_SHUTDOWN_THRESHOLD;
+        info->thresholds.shutdown = th->shutdown;
+    }
+
+    rv = onlpsim_sysfs_read_int(th->path, &info->mcelsius);
+    return (rv < 0) ? rv : ONLP_STATUS_OK;
+}
@@ -0,0 +1,8 @@
+###############################################################################
+#
+# onlpsim Unit Test Makefile.
+#
+###############################################################################
+UMODULE := onlpsim
+UMODULE_SUBDIR := $(dir $(lastword $(MAKEFILE_LIST)))
+include $(BUILDER)/utest.mk
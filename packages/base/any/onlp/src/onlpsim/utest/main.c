@@ -1,35 +1,38 @@
 /************************************************************
  * <bsn.cl fy=2014 v=onl>
- *
- *           Copyright 2014 Big Switch Networks, Inc.
- *
+ * 
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.       
+ * 
  * Licensed under the Eclipse Public License, Version 1.0 (the
  * "License"); you may not use this file except in compliance
  * with the License. You may obtain a copy of the License at
- *
+ * 
  *        http://www.eclipse.org/legal/epl-v10.html
- *
+ * 
  * Unless required by applicable law or agreed to in writing,
  * software distributed under the License is distributed on an
  * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
  * either express or implied. See the License for the specific
  * language governing permissions and limitations under the
  * License.
- *
+ * 
  * </bsn.cl>
  ************************************************************
  *
  *
  *
  ***********************************************************/
-#include <errno.h>
-#include <fcntl.h>
+#include <onlpsim/onlpsim_config.h>
+
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
-#include <unistd.h>
 #include <AIM/aim.h>
-#include <onlplib/file.h>
-#include <sys/mman.h>
-#include "platform_lib.h"
 
-/* Nothing on this platform */
+int aim_main(int argc, char* argv[])
+{
+    printf("onlpsim Utest Is Empty\n");
+    onlpsim_config_show(&aim_pvs_stdout);
+    return 0;
+}
+
@@ -0,0 +1,163 @@
+/**********************************************************************
+ *
+ * cmis.h
+ *
+ * idprom defintions for CMIS 4.x/5.x (QSFP-DD, OSFP) modules.
+ *
+ **********************************************************************/
+
+#ifndef __SFF_CMIS_H__
+#define __SFF_CMIS_H__
+
+#include <sff/sff_config.h>
+
+/* identifier, byte 0 (SFF-8024) */
+
+#define CMIS_IDENT_QSFP_DD               0x18
+#define CMIS_IDENT_OSFP                  0x19
+#define CMIS_IDENT_QSFP_CMIS             0x1E
+
+#define CMIS_MODULE_QSFP_DD(idprom)             \
+    (idprom[0] == CMIS_IDENT_QSFP_DD)
+#define CMIS_MODULE_OSFP(idprom)                \
+    (idprom[0] == CMIS_IDENT_OSFP)
+#define CMIS_MODULE_QSFP_CMIS(idprom)           \
+    (idprom[0] == CMIS_IDENT_QSFP_CMIS)
+
+#define CMIS_MODULE(idprom)                     \
+    (CMIS_MODULE_QSFP_DD(idprom)                \
+     || CMIS_MODULE_OSFP(idprom)                \
+     || CMIS_MODULE_QSFP_CMIS(idprom))
+
+/* revision compliance, byte 1 */
+
+#define CMIS_REVISION_MAJOR(idprom)             \
+    (idprom[1] >> 4)
+#define CMIS_REVISION_MINOR(idprom)             \
+    (idprom[1] & 0x0F)
+
+/* memory model, byte 2 (flat memory modules have no upper pages) */
+
+#define CMIS_FLAT_MEM(idprom)                   \
+    (idprom[2] & 0x80)
+
+/* module monitors, bytes 14-17 */
+
+#define CMIS_TEMP(idprom)                       \
+    (idprom[14] << 8 | idprom[14 + 1])
+#define CMIS_VOLT(idprom)                       \
+    (idprom[16] << 8 | idprom[16 + 1])
+
+#define CMIS_MONITOR_OFFSET              14
+#define CMIS_MONITOR_LEN                 4
+
+/* module media type, byte 85 */
+
+#define CMIS_MEDIA_TYPE(idprom)                 \
+    (idprom[85])
+
+#define CMIS_MEDIA_TYPE_UNDEFINED        0x00
+#define CMIS_MEDIA_TYPE_MMF              0x01
+#define CMIS_MEDIA_TYPE_SMF              0x02
+#define CMIS_MEDIA_TYPE_PASSIVE_CU       0x03
+#define CMIS_MEDIA_TYPE_ACTIVE_CABLE     0x04
+#define CMIS_MEDIA_TYPE_BASE_T           0x05
+
+/* application advertisement, bytes 86-117 */
+
+#define CMIS_APP_OFFSET                  86
+#define CMIS_APP_SIZE                    4
+#define CMIS_APP_COUNT                   8
+
+#define CMIS_APP_HOST_ID(idprom, _n)            \
+    (idprom[CMIS_APP_OFFSET + CMIS_APP_SIZE*(_n)])
+#define CMIS_APP_MEDIA_ID(idprom, _n)           \
+    (idprom[CMIS_APP_OFFSET + CMIS_APP_SIZE*(_n) + 1])
+#define CMIS_APP_HOST_LANES(idprom, _n)         \
+    (idprom[CMIS_APP_OFFSET + CMIS_APP_SIZE*(_n) + 2] >> 4)
+#define CMIS_APP_MEDIA_LANES(idprom, _n)        \
+    (idprom[CMIS_APP_OFFSET + CMIS_APP_SIZE*(_n) + 2] & 0x0F)
+#define CMIS_APP_LANE_OPTIONS(idprom, _n)       \
+    (idprom[CMIS_APP_OFFSET + CMIS_APP_SIZE*(_n) + 3])
+
+/* a host interface ID of 0xFF terminates the table */
+#define CMIS_APP_HOST_ID_UNUSED          0x00
+#define CMIS_APP_HOST_ID_END             0xFF
+
+/* host electrical interface IDs (SFF-8024 table 4-5) */
+
+#define CMIS_HOST_CAUI4                  0x0B
+#define CMIS_HOST_100GAUI4               0x0C
+#define CMIS_HOST_100GAUI2               0x0D
+#define CMIS_HOST_200GAUI8               0x0E
+#define CMIS_HOST_200GAUI4               0x0F
+#define CMIS_HOST_400GAUI16              0x10
+#define CMIS_HOST_400GAUI8               0x11
+#define CMIS_HOST_100GBASE_CR4           0x1B
+#define CMIS_HOST_200GBASE_CR4           0x1D
+#define CMIS_HOST_400GBASE_CR8           0x1E
+
+/* MMF media interface IDs (SFF-8024 table 4-6) */
+
+#define CMIS_MMF_100GBASE_SR4            0x09
+#define CMIS_MMF_200GBASE_SR4            0x0E
+#define CMIS_MMF_400GBASE_SR8            0x10
+
+/* SMF media interface IDs (SFF-8024 table 4-7) */
+
+#define CMIS_SMF_100GBASE_LR4            0x0D
+#define CMIS_SMF_100G_CWDM4              0x10
+#define CMIS_SMF_200GBASE_DR4            0x17
+#define CMIS_SMF_200GBASE_FR4            0x18
+#define CMIS_SMF_400GBASE_FR8            0x1A
+#define CMIS_SMF_400GBASE_LR8            0x1B
+#define CMIS_SMF_400GBASE_DR4            0x1C
+#define CMIS_SMF_400G_FR4                0x1D
+#define CMIS_SMF_400G_LR4                0x1E
+#define CMIS_SMF_400ZR                   0x3E
+
+/* page and bank select, bytes 126-127 */
+
+#define CMIS_BANK_SELECT                 126
+#define CMIS_PAGE_SELECT                 127
+
+/* upper page 00h */
+
+#define CMIS_VENDOR_NAME                 129
+#define CMIS_VENDOR_PN                   148
+#define CMIS_VENDOR_SN                   166
+
+/* cable assembly length, byte 202 page 0 */
+
+#define CMIS_CABLE_LENGTH_MULT(idprom)          \
+    (idprom[202] >> 6)
+#define CMIS_CABLE_LENGTH_BASE(idprom)          \
+    (idprom[202] & 0x3F)
+
+/* base checksum over bytes 128-221, stored in byte 222 */
+
+#define CMIS_CC_BASE_START               128
+#define CMIS_CC_BASE                     222
+
+/* page 01h, advertised monitors */
+
+#define CMIS_PAGE_ADVERTISING            0x01
+#define CMIS_LANE_MONITORS_SUPPORTED     160
+
+#define CMIS_TX_BIAS_SUPPORTED(_b)       ((_b) & 0x01)
+#define CMIS_TX_POWER_SUPPORTED(_b)      ((_b) & 0x02)
+#define CMIS_RX_POWER_SUPPORTED(_b)      ((_b) & 0x04)
+#define CMIS_TX_BIAS_MULT(_b)            (1 << (((_b) >> 3) & 0x3))
+
+/* page 11h (bank 0 covers lanes 1-8), per-lane monitors */
+
+#define CMIS_PAGE_LANE_STATUS            0x11
+#define CMIS_LANES_PER_BANK              8
+
+#define CMIS_LANE_TX_POWER               154
+#define CMIS_LANE_TX_BIAS                170
+#define CMIS_LANE_RX_POWER               186
+#define CMIS_LANE_MONITOR_OFFSET         CMIS_LANE_TX_POWER
+#define CMIS_LANE_MONITOR_LEN            48
+
+#endif /* __SFF_CMIS_H__ */
@@ -71,6 +71,8 @@ typedef enum sff_module_caps_e {
     SFF_MODULE_CAPS_F_25G = 8,
     SFF_MODULE_CAPS_F_40G = 16,
     SFF_MODULE_CAPS_F_100G = 32,
+    SFF_MODULE_CAPS_F_200G = 64,
+    SFF_MODULE_CAPS_F_400G = 128,
 } sff_module_caps_t;
 
 /** Enum names. */
@@ -96,6 +98,19 @@ extern aim_map_si_t sff_module_caps_desc_map[];
 
 /** sff_module_type */
 typedef enum sff_module_type_e {
+    SFF_MODULE_TYPE_400G_BASE_CR8,
+    SFF_MODULE_TYPE_400G_AOC,
+    SFF_MODULE_TYPE_400G_BASE_SR8,
+    SFF_MODULE_TYPE_400G_BASE_DR4,
+    SFF_MODULE_TYPE_400G_BASE_FR4,
+    SFF_MODULE_TYPE_400G_BASE_LR4,
+    SFF_MODULE_TYPE_400G_BASE_FR8,
+    SFF_MODULE_TYPE_400G_BASE_LR8,
+    SFF_MODULE_TYPE_400G_ZR,
+    SFF_MODULE_TYPE_200G_BASE_CR4,
+    SFF_MODULE_TYPE_200G_BASE_SR4,
+    SFF_MODULE_TYPE_200G_BASE_DR4,
+    SFF_MODULE_TYPE_200G_BASE_FR4,
     SFF_MODULE_TYPE_100G_AOC,
     SFF_MODULE_TYPE_100G_BASE_CR4,
     SFF_MODULE_TYPE_100G_BASE_SR4,
@@ -133,6 +148,19 @@ typedef enum sff_module_type_e {
 /** Strings macro. */
 #define SFF_MODULE_TYPE_STRINGS \
 {\
+    "400G_BASE_CR8", \
+    "400G_AOC", \
+    "400G_BASE_SR8", \
+    "400G_BASE_DR4", \
+    "400G_BASE_FR4", \
+    "400G_BASE_LR4", \
+    "400G_BASE_FR8", \
+    "400G_BASE_LR8", \
+    "400G_ZR", \
+    "200G_BASE_CR4", \
+    "200G_BASE_SR4", \
+    "200G_BASE_DR4", \
+    "200G_BASE_FR4", \
     "100G_AOC", \
     "100G_BASE_CR4", \
     "100G_BASE_SR4", \
@@ -187,7 +215,10 @@ typedef enum sff_sfp_type_e {
     SFF_SFP_TYPE_QSFP,
     SFF_SFP_TYPE_QSFP_PLUS,
     SFF_SFP_TYPE_QSFP28,
-    SFF_SFP_TYPE_LAST = SFF_SFP_TYPE_QSFP28,
+    SFF_SFP_TYPE_QSFP_DD,
+    SFF_SFP_TYPE_OSFP,
+    SFF_SFP_TYPE_QSFP_CMIS,
+    SFF_SFP_TYPE_LAST = SFF_SFP_TYPE_QSFP_CMIS,
     SFF_SFP_TYPE_COUNT,
     SFF_SFP_TYPE_INVALID = -1,
 } sff_sfp_type_t;
@@ -199,6 +230,9 @@ typedef enum sff_sfp_type_e {
     "QSFP", \
     "QSFP_PLUS", \
     "QSFP28", \
+    "QSFP_DD", \
+    "OSFP", \
+    "QSFP_CMIS", \
 }
 /** Enum names. */
 const char* sff_sfp_type_name(sff_sfp_type_t e);
@@ -211,7 +245,7 @@ const char* sff_sfp_type_desc(sff_sfp_type_t e);
 
 /** validator */
 #define SFF_SFP_TYPE_VALID(_e) \
-    ( (0 <= (_e)) && ((_e) <= SFF_SFP_TYPE_QSFP28))
+    ( (0 <= (_e)) && ((_e) <= SFF_SFP_TYPE_QSFP_CMIS))
 
 /** sff_sfp_type_map table. */
 extern aim_map_si_t sff_sfp_type_map[];
@@ -315,6 +349,15 @@ typedef struct sff_eeprom_s {
  */
 int sff_eeprom_parse(sff_eeprom_t* rv, uint8_t* eeprom);
 
+/**
+ * @brief Parse module information directly from EEPROM data.
+ * @param info [out] Receives the information.
+ * @param eeprom Raw EEPROM data (256 bytes).
+ * @note Unlike sff_eeprom_parse() the EEPROM data is not copied.
+ * The information strings are copied into info.
+ */
+int sff_info_parse(sff_info_t* info, const uint8_t* eeprom);
+
 /**
  * @brief Initialize an SFF module information structure from a file.
  * @param rv [out] Receives thh data.
@@ -350,6 +393,134 @@ int sff_info_from_module_type(sff_info_t* info,
                                sff_sfp_type_t st,
                                sff_module_type_t mt);
 
+/**
+ * The maximum number of optical channels reported in DOM data.
+ */
+#define SFF_DOM_CHANNEL_COUNT_MAX 8
+
+/**
+ * Digital optical monitoring values.
+ *
+ * All values are reported in the native SFF units after
+ * calibration has been applied.
+ */
+typedef struct sff_dom_info_s {
+    /** Whether the module reports DOM data at all */
+    int supported;
+
+    /** The number of valid entries in the per-channel arrays */
+    int nchannels;
+
+    /** Module temperature in 1/256 degrees C */
+    int16_t temp;
+
+    /** Supply voltage in 100uV units */
+    uint16_t voltage;
+
+    /** TX bias current in 2uA units */
+    uint16_t bias_cur[SFF_DOM_CHANNEL_COUNT_MAX];
+
+    /** TX power in 0.1uW units */
+    uint16_t tx_power[SFF_DOM_CHANNEL_COUNT_MAX];
+
+    /** RX power in 0.1uW units */
+    uint16_t rx_power[SFF_DOM_CHANNEL_COUNT_MAX];
+
+} sff_dom_info_t;
+
+/**
+ * @brief Decode DOM values.
+ * @param info [out] Receives the DOM values.
+ * @param se The parsed module EEPROM.
+ * @param a2 The SFF-8472 A2h page for SFP modules. Ignored for
+ * QSFP modules, which report DOM data in the lower page of the
+ * module EEPROM itself.
+ * @note Only module monitors are reported for CMIS modules.
+ * Use sff_cmis_dom_info_get() for lane monitors.
+ */
+int sff_dom_info_get(sff_dom_info_t* info, sff_eeprom_t* se, uint8_t* a2);
+
+/**
+ * Whether the SFP type uses the CMIS memory map.
+ */
+#define SFF_SFP_TYPE_IS_CMIS(_t)                \
+    ( (_t) == SFF_SFP_TYPE_QSFP_DD ||           \
+      (_t) == SFF_SFP_TYPE_OSFP ||              \
+      (_t) == SFF_SFP_TYPE_QSFP_CMIS )
+
+/**
+ * The maximum number of CMIS application advertisements
+ * in the lower page.
+ */
+#define SFF_CMIS_APP_COUNT_MAX 8
+
+/**
+ * CMIS application advertisement entry.
+ */
+typedef struct sff_cmis_app_s {
+    /** Host electrical interface ID (SFF-8024) */
+    uint8_t host_id;
+
+    /** Media interface ID (SFF-8024, table given by the media type) */
+    uint8_t media_id;
+
+    /** Host lane count */
+    uint8_t host_lanes;
+
+    /** Media lane count */
+    uint8_t media_lanes;
+
+    /** Host lane assignment options */
+    uint8_t lane_options;
+} sff_cmis_app_t;
+
+/**
+ * @brief Decode the CMIS application advertisement table.
+ * @param idprom The module EEPROM.
+ * @param apps [out] Receives the applications. May be NULL.
+ * @param max The size of apps.
+ * @returns The number of applications, or < 0 if this is not a CMIS module.
+ */
+int sff_cmis_apps_get(const uint8_t* idprom, sff_cmis_app_t* apps, int max);
+
+/**
+ * @brief Determine the module type of a CMIS module
+ * from its preferred application.
+ * @param idprom The module EEPROM.
+ */
+sff_module_type_t sff_cmis_module_type_get(const uint8_t* idprom);
+
+/**
+ * @brief Decode the CMIS cable assembly length in meters.
+ * @param idprom The module EEPROM.
+ */
+int sff_cmis_length_get(const uint8_t* idprom);
+
+/**
+ * Read a range of a module page.
+ * @param cookie The reader cookie.
+ * @param page The upper page to select. Ignored for offsets below 128.
+ * @param offset The byte offset (0-255).
+ * @param len The number of bytes to read.
+ * @param dst Receives the data.
+ * @returns The number of bytes read, or < 0 on error.
+ */
+typedef int (*sff_page_read_f)(void* cookie, int page, int offset,
+                               int len, uint8_t* dst);
+
+/**
+ * @brief Decode DOM values from a CMIS module.
+ * @param info [out] Receives the DOM values.
+ * @param se The parsed module EEPROM.
+ * @param reader Reads the module pages.
+ * @param cookie The reader cookie.
+ * @note Only the pages holding the requested monitors are read.
+ * Module monitors are read from the lower page, lane monitors
+ * for lanes 1-8 from bank 0 page 11h in a single read.
+ */
+int sff_cmis_dom_info_get(sff_dom_info_t* info, sff_eeprom_t* se,
+                          sff_page_read_f reader, void* cookie);
+
 
 
 #endif /* __SFF_SFF_H__ */
@@ -26,6 +26,7 @@
 #include <sff/8472.h>
 #include <sff/8436.h>
 #include <sff/8636.h>
+#include <sff/cmis.h>
 #include "sff_log.h"
 #include <ctype.h>
 
@@ -42,6 +43,15 @@ sff_sfp_type_get(const uint8_t* eeprom)
         if(SFF8636_MODULE_QSFP28(eeprom)) {
             return SFF_SFP_TYPE_QSFP28;
         }
+        if(CMIS_MODULE_QSFP_DD(eeprom)) {
+            return SFF_SFP_TYPE_QSFP_DD;
+        }
+        if(CMIS_MODULE_OSFP(eeprom)) {
+            return SFF_SFP_TYPE_OSFP;
+        }
+        if(CMIS_MODULE_QSFP_CMIS(eeprom)) {
+            return SFF_SFP_TYPE_QSFP_CMIS;
+        }
     }
     return SFF_SFP_TYPE_INVALID;
 }
@@ -49,6 +59,9 @@ sff_sfp_type_get(const uint8_t* eeprom)
 sff_module_type_t
 sff_module_type_get(const uint8_t* eeprom)
 {
+    if (CMIS_MODULE(eeprom))
+        return sff_cmis_module_type_get(eeprom);
+
     if (SFF8636_MODULE_QSFP28(eeprom)
         && SFF8636_MEDIA_EXTENDED(eeprom)
         && SFF8636_MEDIA_100GE_AOC(eeprom))
@@ -222,6 +235,8 @@ sff_media_type_get(sff_module_type_t mt)
     switch(mt)
         {
         case SFF_MODULE_TYPE_100G_BASE_CR4:
+        case SFF_MODULE_TYPE_400G_BASE_CR8:
+        case SFF_MODULE_TYPE_200G_BASE_CR4:
         case SFF_MODULE_TYPE_40G_BASE_CR4:
         case SFF_MODULE_TYPE_40G_BASE_CR:
         case SFF_MODULE_TYPE_25G_BASE_CR:
@@ -230,6 +245,17 @@ sff_media_type_get(sff_module_type_t mt)
         case SFF_MODULE_TYPE_1G_BASE_T:
             return SFF_MEDIA_TYPE_COPPER;
 
+        case SFF_MODULE_TYPE_400G_AOC:
+        case SFF_MODULE_TYPE_400G_BASE_SR8:
+        case SFF_MODULE_TYPE_400G_BASE_DR4:
+        case SFF_MODULE_TYPE_400G_BASE_FR4:
+        case SFF_MODULE_TYPE_400G_BASE_LR4:
+        case SFF_MODULE_TYPE_400G_BASE_FR8:
+        case SFF_MODULE_TYPE_400G_BASE_LR8:
+        case SFF_MODULE_TYPE_400G_ZR:
+        case SFF_MODULE_TYPE_200G_BASE_SR4:
+        case SFF_MODULE_TYPE_200G_BASE_DR4:
+        case SFF_MODULE_TYPE_200G_BASE_FR4:
         case SFF_MODULE_TYPE_100G_AOC:
         case SFF_MODULE_TYPE_100G_BASE_SR4:
         case SFF_MODULE_TYPE_100G_BASE_LR4:
@@ -272,6 +298,25 @@ sff_module_caps_get(sff_module_type_t mt, uint32_t *caps)
 
     switch(mt)
         {
+        case SFF_MODULE_TYPE_400G_BASE_CR8:
+        case SFF_MODULE_TYPE_400G_AOC:
+        case SFF_MODULE_TYPE_400G_BASE_SR8:
+        case SFF_MODULE_TYPE_400G_BASE_DR4:
+        case SFF_MODULE_TYPE_400G_BASE_FR4:
+        case SFF_MODULE_TYPE_400G_BASE_LR4:
+        case SFF_MODULE_TYPE_400G_BASE_FR8:
+        case SFF_MODULE_TYPE_400G_BASE_LR8:
+        case SFF_MODULE_TYPE_400G_ZR:
+            *caps |= SFF_MODULE_CAPS_F_400G;
+            return 0;
+
+        case SFF_MODULE_TYPE_200G_BASE_CR4:
+        case SFF_MODULE_TYPE_200G_BASE_SR4:
+        case SFF_MODULE_TYPE_200G_BASE_DR4:
+        case SFF_MODULE_TYPE_200G_BASE_FR4:
+            *caps |= SFF_MODULE_CAPS_F_200G;
+            return 0;
+
         case SFF_MODULE_TYPE_100G_AOC:
         case SFF_MODULE_TYPE_100G_BASE_SR4:
         case SFF_MODULE_TYPE_100G_BASE_LR4:
@@ -335,165 +380,298 @@ make_printable__(char* string)
     }
 }
 
-/**
- * @brief Initialize an SFF module information structure.
- * @param rv [out] Receives the data.
- * @param eeprom Raw EEPROM data.
- * @note if eeprom is != NULL it will be copied into rv->eeprom first.
- * @note if eeprom is NULL it is assumed the rv->eeprom buffer
- * has already been initialized.
+/*
+ * Compute the base and extended checksums of the module EEPROM.
  */
-
-int
-sff_eeprom_parse(sff_eeprom_t* se, uint8_t* eeprom)
+static void
+sff_checksums__(const uint8_t* eeprom, uint8_t* cc_base, uint8_t* cc_ext)
 {
-    if(se == NULL) {
-        return -1;
-    }
-    se->identified = 0;
-
-    if(eeprom) {
-        SFF_MEMCPY(se->eeprom, eeprom, 256);
-    }
+    *cc_base = 0;
+    *cc_ext = 0;
 
-    if (SFF8472_MODULE_SFP(se->eeprom)) {
+    if (SFF8472_MODULE_SFP(eeprom)) {
         /* See SFF-8472 pp22, pp28 */
         int i;
-        for (i = 0, se->cc_base = 0; i < 63; ++i)
-            se->cc_base = (se->cc_base + se->eeprom[i]) & 0xFF;
-        for (i = 64, se->cc_ext = 0; i < 95; ++i)
-            se->cc_ext = (se->cc_ext + se->eeprom[i]) & 0xFF;
-    } else if (SFF8436_MODULE_QSFP_PLUS_V2(se->eeprom) ||
-               SFF8636_MODULE_QSFP28(se->eeprom)) {
+        for (i = 0, *cc_base = 0; i < 63; ++i)
+            *cc_base = (*cc_base + eeprom[i]) & 0xFF;
+        for (i = 64, *cc_ext = 0; i < 95; ++i)
+            *cc_ext = (*cc_ext + eeprom[i]) & 0xFF;
+    } else if (SFF8436_MODULE_QSFP_PLUS_V2(eeprom) ||
+               SFF8636_MODULE_QSFP28(eeprom)) {
         /* See SFF-8436 pp72, pp73 */
         int i;
-        for (i = 128, se->cc_base = 0; i < 191; ++i)
-            se->cc_base = (se->cc_base + se->eeprom[i]) & 0xFF;
-        for (i = 192, se->cc_ext = 0; i < 223; ++i)
-            se->cc_ext = (se->cc_ext + se->eeprom[i]) & 0xFF;
+        for (i = 128, *cc_base = 0; i < 191; ++i)
+            *cc_base = (*cc_base + eeprom[i]) & 0xFF;
+        for (i = 192, *cc_ext = 0; i < 223; ++i)
+            *cc_ext = (*cc_ext + eeprom[i]) & 0xFF;
+    } else if (CMIS_MODULE(eeprom)) {
+        /* See CMIS 5.0 8.4.1, there is no extended checksum */
+        int i;
+        for (i = CMIS_CC_BASE_START, *cc_base = 0; i < CMIS_CC_BASE; ++i)
+            *cc_base = (*cc_base + eeprom[i]) & 0xFF;
+        *cc_ext = 0;
     }
+}
 
-    if (!sff_eeprom_validate(se, 1)) {
-        return -1;
+static int
+sff_checksums_valid__(const uint8_t* eeprom, uint8_t cc_base, uint8_t cc_ext,
+                      int verbose)
+{
+    if (SFF8436_MODULE_QSFP_PLUS_V2(eeprom) ||
+        SFF8636_MODULE_QSFP28(eeprom)) {
+
+        if (cc_base != eeprom[191]) {
+            if (verbose) {
+                AIM_LOG_ERROR("sff_eeprom_validate() failed: invalid base QSFP checksum (0x%x should be 0x%x)",
+                              eeprom[191], cc_base);
+            }
+            return 0;
+        }
+
+#if SFF_CONFIG_INCLUDE_EXT_CC_CHECK == 1
+        if (cc_ext != eeprom[223]) {
+            if (verbose) {
+                AIM_LOG_ERROR("sff_info_valid() failed: invalid extended QSFP checksum (0x%x should be 0x%x)",
+                              eeprom[223], cc_ext);
+            }
+            return 0;
+        }
+#endif
+
+    } else if (CMIS_MODULE(eeprom)) {
+
+        if (cc_base != eeprom[CMIS_CC_BASE]) {
+            if (verbose) {
+                AIM_LOG_ERROR("sff_eeprom_validate() failed: invalid base CMIS checksum (0x%x should be 0x%x)",
+                              eeprom[CMIS_CC_BASE], cc_base);
+            }
+            return 0;
+        }
+
+    } else if (SFF8472_MODULE_SFP(eeprom)) {
+
+        if (cc_base != eeprom[63]) {
+            if (verbose) {
+                AIM_LOG_ERROR("sff_info_valid() failed: invalid base SFP checksum (0x%x should be 0x%x)",
+                              eeprom[63], cc_base);
+            }
+            return 0;
+        }
+
+#if SFF_CONFIG_INCLUDE_EXT_CC_CHECK == 1
+        if (cc_ext != eeprom[95]) {
+            if (verbose) {
+                AIM_LOG_ERROR("sff_info_valid() failed: invalid extended SFP checksum (0x%x should be 0x%x)",
+                              eeprom[95], cc_ext);
+            }
+            return 0;
+        }
+#endif
+
+    } else {
+
+        if (verbose) {
+            AIM_LOG_ERROR("sff_info_valid() failed: invalid module type");
+        }
+
+        return 0;
     }
 
-    se->info.sfp_type = sff_sfp_type_get(se->eeprom);
-    if(se->info.sfp_type == SFF_SFP_TYPE_INVALID) {
-        AIM_LOG_ERROR("sff_eeprom_parse() failed: invalid sfp type");
+    return 1;
+}
+
+static int
+sff_info_parse__(sff_info_t* info, const uint8_t* eeprom)
+{
+    info->sfp_type = sff_sfp_type_get(eeprom);
+    if(info->sfp_type == SFF_SFP_TYPE_INVALID) {
+        AIM_LOG_ERROR("sff_info_parse() failed: invalid sfp type");
         return -1;
     }
-    se->info.sfp_type_name = sff_sfp_type_desc(se->info.sfp_type);
+    info->sfp_type_name = sff_sfp_type_desc(info->sfp_type);
 
     const uint8_t *vendor, *model, *serial;
 
-    switch(se->info.sfp_type)
+    switch(info->sfp_type)
         {
         case SFF_SFP_TYPE_QSFP_PLUS:
         case SFF_SFP_TYPE_QSFP28:
-            vendor=se->eeprom+148;
-            model=se->eeprom+168;
-            serial=se->eeprom+196;
+            vendor=eeprom+148;
+            model=eeprom+168;
+            serial=eeprom+196;
+            break;
+
+        case SFF_SFP_TYPE_QSFP_DD:
+        case SFF_SFP_TYPE_OSFP:
+        case SFF_SFP_TYPE_QSFP_CMIS:
+            vendor=eeprom+CMIS_VENDOR_NAME;
+            model=eeprom+CMIS_VENDOR_PN;
+            serial=eeprom+CMIS_VENDOR_SN;
             break;
 
         case SFF_SFP_TYPE_SFP:
         default:
-            vendor=se->eeprom+20;
-            model=se->eeprom+40;
-            serial=se->eeprom+68;
+            vendor=eeprom+20;
+            model=eeprom+40;
+            serial=eeprom+68;
             break;
         }
 
     /* handle NULL fields, they should actually be space-padded */
     const char *empty = "                ";
     if (*vendor) {
-        aim_strlcpy(se->info.vendor, (char*)vendor, sizeof(se->info.vendor));
-        make_printable__(se->info.vendor);
+        aim_strlcpy(info->vendor, (char*)vendor, sizeof(info->vendor));
+        make_printable__(info->vendor);
     }
     else {
-        aim_strlcpy(se->info.vendor, empty, 17);
+        aim_strlcpy(info->vendor, empty, 17);
     }
     if (*model) {
-        aim_strlcpy(se->info.model, (char*)model, sizeof(se->info.model));
-        make_printable__(se->info.model);
+        aim_strlcpy(info->model, (char*)model, sizeof(info->model));
+        make_printable__(info->model);
     }
     else {
-        aim_strlcpy(se->info.model, empty, 17);
+        aim_strlcpy(info->model, empty, 17);
     }
     if (*serial) {
-        aim_strlcpy(se->info.serial, (char*)serial, sizeof(se->info.serial));
-        make_printable__(se->info.serial);
+        aim_strlcpy(info->serial, (char*)serial, sizeof(info->serial));
+        make_printable__(info->serial);
     }
     else {
-        aim_strlcpy(se->info.serial, empty, 17);
+        aim_strlcpy(info->serial, empty, 17);
     }
 
-    se->info.module_type = sff_module_type_get(se->eeprom);
-    if(se->info.module_type == SFF_MODULE_TYPE_INVALID) {
+    info->module_type = sff_module_type_get(eeprom);
+    if(info->module_type == SFF_MODULE_TYPE_INVALID) {
         AIM_LOG_ERROR("sff_info_init() failed: invalid module type");
         return -1;
     }
 
-    if(sff_info_from_module_type(&se->info, se->info.sfp_type,
-                                 se->info.module_type) < 0) {
+    if(sff_info_from_module_type(info, info->sfp_type,
+                                 info->module_type) < 0) {
         return -1;
     }
 
     int aoc_length;
-    switch (se->info.media_type)
+    switch (info->media_type)
         {
         case SFF_MEDIA_TYPE_COPPER:
-            switch (se->info.sfp_type)
+            switch (info->sfp_type)
                 {
                 case SFF_SFP_TYPE_QSFP_PLUS:
                 case SFF_SFP_TYPE_QSFP28:
-                    se->info.length = se->eeprom[146];
+                    info->length = eeprom[146];
                     break;
                 case SFF_SFP_TYPE_SFP:
-                    se->info.length = se->eeprom[18];
+                    info->length = eeprom[18];
+                    break;
+                case SFF_SFP_TYPE_QSFP_DD:
+                case SFF_SFP_TYPE_OSFP:
+                case SFF_SFP_TYPE_QSFP_CMIS:
+                    info->length = sff_cmis_length_get(eeprom);
                     break;
                 default:
-                    se->info.length = -1;
+                    info->length = -1;
                     break;
                 }
             break;
 
         case SFF_MEDIA_TYPE_FIBER:
-            switch (se->info.sfp_type)
+            switch (info->sfp_type)
                 {
                 case SFF_SFP_TYPE_QSFP28:
-                    aoc_length = _sff8636_qsfp28_100g_aoc_length(se->eeprom);
-                    se->info.length = aoc_length;
+                    aoc_length = _sff8636_qsfp28_100g_aoc_length(eeprom);
+                    info->length = aoc_length;
+                    break;
+                case SFF_SFP_TYPE_QSFP_DD:
+                case SFF_SFP_TYPE_OSFP:
+                case SFF_SFP_TYPE_QSFP_CMIS:
+                    if (CMIS_MEDIA_TYPE(eeprom) == CMIS_MEDIA_TYPE_ACTIVE_CABLE)
+                        info->length = sff_cmis_length_get(eeprom);
+                    else
+                        info->length = -1;
                     break;
                 case SFF_SFP_TYPE_QSFP_PLUS:
                 case SFF_SFP_TYPE_SFP:
-                    aoc_length = _sff8436_qsfp_40g_aoc_length(se->eeprom);
+                    aoc_length = _sff8436_qsfp_40g_aoc_length(eeprom);
                     if (aoc_length < 0)
-                        aoc_length = _sff8472_sfp_10g_aoc_length(se->eeprom);
+                        aoc_length = _sff8472_sfp_10g_aoc_length(eeprom);
                     if (aoc_length > 0)
-                        se->info.length = aoc_length;
+                        info->length = aoc_length;
                     else
-                        se->info.length = -1;
+                        info->length = -1;
                     break;
                 default:
-                    se->info.length = -1;
+                    info->length = -1;
                     break;
                 }
             break;
         default:
-            se->info.length = -1;
+            info->length = -1;
         }
 
-    if(se->info.length == -1) {
-        se->info.length_desc[0] = 0;
+    if(info->length == -1) {
+        info->length_desc[0] = 0;
     }
     else {
-        SFF_SNPRINTF(se->info.length_desc, sizeof(se->info.length_desc), "%dm", se->info.length);
+        SFF_SNPRINTF(info->length_desc, sizeof(info->length_desc), "%dm", info->length);
+    }
+    return 0;
+}
+
+/**
+ * @brief Initialize an SFF module information structure.
+ * @param rv [out] Receives the data.
+ * @param eeprom Raw EEPROM data.
+ * @note if eeprom is != NULL it will be copied into rv->eeprom first.
+ * @note if eeprom is NULL it is assumed the rv->eeprom buffer
+ * has already been initialized.
+ */
+
+int
+sff_eeprom_parse(sff_eeprom_t* se, uint8_t* eeprom)
+{
+    if(se == NULL) {
+        return -1;
+    }
+    se->identified = 0;
+
+    if(eeprom) {
+        SFF_MEMCPY(se->eeprom, eeprom, 256);
+    }
+
+    sff_checksums__(se->eeprom, &se->cc_base, &se->cc_ext);
+
+    if (!sff_eeprom_validate(se, 1)) {
+        return -1;
+    }
+
+    if(sff_info_parse__(&se->info, se->eeprom) < 0) {
+        return -1;
     }
     se->identified = 1;
 
     return 0;
 }
 
+int
+sff_info_parse(sff_info_t* info, const uint8_t* eeprom)
+{
+    uint8_t cc_base, cc_ext;
+
+    if(info == NULL || eeprom == NULL) {
+        return -1;
+    }
+
+    sff_checksums__(eeprom, &cc_base, &cc_ext);
+
+    if (!sff_checksums_valid__(eeprom, cc_base, cc_ext, 1)) {
+        return -1;
+    }
+
+    return sff_info_parse__(info, eeprom);
+}
+
 int
 sff_info_from_module_type(sff_info_t* info, sff_sfp_type_t st, sff_module_type_t mt)
 {
@@ -560,55 +738,5 @@ sff_eeprom_invalidate(sff_eeprom_t *se)
 int
 sff_eeprom_validate(sff_eeprom_t *se, int verbose)
 {
-    if (SFF8436_MODULE_QSFP_PLUS_V2(se->eeprom) ||
-        SFF8636_MODULE_QSFP28(se->eeprom)) {
-
-        if (se->cc_base != se->eeprom[191]) {
-            if (verbose) {
-                AIM_LOG_ERROR("sff_eeprom_validate() failed: invalid base QSFP checksum (0x%x should be 0x%x)",
-                              se->eeprom[191], se->cc_base);
-            }
-            return 0;
-        }
-
-#if SFF_CONFIG_INCLUDE_EXT_CC_CHECK == 1
-        if (se->cc_ext != se->eeprom[223]) {
-            if (verbose) {
-                AIM_LOG_ERROR("sff_info_valid() failed: invalid extended QSFP checksum (0x%x should be 0x%x)",
-                              se->eeprom[223], se->cc_ext);
-            }
-            return 0;
-        }
-#endif
-
-    } else if (SFF8472_MODULE_SFP(se->eeprom)) {
-
-        if (se->cc_base != se->eeprom[63]) {
-            if (verbose) {
-                AIM_LOG_ERROR("sff_info_valid() failed: invalid base SFP checksum (0x%x should be 0x%x)",
-                              se->eeprom[63], se->cc_base);
-            }
-            return 0;
-        }
-
-#if SFF_CONFIG_INCLUDE_EXT_CC_CHECK == 1
-        if (se->cc_ext != se->eeprom[95]) {
-            if (verbose) {
-                AIM_LOG_ERROR("sff_info_valid() failed: invalid extended SFP checksum (0x%x should be 0x%x)",
-                              se->eeprom[95], se->cc_ext);
-            }
-            return 0;
-        }
-#endif
-
-    } else {
-
-        if (verbose) {
-            AIM_LOG_ERROR("sff_info_valid() failed: invalid module type");
-        }
-
-        return 0;
-    }
-
-    return 1;
+    return sff_checksums_valid__(se->eeprom, se->cc_base, se->cc_ext, verbose);
 }
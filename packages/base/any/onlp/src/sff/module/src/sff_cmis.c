@@ -0,0 +1,187 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * CMIS (QSFP-DD, OSFP) Module Decoding
+ *
+ * Identification only uses the lower page and upper page 00h,
+ * which make up the 256 byte module EEPROM read by the
+ * platform. Banked pages are fetched on demand through a
+ * page reader when DOM data is requested.
+ *
+ ***********************************************************/
+#include <sff/sff.h>
+#include <sff/cmis.h>
+#include "sff_log.h"
+
+int
+sff_cmis_apps_get(const uint8_t* idprom, sff_cmis_app_t* apps, int max)
+{
+    int i, count = 0;
+
+    if(idprom == NULL || !CMIS_MODULE(idprom)) {
+        return -1;
+    }
+
+    for(i = 0; i < CMIS_APP_COUNT && count < max; i++) {
+        uint8_t host_id = CMIS_APP_HOST_ID(idprom, i);
+        if(host_id == CMIS_APP_HOST_ID_END) {
+            break;
+        }
+        if(host_id == CMIS_APP_HOST_ID_UNUSED) {
+            continue;
+        }
+        if(apps) {
+            apps[count].host_id = host_id;
+            apps[count].media_id = CMIS_APP_MEDIA_ID(idprom, i);
+            apps[count].host_lanes = CMIS_APP_HOST_LANES(idprom, i);
+            apps[count].media_lanes = CMIS_APP_MEDIA_LANES(idprom, i);
+            apps[count].lane_options = CMIS_APP_LANE_OPTIONS(idprom, i);
+        }
+        count++;
+    }
+    return count;
+}
+
+/*
+ * Copper and active cables are classified by their host interface,
+ * optics by their media interface.
+ */
+static sff_module_type_t
+cmis_app_module_type__(uint8_t media_type, const sff_cmis_app_t* app)
+{
+    switch(media_type)
+        {
+        case CMIS_MEDIA_TYPE_PASSIVE_CU:
+            switch(app->host_id)
+                {
+                case CMIS_HOST_400GAUI8:
+                case CMIS_HOST_400GBASE_CR8:
+                    return SFF_MODULE_TYPE_400G_BASE_CR8;
+                case CMIS_HOST_200GAUI4:
+                case CMIS_HOST_200GBASE_CR4:
+                    return SFF_MODULE_TYPE_200G_BASE_CR4;
+                case CMIS_HOST_CAUI4:
+                case CMIS_HOST_100GAUI4:
+                case CMIS_HOST_100GBASE_CR4:
+                    return SFF_MODULE_TYPE_100G_BASE_CR4;
+                default:
+                    break;
+                }
+            break;
+
+        case CMIS_MEDIA_TYPE_ACTIVE_CABLE:
+            switch(app->host_id)
+                {
+                case CMIS_HOST_400GAUI8:
+                    return SFF_MODULE_TYPE_400G_AOC;
+                case CMIS_HOST_CAUI4:
+                case CMIS_HOST_100GAUI4:
+                    return SFF_MODULE_TYPE_100G_AOC;
+                default:
+                    break;
+                }
+            break;
+
+        case CMIS_MEDIA_TYPE_MMF:
+            switch(app->media_id)
+                {
+                case CMIS_MMF_400GBASE_SR8:
+                    return SFF_MODULE_TYPE_400G_BASE_SR8;
+                case CMIS_MMF_200GBASE_SR4:
+                    return SFF_MODULE_TYPE_200G_BASE_SR4;
+                case CMIS_MMF_100GBASE_SR4:
+                    return SFF_MODULE_TYPE_100G_BASE_SR4;
+                default:
+                    break;
+                }
+            break;
+
+        case CMIS_MEDIA_TYPE_SMF:
+            switch(app->media_id)
+                {
+                case CMIS_SMF_400GBASE_DR4:
+                    return SFF_MODULE_TYPE_400G_BASE_DR4;
+                case CMIS_SMF_400G_FR4:
+                    return SFF_MODULE_TYPE_400G_BASE_FR4;
+                case CMIS_SMF_400G_LR4:
+                    return SFF_MODULE_TYPE_400G_BASE_LR4;
+                case CMIS_SMF_400GBASE_FR8:
+                    return SFF_MODULE_TYPE_400G_BASE_FR8;
+                case CMIS_SMF_400GBASE_LR8:
+                    return SFF_MODULE_TYPE_400G_BASE_LR8;
+                case CMIS_SMF_400ZR:
+                    return SFF_MODULE_TYPE_400G_ZR;
+                case CMIS_SMF_200GBASE_DR4:
+                    return SFF_MODULE_TYPE_200G_BASE_DR4;
+                case CMIS_SMF_200GBASE_FR4:
+                    return SFF_MODULE_TYPE_200G_BASE_FR4;
+                case CMIS_SMF_100GBASE_LR4:
+                    return SFF_MODULE_TYPE_100G_BASE_LR4;
+                case CMIS_SMF_100G_CWDM4:
+                    return SFF_MODULE_TYPE_100G_CWDM4;
+                default:
+                    break;
+                }
+            break;
+
+        default:
+            break;
+        }
+    return SFF_MODULE_TYPE_INVALID;
+}
+
+sff_module_type_t
+sff_cmis_module_type_get(const uint8_t* idprom)
+{
+    int i, count;
+    sff_cmis_app_t apps[SFF_CMIS_APP_COUNT_MAX];
+
+    count = sff_cmis_apps_get(idprom, apps, SFF_CMIS_APP_COUNT_MAX);
+
+    /* Applications are advertised in order of preference. */
+    for(i = 0; i < count; i++) {
+        sff_module_type_t mt = cmis_app_module_type__(CMIS_MEDIA_TYPE(idprom),
+                                                       apps + i);
+        if(mt != SFF_MODULE_TYPE_INVALID) {
+            return mt;
+        }
+    }
+    return SFF_MODULE_TYPE_INVALID;
+}
+
+int
+sff_cmis_length_get(const uint8_t* idprom)
+{
+    int base = CMIS_CABLE_LENGTH_BASE(idprom);
+
+    switch(CMIS_CABLE_LENGTH_MULT(idprom))
+        {
+        case 0:
+            /* 0.1m units, rounded to the nearest meter */
+            return (base + 5) / 10;
+        case 1:
+            return base;
+        case 2:
+            return base * 10;
+        default:
+            return base * 100;
+        }
+}
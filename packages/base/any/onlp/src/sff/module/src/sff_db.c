@@ -61,6 +61,12 @@
 #define SFF_100G_CWDM4_PROPERTIES                                       \
     SFF_SFP_TYPE_QSFP28, "QSFP28", SFF_MODULE_TYPE_100G_CWDM4, "100G-CWDM4", SFF_MEDIA_TYPE_FIBER, "Fiber", SFF_MODULE_CAPS_F_100G
 
+#define SFF_400G_BASE_DR4_PROPERTIES                                    \
+    SFF_SFP_TYPE_QSFP_DD, "QSFP-DD", SFF_MODULE_TYPE_400G_BASE_DR4, "400GBASE-DR4", SFF_MEDIA_TYPE_FIBER, "Fiber", SFF_MODULE_CAPS_F_400G
+
+#define SFF_400G_BASE_CR8_PROPERTIES                                    \
+    SFF_SFP_TYPE_QSFP_DD, "QSFP-DD", SFF_MODULE_TYPE_400G_BASE_CR8, "400GBASE-CR8", SFF_MEDIA_TYPE_COPPER, "Copper", SFF_MODULE_CAPS_F_400G
+
 static sff_db_entry_t sff_database__[] =
     {
 
@@ -1413,6 +1419,64 @@ static sff_db_entry_t sff_database__[] =
                 },
             },
         },
+        {
+            {
+                .eeprom = {
+                    0x18, 0x40, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x40,
+                    0x80, 0xe8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x11, 0x1c, 0x84, 0x01, 0x0c, 0x14, 0x11, 0xff, 0xff, 0x00,
+                    0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0xff, 0x00,
+                    0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                    0x18, 0x47, 0x45, 0x4e, 0x45, 0x52, 0x49, 0x43, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+                    0x20, 0x00, 0x00, 0x00, 0x51, 0x44, 0x44, 0x2d, 0x34, 0x30, 0x30, 0x47, 0x2d, 0x44, 0x52, 0x34,
+                    0x20, 0x20, 0x20, 0x20, 0x30, 0x31, 0x43, 0x4d, 0x49, 0x53, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+                    0x30, 0x31, 0x20, 0x20, 0x20, 0x20, 0x32, 0x30, 0x32, 0x36, 0x30, 0x31, 0x30, 0x31, 0x00, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb3, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                },
+                .info = {
+                "GENERIC         ",
+                "QDD-400G-DR4    ",
+                "CMIS00000001    ",
+                SFF_400G_BASE_DR4_PROPERTIES,
+                -1,
+                },
+            },
+        },
+        {
+            {
+                .eeprom = {
+                    0x18, 0x40, 0x80, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x40,
+                    0x80, 0xe8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x11, 0x01, 0x88, 0x01, 0x0f, 0x01, 0x44, 0x11, 0xff, 0x00,
+                    0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0xff, 0x00,
+                    0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                    0x18, 0x47, 0x45, 0x4e, 0x45, 0x52, 0x49, 0x43, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+                    0x20, 0x00, 0x00, 0x00, 0x51, 0x44, 0x44, 0x2d, 0x34, 0x30, 0x30, 0x47, 0x2d, 0x43, 0x52, 0x38,
+                    0x2d, 0x32, 0x4d, 0x20, 0x30, 0x31, 0x43, 0x4d, 0x49, 0x53, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+                    0x30, 0x32, 0x20, 0x20, 0x20, 0x20, 0x32, 0x30, 0x32, 0x36, 0x30, 0x31, 0x30, 0x31, 0x00, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x23, 0x00, 0x00, 0x00, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5c, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                },
+                .info = {
+                "GENERIC         ",
+                "QDD-400G-CR8-2M ",
+                "CMIS00000002    ",
+                SFF_400G_BASE_CR8_PROPERTIES,
+                2,
+                },
+            },
+        },
 
 #endif /** SFF_CONFIG_INCLUDE_DATABASE */
     };
@@ -0,0 +1,252 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *        Copyright 2014, 2015 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Digital Optical Monitoring
+ *
+ ***********************************************************/
+#include <sff/sff.h>
+#include <sff/8472.h>
+#include <sff/8436.h>
+#include <sff/8636.h>
+#include <sff/cmis.h>
+#include "sff_log.h"
+
+#define BE16(_d, _o) ( ((_d)[_o] << 8) | (_d)[(_o)+1] )
+
+static float
+be_float__(const uint8_t* data, int offset)
+{
+    union {
+        uint32_t u;
+        float f;
+    } v;
+    v.u = ((uint32_t)data[offset] << 24) | (data[offset+1] << 16) |
+        (data[offset+2] << 8) | data[offset+3];
+    return v.f;
+}
+
+static uint16_t
+clamp16__(float v)
+{
+    if(v < 0) {
+        return 0;
+    }
+    if(v > 0xFFFF) {
+        return 0xFFFF;
+    }
+    return (uint16_t)v;
+}
+
+/*
+ * Apply SFF-8472 external calibration (slope is unsigned 8.8 fixed point).
+ */
+static uint16_t
+extcal_linear__(const uint8_t* a2, uint16_t raw, int slope, int offset)
+{
+    float s = BE16(a2, slope) / 256.0;
+    int16_t o = BE16(a2, offset);
+    return clamp16__(s * raw + o);
+}
+
+static uint16_t
+extcal_rxpwr__(const uint8_t* a2, uint16_t raw)
+{
+    float p = be_float__(a2, SFF8472_CAL_RXPWR0);
+    float x = raw;
+
+    p += be_float__(a2, SFF8472_CAL_RXPWR1) * x;
+    x *= raw;
+    p += be_float__(a2, SFF8472_CAL_RXPWR2) * x;
+    x *= raw;
+    p += be_float__(a2, SFF8472_CAL_RXPWR3) * x;
+    x *= raw;
+    p += be_float__(a2, SFF8472_CAL_RXPWR4) * x;
+    return clamp16__(p);
+}
+
+static int
+sff_dom_info_get_sfp__(sff_dom_info_t* info, const uint8_t* idprom,
+                       const uint8_t* a2)
+{
+    if(!SFF8472_DOM_SUPPORTED(idprom)) {
+        return 0;
+    }
+    if(a2 == NULL) {
+        return -1;
+    }
+
+    info->supported = 1;
+    info->nchannels = 1;
+    info->temp = SFF8472_SFP_TEMP(a2);
+    info->voltage = SFF8472_SFP_VOLT(a2);
+    info->bias_cur[0] = SFF8472_BIAS_CUR(a2);
+    info->tx_power[0] = SFF8472_TX_PWR(a2);
+    info->rx_power[0] = SFF8472_RX_PWR(a2);
+
+    if(SFF8472_DOM_USE_EXTCAL(idprom)) {
+        float s = BE16(a2, SFF8472_CAL_T_SLP) / 256.0;
+        int16_t o = BE16(a2, SFF8472_CAL_T_OFF);
+        info->temp = (int16_t)(s * info->temp + o);
+        info->voltage = extcal_linear__(a2, info->voltage,
+                                        SFF8472_CAL_V_SLP, SFF8472_CAL_V_OFF);
+        info->bias_cur[0] = extcal_linear__(a2, info->bias_cur[0],
+                                            SFF8472_CAL_TXI_SLP, SFF8472_CAL_TXI_OFF);
+        info->tx_power[0] = extcal_linear__(a2, info->tx_power[0],
+                                            SFF8472_CAL_TXPWR_SLP, SFF8472_CAL_TXPWR_OFF);
+        info->rx_power[0] = extcal_rxpwr__(a2, info->rx_power[0]);
+    }
+    return 0;
+}
+
+static int
+sff_dom_info_get_qsfp__(sff_dom_info_t* info, const uint8_t* idprom)
+{
+    int i;
+
+    /* SFF-8436 and SFF-8636 share the same lower page monitor layout. */
+    info->supported = 1;
+    info->nchannels = 4;
+    info->temp = SFF8636_SFP_TEMP(idprom);
+    info->voltage = SFF8636_SFP_VOLT(idprom);
+    for(i = 0; i < 4; i++) {
+        info->rx_power[i] = BE16(idprom, 34 + 2*i);
+        info->bias_cur[i] = BE16(idprom, 42 + 2*i);
+        info->tx_power[i] = BE16(idprom, 50 + 2*i);
+    }
+    return 0;
+}
+
+static int
+sff_dom_info_get_cmis__(sff_dom_info_t* info, const uint8_t* idprom)
+{
+    /* Lane monitors are in banked pages, see sff_cmis_dom_info_get(). */
+    info->supported = 1;
+    info->nchannels = 0;
+    info->temp = CMIS_TEMP(idprom);
+    info->voltage = CMIS_VOLT(idprom);
+    return 0;
+}
+
+int
+sff_dom_info_get(sff_dom_info_t* info, sff_eeprom_t* se, uint8_t* a2)
+{
+    if(info == NULL || se == NULL) {
+        return -1;
+    }
+
+    SFF_MEMSET(info, 0, sizeof(*info));
+
+    if(!se->identified) {
+        return -1;
+    }
+
+    switch(se->info.sfp_type)
+        {
+        case SFF_SFP_TYPE_SFP:
+            return sff_dom_info_get_sfp__(info, se->eeprom, a2);
+
+        case SFF_SFP_TYPE_QSFP:
+        case SFF_SFP_TYPE_QSFP_PLUS:
+        case SFF_SFP_TYPE_QSFP28:
+            return sff_dom_info_get_qsfp__(info, se->eeprom);
+
+        case SFF_SFP_TYPE_QSFP_DD:
+        case SFF_SFP_TYPE_OSFP:
+        case SFF_SFP_TYPE_QSFP_CMIS:
+            return sff_dom_info_get_cmis__(info, se->eeprom);
+
+        default:
+            break;
+        }
+    return -1;
+}
+
+int
+sff_cmis_dom_info_get(sff_dom_info_t* info, sff_eeprom_t* se,
+                      sff_page_read_f reader, void* cookie)
+{
+    int i, mult;
+    uint8_t adv;
+    uint8_t mon[CMIS_MONITOR_LEN];
+    uint8_t lanes[CMIS_LANE_MONITOR_LEN];
+    sff_cmis_app_t app;
+
+    if(info == NULL || se == NULL || reader == NULL) {
+        return -1;
+    }
+
+    SFF_MEMSET(info, 0, sizeof(*info));
+
+    if(!se->identified || !SFF_SFP_TYPE_IS_CMIS(se->info.sfp_type)) {
+        return -1;
+    }
+
+    if(reader(cookie, 0, CMIS_MONITOR_OFFSET,
+              sizeof(mon), mon) != sizeof(mon)) {
+        return -1;
+    }
+    info->supported = 1;
+    info->temp = BE16(mon, 0);
+    info->voltage = BE16(mon, 2);
+
+    /* Flat memory modules (passive copper) have no lane monitors. */
+    if(CMIS_FLAT_MEM(se->eeprom)) {
+        return 0;
+    }
+
+    if(reader(cookie, CMIS_PAGE_ADVERTISING, CMIS_LANE_MONITORS_SUPPORTED,
+              1, &adv) != 1) {
+        return -1;
+    }
+    if(!CMIS_TX_BIAS_SUPPORTED(adv) && !CMIS_TX_POWER_SUPPORTED(adv) &&
+       !CMIS_RX_POWER_SUPPORTED(adv)) {
+        return 0;
+    }
+
+    /* All lane monitors for bank 0 in one read. */
+    if(reader(cookie, CMIS_PAGE_LANE_STATUS, CMIS_LANE_MONITOR_OFFSET,
+              sizeof(lanes), lanes) != sizeof(lanes)) {
+        return -1;
+    }
+
+    info->nchannels = CMIS_LANES_PER_BANK;
+    if(sff_cmis_apps_get(se->eeprom, &app, 1) == 1 &&
+       app.media_lanes > 0 && app.media_lanes < CMIS_LANES_PER_BANK) {
+        info->nchannels = app.media_lanes;
+    }
+
+    mult = CMIS_TX_BIAS_MULT(adv);
+    for(i = 0; i < info->nchannels; i++) {
+        if(CMIS_TX_POWER_SUPPORTED(adv)) {
+            info->tx_power[i] = BE16(lanes, CMIS_LANE_TX_POWER -
+                                     CMIS_LANE_MONITOR_OFFSET + 2*i);
+        }
+        if(CMIS_TX_BIAS_SUPPORTED(adv)) {
+            info->bias_cur[i] = clamp16__(BE16(lanes, CMIS_LANE_TX_BIAS -
+                                               CMIS_LANE_MONITOR_OFFSET + 2*i) * mult);
+        }
+        if(CMIS_RX_POWER_SUPPORTED(adv)) {
+            info->rx_power[i] = BE16(lanes, CMIS_LANE_RX_POWER -
+                                     CMIS_LANE_MONITOR_OFFSET + 2*i);
+        }
+    }
+    return 0;
+}
@@ -69,6 +69,8 @@ aim_map_si_t sff_module_caps_map[] =
     { "F_25G", SFF_MODULE_CAPS_F_25G },
     { "F_40G", SFF_MODULE_CAPS_F_40G },
     { "F_100G", SFF_MODULE_CAPS_F_100G },
+    { "F_200G", SFF_MODULE_CAPS_F_200G },
+    { "F_400G", SFF_MODULE_CAPS_F_400G },
     { NULL, 0 }
 };
 
@@ -80,6 +82,8 @@ aim_map_si_t sff_module_caps_desc_map[] =
     { "None", SFF_MODULE_CAPS_F_25G },
     { "None", SFF_MODULE_CAPS_F_40G },
     { "None", SFF_MODULE_CAPS_F_100G },
+    { "None", SFF_MODULE_CAPS_F_200G },
+    { "None", SFF_MODULE_CAPS_F_400G },
     { NULL, 0 }
 };
 
@@ -131,6 +135,19 @@ sff_module_caps_valid(sff_module_caps_t e)
 
 aim_map_si_t sff_module_type_map[] =
 {
+    { "400G_BASE_CR8", SFF_MODULE_TYPE_400G_BASE_CR8 },
+    { "400G_AOC", SFF_MODULE_TYPE_400G_AOC },
+    { "400G_BASE_SR8", SFF_MODULE_TYPE_400G_BASE_SR8 },
+    { "400G_BASE_DR4", SFF_MODULE_TYPE_400G_BASE_DR4 },
+    { "400G_BASE_FR4", SFF_MODULE_TYPE_400G_BASE_FR4 },
+    { "400G_BASE_LR4", SFF_MODULE_TYPE_400G_BASE_LR4 },
+    { "400G_BASE_FR8", SFF_MODULE_TYPE_400G_BASE_FR8 },
+    { "400G_BASE_LR8", SFF_MODULE_TYPE_400G_BASE_LR8 },
+    { "400G_ZR", SFF_MODULE_TYPE_400G_ZR },
+    { "200G_BASE_CR4", SFF_MODULE_TYPE_200G_BASE_CR4 },
+    { "200G_BASE_SR4", SFF_MODULE_TYPE_200G_BASE_SR4 },
+    { "200G_BASE_DR4", SFF_MODULE_TYPE_200G_BASE_DR4 },
+    { "200G_BASE_FR4", SFF_MODULE_TYPE_200G_BASE_FR4 },
     { "100G_AOC", SFF_MODULE_TYPE_100G_AOC },
     { "100G_BASE_CR4", SFF_MODULE_TYPE_100G_BASE_CR4 },
     { "100G_BASE_SR4", SFF_MODULE_TYPE_100G_BASE_SR4 },
@@ -165,6 +182,19 @@ aim_map_si_t sff_module_type_map[] =
 
 aim_map_si_t sff_module_type_desc_map[] =
 {
+    { "400GBASE-CR8", SFF_MODULE_TYPE_400G_BASE_CR8 },
+    { "400G-AOC", SFF_MODULE_TYPE_400G_AOC },
+    { "400GBASE-SR8", SFF_MODULE_TYPE_400G_BASE_SR8 },
+    { "400GBASE-DR4", SFF_MODULE_TYPE_400G_BASE_DR4 },
+    { "400G-FR4", SFF_MODULE_TYPE_400G_BASE_FR4 },
+    { "400G-LR4", SFF_MODULE_TYPE_400G_BASE_LR4 },
+    { "400GBASE-FR8", SFF_MODULE_TYPE_400G_BASE_FR8 },
+    { "400GBASE-LR8", SFF_MODULE_TYPE_400G_BASE_LR8 },
+    { "400ZR", SFF_MODULE_TYPE_400G_ZR },
+    { "200GBASE-CR4", SFF_MODULE_TYPE_200G_BASE_CR4 },
+    { "200GBASE-SR4", SFF_MODULE_TYPE_200G_BASE_SR4 },
+    { "200GBASE-DR4", SFF_MODULE_TYPE_200G_BASE_DR4 },
+    { "200GBASE-FR4", SFF_MODULE_TYPE_200G_BASE_FR4 },
     { "100G-AOC", SFF_MODULE_TYPE_100G_AOC },
     { "100GBASE-CR4", SFF_MODULE_TYPE_100G_BASE_CR4 },
     { "100GBASE-SR4", SFF_MODULE_TYPE_100G_BASE_SR4 },
@@ -243,6 +273,9 @@ aim_map_si_t sff_sfp_type_map[] =
     { "QSFP", SFF_SFP_TYPE_QSFP },
     { "QSFP_PLUS", SFF_SFP_TYPE_QSFP_PLUS },
     { "QSFP28", SFF_SFP_TYPE_QSFP28 },
+    { "QSFP_DD", SFF_SFP_TYPE_QSFP_DD },
+    { "OSFP", SFF_SFP_TYPE_OSFP },
+    { "QSFP_CMIS", SFF_SFP_TYPE_QSFP_CMIS },
     { NULL, 0 }
 };
 
@@ -252,6 +285,9 @@ aim_map_si_t sff_sfp_type_desc_map[] =
     { "QSFP", SFF_SFP_TYPE_QSFP },
     { "QSFP+", SFF_SFP_TYPE_QSFP_PLUS },
     { "QSFP28", SFF_SFP_TYPE_QSFP28 },
+    { "QSFP-DD", SFF_SFP_TYPE_QSFP_DD },
+    { "OSFP", SFF_SFP_TYPE_OSFP },
+    { "QSFP+ (CMIS)", SFF_SFP_TYPE_QSFP_CMIS },
     { NULL, 0 }
 };
 
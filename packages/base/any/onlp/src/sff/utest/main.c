@@ -8,10 +8,60 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <AIM/aim.h>
 #include <sff/sff.h>
 #include <sff/sff_db.h>
 
+#define SFF_UTEST_BENCH_ITERATIONS 1000000
+
+static uint64_t
+now_ns__(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/*
+ * Parse the whole database repeatedly and report the cost per module.
+ */
+static void
+bench__(sff_db_entry_t* entries, int count, int iterations)
+{
+    int i, j;
+    uint64_t start, elapsed;
+    uint64_t modules = (uint64_t)count * iterations;
+    volatile int sink = 0;
+    sff_eeprom_t se;
+    sff_info_t info;
+
+    if(modules == 0) {
+        return;
+    }
+
+    start = now_ns__();
+    for(i = 0; i < iterations; i++) {
+        for(j = 0; j < count; j++) {
+            sink += sff_eeprom_parse(&se, entries[j].se.eeprom);
+        }
+    }
+    elapsed = now_ns__() - start;
+    aim_printf(&aim_pvs_stdout, "sff_eeprom_parse: %d x %d modules: %.1f ns/module\n",
+               iterations, count, (double)elapsed / modules);
+
+    start = now_ns__();
+    for(i = 0; i < iterations; i++) {
+        for(j = 0; j < count; j++) {
+            sink += sff_info_parse(&info, entries[j].se.eeprom);
+        }
+    }
+    elapsed = now_ns__() - start;
+    aim_printf(&aim_pvs_stdout, "sff_info_parse:   %d x %d modules: %.1f ns/module\n",
+               iterations, count, (double)elapsed / modules);
+    (void)sink;
+}
+
 int
 aim_main(int argc, char* argv[])
 {
@@ -101,6 +151,10 @@ aim_main(int argc, char* argv[])
                    p->se.info.serial);
 
     }
+
+    /* The iteration count can be given on the command line. */
+    bench__(entries, count,
+            (argc > 1) ? atoi(argv[1]) : SFF_UTEST_BENCH_ITERATIONS);
     return 0;
 }
 
@@ -24,7 +24,7 @@
  *
  ***********************************************************/
 #include <onlp/platformi/fani.h>
-#include <onlplib/mmap.h>
+#include <onlplib/regmap.h>
 #include <unistd.h>
 //#include "onlpie_int.h"
 #include "platform_lib.h"
@@ -81,7 +81,7 @@ const onlp_fan_cpld_t fan_data[] = {
 {CPLD_REG_PSU_2_FAN_STATUS_OFFSET, CPLD_PSU_FAN_STATUS_BIT_MASK},
 };
 
-static volatile uint8_t* cpld_base__ = NULL;
+static onlp_regmap_t* cpld__ = NULL;
 
 /*
  * This function will be called prior to all of onlp_fani_* functions.
@@ -92,8 +92,8 @@ onlp_fani_init(void)
     /*
      * Map the CPLD address
      */
-    cpld_base__ = onlp_mmap(CPLD_BASE_ADDRESS, getpagesize(), __FILE__);
-    if(cpld_base__ == NULL || cpld_base__ == MAP_FAILED) {
+    cpld__ = onlp_regmap_open(CPLD_BASE_ADDRESS, getpagesize(), __FILE__);
+    if(cpld__ == NULL) {
         return ONLP_STATUS_E_INTERNAL;
     }
 
@@ -222,7 +222,7 @@ onlp_fani_info_get(onlp_oid_t id, onlp_fan_info_t* info)
 
     *info = finfo[fid];
 
-    val = cpld_base__[fan_data[fid].cpld_offset];
+    val = onlp_regmap_read8(cpld__, fan_data[fid].cpld_offset);
 
     switch (fid)
     {
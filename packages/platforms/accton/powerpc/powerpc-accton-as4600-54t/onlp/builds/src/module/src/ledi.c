@@ -23,7 +23,7 @@
  *
  ***********************************************************/
 #include <onlp/platformi/ledi.h>
-#include <onlplib/mmap.h>
+#include <onlplib/regmap.h>
 #include "powerpc_accton_as4600_54t_int.h"
 
 /* LED related data
@@ -101,7 +101,7 @@ const onlp_led_cpld_t led_data[] = {
 {LED_MODULE_2, CPLD_SYSTEM_LED_CONTROL_OFFSET_2, CPLD_LED_MODULE_2_REG_MASK, CPLD_LED_MODULE_2_AMBER, ONLP_LED_MODE_ORANGE}
 };
 
-static volatile uint8_t* cpld_base__ = NULL;
+static onlp_regmap_t* cpld__ = NULL;
 
 static int
 led_cpld_val_to_light_mode(enum onlp_led_id lid, unsigned char reg_val)
@@ -145,8 +145,8 @@ onlp_ledi_init(void)
     /*
      * Map the CPLD address
      */
-    cpld_base__ = onlp_mmap(CPLD_BASE_ADDRESS, getpagesize(), __FILE__);
-    if(cpld_base__ == NULL || cpld_base__ == MAP_FAILED) {
+    cpld__ = onlp_regmap_open(CPLD_BASE_ADDRESS, getpagesize(), __FILE__);
+    if(cpld__ == NULL) {
         return ONLP_STATUS_E_INTERNAL;
     }
 
@@ -234,7 +234,7 @@ onlp_ledi_info_get(onlp_oid_t id, onlp_led_info_t* info)
     /* Set the mode () */
     info->mode = 0;
 
-    data = cpld_base__[reg];
+    data = onlp_regmap_read8(cpld__, reg);
     info->mode |= led_cpld_val_to_light_mode(ONLP_OID_ID_GET(id), data);
 
     return ONLP_STATUS_OK;
@@ -276,8 +276,8 @@ onlp_ledi_mode_set(onlp_oid_t id, onlp_led_mode_t mode)
         break;
     }
 
-    data = cpld_base__[reg];
-    cpld_base__[reg] = led_light_mode_to_cpld_val(ONLP_OID_ID_GET(id), mode, data);
+    data = onlp_regmap_read8(cpld__, reg);
+    onlp_regmap_write8(cpld__, reg, led_light_mode_to_cpld_val(ONLP_OID_ID_GET(id), mode, data));
 
     return ONLP_STATUS_OK;
 }
@@ -24,7 +24,7 @@
  *
  ***********************************************************/
 #include <onlp/platformi/psui.h>
-#include <onlplib/mmap.h>
+#include <onlplib/regmap.h>
 //#include "onlpie_int.h"
 #include "platform_lib.h"
 
@@ -80,7 +80,7 @@ const onlp_psu_cpld_t psu_cpld_data[] = {
 {PSU_2, CPLD_REG_PSU_2_STATUS_OFFSET, CPLD_REG_PSU_PRESENT_MASK, CPLD_REG_PSU_POWER_GOOD_MASK}
 };
 
-static volatile uint8_t* cpld_base__ = NULL;
+static onlp_regmap_t* cpld__ = NULL;
 /*
  * This function will be called prior to any other onlp_psui functions.
  */
@@ -90,8 +90,8 @@ onlp_psui_init(void)
     /*
      * Map the CPLD address
      */
-    cpld_base__ = onlp_mmap(CPLD_BASE_ADDRESS, getpagesize(), __FILE__);
-    if(cpld_base__ == NULL || cpld_base__ == MAP_FAILED) {
+    cpld__ = onlp_regmap_open(CPLD_BASE_ADDRESS, getpagesize(), __FILE__);
+    if(cpld__ == NULL) {
         return ONLP_STATUS_E_INTERNAL;
     }
     return ONLP_STATUS_OK;
@@ -140,7 +140,7 @@ onlp_psui_info_get(onlp_oid_t id, onlp_psu_info_t* info)
 
     *info = pinfo[ONLP_OID_ID_GET(id)];
 
-    val = cpld_base__[psu_cpld_data[pid].cpld_addr];
+    val = onlp_regmap_read8(cpld__, psu_cpld_data[pid].cpld_addr);
 
     if ((val & psu_cpld_data[pid].present_mask) == 0 )
     {
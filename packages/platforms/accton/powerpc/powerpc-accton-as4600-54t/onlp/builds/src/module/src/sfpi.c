@@ -24,7 +24,7 @@
  *
  ***********************************************************/
 #include <onlp/platformi/sfpi.h>
-#include <onlplib/mmap.h>
+#include <onlplib/regmap.h>
 
 #include <errno.h>
 #include <fcntl.h>
@@ -60,7 +60,7 @@
 #define MAX_I2C_BUSSES     2
 #define I2C_BUFFER_MAXSIZE 16
 
-static volatile uint8_t* cpld_base__ = NULL;
+static onlp_regmap_t* cpld__ = NULL;
 
 int
 onlp_sfpi_init(void)
@@ -68,8 +68,8 @@ onlp_sfpi_init(void)
     /*
      * Map the CPLD address
      */
-    cpld_base__ = onlp_mmap(CPLD_BASE_ADDRESS, getpagesize(), __FILE__);
-    if(cpld_base__ == NULL || cpld_base__ == MAP_FAILED) {
+    cpld__ = onlp_regmap_open(CPLD_BASE_ADDRESS, getpagesize(), __FILE__);
+    if(cpld__ == NULL) {
         return ONLP_STATUS_E_INTERNAL;
     }
     return ONLP_STATUS_OK;
@@ -94,7 +94,7 @@ int
 onlp_sfpi_presence_bitmap_get(onlp_sfp_bitmap_t* dst)
 {
     unsigned char val;
-    val = cpld_base__[CPLD_REG_SFP_PRESENT];
+    val = onlp_regmap_read8(cpld__, CPLD_REG_SFP_PRESENT);
     
     AIM_BITMAP_MOD(dst, 48, (val & CPLD_SFP_1_BIT_MASK) ? 0 : 1);
     AIM_BITMAP_MOD(dst, 49, (val & CPLD_SFP_2_BIT_MASK) ? 0 : 1);
@@ -108,7 +108,7 @@ int
 onlp_sfpi_rx_los_bitmap_get(onlp_sfp_bitmap_t* dst)
 {
     unsigned char val;
-    val = cpld_base__[CPLD_REG_SFP_RX_LOSS];
+    val = onlp_regmap_read8(cpld__, CPLD_REG_SFP_RX_LOSS);
     
     AIM_BITMAP_MOD(dst, 48, (val & CPLD_SFP_1_BIT_MASK) ? 1 : 0);
     AIM_BITMAP_MOD(dst, 49, (val & CPLD_SFP_2_BIT_MASK) ? 1 : 0);
@@ -150,7 +150,7 @@ onlp_sfpi_is_present(int port)
      * Return 0 if not present.
      * Return < 0 if error.
      */
-    val = cpld_base__[regOffset];
+    val = onlp_regmap_read8(cpld__, regOffset);
     rc = (val & mask) ? 0 : 1;
 
     return rc;
@@ -230,7 +230,7 @@ tx_enable_set__(int port, int enable)
     /* If enable is 1, enable the SFP */
     /* If enable is 0, disable the SFP */
     unsigned int regOffset;
-    unsigned char val, mask;
+    unsigned char mask;
 
     regOffset = CPLD_REG_SFP_TX_DISABLE;
 
@@ -252,24 +252,11 @@ tx_enable_set__(int port, int enable)
         return ONLP_STATUS_E_INVALID;
     }
 
-    /* read the current status.
-     */
-    val = cpld_base__[regOffset];
-
     /* CPLD value:
      * 0: transmit Enable
      * 1: transmit Disable
      */
-    if ( enable == 1)
-    {
-        val &= ~mask;
-    }
-    else
-    {
-        val |= mask;
-    }
-
-    cpld_base__[regOffset] = val;
+    onlp_regmap_modify8(cpld__, regOffset, mask, (enable == 1) ? 0 : mask);
 
     return ONLP_STATUS_OK;
 }
@@ -303,7 +290,7 @@ tx_enable_get__(int port, int* enable)
         return ONLP_STATUS_E_INTERNAL;
     }
 
-    val = cpld_base__[regOffset];
+    val = onlp_regmap_read8(cpld__, regOffset);
 
     /* Return whether the SFP is currently enabled
      * =0, if disable
@@ -318,12 +305,10 @@ tx_enable_get__(int port, int* enable)
 static int
 control_flags_get__(int port, uint32_t* status)
 {
-    unsigned int regOffset1, regOffset2;
+    /* RX_LOSS and TX_FAIL are adjacent and read in one pass. */
+    uint8_t bank[CPLD_REG_SFP_TX_FAIL - CPLD_REG_SFP_RX_LOSS + 1];
     unsigned char val1, val2, mask;
 
-    regOffset1 = CPLD_REG_SFP_RX_LOSS;
-    regOffset2 = CPLD_REG_SFP_TX_FAIL;
-
     *status = 0;
 
     switch(port)
@@ -344,8 +329,11 @@ control_flags_get__(int port, uint32_t* status)
         return ONLP_STATUS_E_INTERNAL;
     }
 
-    val1 = cpld_base__[regOffset1];
-    val2 = cpld_base__[regOffset2];
+    if(onlp_regmap_snapshot(cpld__, CPLD_REG_SFP_RX_LOSS, bank, sizeof(bank)) < 0) {
+        return ONLP_STATUS_E_INTERNAL;
+    }
+    val1 = bank[0];
+    val2 = bank[CPLD_REG_SFP_TX_FAIL - CPLD_REG_SFP_RX_LOSS];
 
     /* Report any current status flags for the SFP */
     if ((val1 & mask) == mask)
@@ -410,7 +398,8 @@ onlp_sfpi_control_get(int port, onlp_sfp_control_t control, int* value)
 int
 onlp_sfpi_denit(void)
 {
-    munmap((void*)cpld_base__, getpagesize());
+    onlp_regmap_close(cpld__);
+    cpld__ = NULL;
     return 0;
 }
 
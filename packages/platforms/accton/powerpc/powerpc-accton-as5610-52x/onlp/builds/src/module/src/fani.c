@@ -25,7 +25,7 @@
  ***********************************************************/
 #include <onlp/platformi/fani.h>
 #include <sys/mman.h>
-#include <onlplib/mmap.h>
+#include <onlplib/regmap.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -36,9 +36,6 @@
  */
 #define CPLD_BASE_ADDRESS    		 0xEA000000
 
-#define CPLD_REG_PSU1_STATUS         0x02
-#define CPLD_REG_PSU2_STATUS         0x01
-#define CPLD_REG_SYS_STATUS          0x03
 #define CPLD_PSU_PRESENT_MASK        0x01
 #define CPLD_PSU_POWER_GOOD_MASK     0x02
 #define CPLD_PSU_FAN_FAILURE_MASK    0x04
@@ -110,7 +107,7 @@ chassis_fan_duty_cycle_to_cpld_val(int duty_cycle)
     return (duty_cycle / 3.25);
 }
 
-static volatile uint8_t* cpld_base__ = NULL;
+static onlp_regmap_t* cpld__ = NULL;
 
 /*
  * This function will be called prior to all of onlp_fani_* functions.
@@ -121,9 +118,9 @@ onlp_fani_init(void)
     /*
      * Map the CPLD address
      */
-    cpld_base__ = onlp_mmap(CPLD_BASE_ADDRESS, getpagesize(), __FILE__);
+    cpld__ = onlp_regmap_open(CPLD_BASE_ADDRESS, getpagesize(), __FILE__);
 
-    if(cpld_base__ == NULL || cpld_base__ == MAP_FAILED) {
+    if(cpld__ == NULL) {
         return ONLP_STATUS_E_INTERNAL;
     }
 
@@ -151,10 +148,14 @@ onlp_fan_info_t finfo[] = {
 static int
 chassis_fan_get_info(onlp_fan_info_t* info)
 {
+    unsigned char bank[CPLD_STATUS_BANK_SIZE];
     unsigned char data;
     info->status = 0;
 
-    data = cpld_base__[CPLD_REG_SYS_STATUS];
+    if (cpld_read_bank(CPLD_STATUS_BANK_START, bank, sizeof(bank)) != 0) {
+        return ONLP_STATUS_E_INTERNAL;
+    }
+    data = CPLD_STATUS_BANK_REG(bank, CPLD_REG_SYS_STATUS);
 
     /* Get the present bit */
     if ((~data) & CPLD_FAN_PRESENT_MASK) {
@@ -178,7 +179,7 @@ chassis_fan_get_info(onlp_fan_info_t* info)
 
     /* Get the percentage
      */
-    data = cpld_base__[CPLD_FAN_SPEED_CTL_REG];
+    data = onlp_regmap_read8(cpld__, CPLD_FAN_SPEED_CTL_REG);
     info->percentage = chassis_fan_cpld_val_to_duty_cycle(data);
 
     return ONLP_STATUS_OK;
@@ -247,6 +248,7 @@ psu_cpr_4011_b2f_fan_info_get(onlp_fan_info_t* info)
 static int
 psu_um400d_fan_info_get(onlp_fan_info_t* info)
 {
+    unsigned char bank[CPLD_STATUS_BANK_SIZE];
     unsigned char cpld_offset, data;
 
     info->mode       = ONLP_FAN_MODE_INVALID; /* Set current mode */
@@ -262,7 +264,10 @@ psu_um400d_fan_info_get(onlp_fan_info_t* info)
         cpld_offset = CPLD_REG_PSU2_STATUS;
     }
 
-    data = cpld_base__[cpld_offset];
+    if (cpld_read_bank(CPLD_STATUS_BANK_START, bank, sizeof(bank)) != 0) {
+        return ONLP_STATUS_E_INTERNAL;
+    }
+    data = CPLD_STATUS_BANK_REG(bank, cpld_offset);
 
     if (!(data & CPLD_PSU_FAN_FAILURE_MASK)) {
         info->status |= ONLP_FAN_STATUS_FAILED;
@@ -338,7 +343,7 @@ onlp_fani_rpm_set(onlp_oid_t id, int rpm)
 static int
 onlp_chassis_fan_percentage_set(int p)
 {
-    cpld_base__[CPLD_FAN_SPEED_CTL_REG] = chassis_fan_duty_cycle_to_cpld_val(p);
+    onlp_regmap_write8(cpld__, CPLD_FAN_SPEED_CTL_REG, chassis_fan_duty_cycle_to_cpld_val(p));
 
     return ONLP_STATUS_OK;
 }
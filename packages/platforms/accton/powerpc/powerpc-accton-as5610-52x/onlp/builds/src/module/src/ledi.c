@@ -24,7 +24,7 @@
 #include <stdio.h>
 #include <string.h>
 
-#include <onlplib/mmap.h>
+#include <onlplib/regmap.h>
 
 //#include "onlpie_int.h"
 
@@ -132,7 +132,29 @@ onlp_led_light_mode_to_cpld_val(onlp_led_id_t lid, onlp_led_mode_t mode, unsigne
     return orig_val;
 }
 
-static volatile uint8_t* cpld_base__ = NULL;
+/*
+ * The CPLD register for the given LED mode, or -1 if the
+ * LED does not support the mode.
+ */
+static int
+onlp_led_cpld_reg(onlp_oid_t id, onlp_led_mode_t mode)
+{
+    int i;
+
+    if (!ONLP_OID_IS_LED(id)) {
+        return -1;
+    }
+
+    for (i = 0; i < AIM_ARRAYSIZE(led_data); i++) {
+        if (ONLP_OID_ID_GET(id) == led_data[i].lid && mode == led_data[i].mode) {
+            return led_data[i].cpld_offset;
+        }
+    }
+
+    return -1;
+}
+
+static onlp_regmap_t* cpld__ = NULL;
 
 /*
  * This function will be called prior to any other onlp_ledi_* functions.
@@ -143,9 +165,9 @@ onlp_ledi_init(void)
     /*
      * Map the CPLD address
      */
-    cpld_base__ = onlp_mmap(CPLD_BASE_ADDRESS, getpagesize(), __FILE__);
+    cpld__ = onlp_regmap_open(CPLD_BASE_ADDRESS, getpagesize(), __FILE__);
 
-    if(cpld_base__ == NULL || cpld_base__ == MAP_FAILED) {
+    if(cpld__ == NULL) {
         return ONLP_STATUS_E_INTERNAL;
     }
 
@@ -206,7 +228,7 @@ onlp_ledi_info_get(onlp_oid_t id, onlp_led_info_t* info)
         break;
     }
 
-    data = cpld_base__[reg];
+    data = onlp_regmap_read8(cpld__, reg);
     info->mode = onlp_led_cpld_val_to_light_mode(ONLP_OID_ID_GET(id), data);
 
     /* Set the on/off status */
@@ -260,8 +282,53 @@ onlp_ledi_mode_set(onlp_oid_t id, onlp_led_mode_t mode)
         break;
     }
 
-    data = cpld_base__[reg];
-    cpld_base__[reg] = onlp_led_light_mode_to_cpld_val(ONLP_OID_ID_GET(id), mode, data);
+    data = onlp_regmap_read8(cpld__, reg);
+    onlp_regmap_write8(cpld__, reg, onlp_led_light_mode_to_cpld_val(ONLP_OID_ID_GET(id), mode, data));
+
+    return ONLP_STATUS_OK;
+}
+
+/*
+ * Set multiple LEDs with one read and one write per CPLD register.
+ */
+int
+onlp_ledi_set_many(onlp_led_update_t* updates, int count)
+{
+    int i, j, reg;
+    unsigned char data;
+
+    for (i = 0; i < count; i++) {
+        updates[i].rv = (onlp_led_cpld_reg(updates[i].id, updates[i].mode) < 0) ?
+            ONLP_STATUS_E_UNSUPPORTED : ONLP_STATUS_OK;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (updates[i].rv < 0) {
+            continue;
+        }
+        reg = onlp_led_cpld_reg(updates[i].id, updates[i].mode);
+
+        /* Skip registers already written for an earlier update. */
+        for (j = 0; j < i; j++) {
+            if (updates[j].rv == ONLP_STATUS_OK &&
+                onlp_led_cpld_reg(updates[j].id, updates[j].mode) == reg) {
+                break;
+            }
+        }
+        if (j < i) {
+            continue;
+        }
+
+        data = onlp_regmap_read8(cpld__, reg);
+        for (j = i; j < count; j++) {
+            if (updates[j].rv == ONLP_STATUS_OK &&
+                onlp_led_cpld_reg(updates[j].id, updates[j].mode) == reg) {
+                data = onlp_led_light_mode_to_cpld_val(ONLP_OID_ID_GET(updates[j].id),
+                                                       updates[j].mode, data);
+            }
+        }
+        onlp_regmap_write8(cpld__, reg, data);
+    }
 
     return ONLP_STATUS_OK;
 }
@@ -30,6 +30,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <linux/i2c-devices.h>
+#include <onlplib/regmap.h>
 #include "platform_lib.h"
 
 #define CPLD_BASE_ADDRESS       0xEA000000
@@ -39,82 +40,47 @@
 
 #define PMBUS_LITERAL_DATA_MULTIPLIER 1000
 
-static int mem_read(unsigned int base, unsigned int offset, unsigned char *val)
+/*
+ * The CPLD window is mapped on first use and shared with the
+ * fan, LED and PSU drivers.
+ */
+static onlp_regmap_t*
+cpld_regmap__(void)
 {
-    int fd;
-    void* pMem;
-
-    fd = open("/dev/mem", O_RDWR);
-    if (fd < 0)
-    {
-        printf("IO R/W: can't open /dev/mem.\n");
-        return -1;
-    }
-    else
-    {
-        pMem = mmap(0, getpagesize(), PROT_READ|PROT_WRITE, MAP_SHARED, fd, base);
-
-        if (pMem == MAP_FAILED)
-        {
-            printf("IO R/W: can't get the address pointer (%s)\n", strerror(errno));
-            close(fd);
-            return -1;
-        }
-
-        *val = *((volatile unsigned char*)(pMem + offset));
-
-        if ( -1 == munmap(pMem, getpagesize() ) )
-            printf("IO R/W: can't release the address pointer (%s)\n", strerror(errno));
-
-        close(fd);
+    static onlp_regmap_t* cpld__ = NULL;
+    if(cpld__ == NULL) {
+        cpld__ = onlp_regmap_open(CPLD_BASE_ADDRESS, getpagesize(), __FILE__);
     }
-
-    return 0;
+    return cpld__;
 }
 
-static int mem_write(unsigned int base, unsigned int offset, unsigned char val)
+int cpld_read(unsigned int regOffset, unsigned char *val)
 {
-    int fd;
-    void* pMem;
-
-    fd = open("/dev/mem", O_RDWR);
-    if (fd < 0)
-    {
-        printf("IO R/W: can't open /dev/mem.\n");
+    onlp_regmap_t* rm = cpld_regmap__();
+    if (rm == NULL || regOffset >= rm->size) {
         return -1;
     }
-    else
-    {
-        pMem = mmap(0, getpagesize(), PROT_READ|PROT_WRITE, MAP_SHARED,fd, base);
-
-        if (pMem == MAP_FAILED)
-        {
-            printf("IO R/W: can't get the address pointer (%s)\n", strerror(errno));
-            close(fd);
-            return -1;
-        }
-
-        *((volatile unsigned char *)(pMem + offset)) = val;
-
-        if ( -1 == munmap(pMem, getpagesize() ) )
-		{
-            printf("IO R/W: can't release the address pointer (%s)\n", strerror(errno));
-		}
-
-        close(fd);
-
-        return 0;
-    }
+    *val = onlp_regmap_read8(rm, regOffset);
+    return 0;
 }
 
-int cpld_read(unsigned int regOffset, unsigned char *val)
+int cpld_write(unsigned int regOffset, unsigned char val)
 {
-    return mem_read((unsigned int)CPLD_BASE_ADDRESS, regOffset, val);
+    onlp_regmap_t* rm = cpld_regmap__();
+    if (rm == NULL || regOffset >= rm->size) {
+        return -1;
+    }
+    onlp_regmap_write8(rm, regOffset, val);
+    return 0;
 }
 
-int cpld_write(unsigned int regOffset, unsigned char val)
+int cpld_read_bank(unsigned int regOffset, unsigned char *buf, int len)
 {
-    return mem_write((unsigned int)CPLD_BASE_ADDRESS, regOffset, val);
+    onlp_regmap_t* rm = cpld_regmap__();
+    if (rm == NULL) {
+        return -1;
+    }
+    return (onlp_regmap_snapshot(rm, regOffset, buf, len) == len) ? 0 : -1;
 }
 
 int i2c_write(unsigned int bus_id, unsigned char i2c_addr,
@@ -405,46 +371,6 @@ pmbus_read_literal_data(unsigned char bus, unsigned char i2c_addr, unsigned char
     return 0;
 }
 
-int
-pmbus_parse_vout_format(unsigned char vout_mode, unsigned short val)
-{
-    int exponent, mantissa;
-
-    exponent = two_complement_to_int(vout_mode, 5, 0x1f);
-    mantissa = val;
-
-    if (exponent >= 0) {
-        return (mantissa << exponent) * PMBUS_LITERAL_DATA_MULTIPLIER;
-    }
-    else {
-        return (mantissa * PMBUS_LITERAL_DATA_MULTIPLIER) / (1 << -exponent);
-    }
-}
-
-int
-pmbus_read_vout_data(unsigned char bus, unsigned char i2c_addr, int *val)
-{
-    unsigned char vout_mode = 0;
-    unsigned char vout_val[2] = {0};
-    *val = 0;
-
-    /* Read VOUT_MODE first */
-    if (i2c_nRead(bus, i2c_addr, 0x20, sizeof(vout_mode), &vout_mode) != 0) {
-        printf("%s(%d): Failed to read vout data reg(0x20)\r\n", __FUNCTION__, __LINE__);
-        return -1;
-    }
-
-    /* Read VOUT */
-    if (i2c_nRead(bus, i2c_addr, 0x8B, sizeof(vout_val), vout_val) != 0) {
-        printf("%s(%d): Failed to read vout data reg(0x8B)\r\n", __FUNCTION__, __LINE__);
-        return -1;
-    }
-
-    *val = pmbus_parse_vout_format(vout_mode, vout_val[1] << 8 | vout_val[0]);
-
-    return 0;
-}
-
 int int_to_pmbus_linear(int val)
 {
     int mantissa = val, exponent = 0;
@@ -30,6 +30,18 @@ int cpld_read(unsigned int regOffset, unsigned char *val);
 
 int cpld_write(unsigned int regOffset, unsigned char val);
 
+/* Read len consecutive CPLD registers in one pass. */
+int cpld_read_bank(unsigned int regOffset, unsigned char *buf, int len);
+
+/* PSU and system status bank in CPLD
+ */
+#define CPLD_REG_PSU2_STATUS         0x01
+#define CPLD_REG_PSU1_STATUS         0x02
+#define CPLD_REG_SYS_STATUS          0x03
+#define CPLD_STATUS_BANK_START       CPLD_REG_PSU2_STATUS
+#define CPLD_STATUS_BANK_SIZE        3
+#define CPLD_STATUS_BANK_REG(_bank, _reg) ((_bank)[(_reg) - CPLD_STATUS_BANK_START])
+
 int i2c_write(unsigned int bus_id, unsigned char i2c_addr, unsigned char offset, unsigned char *buf);
 
 int i2c_read(unsigned int bus_id, unsigned char i2c_addr, unsigned char offset, unsigned char *buf);
@@ -45,10 +57,6 @@ int pmbus_parse_literal_format(unsigned short val);
 
 int pmbus_read_literal_data(unsigned char bus, unsigned char i2c_addr, unsigned char reg, int *val);
 
-int pmbus_parse_vout_format(unsigned char vout_mode, unsigned short val);
-
-int pmbus_read_vout_data(unsigned char bus, unsigned char i2c_addr, int *val);
-
 int int_to_pmbus_linear(int val);
 
 int as5610_52x_i2c0_pca9548_channel_set(unsigned char channel);
@@ -24,20 +24,15 @@
  *
  ***********************************************************/
 #include <onlp/platformi/psui.h>
-#include <onlplib/mmap.h>
+#include <onlplib/pmbus.h>
 #include <sys/mman.h>
 #include <stdio.h>
 #include <string.h>
 #include "powerpc_accton_as5610_52x_log.h"
 #include "platform_lib.h"
 
-#define CPLD_BASE_ADDRESS    		0xEA000000
-
-/* PSU status register in CPLD
+/* PSU status bits in CPLD
  */
-#define CPLD_REG_PSU1_STATUS       0x2
-#define CPLD_REG_PSU2_STATUS       0x1
-#define CPLD_REG_SYS_STATUS        0x3
 #define CPLD_PSU_PRESENT_MASK      0x1
 #define CPLD_PSU_POWER_GOOD_MASK   0x2
 
@@ -46,14 +41,6 @@
 #define I2C_AC_PSU1_SLAVE_ADDR_CFG      0x3E
 #define I2C_AC_PSU2_SLAVE_ADDR_CFG      0x3D
 
-#define PSU_PMBUS_REG_READ_VIN     0x88
-#define PSU_PMBUS_REG_READ_VOUT    0x8B
-#define PSU_PMBUS_REG_READ_IIN     0x89
-#define PSU_PMBUS_REG_READ_IOUT    0x8C
-#define PSU_PMBUS_REG_READ_PIN     0x97
-#define PSU_PMBUS_REG_READ_POUT    0x96
-#define PSU_PMBUS_REG_VOUT_MODE    0x20
-
 #define VALIDATE(_id)                           \
     do {                                        \
         if(!ONLP_OID_IS_PSU(_id)) {             \
@@ -61,20 +48,9 @@
         }                                       \
     } while(0)
 
-static volatile uint8_t* cpld_base__ = NULL;
-
 int
 onlp_psui_init(void)
 {
-    /*
-     * Map the CPLD address
-     */
-    cpld_base__ = onlp_mmap(CPLD_BASE_ADDRESS, getpagesize(), __FILE__);
-
-    if(cpld_base__ == NULL || cpld_base__ == MAP_FAILED) {
-        return ONLP_STATUS_E_INTERNAL;
-    }
-
     return ONLP_STATUS_OK;
 }
 
@@ -82,6 +58,7 @@ int
 psu_cpr_4011_info_get(onlp_psu_info_t* info)
 {
     int index = ONLP_OID_ID_GET(info->hdr.id);
+    onlp_pmbus_sample_t sample;
     unsigned char mux_ch[]   = {0x2, 0x4};
     unsigned char cfg_addr[] = {I2C_AC_PSU1_SLAVE_ADDR_CFG, I2C_AC_PSU2_SLAVE_ADDR_CFG};
 
@@ -104,28 +81,9 @@ psu_cpr_4011_info_get(onlp_psu_info_t* info)
     }
 
     /* Read voltage, current and power */
-    if (pmbus_read_vout_data(I2C_PSU_BUS_ID, cfg_addr[index-1], &info->mvout) == 0) {
-        info->caps |= ONLP_PSU_CAPS_VOUT;
-    }
-
-    if (pmbus_read_literal_data(I2C_PSU_BUS_ID, cfg_addr[index-1], PSU_PMBUS_REG_READ_VIN,  &info->mvin) == 0) {
-        info->caps |= ONLP_PSU_CAPS_VIN;
-    }
-
-    if (pmbus_read_literal_data(I2C_PSU_BUS_ID, cfg_addr[index-1], PSU_PMBUS_REG_READ_IOUT, &info->miout) == 0) {
-        info->caps |= ONLP_PSU_CAPS_IOUT;
-    }
-
-    if (pmbus_read_literal_data(I2C_PSU_BUS_ID, cfg_addr[index-1], PSU_PMBUS_REG_READ_IIN,  &info->miin) == 0) {
-        info->caps |= ONLP_PSU_CAPS_IIN;
-    }
-
-    if (pmbus_read_literal_data(I2C_PSU_BUS_ID, cfg_addr[index-1], PSU_PMBUS_REG_READ_POUT, &info->mpout) == 0) {
-        info->caps |= ONLP_PSU_CAPS_POUT;
-    }
-
-    if (pmbus_read_literal_data(I2C_PSU_BUS_ID, cfg_addr[index-1], PSU_PMBUS_REG_READ_PIN,  &info->mpin) == 0) {
-        info->caps |= ONLP_PSU_CAPS_PIN;
+    if (onlp_pmbus_read(I2C_PSU_BUS_ID, cfg_addr[index-1], ONLP_PMBUS_TELEMETRY_ALL,
+                        &sample, ONLP_I2C_F_FORCE) == 0) {
+        onlp_pmbus_psu_info_update(&sample, info);
     }
 
     /* Close psu channel
@@ -175,6 +133,7 @@ onlp_psui_info_get(onlp_oid_t id, onlp_psu_info_t* info)
 {
     int   ret = ONLP_STATUS_OK;
     int index = ONLP_OID_ID_GET(id);
+    unsigned char bank[CPLD_STATUS_BANK_SIZE];
     unsigned char cpld_offset, data;
     as5610_52x_psu_type_t psu_type;
 
@@ -192,7 +151,10 @@ onlp_psui_info_get(onlp_oid_t id, onlp_psu_info_t* info)
 
     /* Get the present state */
     cpld_offset = (index == 1) ? CPLD_REG_PSU1_STATUS: CPLD_REG_PSU2_STATUS;
-    data = cpld_base__[cpld_offset];
+    if (cpld_read_bank(CPLD_STATUS_BANK_START, bank, sizeof(bank)) != 0) {
+        return ONLP_STATUS_E_INTERNAL;
+    }
+    data = CPLD_STATUS_BANK_REG(bank, cpld_offset);
 
     if (data & CPLD_PSU_PRESENT_MASK) {
         info->status &= ~ONLP_PSU_STATUS_PRESENT;
@@ -27,15 +27,74 @@
 #include <linux/slab.h>
 #include <linux/list.h>
 #include <linux/dmi.h>
+#include <linux/interrupt.h>
+#include <linux/workqueue.h>
+#include <linux/jiffies.h>
 
 static LIST_HEAD(cpld_client_list);
 static struct mutex	 list_lock;
 
+/*
+ * Each CPLD keeps a shadow of its register file. Registers are fetched
+ * in blocks with I2C block reads and served from the shadow for up to
+ * shadow_ms milliseconds, so drivers polling the same status bank share
+ * one bus transaction. Writes drop the shadow of the block written.
+ *
+ * Shadowing is off by default. A platform only enables it (shadow_ms)
+ * when its CPLDs auto-increment on block reads and have no
+ * clear-on-read registers.
+ */
+#define CPLD_SHADOW_SIZE	256
+#define CPLD_SHADOW_BLOCK	I2C_SMBUS_BLOCK_MAX
+#define CPLD_SHADOW_BLOCKS	(CPLD_SHADOW_SIZE / CPLD_SHADOW_BLOCK)
+
 struct cpld_client_node {
 	struct i2c_client *client;
 	struct list_head   list;
+	char			   block_read;	/* !=0 if the adapter supports I2C block reads */
+	u8				   regs[CPLD_SHADOW_SIZE];
+	char			   valid[CPLD_SHADOW_BLOCKS];	/* !=0 if the block is valid */
+	unsigned long	   last_updated[CPLD_SHADOW_BLOCKS];	/* In jiffies */
 };
 
+/*
+ * Status registers watched for changes on behalf of other drivers.
+ * The registers are scanned whenever the CPLD interrupt fires, or every
+ * poll_ms milliseconds on boards that do not wire the interrupt line.
+ */
+typedef void (*accton_i2c_cpld_watch_f)(void *cookie, unsigned short cpld_addr,
+										 u8 reg, u8 old, u8 new);
+
+static LIST_HEAD(cpld_watch_list);
+static DEFINE_MUTEX(watch_lock);
+static struct delayed_work watch_work;
+static unsigned long watch_seq;
+
+struct cpld_watch_node {
+	unsigned short			cpld_addr;
+	u8						reg;
+	u8						value;
+	char					valid;		/* !=0 if value is valid */
+	unsigned long			seq;		/* Scan in which value was read */
+	accton_i2c_cpld_watch_f	notify;
+	void				   *cookie;
+	struct list_head		list;
+};
+
+static int irq = -1;
+module_param(irq, int, S_IRUGO);
+MODULE_PARM_DESC(irq, "CPLD interrupt line, or -1 to poll the watched registers");
+
+static int poll_ms = 200;
+module_param(poll_ms, int, S_IRUGO | S_IWUSR);
+MODULE_PARM_DESC(poll_ms, "Watched register poll interval in milliseconds");
+
+static int watch_irq = -1;
+
+static int shadow_ms = 0;
+module_param(shadow_ms, int, S_IRUGO | S_IWUSR);
+MODULE_PARM_DESC(shadow_ms, "Register shadow lifetime in milliseconds, or 0 to always read the CPLD");
+
 /* Addresses scanned for accton_i2c_cpld
  */
 static const unsigned short normal_i2c[] = { 0x31, 0x35, 0x60, 0x61, 0x62, I2C_CLIENT_END };
@@ -56,6 +115,106 @@ static ssize_t show_cpld_version(struct device *dev, struct device_attribute *at
 
 static struct device_attribute ver = __ATTR(version, 0600, show_cpld_version, NULL);
 
+/* Called with list_lock held */
+static int accton_i2c_cpld_shadow_fill(struct cpld_client_node *node, int block)
+{
+	u8 reg = block * CPLD_SHADOW_BLOCK;
+	int status;
+
+	status = i2c_smbus_read_i2c_block_data(node->client, reg, CPLD_SHADOW_BLOCK,
+										   node->regs + reg);
+	if (status != CPLD_SHADOW_BLOCK) {
+		dev_dbg(&node->client->dev, "cpld(0x%x) block(0x%x) err %d\n",
+				node->client->addr, reg, status);
+		node->valid[block] = 0;
+		return (status < 0) ? status : -EIO;
+	}
+
+	node->last_updated[block] = jiffies;
+	node->valid[block] = 1;
+
+	return 0;
+}
+
+/* Called with list_lock held */
+static int accton_i2c_cpld_shadow_read(struct cpld_client_node *node, u8 reg,
+									   u8 *buf, int len)
+{
+	int i, status;
+
+	if (shadow_ms <= 0 || !node->block_read) {
+		for (i = 0; i < len; i++) {
+			status = i2c_smbus_read_byte_data(node->client, reg + i);
+			if (status < 0) {
+				return status;
+			}
+			buf[i] = status;
+		}
+		return len;
+	}
+
+	for (i = reg / CPLD_SHADOW_BLOCK; i <= (reg + len - 1) / CPLD_SHADOW_BLOCK; i++) {
+		if (!node->valid[i] ||
+			time_after(jiffies, node->last_updated[i] + msecs_to_jiffies(shadow_ms))) {
+			status = accton_i2c_cpld_shadow_fill(node, i);
+			if (status < 0) {
+				return status;
+			}
+		}
+	}
+
+	memcpy(buf, node->regs + reg, len);
+	return len;
+}
+
+/* Called with list_lock held */
+static struct cpld_client_node *accton_i2c_cpld_find(unsigned short cpld_addr)
+{
+	struct cpld_client_node *node;
+
+	list_for_each_entry(node, &cpld_client_list, list) {
+		if (node->client->addr == cpld_addr) {
+			return node;
+		}
+	}
+
+	return NULL;
+}
+
+static ssize_t accton_i2c_cpld_regs_read(struct file *filp, struct kobject *kobj,
+		struct bin_attribute *attr,
+		char *buf, loff_t off, size_t count)
+{
+	struct i2c_client *client = to_i2c_client(container_of(kobj, struct device, kobj));
+	struct cpld_client_node *node = i2c_get_clientdata(client);
+	int status;
+
+	if (!node) {
+		return -ENODEV;
+	}
+	if (off >= CPLD_SHADOW_SIZE || count == 0) {
+		return 0;
+	}
+	if (off + count > CPLD_SHADOW_SIZE) {
+		count = CPLD_SHADOW_SIZE - off;
+	}
+
+	mutex_lock(&list_lock);
+	status = accton_i2c_cpld_shadow_read(node, off, buf, count);
+	mutex_unlock(&list_lock);
+
+	return status;
+}
+
+static struct bin_attribute regs = {
+	.attr = {
+		.name = "regs",
+		.mode = S_IRUSR,
+	},
+	.size = CPLD_SHADOW_SIZE,
+	.read = accton_i2c_cpld_regs_read,
+};
+
 static void accton_i2c_cpld_add_client(struct i2c_client *client)
 {
 	struct cpld_client_node *node = kzalloc(sizeof(struct cpld_client_node), GFP_KERNEL);
@@ -66,6 +225,9 @@ static void accton_i2c_cpld_add_client(struct i2c_client *client)
 	}
 	
 	node->client = client;
+	node->block_read = i2c_check_functionality(client->adapter,
+											   I2C_FUNC_SMBUS_READ_I2C_BLOCK);
+	i2c_set_clientdata(client, node);
 	
 	mutex_lock(&list_lock);
 	list_add(&node->list, &cpld_client_list);
@@ -92,6 +254,7 @@ static void accton_i2c_cpld_remove_client(struct i2c_client *client)
 	
 	if (found) {
 		list_del(list_node);
+		i2c_set_clientdata(client, NULL);
 		kfree(cpld_node);
 	}
 	
@@ -116,6 +279,13 @@ static int accton_i2c_cpld_probe(struct i2c_client *client,
 
 	dev_info(&client->dev, "chip found\n");
 	accton_i2c_cpld_add_client(client);
+
+	status = sysfs_create_bin_file(&client->dev.kobj, &regs);
+	if (status) {
+		accton_i2c_cpld_remove_client(client);
+		sysfs_remove_file(&client->dev.kobj, &ver.attr);
+		goto exit;
+	}
 	
 	return 0;
 
@@ -125,6 +295,7 @@ exit:
 
 static int accton_i2c_cpld_remove(struct i2c_client *client)
 {
+	sysfs_remove_bin_file(&client->dev.kobj, &regs);
 	sysfs_remove_file(&client->dev.kobj, &ver.attr);
 	accton_i2c_cpld_remove_client(client);
 	
@@ -150,19 +321,17 @@ static struct i2c_driver accton_i2c_cpld_driver = {
 
 int accton_i2c_cpld_read(unsigned short cpld_addr, u8 reg)
 {
-	struct list_head   *list_node = NULL;
-	struct cpld_client_node *cpld_node = NULL;
+	struct cpld_client_node *cpld_node;
+	u8 value;
 	int ret = -EPERM;
 	
 	mutex_lock(&list_lock);
 
-	list_for_each(list_node, &cpld_client_list)
-	{
-		cpld_node = list_entry(list_node, struct cpld_client_node, list);
-		
-		if (cpld_node->client->addr == cpld_addr) {
-			ret = i2c_smbus_read_byte_data(cpld_node->client, reg);
-			break;
+	cpld_node = accton_i2c_cpld_find(cpld_addr);
+	if (cpld_node) {
+		ret = accton_i2c_cpld_shadow_read(cpld_node, reg, &value, 1);
+		if (ret >= 0) {
+			ret = value;
 		}
 	}
 	
@@ -172,6 +341,47 @@ int accton_i2c_cpld_read(unsigned short cpld_addr, u8 reg)
 }
 EXPORT_SYMBOL(accton_i2c_cpld_read);
 
+/*
+ * Read len consecutive registers starting at reg.
+ * Returns len, or a negative error code.
+ */
+int accton_i2c_cpld_read_block(unsigned short cpld_addr, u8 reg, u8 *buf, int len)
+{
+	struct cpld_client_node *cpld_node;
+	int ret = -EPERM;
+
+	if (len <= 0 || reg + len > CPLD_SHADOW_SIZE) {
+		return -EINVAL;
+	}
+
+	mutex_lock(&list_lock);
+
+	cpld_node = accton_i2c_cpld_find(cpld_addr);
+	if (cpld_node) {
+		ret = accton_i2c_cpld_shadow_read(cpld_node, reg, buf, len);
+	}
+
+	mutex_unlock(&list_lock);
+
+	return ret;
+}
+EXPORT_SYMBOL(accton_i2c_cpld_read_block);
+
+/*
+ * Drop the register shadow of every CPLD. The next read of any
+ * register goes to the hardware.
+ */
+static void accton_i2c_cpld_shadow_invalidate(void)
+{
+	struct cpld_client_node *cpld_node;
+
+	mutex_lock(&list_lock);
+	list_for_each_entry(cpld_node, &cpld_client_list, list) {
+		memset(cpld_node->valid, 0, sizeof(cpld_node->valid));
+	}
+	mutex_unlock(&list_lock);
+}
+
 int accton_i2c_cpld_write(unsigned short cpld_addr, u8 reg, u8 value)
 {
 	struct list_head   *list_node = NULL;
@@ -186,6 +396,7 @@ int accton_i2c_cpld_write(unsigned short cpld_addr, u8 reg, u8 value)
 		
 		if (cpld_node->client->addr == cpld_addr) {
 			ret = i2c_smbus_write_byte_data(cpld_node->client, reg, value);
+			cpld_node->valid[reg / CPLD_SHADOW_BLOCK] = 0;
 			break;
 		}
 	}
@@ -196,14 +407,136 @@ int accton_i2c_cpld_write(unsigned short cpld_addr, u8 reg, u8 value)
 }
 EXPORT_SYMBOL(accton_i2c_cpld_write);
 
+static void accton_i2c_cpld_watch_scan(void)
+{
+	struct cpld_watch_node *node, *prev;
+
+	mutex_lock(&watch_lock);
+	watch_seq++;
+
+	list_for_each_entry(node, &cpld_watch_list, list) {
+		int status = -1;
+
+		/* Each register is read once per scan */
+		list_for_each_entry(prev, &cpld_watch_list, list) {
+			if (prev == node) {
+				break;
+			}
+			if (prev->seq == watch_seq && prev->cpld_addr == node->cpld_addr &&
+				prev->reg == node->reg) {
+				status = prev->value;
+				break;
+			}
+		}
+
+		if (status < 0) {
+			status = accton_i2c_cpld_read(node->cpld_addr, node->reg);
+			if (status < 0) {
+				continue;
+			}
+		}
+
+		if (node->valid && node->value != status) {
+			node->notify(node->cookie, node->cpld_addr, node->reg, node->value, status);
+		}
+
+		node->value = status;
+		node->valid = 1;
+		node->seq	= watch_seq;
+	}
+
+	mutex_unlock(&watch_lock);
+}
+
+static void accton_i2c_cpld_watch_work(struct work_struct *work)
+{
+	accton_i2c_cpld_watch_scan();
+
+	if (watch_irq < 0 && !list_empty(&cpld_watch_list)) {
+		schedule_delayed_work(&watch_work, msecs_to_jiffies(poll_ms > 0 ? poll_ms : 1));
+	}
+}
+
+static irqreturn_t accton_i2c_cpld_watch_irq(int irq, void *dev_id)
+{
+	/* Something changed. Do not let the shadow hide it. */
+	accton_i2c_cpld_shadow_invalidate();
+	accton_i2c_cpld_watch_scan();
+	return IRQ_HANDLED;
+}
+
+/*
+ * Call notify() from process context whenever the value of a CPLD
+ * register changes. notify() may sleep but must not call
+ * accton_i2c_cpld_watch() or accton_i2c_cpld_unwatch().
+ */
+int accton_i2c_cpld_watch(unsigned short cpld_addr, u8 reg,
+						  accton_i2c_cpld_watch_f notify, void *cookie)
+{
+	struct cpld_watch_node *node = kzalloc(sizeof(struct cpld_watch_node), GFP_KERNEL);
+
+	if (!node) {
+		return -ENOMEM;
+	}
+
+	node->cpld_addr = cpld_addr;
+	node->reg		= reg;
+	node->notify	= notify;
+	node->cookie	= cookie;
+
+	mutex_lock(&watch_lock);
+	list_add_tail(&node->list, &cpld_watch_list);
+	mutex_unlock(&watch_lock);
+
+	/* Latch the initial value now */
+	mod_delayed_work(system_wq, &watch_work, 0);
+
+	return 0;
+}
+EXPORT_SYMBOL(accton_i2c_cpld_watch);
+
+void accton_i2c_cpld_unwatch(void *cookie)
+{
+	struct cpld_watch_node *node, *next;
+
+	mutex_lock(&watch_lock);
+
+	list_for_each_entry_safe(node, next, &cpld_watch_list, list) {
+		if (node->cookie == cookie) {
+			list_del(&node->list);
+			kfree(node);
+		}
+	}
+
+	mutex_unlock(&watch_lock);
+}
+EXPORT_SYMBOL(accton_i2c_cpld_unwatch);
+
 static int __init accton_i2c_cpld_init(void)
 {
 	mutex_init(&list_lock);
+	INIT_DELAYED_WORK(&watch_work, accton_i2c_cpld_watch_work);
+
+	if (irq >= 0) {
+		if (request_threaded_irq(irq, NULL, accton_i2c_cpld_watch_irq, IRQF_ONESHOT,
+								 "accton_i2c_cpld", &cpld_watch_list) == 0) {
+			watch_irq = irq;
+		}
+		else {
+			pr_warn("accton_i2c_cpld: unable to request irq %d, polling instead\n", irq);
+		}
+	}
+
 	return i2c_add_driver(&accton_i2c_cpld_driver);
 }
 
 static void __exit accton_i2c_cpld_exit(void)
 {
+	if (watch_irq >= 0) {
+		free_irq(watch_irq, &cpld_watch_list);
+	}
+	watch_irq = -1;
+	cancel_delayed_work_sync(&watch_work);
 	i2c_del_driver(&accton_i2c_cpld_driver);
 }
 	
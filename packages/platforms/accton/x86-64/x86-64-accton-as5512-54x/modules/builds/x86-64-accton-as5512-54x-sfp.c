@@ -73,6 +73,9 @@ static ssize_t sfp_eeprom_read(struct i2c_client *, u8, u8 *,int);
 static ssize_t sfp_eeprom_write(struct i2c_client *, u8 , const char *,int);
 extern int accton_i2c_cpld_read(unsigned short cpld_addr, u8 reg);
 extern int accton_i2c_cpld_write(unsigned short cpld_addr, u8 reg, u8 value);
+extern int accton_i2c_cpld_watch(unsigned short cpld_addr, u8 reg,
+								 void (*notify)(void *, unsigned short, u8, u8, u8), void *cookie);
+extern void accton_i2c_cpld_unwatch(void *cookie);
 
 /* Addresses scanned
  */
@@ -974,6 +977,66 @@ static int sfp_sysfs_eeprom_cleanup(struct kobject *kobj, struct bin_attribute *
 	return 0;
 }
 
+/*
+ * Called by accton_i2c_cpld when a watched present or rx_los register
+ * changes. Port 1 watches the registers of all SFP ports so that user
+ * space can poll() its sfp_is_present_all and sfp_rx_los_all.
+ */
+#define SFP_CPLD_ADDR(port)			(0x61 + (port) / 24)
+#define SFP_PRESENT_REG(port)		(0x6 + ((port) % 24) / 8)
+#define SFP_RX_LOS_REG(port)		(0xF + ((port) % 24) / 8)
+
+static void sfp_msa_status_changed(void *cookie, unsigned short cpld_addr,
+								   u8 reg, u8 old, u8 new)
+{
+	struct i2c_client *client = cookie;
+	struct sfp_port_data *data = i2c_get_clientdata(client);
+	int own = (cpld_addr == SFP_CPLD_ADDR(data->port)) &&
+			  ((old ^ new) & (1 << (data->port % 8)));
+
+	if (reg < SFP_RX_LOS_REG(0)) {
+		if (own && reg == SFP_PRESENT_REG(data->port)) {
+			sysfs_notify(&client->dev.kobj, NULL, "sfp_is_present");
+		}
+		sysfs_notify(&client->dev.kobj, NULL, "sfp_is_present_all");
+	}
+	else {
+		mutex_lock(&data->update_lock);
+		data->msa->valid = 0;
+		mutex_unlock(&data->update_lock);
+
+		if (own && reg == SFP_RX_LOS_REG(data->port)) {
+			sysfs_notify(&client->dev.kobj, NULL, "sfp_rx_los");
+		}
+		sysfs_notify(&client->dev.kobj, NULL, "sfp_rx_los_all");
+	}
+}
+
+static int sfp_msa_watch_status(struct i2c_client *client)
+{
+	struct sfp_port_data *data = i2c_get_clientdata(client);
+	int port, status = 0;
+
+	for (port = 0; port < 48 && !status; port += 8) {
+		if (data->port != 0 && port / 8 != data->port / 8) {
+			continue;
+		}
+
+		status = accton_i2c_cpld_watch(SFP_CPLD_ADDR(port), SFP_PRESENT_REG(port),
+									   sfp_msa_status_changed, client);
+		if (!status) {
+			status = accton_i2c_cpld_watch(SFP_CPLD_ADDR(port), SFP_RX_LOS_REG(port),
+										   sfp_msa_status_changed, client);
+		}
+	}
+
+	if (status) {
+		accton_i2c_cpld_unwatch(client);
+	}
+
+	return status;
+}
+
 static const struct attribute_group sfp_msa_group = {
 	.attrs = sfp_msa_attributes,
 };
@@ -1017,10 +1080,19 @@ static int sfp_msa_probe(struct i2c_client *client, const struct i2c_device_id *
 	}
 
 	*data = msa;
+
+	status = sfp_msa_watch_status(client);
+	if (status) {
+		goto exit_eeprom;
+	}
+
 	dev_info(&client->dev, "sfp msa '%s'\n", client->name);
 
 	return 0;
 
+exit_eeprom:
+	*data = NULL;
+	sfp_sysfs_eeprom_cleanup(&client->dev.kobj, &msa->eeprom.bin);
 exit_remove:
 	sysfs_remove_group(&client->dev.kobj, &sfp_msa_group);
 exit_free:
@@ -1164,6 +1236,7 @@ static int sfp_device_probe(struct i2c_client *client,
 
 static int sfp_msa_remove(struct i2c_client *client, struct sfp_msa_data *data)
 {
+	accton_i2c_cpld_unwatch(client);
 	sfp_sysfs_eeprom_cleanup(&client->dev.kobj, &data->eeprom.bin);
 	sysfs_remove_group(&client->dev.kobj, &sfp_msa_group);	
 	kfree(data);
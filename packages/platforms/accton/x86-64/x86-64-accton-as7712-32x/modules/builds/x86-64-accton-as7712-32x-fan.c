@@ -29,6 +29,7 @@
 #include <linux/sysfs.h>
 #include <linux/slab.h>
 #include <linux/dmi.h>
+#include <linux/workqueue.h>
 
 #define DRVNAME "as7712_32x_fan"
 
@@ -66,6 +67,10 @@ struct as7712_32x_fan_data {
     char             valid;           /* != 0 if registers are valid */
     unsigned long    last_updated;    /* In jiffies */
     u8               reg_val[ARRAY_SIZE(fan_reg)]; /* Register value */
+    struct i2c_client *client;
+    struct delayed_work notify_work;  /* Fault and present change detection */
+    u8               notify_present;  /* Present bits at the last check */
+    u8               notify_fault;    /* Fault bits at the last check */
 };
 
 enum fan_id {
@@ -346,6 +351,52 @@ static ssize_t fan_show_value(struct device *dev, struct device_attribute *da,
     return ret;
 }
 
+/*
+ * Poll the fan CPLD and raise sysfs_notify() on the fanN_present and
+ * fanN_fault attributes that changed, so user space can poll() them
+ * instead of reading them periodically.
+ */
+#define FAN_NOTIFY_INTERVAL (HZ + HZ / 2)
+
+static void as7712_32x_fan_notify_work(struct work_struct *work)
+{
+    struct as7712_32x_fan_data *data =
+        container_of(to_delayed_work(work), struct as7712_32x_fan_data, notify_work);
+    u8 present = 0, fault = 0, changed;
+    char name[16];
+    int i;
+
+    as7712_32x_fan_update_device(&data->client->dev);
+
+    if (data->valid) {
+        for (i = FAN1_ID; i <= FAN6_ID; i++) {
+            present |= reg_val_to_is_present(data->reg_val[FAN_PRESENT_REG], i) << i;
+            fault   |= is_fan_fault(data, i) << i;
+        }
+
+        changed = present ^ data->notify_present;
+        for (i = FAN1_ID; i <= FAN6_ID; i++) {
+            if (changed & (1 << i)) {
+                snprintf(name, sizeof(name), "fan%d_present", i + 1);
+                sysfs_notify(&data->client->dev.kobj, NULL, name);
+            }
+        }
+
+        changed = fault ^ data->notify_fault;
+        for (i = FAN1_ID; i <= FAN6_ID; i++) {
+            if (changed & (1 << i)) {
+                snprintf(name, sizeof(name), "fan%d_fault", i + 1);
+                sysfs_notify(&data->client->dev.kobj, NULL, name);
+            }
+        }
+
+        data->notify_present = present;
+        data->notify_fault   = fault;
+    }
+
+    schedule_delayed_work(&data->notify_work, FAN_NOTIFY_INTERVAL);
+}
+
 static const struct attribute_group as7712_32x_fan_group = {
     .attrs = as7712_32x_fan_attributes,
 };
@@ -408,7 +459,9 @@ static int as7712_32x_fan_probe(struct i2c_client *client,
 
     i2c_set_clientdata(client, data);
     data->valid = 0;
+    data->client = client;
     mutex_init(&data->update_lock);
+    INIT_DELAYED_WORK(&data->notify_work, as7712_32x_fan_notify_work);
 
     dev_info(&client->dev, "chip found\n");
 
@@ -426,6 +479,8 @@ static int as7712_32x_fan_probe(struct i2c_client *client,
 
     dev_info(&client->dev, "%s: fan '%s'\n",
          dev_name(data->hwmon_dev), client->name);
+
+    schedule_delayed_work(&data->notify_work, 0);
     
     return 0;
 
@@ -441,6 +496,7 @@ exit:
 static int as7712_32x_fan_remove(struct i2c_client *client)
 {
     struct as7712_32x_fan_data *data = i2c_get_clientdata(client);
+    cancel_delayed_work_sync(&data->notify_work);
     hwmon_device_unregister(data->hwmon_dev);
     sysfs_remove_group(&client->dev.kobj, &as7712_32x_fan_group);
     
@@ -213,6 +213,29 @@ onlp_sfpi_dev_writew(int port, uint8_t devaddr, uint8_t addr, uint16_t value)
     return onlp_i2c_writew(bus, devaddr, addr, value, ONLP_I2C_F_FORCE);
 }
 
+int
+onlp_sfpi_read(int port, uint8_t devaddr, int page, int offset, int len, uint8_t* buf)
+{
+    int rv;
+    int bus = FRONT_PORT_TO_MUX_INDEX(port);
+    int paged = (page > 0 && offset + len > ONLP_SFP_PAGE_UPPER);
+
+    if (paged) {
+        rv = onlp_i2c_writeb(bus, devaddr, ONLP_SFP_PAGE_SELECT, page, ONLP_I2C_F_FORCE);
+        if (rv < 0) {
+            return rv;
+        }
+    }
+
+    rv = onlp_i2c_block_read(bus, devaddr, offset, len, buf, ONLP_I2C_F_FORCE);
+
+    if (paged) {
+        onlp_i2c_writeb(bus, devaddr, ONLP_SFP_PAGE_SELECT, 0, ONLP_I2C_F_FORCE);
+    }
+
+    return (rv < 0) ? rv : len;
+}
+
 int
 onlp_sfpi_denit(void)
 {
@@ -9,7 +9,7 @@ class OnlPlatform_x86_64_accton_as7712_32x_r0(OnlPlatformAccton,
 
     def baseconfig(self):
         self.insmod('ym2651y')
-        self.insmod('accton_i2c_cpld')
+        self.insmod('accton_i2c_cpld', params={'shadow_ms': 100})
         for m in [ 'fan', 'psu', 'leds', 'sfp' ]:
             self.insmod("x86-64-accton-as7712-32x-%s.ko" % m)
 
@@ -44,19 +44,25 @@ static const unsigned short normal_i2c[] = { 0x50, I2C_CLIENT_END };
 struct as7716_32x_sfp_data {
 	struct device	   *hwmon_dev;
 	struct mutex		update_lock;
-	char				valid;			 /* !=0 if registers are valid */
+	char				valid;			 /* !=0 if is_present is valid */
 	unsigned long		last_updated;	 /* In jiffies */
 	int					port;			 /* Front port index */
+	char				eeprom_valid;	 /* !=0 if eeprom holds the inserted module's upper page */
 	char				eeprom[256];	 /* eeprom data */
 	u32					is_present;		 /* present status */
+	struct bin_attribute eeprom_bin;	 /* sfp_eeprom */
 };
 
 static struct as7716_32x_sfp_data *as7716_32x_sfp_update_device(struct device *dev);
+static int as7716_32x_sfp_update_present(struct i2c_client *client);
+static int as7716_32x_sfp_read_block(struct i2c_client *client, u8 command, u8 *data, int data_len);
 static ssize_t show_port_number(struct device *dev, struct device_attribute *da, char *buf);
 static ssize_t show_present(struct device *dev, struct device_attribute *da,char *buf);
-static ssize_t show_eeprom(struct device *dev, struct device_attribute *da, char *buf);
 extern int accton_i2c_cpld_read(unsigned short cpld_addr, u8 reg);
 extern int accton_i2c_cpld_write(unsigned short cpld_addr, u8 reg, u8 value);
+extern int accton_i2c_cpld_watch(unsigned short cpld_addr, u8 reg,
+								 void (*notify)(void *, unsigned short, u8, u8, u8), void *cookie);
+extern void accton_i2c_cpld_unwatch(void *cookie);
 
 enum as7716_32x_sfp_sysfs_attributes {
 	SFP_PORT_NUMBER,
@@ -70,13 +76,11 @@ enum as7716_32x_sfp_sysfs_attributes {
 static SENSOR_DEVICE_ATTR(sfp_port_number,    S_IRUGO, show_port_number, NULL, SFP_PORT_NUMBER);
 static SENSOR_DEVICE_ATTR(sfp_is_present,     S_IRUGO, show_present,     NULL, SFP_IS_PRESENT);
 static SENSOR_DEVICE_ATTR(sfp_is_present_all, S_IRUGO, show_present,     NULL, SFP_IS_PRESENT_ALL);
-static SENSOR_DEVICE_ATTR(sfp_eeprom,	      S_IRUGO, show_eeprom,      NULL, SFP_EEPROM);
 
 static struct attribute *as7716_32x_sfp_attributes[] = {
 	&sensor_dev_attr_sfp_port_number.dev_attr.attr,
 	&sensor_dev_attr_sfp_is_present.dev_attr.attr,
 	&sensor_dev_attr_sfp_is_present_all.dev_attr.attr,
-	&sensor_dev_attr_sfp_eeprom.dev_attr.attr,
 	NULL
 };
 
@@ -137,22 +141,125 @@ static ssize_t show_present(struct device *dev, struct device_attribute *da,
 	}
 }
 
-static ssize_t show_eeprom(struct device *dev, struct device_attribute *da,
-			 char *buf)
+/*
+ * The lower half of the eeprom holds the live monitors and latched
+ * flags, so it is read from the module on every request. The upper
+ * page 00h is static; it is read once per insertion and served from
+ * the cache until the port is found empty.
+ */
+#define SFP_EEPROM_UPPER_PAGE	128
+static ssize_t sfp_bin_read(struct file *filp, struct kobject *kobj,
+		struct bin_attribute *attr,
+		char *buf, loff_t off, size_t count)
 {
-	struct as7716_32x_sfp_data *data = as7716_32x_sfp_update_device(dev);
+	struct i2c_client *client = to_i2c_client(container_of(kobj, struct device, kobj));
+	struct as7716_32x_sfp_data *data = i2c_get_clientdata(client);
+	int status;
+	int i;
 
-	if (!data->valid) {
+	if (off >= sizeof(data->eeprom)) {
 		return 0;
 	}
+	if (off + count > sizeof(data->eeprom)) {
+		count = sizeof(data->eeprom) - off;
+	}
 
-	if (!data->is_present) {
-		return 0;
+	mutex_lock(&data->update_lock);
+
+	status = as7716_32x_sfp_update_present(client);
+	if (status < 0 || !data->is_present) {
+		count = 0;
+		goto exit;
 	}
 
-	memcpy(buf, data->eeprom, sizeof(data->eeprom));
+	/* Lower half: the blocks which overlap the request */
+	for (i = off/I2C_SMBUS_BLOCK_MAX;
+		 i*I2C_SMBUS_BLOCK_MAX < min_t(loff_t, off + count, SFP_EEPROM_UPPER_PAGE); i++) {
+		status = as7716_32x_sfp_read_block(client, i*I2C_SMBUS_BLOCK_MAX,
+										   data->eeprom+(i*I2C_SMBUS_BLOCK_MAX),
+										   I2C_SMBUS_BLOCK_MAX);
+		if (status < 0) {
+			goto read_error;
+		}
+	}
+
+	/* Upper page 00h: the whole page, once per insertion */
+	if (off + count > SFP_EEPROM_UPPER_PAGE && !data->eeprom_valid) {
+		for (i = SFP_EEPROM_UPPER_PAGE/I2C_SMBUS_BLOCK_MAX; i < sizeof(data->eeprom)/I2C_SMBUS_BLOCK_MAX; i++) {
+			status = as7716_32x_sfp_read_block(client, i*I2C_SMBUS_BLOCK_MAX,
+											   data->eeprom+(i*I2C_SMBUS_BLOCK_MAX),
+											   I2C_SMBUS_BLOCK_MAX);
+			if (status < 0) {
+				goto read_error;
+			}
+		}
 
-	return sizeof(data->eeprom);
+		data->eeprom_valid = 1;
+	}
+
+	memcpy(buf, data->eeprom + off, count);
+	goto exit;
+
+read_error:
+	dev_dbg(&client->dev, "unable to read eeprom from port(%d)\n", data->port);
+	count = status;
+
+exit:
+	mutex_unlock(&data->update_lock);
+
+	return count;
+}
+
+static int sfp_sysfs_eeprom_init(struct kobject *kobj, struct bin_attribute *eeprom)
+{
+	sysfs_bin_attr_init(eeprom);
+	eeprom->attr.name = "sfp_eeprom";
+	eeprom->attr.mode = S_IRUGO;
+	eeprom->read	  = sfp_bin_read;
+	eeprom->size	  = 256;
+
+	return sysfs_create_bin_file(kobj, eeprom);
+}
+
+/*
+ * Called by accton_i2c_cpld when a watched present register changes.
+ * Port 1 watches all present registers so that user space can poll()
+ * its sfp_is_present_all for any insertion or removal.
+ */
+static void as7716_32x_sfp_present_changed(void *cookie, unsigned short cpld_addr,
+										   u8 reg, u8 old, u8 new)
+{
+	struct i2c_client *client = cookie;
+	struct as7716_32x_sfp_data *data = i2c_get_clientdata(client);
+	u8 mask = 1 << (data->port % 8);
+
+	if (reg == 0x30 + (data->port/8) && ((old ^ new) & mask)) {
+		mutex_lock(&data->update_lock);
+		data->is_present   = (new & mask) ? 0 : 1;
+		data->eeprom_valid = 0;
+		data->last_updated = jiffies;
+		data->valid = 1;
+		mutex_unlock(&data->update_lock);
+
+		sysfs_notify(&client->dev.kobj, NULL, "sfp_is_present");
+	}
+
+	sysfs_notify(&client->dev.kobj, NULL, "sfp_is_present_all");
+}
+
+static int as7716_32x_sfp_watch_present(struct i2c_client *client)
+{
+	struct as7716_32x_sfp_data *data = i2c_get_clientdata(client);
+	int status = 0;
+	u8 reg;
+
+	for (reg = 0x30; reg <= 0x33 && !status; reg++) {
+		if (data->port == 0 || reg == 0x30 + (data->port/8)) {
+			status = accton_i2c_cpld_watch(0x60, reg, as7716_32x_sfp_present_changed, client);
+		}
+	}
+
+	return status;
 }
 
 static const struct attribute_group as7716_32x_sfp_group = {
@@ -188,6 +295,16 @@ static int as7716_32x_sfp_probe(struct i2c_client *client,
 		goto exit_free;
 	}
 
+	status = sfp_sysfs_eeprom_init(&client->dev.kobj, &data->eeprom_bin);
+	if (status) {
+		goto exit_remove_group;
+	}
+
+	status = as7716_32x_sfp_watch_present(client);
+	if (status) {
+		goto exit_remove;
+	}
+
 	data->hwmon_dev = hwmon_device_register(&client->dev);
 	if (IS_ERR(data->hwmon_dev)) {
 		status = PTR_ERR(data->hwmon_dev);
@@ -200,6 +317,9 @@ static int as7716_32x_sfp_probe(struct i2c_client *client,
 	return 0;
 
 exit_remove:
+	accton_i2c_cpld_unwatch(client);
+	sysfs_remove_bin_file(&client->dev.kobj, &data->eeprom_bin);
+exit_remove_group:
 	sysfs_remove_group(&client->dev.kobj, &as7716_32x_sfp_group);
 exit_free:
 	kfree(data);
@@ -212,7 +332,9 @@ static int as7716_32x_sfp_remove(struct i2c_client *client)
 {
 	struct as7716_32x_sfp_data *data = i2c_get_clientdata(client);
 
+	accton_i2c_cpld_unwatch(client);
 	hwmon_device_unregister(data->hwmon_dev);
+	sysfs_remove_bin_file(&client->dev.kobj, &data->eeprom_bin);
 	sysfs_remove_group(&client->dev.kobj, &as7716_32x_sfp_group);
 	kfree(data);
 
@@ -280,54 +402,47 @@ abort:
 	return result;
 }
 
-static struct as7716_32x_sfp_data *as7716_32x_sfp_update_device(struct device *dev)
+/*
+ * Refresh the present status from the CPLD. Called with update_lock held.
+ * The cached eeprom is dropped whenever the port is found empty so the
+ * next module inserted is read again.
+ */
+static int as7716_32x_sfp_update_present(struct i2c_client *client)
 {
-	struct i2c_client *client = to_i2c_client(dev);
 	struct as7716_32x_sfp_data *data = i2c_get_clientdata(client);
+	u8 cpld_reg = 0x30 + (data->port/8);
+	int status;
 
-	mutex_lock(&data->update_lock);
+	status = accton_i2c_cpld_read(0x60, cpld_reg);
+	if (status < 0) {
+		dev_dbg(&client->dev, "cpld(0x60) reg(0x%x) err %d\n", cpld_reg, status);
+		data->valid = 0;
+		return status;
+	}
 
-	if (time_after(jiffies, data->last_updated + HZ + HZ / 2)
-		|| !data->valid) {
-		int status = -1;
-		int i = 0;
-        u8 cpld_reg = 0x30 + (data->port/8);
+	data->is_present = (status & (1 << (data->port % 8))) ? 0 : 1;
+	if (!data->is_present) {
+		data->eeprom_valid = 0;
+	}
 
-		data->valid = 0;
+	data->last_updated = jiffies;
+	data->valid = 1;
 
-		/* Read present status of the specified port number */
-		data->is_present = 0;
-		status = accton_i2c_cpld_read(0x60, cpld_reg);
+	return 0;
+}
 
-		if (status < 0) {
-			dev_dbg(&client->dev, "cpld(0x60) reg(0x%x) err %d\n", cpld_reg, status);
-			goto exit;
-		}
+static struct as7716_32x_sfp_data *as7716_32x_sfp_update_device(struct device *dev)
+{
+	struct i2c_client *client = to_i2c_client(dev);
+	struct as7716_32x_sfp_data *data = i2c_get_clientdata(client);
 
-		data->is_present = (status & (1 << (data->port % 8))) ? 0 : 1;
-
-		/* Read eeprom data based on port number */
-		memset(data->eeprom, 0, sizeof(data->eeprom));
-
-		/* Check if the port is present */
-		if (data->is_present) {
-			/* read eeprom */
-			for (i = 0; i < sizeof(data->eeprom)/I2C_SMBUS_BLOCK_MAX; i++) {
-				status = as7716_32x_sfp_read_block(client, i*I2C_SMBUS_BLOCK_MAX,
-												   data->eeprom+(i*I2C_SMBUS_BLOCK_MAX),
-												   I2C_SMBUS_BLOCK_MAX);
-				if (status < 0) {
-					dev_dbg(&client->dev, "unable to read eeprom from port(%d)\n", data->port);
-					goto exit;
-				}
-			}
-		}
+	mutex_lock(&data->update_lock);
 
-		data->last_updated = jiffies;
-		data->valid = 1;
+	if (time_after(jiffies, data->last_updated + HZ + HZ / 2)
+		|| !data->valid) {
+		as7716_32x_sfp_update_present(client);
 	}
 
-exit:
 	mutex_unlock(&data->update_lock);
 
 	return data;
@@ -0,0 +1,13 @@
+
+###############################################################################
+#
+# Inclusive Makefile for the mlnx_common module.
+#
+# Autogenerated 2015-12-23 23:45:56.754200
+#
+###############################################################################
+mlnx_common_BASEDIR := $(dir $(abspath $(lastword $(MAKEFILE_LIST))))
+include $(mlnx_common_BASEDIR)/module/make.mk
+include $(mlnx_common_BASEDIR)/module/auto/make.mk
+include $(mlnx_common_BASEDIR)/module/src/make.mk
+
@@ -0,0 +1,136 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *           Copyright 2014 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Common Mellanox Platform Implementation
+ *
+ * All Mellanox x86-64 platforms expose the same /bsp attribute
+ * layout. This module implements the ONLP platform interfaces
+ * for all of them. Each platform module only provides a
+ * descriptor of its thermals, fans, PSUs, LEDs and ports.
+ *
+ ***********************************************************/
+#ifndef __MLNX_COMMON_H__
+#define __MLNX_COMMON_H__
+
+#include <mlnx_common/mlnx_common_config.h>
+#include <onlp/onlp.h>
+
+/**
+ * Thermal sensor descriptor.
+ * Read from /bsp/thermal/<node>.
+ */
+typedef struct mlnx_thermal_s {
+    /** OID description */
+    const char* description;
+    /** Attribute name */
+    const char* node;
+    /** PSU index for PSU sensors, 0 for chassis sensors */
+    int psu;
+    /** ONLP_THERMAL_CAPS_* */
+    uint32_t caps;
+    /** Warning threshold in milli-celsius */
+    int warning;
+    /** Error threshold in milli-celsius */
+    int error;
+    /** Shutdown threshold in milli-celsius */
+    int shutdown;
+} mlnx_thermal_t;
+
+/**
+ * Fan descriptor.
+ * Chassis fan N is read from /bsp/fan/fanN_*.
+ * The fan of PSU N is read from /bsp/fan/psuN_fan1_*.
+ * Chassis fans must precede PSU fans.
+ */
+typedef struct mlnx_fan_s {
+    /** OID description */
+    const char* description;
+    /** PSU index for PSU fans, 0 for chassis fans */
+    int psu;
+    /** ONLP_FAN_CAPS_* */
+    uint32_t caps;
+} mlnx_fan_t;
+
+/**
+ * LED descriptor.
+ * Read from and written to /bsp/led/led_<node>.
+ */
+typedef struct mlnx_led_s {
+    /** OID description */
+    const char* description;
+    /** Attribute name */
+    const char* node;
+    /** ONLP_LED_CAPS_* */
+    uint32_t caps;
+} mlnx_led_t;
+
+/**
+ * Platform descriptor.
+ */
+typedef struct mlnx_platform_info_s {
+    /** ONL platform name */
+    const char* onl_platform_name;
+    /** ONIE platform name */
+    const char* onie_platform_name;
+
+    /** Number of QSFP ports */
+    int sfp_ports;
+
+    /** Thermal sensors, indexed by OID id - 1 */
+    const mlnx_thermal_t* thermals;
+    int thermal_count;
+
+    /** Fans, indexed by OID id - 1 */
+    const mlnx_fan_t* fans;
+    int fan_count;
+    /**
+     * Number of chassis fans on each fan FRU.
+     * 0 if the chassis fans are fixed and always present.
+     */
+    int fans_per_fru;
+    /** Model of fixed chassis fans */
+    const char* fan_model;
+
+    /** Number of PSUs */
+    int psu_count;
+    /**
+     * Model of fixed PSUs.
+     * Fixed PSUs are always present, have no FRU EEPROM and
+     * report output voltage and current only.
+     */
+    const char* psu_model;
+
+    /** LEDs, indexed by OID id - 1 */
+    const mlnx_led_t* leds;
+    int led_count;
+
+    /** CPLD names. Versions are read from /bsp/cpld/cpld_<name>_version. */
+    const char* const* cplds;
+    int cpld_count;
+} mlnx_platform_info_t;
+
+/**
+ * @brief Get the platform descriptor.
+ * @note This must be provided by each platform module.
+ */
+const mlnx_platform_info_t* mlnx_platform_info_get(void);
+
+#endif /* __MLNX_COMMON_H__ */
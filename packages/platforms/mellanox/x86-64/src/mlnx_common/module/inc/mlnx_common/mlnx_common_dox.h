@@ -0,0 +1,26 @@
+/**************************************************************************//**
+ *
+ * mlnx_common Doxygen Header
+ *
+ *****************************************************************************/
+#ifndef __mlnx_common_DOX_H__
+#define __mlnx_common_DOX_H__
+
+/**
+ * @defgroup mlnx_common mlnx_common - mlnx_common Description
+ *
+
+The documentation overview for this module should go here.
+
+ *
+ * @{
+ *
+ * @defgroup mlnx_common-mlnx_common Public Interface
+ * @defgroup mlnx_common-config Compile Time Configuration
+ * @defgroup mlnx_common-porting Porting Macros
+ *
+ * @}
+ *
+ */
+
+#endif /* __mlnx_common_DOX_H__ */
@@ -0,0 +1,107 @@
+/**************************************************************************//**
+ *
+ * @file
+ * @brief mlnx_common Porting Macros.
+ *
+ * @addtogroup mlnx_common-porting
+ * @{
+ *
+ *****************************************************************************/
+#ifndef __mlnx_common_PORTING_H__
+#define __mlnx_common_PORTING_H__
+
+
+/* <auto.start.portingmacro(ALL).define> */
+#if mlnx_common_CONFIG_PORTING_INCLUDE_STDLIB_HEADERS == 1
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <memory.h>
+#endif
+
+#ifndef mlnx_common_MALLOC
+    #if defined(GLOBAL_MALLOC)
+        #define mlnx_common_MALLOC GLOBAL_MALLOC
+    #elif mlnx_common_CONFIG_PORTING_STDLIB == 1
+        #define mlnx_common_MALLOC malloc
+    #else
+        #error The macro mlnx_common_MALLOC is required but cannot be defined.
+    #endif
+#endif
+
+#ifndef mlnx_common_FREE
+    #if defined(GLOBAL_FREE)
+        #define mlnx_common_FREE GLOBAL_FREE
+    #elif mlnx_common_CONFIG_PORTING_STDLIB == 1
+        #define mlnx_common_FREE free
+    #else
+        #error The macro mlnx_common_FREE is required but cannot be defined.
+    #endif
+#endif
+
+#ifndef mlnx_common_MEMSET
+    #if defined(GLOBAL_MEMSET)
+        #define mlnx_common_MEMSET GLOBAL_MEMSET
+    #elif mlnx_common_CONFIG_PORTING_STDLIB == 1
+        #define mlnx_common_MEMSET memset
+    #else
+        #error The macro mlnx_common_MEMSET is required but cannot be defined.
+    #endif
+#endif
+
+#ifndef mlnx_common_MEMCPY
+    #if defined(GLOBAL_MEMCPY)
+        #define mlnx_common_MEMCPY GLOBAL_MEMCPY
+    #elif mlnx_common_CONFIG_PORTING_STDLIB == 1
+        #define mlnx_common_MEMCPY memcpy
+    #else
+        #error The macro mlnx_common_MEMCPY is required but cannot be defined.
+    #endif
+#endif
+
+#ifndef mlnx_common_STRNCPY
+    #if defined(GLOBAL_STRNCPY)
+        #define mlnx_common_STRNCPY GLOBAL_STRNCPY
+    #elif mlnx_common_CONFIG_PORTING_STDLIB == 1
+        #define mlnx_common_STRNCPY strncpy
+    #else
+        #error The macro mlnx_common_STRNCPY is required but cannot be defined.
+    #endif
+#endif
+
+#ifndef mlnx_common_VSNPRINTF
+    #if defined(GLOBAL_VSNPRINTF)
+        #define mlnx_common_VSNPRINTF GLOBAL_VSNPRINTF
+    #elif mlnx_common_CONFIG_PORTING_STDLIB == 1
+        #define mlnx_common_VSNPRINTF vsnprintf
+    #else
+        #error The macro mlnx_common_VSNPRINTF is required but cannot be defined.
+    #endif
+#endif
+
+#ifndef mlnx_common_SNPRINTF
+    #if defined(GLOBAL_SNPRINTF)
+        #define mlnx_common_SNPRINTF GLOBAL_SNPRINTF
+    #elif mlnx_common_CONFIG_PORTING_STDLIB == 1
+        #define mlnx_common_SNPRINTF snprintf
+    #else
+        #error The macro mlnx_common_SNPRINTF is required but cannot be defined.
+    #endif
+#endif
+
+#ifndef mlnx_common_STRLEN
+    #if defined(GLOBAL_STRLEN)
+        #define mlnx_common_STRLEN GLOBAL_STRLEN
+    #elif mlnx_common_CONFIG_PORTING_STDLIB == 1
+        #define mlnx_common_STRLEN strlen
+    #else
+        #error The macro mlnx_common_STRLEN is required but cannot be defined.
+    #endif
+#endif
+
+/* <auto.end.portingmacro(ALL).define> */
+
+
+#endif /* __mlnx_common_PORTING_H__ */
+/* @} */
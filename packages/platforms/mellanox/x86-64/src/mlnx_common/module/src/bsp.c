@@ -0,0 +1,149 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *           Copyright 2014 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * BSP Attribute Access
+ *
+ * Attribute files are opened on first use and kept open.
+ * Each read is a single pread() at offset 0, which returns
+ * the current value of the attribute. All callers are
+ * serialized by the ONLP API lock.
+ *
+ ***********************************************************/
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <onlplib/file.h>
+#include "mlnx_common_int.h"
+#include "mlnx_common_log.h"
+
+typedef struct bsp_fd_s {
+    char path[MLNX_BSP_PATH_MAX];
+    int fd;
+} bsp_fd_t;
+
+static bsp_fd_t fds__[MLNX_COMMON_CONFIG_BSP_FD_CACHE_SIZE];
+
+/**
+ * Find or claim the cache entry for the given path.
+ * Returns NULL if the cache is full.
+ */
+static bsp_fd_t*
+bsp_fd_entry__(const char* path)
+{
+    uint32_t h = 2166136261U;
+    const char* p;
+    int i;
+
+    for(p = path; *p; p++) {
+        h = (h ^ (uint8_t)*p) * 16777619U;
+    }
+
+    for(i = 0; i < MLNX_COMMON_CONFIG_BSP_FD_CACHE_SIZE; i++) {
+        bsp_fd_t* e = fds__ + ((h + i) % MLNX_COMMON_CONFIG_BSP_FD_CACHE_SIZE);
+        if(e->path[0] == 0) {
+            aim_strlcpy(e->path, path, sizeof(e->path));
+            e->fd = -1;
+            return e;
+        }
+        if(!strcmp(e->path, path)) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+static int
+bsp_vread__(uint8_t* data, int max, int* len, const char* fmt, va_list vargs)
+{
+    char path[MLNX_BSP_PATH_MAX];
+    bsp_fd_t* e;
+    int n = -1, retry;
+
+    if(vsnprintf(path, sizeof(path), fmt, vargs) >= sizeof(path) ||
+       (e = bsp_fd_entry__(path)) == NULL) {
+        /* Not cacheable. */
+        return onlp_file_read(data, max, len, "%s", path);
+    }
+
+    memset(data, 0, max);
+    for(retry = 0; retry < 2; retry++) {
+        if(e->fd < 0 && (e->fd = open(path, O_RDONLY)) < 0) {
+            return ONLP_STATUS_E_MISSING;
+        }
+        if((n = pread(e->fd, data, max, 0)) > 0) {
+            break;
+        }
+        /* The attribute may have been recreated by a driver reload. */
+        close(e->fd);
+        e->fd = -1;
+    }
+
+    if(n <= 0) {
+        AIM_LOG_ERROR("Failed to read input file '%s'", path);
+        return ONLP_STATUS_E_INTERNAL;
+    }
+
+    *len = n;
+    return ONLP_STATUS_OK;
+}
+
+int
+mlnx_bsp_read(uint8_t* data, int max, int* len, const char* fmt, ...)
+{
+    int rv;
+    va_list vargs;
+    va_start(vargs, fmt);
+    rv = bsp_vread__(data, max, len, fmt, vargs);
+    va_end(vargs);
+    return rv;
+}
+
+int
+mlnx_bsp_read_int(int* value, const char* fmt, ...)
+{
+    int rv, len;
+    uint8_t data[32];
+    va_list vargs;
+
+    va_start(vargs, fmt);
+    rv = bsp_vread__(data, sizeof(data) - 1, &len, fmt, vargs);
+    va_end(vargs);
+    if(rv < 0) {
+        return rv;
+    }
+    *value = atoi((char*)data);
+    return ONLP_STATUS_OK;
+}
+
+void
+mlnx_bsp_close_all(void)
+{
+    int i;
+    for(i = 0; i < MLNX_COMMON_CONFIG_BSP_FD_CACHE_SIZE; i++) {
+        if(fds__[i].path[0] && fds__[i].fd >= 0) {
+            close(fds__[i].fd);
+        }
+        fds__[i].path[0] = 0;
+        fds__[i].fd = -1;
+    }
+}
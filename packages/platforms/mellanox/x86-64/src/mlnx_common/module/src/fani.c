@@ -22,13 +22,15 @@
  * Fan Platform Implementation Defaults.
  *
  ***********************************************************/
-#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
 #include <onlplib/file.h>
-#include <onlplib/mmap.h>
 #include <onlp/platformi/fani.h>
-#include "platform_lib.h"
+#include "mlnx_common_int.h"
+#include "mlnx_common_log.h"
 
 #define PREFIX_PATH        "/bsp/fan/"
+#define PREFIX_MODULE_PATH "/bsp/module/"
 
 #define FAN_STATUS_OK  1
 
@@ -37,65 +39,12 @@
 #define RPM_MAGIC_MIN  153.0
 #define RPM_MAGIC_MAX  255.0
 
-#define PROJECT_NAME
-#define LEN_FILE_NAME 80
+#define PSU_FAN_RPM_MIN 11700.0
+#define PSU_FAN_RPM_MAX 19500.0
 
-#define FAN_RESERVED        0
-#define FAN_1_ON_MAIN_BOARD 1
-#define FAN_2_ON_MAIN_BOARD 2
-#define FAN_3_ON_MAIN_BOARD 3
-#define FAN_4_ON_MAIN_BOARD 4
-#define FAN_MODEL	"MEC012579"
-
-static int min_fan_speed[CHASSIS_FAN_COUNT+1] = {0};
-static int max_fan_speed[CHASSIS_FAN_COUNT+1] = {0};
-
-typedef struct fan_path_S
-{
-    char status[LEN_FILE_NAME];
-    char r_speed_get[LEN_FILE_NAME];
-    char r_speed_set[LEN_FILE_NAME];
-    char min[LEN_FILE_NAME];
-    char max[LEN_FILE_NAME];
-}fan_path_T;
-
-#define _MAKE_FAN_PATH_ON_MAIN_BOARD(prj,id) \
-    { #prj"fan"#id"_status", \
-      #prj"fan"#id"_speed_get", \
-      #prj"fan"#id"_speed_set", \
-      #prj"fan"#id"_min", \
-      #prj"fan"#id"_max" }
-
-#define MAKE_FAN_PATH_ON_MAIN_BOARD(prj,id) _MAKE_FAN_PATH_ON_MAIN_BOARD(prj,id)
-
-static fan_path_T fan_path[] =  /* must map with onlp_fan_id */
-{
-    MAKE_FAN_PATH_ON_MAIN_BOARD(PROJECT_NAME, FAN_RESERVED),
-    MAKE_FAN_PATH_ON_MAIN_BOARD(PROJECT_NAME, FAN_1_ON_MAIN_BOARD),
-    MAKE_FAN_PATH_ON_MAIN_BOARD(PROJECT_NAME, FAN_2_ON_MAIN_BOARD),
-    MAKE_FAN_PATH_ON_MAIN_BOARD(PROJECT_NAME, FAN_3_ON_MAIN_BOARD),
-    MAKE_FAN_PATH_ON_MAIN_BOARD(PROJECT_NAME, FAN_4_ON_MAIN_BOARD)
-};
-
-#define MAKE_FAN_INFO_NODE_ON_MAIN_BOARD(id) \
-    { \
-        { ONLP_FAN_ID_CREATE(FAN_##id##_ON_MAIN_BOARD), "Chassis Fan "#id, 0 }, \
-        0x0, \
-        (ONLP_FAN_CAPS_SET_PERCENTAGE | ONLP_FAN_CAPS_GET_PERCENTAGE | \
-         ONLP_FAN_CAPS_GET_RPM | ONLP_FAN_CAPS_SET_RPM), \
-        0, \
-        0, \
-        ONLP_FAN_MODE_INVALID, \
-    }
-
-/* Static fan information */
-onlp_fan_info_t linfo[] = {
-    { }, /* Not used */
-    MAKE_FAN_INFO_NODE_ON_MAIN_BOARD(1),
-    MAKE_FAN_INFO_NODE_ON_MAIN_BOARD(2),
-    MAKE_FAN_INFO_NODE_ON_MAIN_BOARD(3),
-    MAKE_FAN_INFO_NODE_ON_MAIN_BOARD(4)
-};
+/* Indexed by fan OID id. Allocated by onlp_fani_init(). */
+static int* min_fan_speed = NULL;
+static int* max_fan_speed = NULL;
 
 #define VALIDATE(_id)                           \
     do {                                        \
@@ -104,31 +53,59 @@ onlp_fan_info_t linfo[] = {
         }                                       \
     } while(0)
 
-#define OPEN_READ_FILE(fullpath, data, nbytes, len)			\
-	if (onlp_file_read((uint8_t*)data, nbytes, &len, fullpath) < 0)	\
-       return ONLP_STATUS_E_INTERNAL;           \
-	else													\
-		AIM_LOG_VERBOSE("read data: %s\n", r_data);			\
+#define READ_INT(_value, ...)                                  \
+    do {                                                       \
+        if (mlnx_bsp_read_int(_value, __VA_ARGS__) < 0) {      \
+            return ONLP_STATUS_E_INTERNAL;                     \
+        }                                                      \
+        AIM_LOG_VERBOSE("read data: %d\n", *(_value));         \
+    } while(0)
 
 static int
-_onlp_fani_info_get_fan(int local_id, onlp_fan_info_t* info)
+_onlp_fani_fru_get(mlnx_fru_type_t type, int index, onlp_fan_info_t* info)
 {
-    int   len = 0, nbytes = 10;
+    mlnx_fru_t fru;
+    int rv = mlnx_fru_get(type, index, &fru);
+
+    /* A FRU with an incomplete EEPROM still reports what was parsed. */
+    if (rv == ONLP_STATUS_OK || rv == ONLP_STATUS_E_INVALID) {
+        aim_strlcpy(info->serial, fru.serial, sizeof(info->serial));
+        aim_strlcpy(info->model, fru.model, sizeof(info->model));
+        info->caps |= fru.fan_caps;
+    }
+
+    return rv;
+}
+
+static int
+_onlp_fani_info_get_fan(const mlnx_platform_info_t* pi, int local_id, onlp_fan_info_t* info)
+{
+    int   value = 0;
+    int   fru = 0;
     float range = 0;
     float temp  = 0;
-    char  r_data[10]   = {0};
-    char  fullpath[65] = {0};
-    const char fan_model[]=FAN_MODEL;
 
-    /* Fixed system FAN is always present */
+    if (pi->fans_per_fru) {
+        /* Eeprom and presence are per FRU but not per fan.
+           So, need to convert fan ID to FRU ID. */
+        fru = (local_id + pi->fans_per_fru - 1) / pi->fans_per_fru;
+
+        /* get fan status
+        */
+        READ_INT(&value, PREFIX_MODULE_PATH "fan%d_status", fru);
+        mlnx_fru_presence_update(MLNX_FRU_FAN, fru, value == FAN_STATUS_OK);
+        if (value != FAN_STATUS_OK) {
+            return ONLP_STATUS_OK;
+        }
+    } else {
+        /* Fixed system FAN is always present */
+        strncpy(info->model, pi->fan_model, sizeof(info->model));
+    }
     info->status |= ONLP_FAN_STATUS_PRESENT;
 
-    strncpy(info->model, fan_model, sizeof(info->model));
-
-     /* get fan speed */
-    snprintf(fullpath, sizeof(fullpath), "%s%s", PREFIX_PATH, fan_path[local_id].r_speed_get);
-    OPEN_READ_FILE(fullpath, r_data, nbytes, len);
-    info->rpm = atoi(r_data);
+    /* get fan speed
+    */
+    READ_INT(&info->rpm, PREFIX_PATH "fan%d_speed_get", local_id);
 
     /* check failure */
     if (info->rpm <= 0) {
@@ -137,15 +114,10 @@ _onlp_fani_info_get_fan(int local_id, onlp_fan_info_t* info)
     }
 
     if (ONLP_FAN_CAPS_GET_PERCENTAGE & info->caps) {
-        /* get fan min speed */
-        snprintf(fullpath, sizeof(fullpath), "%s%s", PREFIX_PATH, fan_path[local_id].min);
-        OPEN_READ_FILE(fullpath, r_data, nbytes, len);
-        min_fan_speed[local_id] = atoi(r_data);
-
-        /* get fan max speed */
-        snprintf(fullpath, sizeof(fullpath), "%s%s", PREFIX_PATH, fan_path[local_id].max);
-        OPEN_READ_FILE(fullpath, r_data, nbytes, len);
-        max_fan_speed[local_id] = atoi(r_data);
+        /* get fan min and max speed
+         */
+        READ_INT(&min_fan_speed[local_id], PREFIX_PATH "fan%d_min", local_id);
+        READ_INT(&max_fan_speed[local_id], PREFIX_PATH "fan%d_max", local_id);
 
         /* get speed percentage from rpm */
         range = max_fan_speed[local_id] - min_fan_speed[local_id];
@@ -160,6 +132,52 @@ _onlp_fani_info_get_fan(int local_id, onlp_fan_info_t* info)
         }
     }
 
+    if (fru) {
+        return _onlp_fani_fru_get(MLNX_FRU_FAN, fru, info);
+    }
+
+    return ONLP_STATUS_OK;
+}
+
+static int
+_onlp_fani_info_get_fan_on_psu(int psu_id, onlp_fan_info_t* info)
+{
+    int   value = 0;
+    float rpms_per_perc = 0.0;
+    float temp = 0.0;
+
+    /* get fan status
+    */
+    READ_INT(&value, PREFIX_MODULE_PATH "psu%d_status", psu_id);
+    mlnx_fru_presence_update(MLNX_FRU_PSU, psu_id, value == FAN_STATUS_OK);
+    if (value != FAN_STATUS_OK) {
+        return ONLP_STATUS_OK;
+    }
+    info->status |= ONLP_FAN_STATUS_PRESENT;
+
+    /* get fan speed
+    */
+    READ_INT(&info->rpm, PREFIX_PATH "psu%d_fan1_speed_get", psu_id);
+
+    /* check failure */
+    if (info->rpm <= 0) {
+      info->status |= ONLP_FAN_STATUS_FAILED;
+      return ONLP_STATUS_OK;
+    }
+
+    /* get speed percentage from rpm */
+    rpms_per_perc = PSU_FAN_RPM_MIN / PERCENTAGE_MIN;
+    temp = (float)info->rpm / rpms_per_perc;
+    if (temp < PERCENTAGE_MIN) {
+      temp = PERCENTAGE_MIN;
+    }
+    info->percentage = (int)temp;
+
+    /* Serial number and model for PSU fan is the same as for appropriate PSU */
+    if (0 != _onlp_fani_fru_get(MLNX_FRU_PSU, psu_id, info)) {
+        return ONLP_STATUS_E_INTERNAL;
+    }
+
     return ONLP_STATUS_OK;
 }
 
@@ -169,34 +187,58 @@ _onlp_fani_info_get_fan(int local_id, onlp_fan_info_t* info)
 int
 onlp_fani_init(void)
 {
+    const mlnx_platform_info_t* pi = mlnx_platform_info_get();
+
+    if (min_fan_speed == NULL) {
+        min_fan_speed = aim_zmalloc((pi->fan_count + 1) * sizeof(int));
+        max_fan_speed = aim_zmalloc((pi->fan_count + 1) * sizeof(int));
+    }
+
     return ONLP_STATUS_OK;
 }
 
+/*
+ * Get the descriptor of the given fan and
+ * initialize its static information.
+ */
+static const mlnx_fan_t*
+_onlp_fani_static_get(onlp_oid_t id, onlp_fan_info_t* info)
+{
+    int local_id = ONLP_OID_ID_GET(id);
+    const mlnx_platform_info_t* pi = mlnx_platform_info_get();
+    const mlnx_fan_t* fan;
+
+    if (local_id < 1 || local_id > pi->fan_count) {
+        return NULL;
+    }
+    fan = pi->fans + local_id - 1;
+
+    if (info) {
+        memset(info, 0, sizeof(*info));
+        info->hdr.id = id;
+        aim_strlcpy(info->hdr.description, fan->description, sizeof(info->hdr.description));
+        info->caps = fan->caps;
+        info->mode = ONLP_FAN_MODE_INVALID;
+    }
+
+    return fan;
+}
+
 int
 onlp_fani_info_get(onlp_oid_t id, onlp_fan_info_t* info)
 {
-    int rc = 0;
-    int local_id = 0;
+    const mlnx_fan_t* fan;
     VALIDATE(id);
 
-    local_id = ONLP_OID_ID_GET(id);
+    if ((fan = _onlp_fani_static_get(id, info)) == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
 
-    *info = linfo[local_id];
-
-    switch (local_id)
-        {
-        case FAN_1_ON_MAIN_BOARD:
-        case FAN_2_ON_MAIN_BOARD:
-        case FAN_3_ON_MAIN_BOARD:
-        case FAN_4_ON_MAIN_BOARD:
-            rc =_onlp_fani_info_get_fan(local_id, info);
-            break;
-        default:
-            rc = ONLP_STATUS_E_INVALID;
-            break;
-        }
+    if (fan->psu) {
+        return _onlp_fani_info_get_fan_on_psu(fan->psu, info);
+    }
 
-    return rc;
+    return _onlp_fani_info_get_fan(mlnx_platform_info_get(), ONLP_OID_ID_GET(id), info);
 }
 
 /*
@@ -213,14 +255,16 @@ onlp_fani_rpm_set(onlp_oid_t id, int rpm)
     float temp = 0.0;
     int   rv = 0, local_id = 0, nbytes = 10;
     char  r_data[10]   = {0};
-    onlp_fan_info_t* info = NULL;
+    const mlnx_fan_t* fan;
 
     VALIDATE(id);
 
+    if ((fan = _onlp_fani_static_get(id, NULL)) == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
     local_id = ONLP_OID_ID_GET(id);
-    info = &linfo[local_id];
 
-    if (0 == (ONLP_FAN_CAPS_SET_RPM & info->caps)) {
+    if (0 == (ONLP_FAN_CAPS_SET_RPM & fan->caps)) {
         return ONLP_STATUS_E_UNSUPPORTED;
     }
 
@@ -235,9 +279,6 @@ onlp_fani_rpm_set(onlp_oid_t id, int rpm)
        Value 153 is minimum rpm.
        Value 255 is maximum rpm.
     */
-    if (local_id > sizeof(min_fan_speed)/sizeof(min_fan_speed[0])) {
-        return ONLP_STATUS_E_INTERNAL;
-    }
     if (max_fan_speed[local_id] - min_fan_speed[local_id] < 0) {
         return ONLP_STATUS_E_INTERNAL;
     }
@@ -250,11 +291,10 @@ onlp_fani_rpm_set(onlp_oid_t id, int rpm)
 
     snprintf(r_data, sizeof(r_data), "%d", (int)temp);
     nbytes = strnlen(r_data, sizeof(r_data));
-    rv = onlp_file_write((uint8_t*)r_data, nbytes, "%s%s", PREFIX_PATH,
-            fan_path[local_id].r_speed_set);
-	if (rv < 0) {
-		return ONLP_STATUS_E_INTERNAL;
-	}
+    rv = onlp_file_write((uint8_t*)r_data, nbytes, PREFIX_PATH "fan%d_speed_set", local_id);
+    if (rv < 0) {
+        return ONLP_STATUS_E_INTERNAL;
+    }
 
     return ONLP_STATUS_OK;
 }
@@ -271,15 +311,17 @@ int
 onlp_fani_percentage_set(onlp_oid_t id, int p)
 {
     float temp = 0.0;
-    int   rv = 0, local_id = 0, nbytes = 10;
+    int   rv = 0, nbytes = 10;
     char  r_data[10]   = {0};
-    onlp_fan_info_t* info = NULL;
+    const mlnx_fan_t* fan;
 
     VALIDATE(id);
-    local_id = ONLP_OID_ID_GET(id);
-    info = &linfo[local_id];
 
-    if (0 == (ONLP_FAN_CAPS_SET_PERCENTAGE & info->caps)) {
+    if ((fan = _onlp_fani_static_get(id, NULL)) == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+
+    if (0 == (ONLP_FAN_CAPS_SET_PERCENTAGE & fan->caps)) {
         return ONLP_STATUS_E_UNSUPPORTED;
     }
 
@@ -303,11 +345,11 @@ onlp_fani_percentage_set(onlp_oid_t id, int p)
 
     snprintf(r_data, sizeof(r_data), "%d", (int)temp);
     nbytes = strnlen(r_data, sizeof(r_data));
-    rv = onlp_file_write((uint8_t*)r_data, nbytes, "%s%s",
-    		PREFIX_PATH, fan_path[local_id].r_speed_set);
-	if (rv < 0) {
-		return ONLP_STATUS_E_INTERNAL;
-	}
+    rv = onlp_file_write((uint8_t*)r_data, nbytes, PREFIX_PATH "fan%d_speed_set",
+                         ONLP_OID_ID_GET(id));
+    if (rv < 0) {
+        return ONLP_STATUS_E_INTERNAL;
+    }
 
     return ONLP_STATUS_OK;
 }
@@ -347,4 +389,3 @@ onlp_fani_ioctl(onlp_oid_t id, va_list vargs)
 {
     return ONLP_STATUS_E_UNSUPPORTED;
 }
-
@@ -0,0 +1,193 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *           Copyright 2014 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * FRU EEPROM Cache
+ *
+ * The FRU EEPROM contents only change when a FRU is replaced.
+ * Each EEPROM is parsed once and the result is kept until the
+ * FRU presence status changes. All callers are serialized by
+ * the ONLP API lock.
+ *
+ ***********************************************************/
+#include <string.h>
+#include "mlnx_common_int.h"
+#include "mlnx_common_log.h"
+
+typedef struct fru_entry_s {
+    /** Last reported presence, or -1 if unknown */
+    int present;
+    /** Non-zero if the entry holds a parse result */
+    int parsed;
+    mlnx_fru_t fru;
+} fru_entry_t;
+
+static fru_entry_t fru_cache__[MLNX_FRU_TYPE_COUNT][MLNX_FRU_MAX + 1];
+static int fru_cache_init__ = 0;
+
+static fru_entry_t*
+fru_entry__(mlnx_fru_type_t type, int index)
+{
+    if(!fru_cache_init__) {
+        int t, i;
+        for(t = 0; t < MLNX_FRU_TYPE_COUNT; t++) {
+            for(i = 0; i <= MLNX_FRU_MAX; i++) {
+                fru_cache__[t][i].present = -1;
+            }
+        }
+        fru_cache_init__ = 1;
+    }
+
+    if(type < 0 || type >= MLNX_FRU_TYPE_COUNT || index < 1 || index > MLNX_FRU_MAX) {
+        return NULL;
+    }
+    return &fru_cache__[type][index];
+}
+
+static int
+fru_parse_fan__(int fan_fru, mlnx_fru_t* fru)
+{
+    const char sanity_checker[] = "MLNX";
+    const uint8_t sanity_offset = 8;
+    const uint8_t sanity_len    = 4;
+    const uint8_t block1_start  = 12;
+    const uint8_t block1_type   = 1;
+    const uint8_t block2_start  = 14;
+    const uint8_t block2_type   = 5;
+    const uint8_t serial_offset = 8;
+    const uint8_t serial_len    = 24;
+    const uint8_t part_len      = 20;
+    const uint8_t fan_offset    = 14;
+    const uint8_t multiplier    = 16;
+    uint8_t data[256] = {0};
+    uint8_t offset = 0;
+    int len = 0;
+
+    if (mlnx_bsp_read(data, sizeof(data), &len, MLNX_IDPROM_PATH, "fan", fan_fru) < 0) {
+        return ONLP_STATUS_E_INTERNAL;
+    }
+
+    /* Sanity checker */
+    if (strncmp(sanity_checker, (char*)&data[sanity_offset], sanity_len)) {
+        return ONLP_STATUS_E_INVALID;
+    }
+
+    /* Checking eeprom block type with S/N and P/N */
+    if (data[block1_start + 1] != block1_type) {
+        return ONLP_STATUS_E_INVALID;
+    }
+
+    /* Reading serial number */
+    offset = data[block1_start] * multiplier + serial_offset;
+    strncpy(fru->serial, (char *)&data[offset], serial_len);
+
+    /* Reading part number */
+    offset += serial_len;
+    strncpy(fru->model, (char *)&data[offset], part_len);
+
+    /* Reading fan direction */
+    if (data[block2_start + 1] != block2_type) {
+        return ONLP_STATUS_E_INVALID;
+    }
+    offset = data[block2_start] * multiplier + fan_offset;
+    switch (data[offset]) {
+    case 1:
+        fru->fan_caps = ONLP_FAN_CAPS_F2B;
+        break;
+    case 2:
+        fru->fan_caps = ONLP_FAN_CAPS_B2F;
+        break;
+    default:
+        break;
+    }
+
+    return ONLP_STATUS_OK;
+}
+
+static int
+fru_parse_psu__(int psu, mlnx_fru_t* fru)
+{
+    const char sanity_check[]   = "MLNX";
+    const uint8_t serial_len    = 24;
+    char data[256] = {0};
+    bool sanity_found = false;
+    int index = 0, len = 0;
+
+    if (mlnx_bsp_read((uint8_t*)data, sizeof(data)-1, &len,
+                      MLNX_IDPROM_PATH, "psu", psu) < 0) {
+        return ONLP_STATUS_E_INTERNAL;
+    }
+
+    /* Looking for sanity checker */
+    while (index < sizeof(data) - sizeof(sanity_check) - serial_len) {
+        if (!strncmp(&data[index], sanity_check, sizeof(sanity_check) - 1)) {
+            sanity_found = true;
+            break;
+        }
+        index++;
+    }
+    if (false == sanity_found) {
+        return ONLP_STATUS_E_INVALID;
+    }
+
+    /* Serial number */
+    index += strlen(sanity_check);
+    strncpy(fru->serial, &data[index], sizeof(fru->serial) - 1);
+
+    /* Part number */
+    index += serial_len;
+    strncpy(fru->model, &data[index], sizeof(fru->model) - 1);
+
+    return ONLP_STATUS_OK;
+}
+
+void
+mlnx_fru_presence_update(mlnx_fru_type_t type, int index, int present)
+{
+    fru_entry_t* e = fru_entry__(type, index);
+
+    if (e && e->present != present) {
+        e->present = present;
+        e->parsed = 0;
+    }
+}
+
+int
+mlnx_fru_get(mlnx_fru_type_t type, int index, mlnx_fru_t* fru)
+{
+    fru_entry_t* e = fru_entry__(type, index);
+
+    if (e && e->parsed) {
+        *fru = e->fru;
+        return fru->rv;
+    }
+
+    memset(fru, 0, sizeof(*fru));
+    fru->rv = (type == MLNX_FRU_FAN) ?
+        fru_parse_fan__(index, fru) : fru_parse_psu__(index, fru);
+
+    /* Read failures are retried. Parse failures are kept. */
+    if (e && fru->rv != ONLP_STATUS_E_INTERNAL) {
+        e->fru = *fru;
+        e->parsed = 1;
+    }
+
+    return fru->rv;
+}
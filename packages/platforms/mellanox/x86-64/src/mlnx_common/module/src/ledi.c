@@ -0,0 +1,218 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *           Copyright 2014 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ *
+ *
+ ***********************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <onlplib/file.h>
+#include <onlp/platformi/ledi.h>
+#include "mlnx_common_int.h"
+#include "mlnx_common_log.h"
+
+#define prefix_path "/bsp/led/led_"
+#define driver_value_len 50
+
+#define LED_MODE_OFF         "none"
+#define LED_MODE_GREEN       "green"
+#define LED_MODE_RED         "red"
+#define LED_MODE_BLUE        "blue"
+#define LED_MODE_GREEN_BLINK "green_blink"
+#define LED_MODE_RED_BLINK   "red_blink"
+#define LED_MODE_BLUE_BLINK  "blue_blink"
+#define LED_MODE_AUTO        "cpld_control"
+
+#define VALIDATE(_id)                           \
+    do {                                        \
+        if(!ONLP_OID_IS_LED(_id)) {             \
+            return ONLP_STATUS_E_INVALID;       \
+        }                                       \
+    } while(0)
+
+/*
+ * All LEDs share the driver mode names.
+ * The modes an LED supports are given by its capabilities.
+ */
+typedef struct led_light_mode_map {
+    char* driver_led_mode;
+    enum onlp_led_mode_e onlp_led_mode;
+} led_light_mode_map_t;
+
+static led_light_mode_map_t led_map[] = {
+    { LED_MODE_OFF,         ONLP_LED_MODE_OFF },
+    { LED_MODE_GREEN,       ONLP_LED_MODE_GREEN },
+    { LED_MODE_RED,         ONLP_LED_MODE_RED },
+    { LED_MODE_BLUE,        ONLP_LED_MODE_BLUE },
+    { LED_MODE_RED_BLINK,   ONLP_LED_MODE_RED_BLINKING },
+    { LED_MODE_GREEN_BLINK, ONLP_LED_MODE_GREEN_BLINKING },
+    { LED_MODE_BLUE_BLINK,  ONLP_LED_MODE_BLUE_BLINKING },
+    { LED_MODE_AUTO,        ONLP_LED_MODE_AUTO },
+};
+
+static int driver_to_onlp_led_mode(const mlnx_led_t* led, char* driver_led_mode)
+{
+    int i;
+
+    for (i = 0; i < AIM_ARRAYSIZE(led_map); i++)
+    {
+        if ((led->caps & (1 << led_map[i].onlp_led_mode)) &&
+            !strncmp(led_map[i].driver_led_mode, driver_led_mode, driver_value_len))
+        {
+            return led_map[i].onlp_led_mode;
+        }
+    }
+
+    return 0;
+}
+
+static char* onlp_to_driver_led_mode(const mlnx_led_t* led, onlp_led_mode_t onlp_led_mode)
+{
+    int i;
+
+    for (i = 0; i < AIM_ARRAYSIZE(led_map); i++)
+    {
+        if ((led->caps & (1 << led_map[i].onlp_led_mode)) &&
+            onlp_led_mode == led_map[i].onlp_led_mode)
+        {
+            return led_map[i].driver_led_mode;
+        }
+    }
+
+    return LED_MODE_OFF;
+}
+
+static const mlnx_led_t*
+led_get(onlp_oid_t id)
+{
+    int local_id = ONLP_OID_ID_GET(id);
+    const mlnx_platform_info_t* pi = mlnx_platform_info_get();
+
+    if (local_id < 1 || local_id > pi->led_count) {
+        return NULL;
+    }
+    return pi->leds + local_id - 1;
+}
+
+/*
+ * This function will be called prior to any other onlp_ledi_* functions.
+ */
+int
+onlp_ledi_init(void)
+{
+    /*
+     * TODO setting UI LED to off when it will be supported
+     */
+
+    return ONLP_STATUS_OK;
+}
+
+int
+onlp_ledi_info_get(onlp_oid_t id, onlp_led_info_t* info)
+{
+    int  len;
+    uint8_t data[driver_value_len] = {0};
+    const mlnx_led_t* led;
+
+    VALIDATE(id);
+
+    if ((led = led_get(id)) == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+
+    /* Set the onlp_oid_hdr_t and capabilities */
+    memset(info, 0, sizeof(*info));
+    info->hdr.id = id;
+    aim_strlcpy(info->hdr.description, led->description, sizeof(info->hdr.description));
+    info->status = ONLP_LED_STATUS_PRESENT;
+    info->caps = led->caps;
+
+    /* Get LED mode */
+    if (mlnx_bsp_read(data, sizeof(data), &len, "%s%s",
+                      prefix_path, led->node) != 0) {
+        return ONLP_STATUS_E_INTERNAL;
+    }
+
+    info->mode = driver_to_onlp_led_mode(led, (char*)data);
+
+    /* Set the on/off status */
+    if (info->mode != ONLP_LED_MODE_OFF) {
+        info->status |= ONLP_LED_STATUS_ON;
+    }
+
+    return ONLP_STATUS_OK;
+}
+
+/*
+ * Turn an LED on or off.
+ *
+ * This function will only be called if the LED OID supports the ONOFF
+ * capability.
+ *
+ * What 'on' means in terms of colors or modes for multimode LEDs is
+ * up to the platform to decide. This is intended as baseline toggle mechanism.
+ */
+int
+onlp_ledi_set(onlp_oid_t id, int on_or_off)
+{
+    VALIDATE(id);
+
+    if (!on_or_off) {
+        return onlp_ledi_mode_set(id, ONLP_LED_MODE_OFF);
+    }
+
+    return ONLP_STATUS_E_UNSUPPORTED;
+}
+
+/*
+ * This function puts the LED into the given mode. It is a more functional
+ * interface for multimode LEDs.
+ *
+ * Only modes reported in the LED's capabilities will be attempted.
+ */
+int
+onlp_ledi_mode_set(onlp_oid_t id, onlp_led_mode_t mode)
+{
+    const mlnx_led_t* led;
+
+    VALIDATE(id);
+
+    if ((led = led_get(id)) == NULL) {
+        return ONLP_STATUS_E_INVALID;
+    }
+
+    if (onlp_file_write_str(onlp_to_driver_led_mode(led, mode),
+                            "%s%s", prefix_path, led->node) != 0)
+    {
+        return ONLP_STATUS_E_INTERNAL;
+    }
+
+    return ONLP_STATUS_OK;
+}
+
+/*
+ * Generic LED ioctl interface.
+ */
+int
+onlp_ledi_ioctl(onlp_oid_t id, va_list vargs)
+{
+    return ONLP_STATUS_E_UNSUPPORTED;
+}
@@ -0,0 +1,77 @@
+/**************************************************************************//**
+ *
+ * mlnx_common Internal Header
+ *
+ *****************************************************************************/
+#ifndef __mlnx_common_INT_H__
+#define __mlnx_common_INT_H__
+
+#include <mlnx_common/mlnx_common_config.h>
+#include <mlnx_common/mlnx_common.h>
+#include <onlp/fan.h>
+
+#define MLNX_BSP_PATH_MAX 80
+
+#define MLNX_IDPROM_PATH "/bsp/eeprom/%s%d_info"
+
+/**
+ * @brief Read a BSP attribute through a kept-open descriptor.
+ * @param data Receives the data.
+ * @param max Maximum read length.
+ * @param len Receives the read length.
+ * @param fmt Path format specifier.
+ */
+int mlnx_bsp_read(uint8_t* data, int max, int* len, const char* fmt, ...);
+
+/**
+ * @brief Read an integer BSP attribute through a kept-open descriptor.
+ */
+int mlnx_bsp_read_int(int* value, const char* fmt, ...);
+
+/**
+ * @brief Close all kept-open BSP descriptors.
+ */
+void mlnx_bsp_close_all(void);
+
+/** FRU types */
+typedef enum mlnx_fru_type_e {
+    MLNX_FRU_FAN,
+    MLNX_FRU_PSU,
+    MLNX_FRU_TYPE_COUNT,
+} mlnx_fru_type_t;
+
+/** Maximum FRU index of each type */
+#define MLNX_FRU_MAX 8
+
+/** Parsed FRU EEPROM */
+typedef struct mlnx_fru_s {
+    /** Parse result */
+    int rv;
+    /** Serial number */
+    char serial[ONLP_CONFIG_INFO_STR_MAX];
+    /** Part number */
+    char model[ONLP_CONFIG_INFO_STR_MAX];
+    /** Fan FRUs: ONLP_FAN_CAPS_F2B or ONLP_FAN_CAPS_B2F */
+    uint32_t fan_caps;
+} mlnx_fru_t;
+
+/**
+ * @brief Report the presence of a FRU.
+ * @param type The FRU type.
+ * @param index The FRU index.
+ * @param present The presence status.
+ * @note A presence transition discards the cached EEPROM data.
+ */
+void mlnx_fru_presence_update(mlnx_fru_type_t type, int index, int present);
+
+/**
+ * @brief Get the parsed EEPROM of a FRU.
+ * @param type The FRU type.
+ * @param index The FRU index.
+ * @param fru Receives the parsed data.
+ * @returns The parse result, also stored in fru->rv.
+ * @note The EEPROM is only read if no parse result is cached.
+ */
+int mlnx_fru_get(mlnx_fru_type_t type, int index, mlnx_fru_t* fru);
+
+#endif /* __mlnx_common_INT_H__ */
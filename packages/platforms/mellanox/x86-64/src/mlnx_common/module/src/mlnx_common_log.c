@@ -0,0 +1,18 @@
+/**************************************************************************//**
+ *
+ *
+ *
+ *****************************************************************************/
+#include <mlnx_common/mlnx_common_config.h>
+
+#include "mlnx_common_log.h"
+/*
+ * mlnx_common log struct.
+ */
+AIM_LOG_STRUCT_DEFINE(
+                      mlnx_common_CONFIG_LOG_OPTIONS_DEFAULT,
+                      mlnx_common_CONFIG_LOG_BITS_DEFAULT,
+                      NULL, /* Custom log map */
+                      mlnx_common_CONFIG_LOG_CUSTOM_BITS_DEFAULT
+                     );
+
@@ -0,0 +1,12 @@
+/**************************************************************************//**
+ *
+ * 
+ *
+ *****************************************************************************/
+#ifndef __mlnx_common_LOG_H__
+#define __mlnx_common_LOG_H__
+
+#define AIM_LOG_MODULE_NAME mlnx_common
+#include <AIM/aim_log.h>
+
+#endif /* __mlnx_common_LOG_H__ */
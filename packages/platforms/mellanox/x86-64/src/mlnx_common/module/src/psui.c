@@ -24,16 +24,15 @@
  ***********************************************************/
 #include <stdio.h>
 #include <string.h>
-#include <onlplib/file.h>
-#include <onlplib/mmap.h>
 #include <onlp/platformi/psui.h>
-#include "platform_lib.h"
+#include "mlnx_common_int.h"
+#include "mlnx_common_log.h"
 
 #define PSU_STATUS_PRESENT   1
 #define PSU_CABLE_PRESENT    1
 
-#define PSU_NODE_MAX_INT_LEN  8
-#define PSU_NODE_MAX_PATH_LEN 64
+#define PSU_MODULE_PREFIX "/bsp/module/psu%d_%s"
+#define PSU_POWER_PREFIX  "/bsp/power/psu%d_%s"
 
 #define VALIDATE(_id)                           \
     do {                                        \
@@ -45,35 +44,29 @@
 static int
 psu_module_info_get(int id, char *node, int *value)
 {
-    int len, ret = 0;
-    char buf[PSU_NODE_MAX_INT_LEN + 1] = {0};
-
     *value = 0;
-
-    ret = onlp_file_read((uint8_t*)buf, sizeof(buf), &len,
-    		PSU_MODULE_PREFIX, id, node);
-    if (ret == 0) {
-        *value = atoi(buf);
-    }
-
-    return ret;
+    return mlnx_bsp_read_int(value, PSU_MODULE_PREFIX, id, node);
 }
 
 static int
 psu_power_info_get(int id, char *node, int *value)
 {
-    int len, ret = 0;
-    char buf[PSU_NODE_MAX_INT_LEN + 1] = {0};
-
     *value = 0;
+    return mlnx_bsp_read_int(value, PSU_POWER_PREFIX, id, node);
+}
 
-    ret = onlp_file_read((uint8_t*)buf, sizeof(buf), &len,
-    		PSU_POWER_PREFIX, id, node);
-    if (ret == 0) {
-        *value = atoi(buf);
+static int
+_psu_fru_get(int index, onlp_psu_info_t* info)
+{
+    mlnx_fru_t fru;
+
+    /* Parsed once per inserted PSU */
+    if (mlnx_fru_get(MLNX_FRU_PSU, index, &fru) == ONLP_STATUS_OK) {
+        aim_strlcpy(info->serial, fru.serial, sizeof(info->serial));
+        aim_strlcpy(info->model, fru.model, sizeof(info->model));
     }
 
-    return ret;
+    return fru.rv;
 }
 
 int
@@ -83,8 +76,9 @@ onlp_psui_init(void)
 }
 
 static int
-_psu_info_get(onlp_psu_info_t* info)
+_psu_info_get(const mlnx_platform_info_t* pi, onlp_psu_info_t* info)
 {
+    int i, c = 0;
     int val   = 0;
     int index = ONLP_OID_ID_GET(info->hdr.id);
 
@@ -97,8 +91,37 @@ _psu_info_get(onlp_psu_info_t* info)
     }
 
     /* Set the associated oid_table */
-    info->hdr.coids[0] = ONLP_FAN_ID_CREATE(index + CHASSIS_FAN_COUNT);
-    info->hdr.coids[1] = ONLP_THERMAL_ID_CREATE(index + CHASSIS_THERMAL_COUNT);
+    for (i = 0; i < pi->fan_count && c < ONLP_OID_TABLE_SIZE; i++) {
+        if (pi->fans[i].psu == index) {
+            info->hdr.coids[c++] = ONLP_FAN_ID_CREATE(i + 1);
+        }
+    }
+    for (i = 0; i < pi->thermal_count && c < ONLP_OID_TABLE_SIZE; i++) {
+        if (pi->thermals[i].psu == index) {
+            info->hdr.coids[c++] = ONLP_THERMAL_ID_CREATE(i + 1);
+        }
+    }
+
+    if (pi->psu_model) {
+        /* Fixed PSUs only report output voltage and current */
+        if (psu_power_info_get(index, "volt", &val) == 0) {
+            info->mvout = val;
+            info->caps |= ONLP_PSU_CAPS_VOUT;
+        }
+
+        if (psu_power_info_get(index, "curr", &val) == 0) {
+            info->miout = val;
+            info->caps |= ONLP_PSU_CAPS_IOUT;
+        }
+
+        info->mpout = info->mvout * info->miout;
+        info->caps |= ONLP_PSU_CAPS_POUT;
+
+        info->mpin = ((int)(info->mpout / 91)) * 100;
+        info->caps |= ONLP_PSU_CAPS_PIN;
+
+        return ONLP_STATUS_OK;
+    }
 
     /* Read voltage, current and power */
     if (psu_power_info_get(index, "volt_in", &val) == 0 &&
@@ -135,49 +158,51 @@ _psu_info_get(onlp_psu_info_t* info)
         return ONLP_STATUS_OK;
     }
 
-    return psu_read_eeprom(index, info, NULL);
+    return _psu_fru_get(index, info);
 }
 
 /*
  * Get all information about the given PSU oid.
  */
-static onlp_psu_info_t pinfo[] =
-{
-    { }, /* Not used */
-    {
-        { ONLP_PSU_ID_CREATE(PSU1_ID), "PSU-1", 0 },
-    },
-    {
-        { ONLP_PSU_ID_CREATE(PSU2_ID), "PSU-2", 0 },
-    }
-};
-
 int
 onlp_psui_info_get(onlp_oid_t id, onlp_psu_info_t* info)
 {
     int val   = 0;
-    int ret   = ONLP_STATUS_OK;
     int index = ONLP_OID_ID_GET(id);
+    const mlnx_platform_info_t* pi = mlnx_platform_info_get();
 
     VALIDATE(id);
 
+    if (index < 1 || index > pi->psu_count) {
+        return ONLP_STATUS_E_INVALID;
+    }
+
     memset(info, 0, sizeof(onlp_psu_info_t));
-    *info = pinfo[index]; /* Set the onlp_oid_hdr_t */
+    info->hdr.id = id;
+    snprintf(info->hdr.description, sizeof(info->hdr.description), "PSU-%d", index);
 
-    /* Get the present state */
-    if (psu_module_info_get(index, "status", &val) != 0) {
-    	AIM_LOG_ERROR("Unable to read PSU(%d) node(psu_present)\r\n", index);
-    }
+    if (pi->psu_model) {
+        /* Fixed system, PSU is always present */
+        info->status |= ONLP_PSU_STATUS_PRESENT;
+        strncpy(info->model, pi->psu_model, sizeof(info->model));
+    } else {
+        /* Get the present state */
+        if (psu_module_info_get(index, "status", &val) != 0) {
+            AIM_LOG_ERROR("Unable to read PSU(%d) node(psu_present)\r\n", index);
+        } else {
+            mlnx_fru_presence_update(MLNX_FRU_PSU, index, val == PSU_STATUS_PRESENT);
+        }
 
-    if (val != PSU_STATUS_PRESENT) {
-        info->status &= ~ONLP_PSU_STATUS_PRESENT;
-        info->status |= ONLP_PSU_STATUS_UNPLUGGED;
-        return ONLP_STATUS_OK;
+        if (val != PSU_STATUS_PRESENT) {
+            info->status &= ~ONLP_PSU_STATUS_PRESENT;
+            info->status |= ONLP_PSU_STATUS_UNPLUGGED;
+            return ONLP_STATUS_OK;
+        }
     }
 
     /* Get the cable preset state */
     if (psu_module_info_get(index, "pwr_status", &val) != 0) {
-    	AIM_LOG_ERROR("Unable to read PSU(%d) node(cable_present)\r\n", index);
+        AIM_LOG_ERROR("Unable to read PSU(%d) node(cable_present)\r\n", index);
     }
 
     if (val != PSU_CABLE_PRESENT) {
@@ -187,9 +212,7 @@ onlp_psui_info_get(onlp_oid_t id, onlp_psu_info_t* info)
 
     info->status |= ONLP_PSU_STATUS_PRESENT;
 
-    ret = _psu_info_get(info);
-
-    return ret;
+    return _psu_info_get(pi, info);
 }
 
 int
@@ -197,4 +220,3 @@ onlp_psui_ioctl(onlp_oid_t pid, va_list vargs)
 {
     return ONLP_STATUS_E_UNSUPPORTED;
 }
-
@@ -24,48 +24,42 @@
  ***********************************************************/
 #include <onlp/platformi/sfpi.h>
 
-#include <fcntl.h> /* For O_RDWR && open */
 #include <stdio.h>
 #include <string.h>
-#include <unistd.h>
-#include <onlplib/file.h>
-#include <onlplib/i2c.h>
 #include <onlplib/sfp.h>
-#include <sys/ioctl.h>
-#include "platform_lib.h"
+#include "mlnx_common_int.h"
+#include "mlnx_common_log.h"
 
 #define MAX_SFP_PATH           64
 #define SFP_SYSFS_VALUE_LEN    20
-static char sfp_node_path[MAX_SFP_PATH] = {0};
-#define NUM_OF_SFP_PORT        16
 #define SFP_PRESENT_STATUS     "good"
 #define SFP_NOT_PRESENT_STATUS "not_connected"
+#define SFP_PORT_PATH          "/bsp/qsfp/qsfp%d"
 
 static int
-msn2100_sfp_node_read_int(char *node_path, int *value)
+mlnx_sfp_status_read(int port, int *value)
 {
-    int data_len = 0, ret = 0;
+    int len = 0;
     char buf[SFP_SYSFS_VALUE_LEN] = {0};
     *value = -1;
 
-    ret = onlp_file_read((uint8_t*)buf, sizeof(buf), &data_len, node_path);
+    if (port < 1 || port > mlnx_platform_info_get()->sfp_ports) {
+        return ONLP_STATUS_E_INVALID;
+    }
 
-    if (ret == 0) {
-        if (!strncmp(buf, SFP_PRESENT_STATUS, strlen(SFP_PRESENT_STATUS))) {
-            *value = 1;
-        } else if (!strncmp(buf, SFP_NOT_PRESENT_STATUS, strlen(SFP_NOT_PRESENT_STATUS))) {
-            *value = 0;
-        }
+    /* The status attribute is kept open. A scan does not open any files. */
+    if (mlnx_bsp_read((uint8_t*)buf, sizeof(buf) - 1, &len,
+                      SFP_PORT_PATH "_status", port) < 0) {
+        return ONLP_STATUS_E_INTERNAL;
     }
 
-    return ret;
-}
+    if (!strncmp(buf, SFP_PRESENT_STATUS, strlen(SFP_PRESENT_STATUS))) {
+        *value = 1;
+    } else if (!strncmp(buf, SFP_NOT_PRESENT_STATUS, strlen(SFP_NOT_PRESENT_STATUS))) {
+        *value = 0;
+    }
 
-static char*
-msn2100_sfp_get_port_path(int port, char *node_name)
-{
-    sprintf(sfp_node_path, "/bsp/qsfp/qsfp%d%s", port, node_name);
-    return sfp_node_path;
+    return 0;
 }
 
 /************************************************************
@@ -76,7 +70,13 @@ msn2100_sfp_get_port_path(int port, char *node_name)
 int
 onlp_sfpi_init(void)
 {
-    /* Called at initialization time */
+    int p, present;
+
+    /* Open all status attributes up front. */
+    for (p = 1; p <= mlnx_platform_info_get()->sfp_ports; p++) {
+        mlnx_sfp_status_read(p, &present);
+    }
+
     return ONLP_STATUS_OK;
 }
 
@@ -86,7 +86,7 @@ onlp_sfpi_bitmap_get(onlp_sfp_bitmap_t* bmap)
     int p = 1;
     AIM_BITMAP_CLR_ALL(bmap);
 
-    for (; p <= NUM_OF_SFP_PORT; p++) {
+    for (; p <= mlnx_platform_info_get()->sfp_ports; p++) {
         AIM_BITMAP_SET(bmap, p);
     }
 
@@ -102,9 +102,8 @@ onlp_sfpi_is_present(int port)
      * Return < 0 if error.
      */
     int present = -1;
-    char* path = msn2100_sfp_get_port_path(port, "_status");
 
-    if (msn2100_sfp_node_read_int(path, &present) != 0) {
+    if (mlnx_sfp_status_read(port, &present) != 0) {
         AIM_LOG_ERROR("Unable to read present status from port(%d)\r\n", port);
         return ONLP_STATUS_E_INTERNAL;
     }
@@ -116,11 +115,13 @@ int
 onlp_sfpi_presence_bitmap_get(onlp_sfp_bitmap_t* dst)
 {
     int ii = 1;
-    int rc = 0;
+    int present = 0;
 
-    for (;ii <= NUM_OF_SFP_PORT; ii++) {
-        rc = onlp_sfpi_is_present(ii);
-        AIM_BITMAP_MOD(dst, ii, (1 == rc) ? 1 : 0);
+    for (;ii <= mlnx_platform_info_get()->sfp_ports; ii++) {
+        if (mlnx_sfp_status_read(ii, &present) != 0) {
+            present = 0;
+        }
+        AIM_BITMAP_MOD(dst, ii, (1 == present) ? 1 : 0);
     }
 
     return ONLP_STATUS_OK;
@@ -129,7 +130,8 @@ onlp_sfpi_presence_bitmap_get(onlp_sfp_bitmap_t* dst)
 int
 onlp_sfpi_eeprom_read(int port, uint8_t data[256])
 {
-    char* path = msn2100_sfp_get_port_path(port, "");
+    char path[MAX_SFP_PATH];
+    snprintf(path, sizeof(path), SFP_PORT_PATH, port);
 
     /*
      * Read the SFP eeprom into data[]
@@ -192,6 +194,6 @@ onlp_sfpi_control_get(int port, onlp_sfp_control_t control, int* value)
 int
 onlp_sfpi_denit(void)
 {
+    mlnx_bsp_close_all();
     return ONLP_STATUS_OK;
 }
-
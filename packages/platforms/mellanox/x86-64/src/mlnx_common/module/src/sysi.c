@@ -22,51 +22,40 @@
  *
  *
  ***********************************************************/
-#include <fcntl.h>
 #include <stdio.h>
-#include <unistd.h>
-#include <sys/stat.h>
-#include <onlplib/file.h>
-#include <onlp/platformi/fani.h>
-#include <onlp/platformi/ledi.h>
-#include <onlp/platformi/psui.h>
+#include <string.h>
+#include <onlplib/onie.h>
 #include <onlp/platformi/sysi.h>
-#include <onlp/platformi/thermali.h>
-#include "platform_lib.h"
-#include "x86_64_mlnx_msn2100_int.h"
-#include "x86_64_mlnx_msn2100_log.h"
-
-#define ONL_PLATFORM_NAME  "x86-64-mlnx-msn2100-r0"
-#define ONIE_PLATFORM_NAME "x86_64-mlnx_msn2100-r0"
-
-#define COMMAND_OUTPUT_BUFFER        256
+#include "mlnx_common_int.h"
+#include "mlnx_common_log.h"
 
-#define PREFIX_PATH_ON_CPLD_DEV          "/bsp/cpld"
-#define NUM_OF_CPLD                      2
-static char arr_cplddev_name[NUM_OF_CPLD][30] =
-{
-    "cpld_brd_version",
-    "cpld_mgmt_version"
-};
+#define PREFIX_PATH_ON_CPLD_DEV "/bsp/cpld"
 
 const char*
 onlp_sysi_platform_get(void)
 {
-    return ONL_PLATFORM_NAME;
+    return mlnx_platform_info_get()->onl_platform_name;
 }
 
 int
 onlp_sysi_platform_info_get(onlp_platform_info_t* pi)
 {
-    int   i, v[NUM_OF_CPLD]={0};
-
-    for (i=0; i < NUM_OF_CPLD; i++) {
-        v[i] = 0;
-        if(onlp_file_read_int(v+i, "%s/%s", PREFIX_PATH_ON_CPLD_DEV, arr_cplddev_name[i]) < 0) {
+    int i, v, n = 0;
+    char versions[128] = {0};
+    const mlnx_platform_info_t* mpi = mlnx_platform_info_get();
+
+    for (i = 0; i < mpi->cpld_count; i++) {
+        v = 0;
+        if(mlnx_bsp_read_int(&v, "%s/cpld_%s_version",
+                             PREFIX_PATH_ON_CPLD_DEV, mpi->cplds[i]) < 0) {
             return ONLP_STATUS_E_INTERNAL;
         }
+        if (n < sizeof(versions)) {
+            n += snprintf(versions + n, sizeof(versions) - n, "%s%s=%d",
+                          (i) ? ", " : "", mpi->cplds[i], v);
+        }
     }
-    pi->cpld_versions = aim_fstrdup("brd=%d, mgmt=%d", v[0], v[1]);
+    pi->cpld_versions = aim_strdup(versions);
 
     return ONLP_STATUS_OK;
 }
@@ -83,34 +72,35 @@ onlp_sysi_oids_get(onlp_oid_t* table, int max)
 {
     int i;
     onlp_oid_t* e = table;
+    onlp_oid_t* end = table + max;
+    const mlnx_platform_info_t* pi = mlnx_platform_info_get();
     memset(table, 0, max*sizeof(onlp_oid_t));
 
-    for (i = 1; i <= CHASSIS_THERMAL_COUNT; i++)
-    {
-        *e++ = ONLP_THERMAL_ID_CREATE(i);
+    /* Chassis thermal sensors. PSU sensors are PSU children. */
+    for (i = 0; i < pi->thermal_count && e < end; i++) {
+        if (pi->thermals[i].psu == 0) {
+            *e++ = ONLP_THERMAL_ID_CREATE(i + 1);
+        }
     }
 
-    for (i = 1; i <= CHASSIS_LED_COUNT; i++)
-    {
+    for (i = 1; i <= pi->led_count && e < end; i++) {
         *e++ = ONLP_LED_ID_CREATE(i);
     }
 
-    for (i = 1; i <= CHASSIS_PSU_COUNT; i++)
-    {
+    for (i = 1; i <= pi->psu_count && e < end; i++) {
         *e++ = ONLP_PSU_ID_CREATE(i);
     }
 
-    for (i = 1; i <= CHASSIS_FAN_COUNT; i++)
-    {
-        *e++ = ONLP_FAN_ID_CREATE(i);
+    /* Chassis fans. PSU fans are PSU children. */
+    for (i = 0; i < pi->fan_count && e < end; i++) {
+        if (pi->fans[i].psu == 0) {
+            *e++ = ONLP_FAN_ID_CREATE(i + 1);
+        }
     }
 
     return 0;
 }
 
-#include <onlplib/onie.h>
-
-
 int
 onlp_sysi_onie_info_get(onlp_onie_info_t* onie)
 {
@@ -120,7 +110,7 @@ onlp_sysi_onie_info_get(onlp_onie_info_t* onie)
         if(onie->platform_name) {
             aim_free(onie->platform_name);
         }
-        onie->platform_name = aim_strdup(ONIE_PLATFORM_NAME);
+        onie->platform_name = aim_strdup(mlnx_platform_info_get()->onie_platform_name);
     }
 
     return rv;
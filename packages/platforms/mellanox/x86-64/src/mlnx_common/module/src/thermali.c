@@ -0,0 +1,88 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *           Copyright 2014 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * Thermal Sensor Platform Implementation.
+ *
+ ***********************************************************/
+#include <string.h>
+#include <onlp/platformi/thermali.h>
+#include "mlnx_common_int.h"
+#include "mlnx_common_log.h"
+
+#define prefix_path "/bsp/thermal"
+
+#define VALIDATE(_id)                           \
+    do {                                        \
+        if(!ONLP_OID_IS_THERMAL(_id)) {         \
+            return ONLP_STATUS_E_INVALID;       \
+        }                                       \
+    } while(0)
+
+/*
+ * This will be called to intiialize the thermali subsystem.
+ */
+int
+onlp_thermali_init(void)
+{
+    return ONLP_STATUS_OK;
+}
+
+/*
+ * Retrieve the information structure for the given thermal OID.
+ *
+ * If the OID is invalid, return ONLP_E_STATUS_INVALID.
+ * If an unexpected error occurs, return ONLP_E_STATUS_INTERNAL.
+ * Otherwise, return ONLP_STATUS_OK with the OID's information.
+ *
+ * Note -- it is expected that you fill out the information
+ * structure even if the sensor described by the OID is not present.
+ */
+int
+onlp_thermali_info_get(onlp_oid_t id, onlp_thermal_info_t* info)
+{
+    int local_id = 0;
+    const mlnx_thermal_t* t;
+    const mlnx_platform_info_t* pi = mlnx_platform_info_get();
+    VALIDATE(id);
+
+    local_id = ONLP_OID_ID_GET(id);
+    if (local_id < 1 || local_id > pi->thermal_count) {
+        return ONLP_STATUS_E_INVALID;
+    }
+    t = pi->thermals + local_id - 1;
+
+    /* Set the onlp_oid_hdr_t and capabilities */
+    memset(info, 0, sizeof(*info));
+    info->hdr.id = id;
+    aim_strlcpy(info->hdr.description, t->description, sizeof(info->hdr.description));
+    info->hdr.poid = (t->psu) ? ONLP_PSU_ID_CREATE(t->psu) : 0;
+    info->status = ONLP_THERMAL_STATUS_PRESENT;
+    info->caps = t->caps;
+    info->thresholds.warning = t->warning;
+    info->thresholds.error = t->error;
+    info->thresholds.shutdown = t->shutdown;
+
+    if (mlnx_bsp_read_int(&info->mcelsius, "%s/%s", prefix_path, t->node) < 0) {
+        return ONLP_STATUS_E_INTERNAL;
+    }
+
+    return ONLP_STATUS_OK;
+}
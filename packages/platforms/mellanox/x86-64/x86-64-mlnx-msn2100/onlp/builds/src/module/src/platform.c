@@ -0,0 +1,98 @@
+/************************************************************
+ * <bsn.cl fy=2014 v=onl>
+ *
+ *           Copyright 2014 Big Switch Networks, Inc.
+ *
+ * Licensed under the Eclipse Public License, Version 1.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *        http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the
+ * License.
+ *
+ * </bsn.cl>
+ ************************************************************
+ *
+ * MSN2100 Platform Descriptor
+ *
+ ***********************************************************/
+#include <onlp/platformi/fani.h>
+#include <onlp/platformi/ledi.h>
+#include <onlp/platformi/thermali.h>
+#include <mlnx_common/mlnx_common.h>
+#include "x86_64_mlnx_msn2100_int.h"
+
+#define CPU_THERMAL  ONLP_THERMAL_CAPS_ALL, 87000, 100000, 105000
+#define ASIC_THERMAL ONLP_THERMAL_CAPS_ALL, 105000, 115000, 120000
+#define AMB_THERMAL  ONLP_THERMAL_CAPS_GET_TEMPERATURE, 0, 0, 0
+
+#define CHASSIS_FAN_CAPS                                        \
+    (ONLP_FAN_CAPS_SET_PERCENTAGE | ONLP_FAN_CAPS_GET_PERCENTAGE | \
+     ONLP_FAN_CAPS_GET_RPM | ONLP_FAN_CAPS_SET_RPM)
+
+#define LED_CAPS                                                \
+    (ONLP_LED_CAPS_ON_OFF | ONLP_LED_CAPS_GREEN | ONLP_LED_CAPS_GREEN_BLINKING | \
+     ONLP_LED_CAPS_RED | ONLP_LED_CAPS_RED_BLINKING | ONLP_LED_CAPS_AUTO)
+#define UID_LED_CAPS                                            \
+    (ONLP_LED_CAPS_ON_OFF | ONLP_LED_CAPS_BLUE | ONLP_LED_CAPS_BLUE_BLINKING | \
+     ONLP_LED_CAPS_AUTO)
+
+static const mlnx_thermal_t thermals__[] = {
+    { "CPU Core 0", "cpu_core0", 0, CPU_THERMAL },
+    { "CPU Core 1", "cpu_core1", 0, CPU_THERMAL },
+    { "CPU Core 2", "cpu_core2", 0, CPU_THERMAL },
+    { "CPU Core 3", "cpu_core3", 0, CPU_THERMAL },
+    { "Asic Thermal Sensor", "asic", 0, ASIC_THERMAL },
+    { "Board AMB Thermal Sensor", "board_amb", 0, AMB_THERMAL },
+    { "Port AMB Thermal Sensor", "port_amb", 0, AMB_THERMAL },
+};
+
+static const mlnx_fan_t fans__[] = {
+    { "Chassis Fan 1", 0, CHASSIS_FAN_CAPS },
+    { "Chassis Fan 2", 0, CHASSIS_FAN_CAPS },
+    { "Chassis Fan 3", 0, CHASSIS_FAN_CAPS },
+    { "Chassis Fan 4", 0, CHASSIS_FAN_CAPS },
+};
+
+static const mlnx_led_t leds__[] = {
+    { "Chassis LED 1 (SYSTEM LED)", "status", LED_CAPS },
+    { "Chassis LED 2 (FAN LED)", "fan", LED_CAPS },
+    { "Chassis LED 3 (PSU1 LED)", "psu1", LED_CAPS },
+    { "Chassis LED 4 (PSU2 LED)", "psu2", LED_CAPS },
+    { "Chassis LED 5 (UID LED)", "uid", UID_LED_CAPS },
+};
+
+static const char* const cplds__[] = {
+    "brd",
+    "mgmt",
+};
+
+static const mlnx_platform_info_t platform_info__ = {
+    .onl_platform_name = "x86-64-mlnx-msn2100-r0",
+    .onie_platform_name = "x86_64-mlnx_msn2100-r0",
+    .sfp_ports = 16,
+    .thermals = thermals__,
+    .thermal_count = AIM_ARRAYSIZE(thermals__),
+    .fans = fans__,
+    .fan_count = AIM_ARRAYSIZE(fans__),
+    .fans_per_fru = 0,
+    .fan_model = "MEC012579",
+    .psu_count = 2,
+    .psu_model = "POW000167",
+    .leds = leds__,
+    .led_count = AIM_ARRAYSIZE(leds__),
+    .cplds = cplds__,
+    .cpld_count = AIM_ARRAYSIZE(cplds__),
+};
+
+const mlnx_platform_info_t*
+mlnx_platform_info_get(void)
+{
+    return &platform_info__;
+}